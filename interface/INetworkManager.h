@@ -39,6 +39,8 @@ namespace WPEFramework
             // All interfaces require a unique ID, defined in Ids.h
             enum { ID = ID_NETWORKMANAGER };
 
+            // COM-RPC resolves methods by position: new methods go at the end only
+
             // Define the RPC methods
             enum InterfaceType : uint8_t {
                 INTERFACE_TYPE_ETHERNET /* @text: ETHERNET */,
@@ -199,6 +201,14 @@ namespace WPEFramework
                 WIFI_STATE_INVALID
             };
 
+            enum OperationStatus : uint8_t
+            {
+                OPERATION_COMPLETED     /* @text: COMPLETED */,
+                OPERATION_TIMEDOUT      /* @text: TIMEDOUT */,
+                OPERATION_CANCELLED     /* @text: CANCELLED */,
+                OPERATION_SUPERSEDED    /* @text: SUPERSEDED */
+            };
+
             using IInterfaceDetailsIterator = RPC::IIteratorType<InterfaceDetails,     ID_NETWORKMANAGER_INTERFACE_DETAILS_ITERATOR>;
             using ISecurityModeIterator     = RPC::IIteratorType<WIFISecurityModeInfo, ID_NETWORKMANAGER_WIFI_SECURITY_MODE_ITERATOR>;
             using IStringIterator           = RPC::IIteratorType<string,               RPC::ID_STRINGITERATOR>;
@@ -278,6 +288,8 @@ namespace WPEFramework
             {
                 enum { ID = ID_NETWORKMANAGER_NOTIFICATION };
 
+                // COM-RPC resolves these by position: new notifications go at the end only
+
                 // Network Notifications that other processes can subscribe to
                 virtual void onInterfaceStateChange(const InterfaceState state /* @in */, const string interface /* @in */){};
                 virtual void onActiveInterfaceChange(const string prevActiveInterface /* @in */, const string currentActiveInterface /* @in */){};
@@ -288,11 +300,38 @@ namespace WPEFramework
                 virtual void onAvailableSSIDs(const string jsonOfScanResults /* @in */){};
                 virtual void onWiFiStateChange(const WiFiState state /* @in */){};
                 virtual void onWiFiSignalQualityChange(const string ssid /* @in */, const int strength /* @in */, const int noise /* @in */, const int snr /* @in */, const WiFiSignalQuality quality /* @in */){};
+                virtual void onAvailableSSIDsDelta(const string jsonOfScanDelta /* @in */){};
+
+                // Completion of a background operation
+                virtual void onOperationComplete(const uint32_t operationId /* @in */, const string operation /* @in */, const OperationStatus status /* @in */, const uint32_t result /* @in */, const uint32_t latency /* @in */){};
+
+                // Internet state of one IP family
+                virtual void onInternetStatusChangeByFamily(const InternetStatus prevState /* @in */, const InternetStatus currState /* @in */, const string interface /* @in */, const string ipversion /* @in */){};
+
+                // Batched address changes of one interface and IP version
+                virtual void onIPAddressesChanged(const string interface /* @in */, const string ipversion /* @in */, const string jsonOfChanges /* @in */){};
             };
 
             // Allow other processes to register/unregister from our notifications
             virtual uint32_t Register(INetworkManager::INotification* notification) = 0;
             virtual uint32_t Unregister(INetworkManager::INotification* notification) = 0;
+
+            /* @brief Background forms of the mutating calls; each returns at once with an operation ID and the result is published as onOperationComplete. The timeout is in milliseconds, 0 for the default */
+            virtual uint32_t WiFiConnectAsync(const WiFiConnectTo& ssid /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) = 0;
+            virtual uint32_t ConnectToKnownSSIDAsync(const string& ssid /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) = 0;
+            virtual uint32_t SetInterfaceStateAsync(const string& interface /* @in */, const bool enabled /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) = 0;
+            virtual uint32_t SetIPSettingsAsync(const string& interface /* @in */, const IPAddress& address /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) = 0;
+            virtual uint32_t StartWPSAsync(const WiFiWPS& method /* @in */, const string& pin /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) = 0;
+            /* @brief Cancel a background operation that has not completed */
+            virtual uint32_t CancelOperation(const uint32_t operationId /* @in */) = 0;
+            /* @brief Outcome counts and latency histogram of the background operations as JSON */
+            virtual uint32_t GetOperationStatistics(string& statistics /* @out */) = 0;
+
+            /* @brief Get the IPv4 and IPv6 Public IPs at once; both binding requests are sent concurrently */
+            virtual uint32_t GetDualStackPublicIP(string& interface /* @inout */, string& ipv4address /* @out */, string& ipv6address /* @out */) = 0;
+
+            /* @brief Probe counts, wakeups and the next delay of the connectivity monitor as JSON */
+            virtual uint32_t GetConnectivityMonitorStatistics(string& statistics /* @out */) = 0;
         };
     }
 }
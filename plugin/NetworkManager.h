@@ -84,11 +84,26 @@ namespace WPEFramework
                     _parent.onInternetStatusChange(prevState, currState, interface);
                 }
 
+                void onIPAddressesChanged(const string interface, const string ipversion, const string jsonOfChanges) override
+                {
+                    _parent.onIPAddressesChanged(interface, ipversion, jsonOfChanges);
+                }
+
+                void onInternetStatusChangeByFamily(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface, const string ipversion) override
+                {
+                    _parent.onInternetStatusChangeByFamily(prevState, currState, interface, ipversion);
+                }
+
                 void onAvailableSSIDs(const string jsonOfScanResults) override
                 {
                     _parent.onAvailableSSIDs(jsonOfScanResults);
                 }
 
+                void onAvailableSSIDsDelta(const string jsonOfScanDelta) override
+                {
+                    _parent.onAvailableSSIDsDelta(jsonOfScanDelta);
+                }
+
                 void onWiFiStateChange(const Exchange::INetworkManager::WiFiState state) override
                 {
                     _parent.onWiFiStateChange(state);
@@ -99,6 +114,11 @@ namespace WPEFramework
                     _parent.onWiFiSignalQualityChange(ssid, strength, noise, snr, quality);
                 }
 
+                void onOperationComplete(const uint32_t operationId, const string operation, const Exchange::INetworkManager::OperationStatus status, const uint32_t result, const uint32_t latency) override
+                {
+                    _parent.onOperationComplete(operationId, operation, status, result, latency);
+                }
+
                 // The activated/deactived methods are part of the RPC::IRemoteConnection::INotification
                 // interface. These are triggered when Thunder detects a connection/disconnection over the
                 // COM-RPC link.
@@ -239,6 +259,7 @@ namespace WPEFramework
             uint32_t IsConnectedToInternet(const JsonObject& parameters, JsonObject& response);
             uint32_t GetCaptivePortalURI(const JsonObject& parameters, JsonObject& response);
             uint32_t GetPublicIP(const JsonObject& parameters, JsonObject& response);
+            uint32_t GetDualStackPublicIP(const JsonObject& parameters, JsonObject& response);
             uint32_t Ping(const JsonObject& parameters, JsonObject& response);
             uint32_t Trace(const JsonObject& parameters, JsonObject& response);
             uint32_t SetHostname (const JsonObject& parameters, JsonObject& response);
@@ -256,14 +277,21 @@ namespace WPEFramework
             uint32_t GetWifiState(const JsonObject& parameters, JsonObject& response);
             uint32_t GetWiFiSignalQuality(const JsonObject& parameters, JsonObject& response);
             uint32_t GetSupportedSecurityModes(const JsonObject& parameters, JsonObject& response);
+            uint32_t CancelOperation(const JsonObject& parameters, JsonObject& response);
+            uint32_t GetOperationStatistics(const JsonObject& parameters, JsonObject& response);
+            uint32_t GetConnectivityMonitorStatistics(const JsonObject& parameters, JsonObject& response);
 
             void onInterfaceStateChange(const Exchange::INetworkManager::InterfaceState state, const string interface);
             void onActiveInterfaceChange(const string prevActiveInterface, const string currentActiveinterface);
             void onIPAddressChange(const string interface, const string ipversion, const string ipaddress, const Exchange::INetworkManager::IPStatus status);
+            void onIPAddressesChanged(const string interface, const string ipversion, const string jsonOfChanges);
             void onInternetStatusChange(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface);
+            void onInternetStatusChangeByFamily(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface, const string ipversion);
             void onAvailableSSIDs(const string jsonOfScanResults);
+            void onAvailableSSIDsDelta(const string jsonOfScanDelta);
             void onWiFiStateChange(const Exchange::INetworkManager::WiFiState state);
             void onWiFiSignalQualityChange(const string ssid, const int strength, const int noise, const int snr, const Exchange::INetworkManager::WiFiSignalQuality quality);
+            void onOperationComplete(const uint32_t operationId, const string operation, const Exchange::INetworkManager::OperationStatus status, const uint32_t result, const uint32_t latency);
 
         private:
             uint32_t _connectionId;
@@ -268,19 +268,6 @@ namespace WPEFramework
             buildVersion = "1.0";
     }
 
-    TestConnectivity::TestConnectivity(const std::vector<std::string>& endpoints, 
-        long timeout_ms, bool headReq, uint8_t ipversion, std::string interface)
-    {
-        getDeviceModel(m_deviceModel, m_buildVersion);
-        internetSate = INTERNET_UNKNOWN;
-        if(endpoints.size() < 1) {
-            NMLOG_ERROR("Endpoints size error ! curl check not possible");
-            return;
-        }
-
-        internetSate = checkCurlResponse(endpoints, timeout_ms, headReq, ipversion, interface);
-    }
-
     static bool curlVerboseEnabled() {
         std::ifstream fileStream("/tmp/nm.plugin.debug");
         return fileStream.is_open();
@@ -299,94 +286,185 @@ namespace WPEFramework
         return size * nmemb;
     }
 
+    /*
+     * DNS answers and TLS sessions are shared by every prober through one CURLSH. Connections
+     * stay in the connection cache of each prober's multi handle, because libcurl does not
+     * support sharing connections between threads. The share lives as long as the process.
+     */
+    static std::mutex probeShareLocks[CURL_LOCK_DATA_LAST];
+
+    static void probeShareLock(CURL*, curl_lock_data data, curl_lock_access, void*)
+    {
+        probeShareLocks[data].lock();
+    }
+
+    static void probeShareUnlock(CURL*, curl_lock_data data, void*)
+    {
+        probeShareLocks[data].unlock();
+    }
+
+    static CURLSH* probeShare()
+    {
+        static CURLSH* share = []() {
+            CURLSH* sh = curl_share_init();
+            if (!sh) {
+                NMLOG_ERROR("curl_share_init returned NULL");
+                return sh;
+            }
+            curl_share_setopt(sh, CURLSHOPT_LOCKFUNC, probeShareLock);
+            curl_share_setopt(sh, CURLSHOPT_UNLOCKFUNC, probeShareUnlock);
+            curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(sh, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            return sh;
+        }();
+        return share;
+    }
+
+    ConnectivityProber::ConnectivityProber()
+    {
+        std::string modelNum, buildVersion;
+        getDeviceModel(modelNum, buildVersion);
+        m_userAgent = "RDKCaptiveCheck/1.1 " + modelNum + "/" + buildVersion;
+        NMLOG_INFO ("INTERNET_CONNECTIVITY_MONITORING_USERAGENT : %s", m_userAgent.c_str());
+        /* no "Connection: close"; the connection is kept for the next probe */
+        m_headers = curl_slist_append(m_headers, "Cache-Control: no-cache, no-store");
+    }
+
+    ConnectivityProber::~ConnectivityProber()
+    {
+        std::lock_guard<std::mutex> lock(m_probeMutex);
+        releaseHandles();
+        if (m_multi)
+            curl_multi_cleanup(m_multi);
+        curl_slist_free_all(m_headers);
+    }
+
+    void ConnectivityProber::releaseHandles()
+    {
+        for (const auto& handle : m_handles)
+            curl_easy_cleanup(handle->easy);
+        m_handles.clear();
+    }
+
+    ConnectivityProber::ProbeHandle* ConnectivityProber::acquireHandle(const std::string& endpoint, bool headReq, uint8_t ipversion, const std::string& interface)
+    {
+        for (const auto& handle : m_handles)
+        {
+            if (handle->endpoint == endpoint && handle->interface == interface &&
+                handle->ipversion == ipversion && handle->headReq == headReq)
+                return handle.get();
+        }
+
+        if (m_handles.size() >= NMCONNECTIVITY_PROBE_HANDLES_MAX)
+        {
+            /* endpoints or interfaces changed; the old handles will not be used again */
+            NMLOG_DEBUG("releasing %d cached probe handles", static_cast<int>(m_handles.size()));
+            releaseHandles();
+        }
+
+        CURL *curl_easy_handle = curl_easy_init();
+        if (!curl_easy_handle)
+        {
+            NMLOG_ERROR("endpoint = <%s> curl_easy_init returned NULL", endpoint.c_str());
+            return nullptr;
+        }
+
+        std::unique_ptr<ProbeHandle> handle(new ProbeHandle{curl_easy_handle, endpoint, interface, ipversion, headReq, endpoint});
+        curlSetOpt(curl_easy_handle, CURLOPT_URL, endpoint.c_str());
+        /* set our custom set of headers */
+        curlSetOpt(curl_easy_handle, CURLOPT_HTTPHEADER, m_headers);
+        curlSetOpt(curl_easy_handle, CURLOPT_USERAGENT, m_userAgent.c_str());
+        if(!headReq)
+        {
+            /* HTTPGET request added insted of HTTPHEAD request fix for DELIA-61526 */
+            curlSetOpt(curl_easy_handle, CURLOPT_HTTPGET, 1L);
+            handle->logmsg += ", Get";
+        }
+        else
+            handle->logmsg += ", Head";
+        curlSetOpt(curl_easy_handle, CURLOPT_WRITEFUNCTION, writeFunction);
+        if (IP_ADDRESS_V4 == ipversion) {
+            curlSetOpt(curl_easy_handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
+            handle->logmsg +=", IPv4";
+        }
+        else if (IP_ADDRESS_V6 == ipversion) {
+            curlSetOpt(curl_easy_handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V6);
+            handle->logmsg +=", IPv6";
+        }
+        else
+            handle->logmsg +=", IPv4/IPv6";
+
+        if(!interface.empty())
+        {
+            curlSetOpt(curl_easy_handle, CURLOPT_INTERFACE, interface.c_str());
+            handle->logmsg += ", " + interface;
+        }
+
+        CURLSH *share = probeShare();
+        if (share)
+            curlSetOpt(curl_easy_handle, CURLOPT_SHARE, share);
+        curlSetOpt(curl_easy_handle, CURLOPT_PRIVATE, handle->logmsg.c_str());
+
+        m_handles.push_back(std::move(handle));
+        return m_handles.back().get();
+    }
+
     /*
      *  It is calculated as the current time plus the specified timeout duration.
      * This ensures that the entire operation does not exceed the given timeout, providing a hard limit
      *        for the network connectivity check.
      */
-    Exchange::INetworkManager::InternetStatus TestConnectivity::checkCurlResponse(const std::vector<std::string>& endpoints,
-                         long timeout_ms,  bool headReq, uint8_t ipversion, std::string interface)
+    void ConnectivityProber::probe(const std::vector<std::string>& endpoints, long timeout_ms, bool headReq, uint8_t ipversion,
+                                   const std::string& interface, std::vector<int>& responses, std::string& captivePortalURI, int& curlErrorCode)
     {
+        std::vector<ProbeResult> results;
+        probe(endpoints, timeout_ms, headReq, std::vector<uint8_t>{ipversion}, interface, results);
+        responses.insert(responses.end(), results[0].responses.begin(), results[0].responses.end());
+        if (!results[0].captivePortalURI.empty())
+            captivePortalURI = results[0].captivePortalURI;
+        if (results[0].curlErrorCode != 0)
+            curlErrorCode = results[0].curlErrorCode;
+    }
+
+    void ConnectivityProber::probe(const std::vector<std::string>& endpoints, long timeout_ms, bool headReq, const std::vector<uint8_t>& ipversions,
+                                   const std::string& interface, std::vector<ProbeResult>& results)
+    {
+        std::lock_guard<std::mutex> lock(m_probeMutex);
+        results.assign(ipversions.size(), ProbeResult());
         long deadline = 0, startTime = current_time(), time_now = 0, time_earlier = 0;
-        std::string logmsg ="";
+        long fastestMs = -1;
 
-        CURLM *curl_multi_handle = curl_multi_init();
-        if (!curl_multi_handle)
+        if (!m_multi && !(m_multi = curl_multi_init()))
         {
             NMLOG_ERROR("curl_multi_init returned NULL");
-            return INTERNET_NOT_AVAILABLE;
+            return;
         }
 
+        /* only the known interfaces are bound, any other name probes on the default route */
+        const std::string bindInterface = (interface == "wlan0" || interface == "eth0") ? interface : "";
+        const bool verbose = curlVerboseEnabled();
         CURLMcode mc;
-        std::vector<CURL*> curl_easy_handles;
-        std::vector<int> http_responses;
-        struct curl_slist *chunk = NULL;
-        std::string userAgent = "RDKCaptiveCheck/1.1";
-        userAgent += " " + m_deviceModel + "/" + m_buildVersion;
-
-        chunk = curl_slist_append(chunk, "Cache-Control: no-cache, no-store");
-        chunk = curl_slist_append(chunk, "Connection: close");
-        for (const auto& endpoint : endpoints)
+        /* each easy handle with the index of its IP version in results */
+        std::vector<std::pair<CURL*, size_t>> curl_easy_handles;
+        for (size_t family = 0; family < ipversions.size(); family++)
         {
-            CURL *curl_easy_handle = curl_easy_init();
-            if (!curl_easy_handle)
+            for (const auto& endpoint : endpoints)
             {
-                NMLOG_ERROR("endpoint = <%s> curl_easy_init returned NULL", endpoint.c_str());
-                continue;
-            }
-            curlSetOpt(curl_easy_handle, CURLOPT_URL, endpoint.c_str());
-            logmsg += endpoint;
-            /* set our custom set of headers */
-            curlSetOpt(curl_easy_handle, CURLOPT_HTTPHEADER, chunk);
-            NMLOG_INFO ("INTERNET_CONNECTIVITY_MONITORING_USERAGENT : %s", userAgent.c_str());
-            curlSetOpt(curl_easy_handle, CURLOPT_USERAGENT, userAgent.c_str());
-            if(!headReq)
-            {
-                /* HTTPGET request added insted of HTTPHEAD request fix for DELIA-61526 */
-                curlSetOpt(curl_easy_handle, CURLOPT_HTTPGET, 1L);
-                logmsg += ", Get";
-            }
-            else
-                logmsg += ", Head";
-            curlSetOpt(curl_easy_handle, CURLOPT_WRITEFUNCTION, writeFunction);
-            curlSetOpt(curl_easy_handle, CURLOPT_TIMEOUT_MS, timeout_ms);
-            if (IP_ADDRESS_V4 == ipversion) {
-                curlSetOpt(curl_easy_handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
-                logmsg +=", IPv4";
-            }
-            else if (IP_ADDRESS_V6 == ipversion) {
-                curlSetOpt(curl_easy_handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V6);
-                logmsg +=", IPv6";
-            }
-            else
-                logmsg +=", IPv4/IPv6";
-
-            if(interface == "wlan0")
-            {
-                curlSetOpt(curl_easy_handle, CURLOPT_INTERFACE, "wlan0");
-                logmsg +=", wlan0";
-            }
-            else if(interface == "eth0")
-            {
-                curlSetOpt(curl_easy_handle, CURLOPT_INTERFACE, "eth0");
-                logmsg +=", eth0";
-            }
-            
-            curlSetOpt(curl_easy_handle, CURLOPT_PRIVATE, logmsg.c_str());
-            if(curlVerboseEnabled())
-            {
-                curlSetOpt(curl_easy_handle, CURLOPT_VERBOSE, 1L);
-            }
-            if (CURLM_OK != (mc = curl_multi_add_handle(curl_multi_handle, curl_easy_handle)))
-            {
-                NMLOG_ERROR("endpoint = <%s> curl_multi_add_handle returned %d (%s)", endpoint.c_str(), mc, curl_multi_strerror(mc));
-                curl_easy_cleanup(curl_easy_handle);
-                continue;
+                ProbeHandle *handle = acquireHandle(endpoint, headReq, ipversions[family], bindInterface);
+                if (!handle)
+                    continue;
+                curlSetOpt(handle->easy, CURLOPT_TIMEOUT_MS, timeout_ms);
+                curlSetOpt(handle->easy, CURLOPT_VERBOSE, verbose ? 1L : 0L);
+                if (CURLM_OK != (mc = curl_multi_add_handle(m_multi, handle->easy)))
+                {
+                    NMLOG_ERROR("endpoint = <%s> curl_multi_add_handle returned %d (%s)", endpoint.c_str(), mc, curl_multi_strerror(mc));
+                    continue;
+                }
+                curl_easy_handles.emplace_back(handle->easy, family);
             }
-            curl_easy_handles.push_back(curl_easy_handle);
         }
-        
-        int handles, msgs_left;
+
+        int handles = 0, msgs_left;
         char *url = nullptr;
         char *endpntConf = nullptr;
         if((current_time() - startTime) > 1000) // 1 sec
@@ -400,16 +478,22 @@ namespace WPEFramework
 
         while (1)
         {
-            if (CURLM_OK != (mc = curl_multi_perform(curl_multi_handle, &handles)))
+            if (CURLM_OK != (mc = curl_multi_perform(m_multi, &handles)))
             {
                 NMLOG_ERROR("curl_multi_perform returned %d (%s)", mc, curl_multi_strerror(mc));
                 break;
             }
-            for (CURLMsg *msg; NULL != (msg = curl_multi_info_read(curl_multi_handle, &msgs_left)); )
+            for (CURLMsg *msg; NULL != (msg = curl_multi_info_read(m_multi, &msgs_left)); )
             {
                 long response_code = -1;
                 if (msg->msg != CURLMSG_DONE)
                     continue;
+                auto owner = std::find_if(curl_easy_handles.begin(), curl_easy_handles.end(),
+                                          [msg](const std::pair<CURL*, size_t>& entry) { return entry.first == msg->easy_handle; });
+                if (owner == curl_easy_handles.end())
+                    continue;
+                ProbeResult& result = results[owner->second];
+                const uint8_t ipversion = ipversions[owner->second];
                 curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &endpntConf);
                 if (CURLE_OK == msg->data.result) {
                     if (curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &response_code) == CURLE_OK)
@@ -417,7 +501,7 @@ namespace WPEFramework
                         if (HttpStatus_302_Found == response_code) {
                             if ( (curl_easy_getinfo(msg->easy_handle, CURLINFO_REDIRECT_URL, &url) == CURLE_OK) && url != nullptr) {
                                 NMLOG_INFO("captive portal found !!!");
-                                captivePortalURI = url;
+                                result.captivePortalURI = url;
                             }
                         }
 
@@ -427,11 +511,7 @@ namespace WPEFramework
                             char *ip = NULL;
                             curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIMARY_IP, &ip);
                             if(ip != NULL) {
-                                if(strchr(ip, ':'))
-                                    ipversion = IP_ADDRESS_V6;
-                                else
-                                    ipversion = IP_ADDRESS_V4; //Fix Me: Error case handling if ip is NULL
-                                NMLOG_DEBUG("ipversion not specified, determined ipversion = %s", (ipversion == IP_ADDRESS_V6) ? "IPv6" : "IPv4");
+                                NMLOG_DEBUG("ipversion not specified, determined ipversion = %s", strchr(ip, ':') ? "IPv6" : "IPv4");
                             }
                             else
                             {
@@ -439,6 +519,16 @@ namespace WPEFramework
                             }
                         }
                     }
+
+                    double totalTime = 0;
+                    long newConnections = 0;
+                    curl_easy_getinfo(msg->easy_handle, CURLINFO_TOTAL_TIME, &totalTime);
+                    curl_easy_getinfo(msg->easy_handle, CURLINFO_NUM_CONNECTS, &newConnections);
+                    long latencyMs = static_cast<long>(totalTime * 1000);
+                    if (fastestMs < 0 || latencyMs < fastestMs)
+                        fastestMs = latencyMs;
+                    NMLOG_DEBUG("endpoint = <%s> http %ld in %ld ms, %s connection", endpntConf, response_code, latencyMs,
+                                                newConnections > 0 ? "new" : "reused");
                 }
                 else
                 {
@@ -447,37 +537,47 @@ namespace WPEFramework
                                                 interface.empty() ? "any" : interface.c_str(),
                                                 msg->data.result,
                                                 curl_easy_strerror(msg->data.result));
-                    curlErrorCode = static_cast<int>(msg->data.result);
+                    result.curlErrorCode = static_cast<int>(msg->data.result);
                 }
-                http_responses.push_back(response_code);
+                result.responses.push_back(response_code);
             }
             time_earlier = time_now;
             time_now = current_time();
             if (handles == 0 || time_now >= deadline)
                 break;
-            if (CURLM_OK != (mc = curl_multi_poll(curl_multi_handle, NULL, 0, deadline - time_now, NULL)))
+            if (CURLM_OK != (mc = curl_multi_poll(m_multi, NULL, 0, deadline - time_now, NULL)))
             {
                 NMLOG_ERROR("curl_multi_poll returned %d (%s)", mc, curl_multi_strerror(mc));
                 break;
             }
         }
 
-        if(curlVerboseEnabled()) {
+        if(verbose) {
+            size_t responseCount = 0;
+            for (const auto& result : results)
+                responseCount += result.responses.size();
             NMLOG_DEBUG("endpoints count = %d response count %d, handles = %d, deadline = %ld, time_now = %ld, time_earlier = %ld",
-                static_cast<int>(endpoints.size()), static_cast<int>(http_responses.size()), handles, deadline, time_now, time_earlier);
+                static_cast<int>(endpoints.size() * ipversions.size()), static_cast<int>(responseCount), handles, deadline, time_now, time_earlier);
         }
 
+        /* the easy handles are kept for the next probe; their connections stay in the multi handle */
         for (const auto& curl_easy_handle : curl_easy_handles)
-        {
-            curl_easy_getinfo(curl_easy_handle, CURLINFO_PRIVATE, &endpntConf);
-            //LOG_DBG("endpoint = <%s> terminating attempt", endpoint);
-            curl_multi_remove_handle(curl_multi_handle, curl_easy_handle);
-            curl_easy_cleanup(curl_easy_handle);
+            curl_multi_remove_handle(m_multi, curl_easy_handle.first);
+        m_lastLatencyMs = fastestMs;
+    }
+
+    TestConnectivity::TestConnectivity(ConnectivityProber& prober, const std::vector<std::string>& endpoints,
+        long timeout_ms, bool headReq, uint8_t ipversion, std::string interface)
+    {
+        internetSate = INTERNET_UNKNOWN;
+        if(endpoints.size() < 1) {
+            NMLOG_ERROR("Endpoints size error ! curl check not possible");
+            return;
         }
-        curl_multi_cleanup(curl_multi_handle);
-        /* free the custom headers */
-        curl_slist_free_all(chunk);
-        return checkInternetStateFromResponseCode(http_responses);
+
+        std::vector<int> http_responses;
+        prober.probe(endpoints, timeout_ms, headReq, ipversion, interface, http_responses, captivePortalURI, curlErrorCode);
+        internetSate = checkInternetStateFromResponseCode(http_responses);
     }
 
     /*
@@ -539,6 +639,76 @@ namespace WPEFramework
         return InternetConnectionState;
     }
 
+    Exchange::INetworkManager::InternetStatus ConnectivityStateTable::update(const std::string& interface, uint8_t ipversion, InternetStatus state,
+                                                                           const std::string& captivePortalURI, Clock::time_point now)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto entry = m_entries.find({interface, ipversion});
+        if (entry == m_entries.end())
+        {
+            m_entries.emplace(std::make_pair(interface, ipversion), Entry{state, captivePortalURI, now, false});
+            return INTERNET_UNKNOWN;
+        }
+        InternetStatus previous = entry->second.state;
+        entry->second = Entry{state, captivePortalURI, now, false};
+        return previous;
+    }
+
+    bool ConnectivityStateTable::lookup(const std::string& interface, uint8_t ipversion, std::chrono::milliseconds maxAge,
+                                        InternetStatus& state, Clock::time_point now) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto entry = m_entries.find({interface, ipversion});
+        if (entry == m_entries.end() || entry->second.stale)
+            return false;
+        if (now - entry->second.updated > ((!m_monitored.empty() && interface == m_monitored) ? m_monitoredMaxAge : maxAge))
+            return false;
+        state = entry->second.state;
+        return true;
+    }
+
+    std::string ConnectivityStateTable::captivePortalURI(const std::string& interface) const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (uint8_t ipversion : {IP_ADDRESS_V4, IP_ADDRESS_V6})
+        {
+            auto entry = m_entries.find({interface, ipversion});
+            if (entry != m_entries.end() && entry->second.state == INTERNET_CAPTIVE_PORTAL)
+                return entry->second.captivePortalURI;
+        }
+        return std::string();
+    }
+
+    void ConnectivityStateTable::invalidate(const std::string& interface)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto& entry : m_entries)
+        {
+            if (entry.first.first == interface)
+                entry.second.stale = true;
+        }
+    }
+
+    void ConnectivityStateTable::setMonitored(const std::string& interface, std::chrono::milliseconds maxAge)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_monitored = interface;
+        m_monitoredMaxAge = maxAge;
+    }
+
+    void ConnectivityStateTable::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_entries.clear();
+        m_monitored.clear();
+    }
+
+    bool ConnectivityStateTable::better(InternetStatus state, InternetStatus than)
+    {
+        auto rank = [](InternetStatus status) { return (status == INTERNET_UNKNOWN) ? -1 : static_cast<int>(status); };
+        return rank(state) > rank(than);
+    }
+
     ConnectivityMonitor::ConnectivityMonitor()
     {
         NMLOG_WARNING("ConnectivityMonitor");
@@ -546,7 +716,17 @@ namespace WPEFramework
         m_notify = true;
         m_InternetState = INTERNET_UNKNOWN;
         m_switchToInitial = true;
-        m_wakeupMonitoring = false;
+
+        using std::chrono::seconds;
+        m_scheduler.setPolicy(ProbeScheduler::PHASE_INITIAL, {seconds(NMCONNECTIVITY_MONITOR_MIN_INTERVAL), seconds(NMCONNECTIVITY_MONITOR_MIN_INTERVAL), 1.0, 0.0});
+        m_scheduler.setPolicy(ProbeScheduler::PHASE_DEGRADED, {seconds(NMCONNECTIVITY_MONITOR_RETRY_INTERVAL), seconds(NMCONNECTIVITY_MONITOR_MAX_INTERVAL),
+                                                               NMCONNECTIVITY_MONITOR_BACKOFF_FACTOR, NMCONNECTIVITY_MONITOR_BACKOFF_JITTER});
+        /* the watched interface is refreshed once per longest interval, before its entries expire */
+        m_scheduler.setPolicy(ProbeScheduler::PHASE_CONNECTED, {seconds(NMCONNECTIVITY_MONITOR_MAX_INTERVAL), seconds(NMCONNECTIVITY_MONITOR_MAX_INTERVAL),
+                                                                1.0, NMCONNECTIVITY_MONITOR_BACKOFF_JITTER});
+        /* nothing is probed here; events wake the monitor, the timer is only a safety net */
+        m_scheduler.setPolicy(ProbeScheduler::PHASE_LINK_DOWN, {seconds(NMCONNECTIVITY_MONITOR_MIN_INTERVAL), seconds(NMCONNECTIVITY_MONITOR_LINK_DOWN_INTERVAL),
+                                                                NMCONNECTIVITY_MONITOR_BACKOFF_FACTOR, 0.0});
         startConnectivityMonitor();
     }
 
@@ -568,24 +748,61 @@ namespace WPEFramework
 
     Exchange::INetworkManager::InternetStatus ConnectivityMonitor::getInternetState(std::string& interface, Exchange::INetworkManager::IPVersion& ipversion, bool ipVersionNotSpecified)
     {
-        uint8_t ipversionLocal = static_cast<uint8_t>(ipVersionNotSpecified ? 2 : ipversion); // 2 = both, 0 = IPv4, 1 = IPv6
+        if (interface.empty() && _instance != nullptr)
+            interface = _instance->getDefaultInterface();
 
-        // if ipversion not specified, check both IP versions and determine it based on the resolved IP address
-        TestConnectivity testInternet(m_endpoint(), NMCONNECTIVITY_CURL_REQUEST_TIMEOUT_MS,
-                NMCONNECTIVITY_CURL_HEAD_REQUEST, ipversionLocal, interface);
+        // if ipversion not specified, answer with the better of the two IP versions
+        std::vector<uint8_t> wanted;
+        if (ipVersionNotSpecified)
+            wanted = {IP_ADDRESS_V4, IP_ADDRESS_V6};
+        else
+            wanted = {static_cast<uint8_t>(ipversion)};
+
+        const std::chrono::milliseconds maxAge = std::chrono::seconds(NMCONNECTIVITY_STATE_MAX_AGE);
+        Exchange::INetworkManager::InternetStatus best = INTERNET_UNKNOWN;
+        uint8_t bestFamily = wanted.front();
+        std::vector<uint8_t> missing;
+        auto answer = [&]() {
+            missing.clear();
+            for (uint8_t family : wanted)
+            {
+                Exchange::INetworkManager::InternetStatus state = INTERNET_UNKNOWN;
+                if (!m_states.lookup(interface, family, maxAge, state))
+                    missing.push_back(family);
+                else if (ConnectivityStateTable::better(state, best))
+                {
+                    best = state;
+                    bestFamily = family;
+                }
+            }
+        };
 
-        if (interface.empty())
-            interface = _instance->getDefaultInterface();
+        answer();
+        // a family without a known state is probed now, unless the other one is already fully connected
+        if (!missing.empty() && best != INTERNET_FULLY_CONNECTED)
+        {
+            NMLOG_DEBUG("no recent internet state of %s for %d IP version(s); probing", interface.c_str(), static_cast<int>(missing.size()));
+            std::vector<uint8_t> families = routableFamilies(interface, missing);
+            if (!families.empty())
+            {
+                uint8_t family = families.front();
+                probeFamilies(m_requestProber, interface, families, family);
+            }
+            answer();
+        }
 
-        return testInternet.getInternetState();
+        ipversion = static_cast<Exchange::INetworkManager::IPVersion>(bestFamily);
+        return best;
     }
 
     std::string ConnectivityMonitor::getCaptivePortalURI()
     {
-        if(m_InternetState == INTERNET_CAPTIVE_PORTAL)
+        const std::string defaultIface = (_instance != nullptr) ? _instance->getDefaultInterface() : std::string();
+        std::string captiveURI = m_states.captivePortalURI(defaultIface);
+        if(!captiveURI.empty())
         {
-            NMLOG_INFO("captive portal URI = %s", m_captiveURI.c_str());
-            return m_captiveURI;
+            NMLOG_INFO("captive portal URI = %s", captiveURI.c_str());
+            return captiveURI;
         }
 
         NMLOG_WARNING("No captive portal found !");
@@ -596,13 +813,13 @@ namespace WPEFramework
     {
         if (m_cmRunning)
         {
-            m_wakeupMonitoring = true;
-            m_cmCv.notify_one();
+            m_scheduler.wake(ProbeScheduler::WAKE_REQUEST);
             NMLOG_DEBUG("connectivity monitor is already running");
             return true;
         }
 
         m_cmRunning = true;
+        m_scheduler.restart();
         m_cmThrdID = std::thread(&ConnectivityMonitor::connectivityMonitorFunction, this);
 
         if(_instance != nullptr) {
@@ -617,16 +834,22 @@ namespace WPEFramework
     bool ConnectivityMonitor::stopConnectivityMonitor()
     {
         m_cmRunning = false;
-        m_wakeupMonitoring = true;
-        m_cmCv.notify_one();
+        m_scheduler.stop();
         if(m_cmThrdID.joinable())
             m_cmThrdID.join();
         m_InternetState = INTERNET_UNKNOWN;
+        m_states.setMonitored("", std::chrono::milliseconds(0));
         NMLOG_INFO("connectivity monitor stoped !!!");
         return true;
     }
 
-    bool ConnectivityMonitor::switchToInitialCheck()
+    void ConnectivityMonitor::wakeup(ProbeScheduler::WakeReason reason)
+    {
+        if (m_cmRunning)
+            m_scheduler.wake(reason);
+    }
+
+    bool ConnectivityMonitor::switchToInitialCheck(ProbeScheduler::WakeReason reason)
     {
 
         if(_instance == nullptr) {
@@ -644,8 +867,9 @@ namespace WPEFramework
 
         m_notify = true;
         m_switchToInitial = true;
-        m_wakeupMonitoring = true;
-        m_cmCv.notify_one();
+        /* until the monitor probed again, requests about this interface are probed themselves */
+        m_states.invalidate(defaultIface);
+        m_scheduler.wake(reason);
 
         NMLOG_INFO("switching to initial check - eth %s - wlan %s - default interface %s",
                     _instance->m_ethConnected.load()? "up":"down", _instance->m_wlanConnected.load()? "up":"down", defaultIface.c_str());
@@ -669,20 +893,104 @@ namespace WPEFramework
             NMLOG_FATAL("NetworkManagerImplementation Instance NULL notifyInternetStatusChange failed.");
     }
 
+    Exchange::INetworkManager::InternetStatus ConnectivityMonitor::probeInternet(const std::string& interface)
+    {
+        std::vector<uint8_t> families = routableFamilies(interface, {IP_ADDRESS_V4, IP_ADDRESS_V6});
+        if (families.empty())
+        {
+            NMLOG_INFO("link pre-check failed on %s; no HTTP probe", interface.c_str());
+            m_scheduler.recordSkippedProbe();
+            return INTERNET_NOT_AVAILABLE;
+        }
+
+        m_scheduler.recordProbe();
+        uint8_t family = families.front();
+        return probeFamilies(m_monitorProber, interface, families, family);
+    }
+
+    std::vector<uint8_t> ConnectivityMonitor::routableFamilies(const std::string& interface, const std::vector<uint8_t>& families)
+    {
+        /*
+         * A default route whose gateway failed ARP cannot carry the probe. With no default
+         * route on the interface at all, look at every interface, since the route may live
+         * on another interface or table that /proc/net/route does not show.
+         */
+        LinkPrecheck::Result link = m_precheck.check(interface);
+        if (!link.ipv4Route && !link.ipv6Route)
+            link = m_precheck.check("");
+
+        std::vector<uint8_t> routable;
+        for (uint8_t family : families)
+        {
+            bool usable = (family == IP_ADDRESS_V4) ? (link.ipv4Route && !link.ipv4GatewayFailed) : link.ipv6Route;
+            if (usable)
+                routable.push_back(family);
+            else
+            {
+                NMLOG_DEBUG("%s has no usable %s default route (gateway %s %s)", interface.c_str(), (family == IP_ADDRESS_V4) ? "IPv4" : "IPv6",
+                            link.ipv4Gateway.c_str(), link.ipv4GatewayFailed ? "unresolved" : "ok");
+                recordState(interface, family, INTERNET_NOT_AVAILABLE, "");
+            }
+        }
+        return routable;
+    }
+
+    Exchange::INetworkManager::InternetStatus ConnectivityMonitor::probeFamilies(ConnectivityProber& prober, const std::string& interface,
+                                                                                const std::vector<uint8_t>& families, uint8_t& bestFamily)
+    {
+        const std::vector<std::string> endpoints = m_endpoint();
+        if (endpoints.empty())
+        {
+            NMLOG_ERROR("Endpoints size error ! curl check not possible");
+            return INTERNET_UNKNOWN;
+        }
+
+        std::vector<ConnectivityProber::ProbeResult> results;
+        prober.probe(endpoints, NMCONNECTIVITY_CURL_REQUEST_TIMEOUT_MS, NMCONNECTIVITY_CURL_HEAD_REQUEST, families, interface, results);
+
+        Exchange::INetworkManager::InternetStatus best = INTERNET_UNKNOWN;
+        for (size_t i = 0; i < families.size(); i++)
+        {
+            Exchange::INetworkManager::InternetStatus state = TestConnectivity::checkInternetStateFromResponseCode(results[i].responses);
+            recordState(interface, families[i], state, (state == INTERNET_CAPTIVE_PORTAL) ? results[i].captivePortalURI : "");
+            if (ConnectivityStateTable::better(state, best))
+            {
+                best = state;
+                bestFamily = families[i];
+            }
+        }
+        return best;
+    }
+
+    void ConnectivityMonitor::recordState(const std::string& interface, uint8_t ipversion, Exchange::INetworkManager::InternetStatus state,
+                                          const std::string& captivePortalURI)
+    {
+        Exchange::INetworkManager::InternetStatus previous = m_states.update(interface, ipversion, state, captivePortalURI);
+        if (previous == state)
+            return;
+
+        NMLOG_INFO("%s %s internet state %s -> %s", interface.c_str(), (ipversion == IP_ADDRESS_V4) ? "IPv4" : "IPv6",
+                    getInternetStateString(previous), getInternetStateString(state));
+        if (_instance != nullptr)
+            _instance->ReportInternetStatusChangeByFamily(previous, state, interface, static_cast<Exchange::INetworkManager::IPVersion>(ipversion));
+    }
+
     void ConnectivityMonitor::connectivityMonitorFunction()
     {
-        int timeoutInSec = NMCONNECTIVITY_MONITOR_MIN_INTERVAL;
         Exchange::INetworkManager::InternetStatus currentInternetState = INTERNET_NOT_AVAILABLE;
         int InitialRetryCount = 0;
+        ProbeScheduler::Phase lastPhase = ProbeScheduler::PHASE_INITIAL;
         m_switchToInitial = true;
         m_InternetState = INTERNET_UNKNOWN;
         m_notify = true;
 
         while (m_cmRunning) {
+            ProbeScheduler::Phase phase = ProbeScheduler::PHASE_LINK_DOWN;
+
             if (nullptr == _instance)
             {
                 NMLOG_DEBUG("Must be right from the constructor; because the _instance is NULL");
-                timeoutInSec = NMCONNECTIVITY_MONITOR_MIN_INTERVAL;
+                phase = ProbeScheduler::PHASE_INITIAL; // nothing wakes the monitor when the instance is set
                 m_InternetState = INTERNET_NOT_AVAILABLE;
                 currentInternetState = INTERNET_NOT_AVAILABLE;
                 InitialRetryCount = 0;
@@ -690,7 +998,7 @@ namespace WPEFramework
             // Check if no interfaces are connected
             else if (_instance != nullptr && !_instance->m_ethConnected.load() && !_instance->m_wlanConnected.load()) {
                 NMLOG_DEBUG("no interface connected, no ccm check");
-                timeoutInSec = NMCONNECTIVITY_MONITOR_MIN_INTERVAL;
+                m_states.setMonitored("", std::chrono::milliseconds(0));
                 m_InternetState = INTERNET_NOT_AVAILABLE;
                 currentInternetState = INTERNET_NOT_AVAILABLE;
                 if (InitialRetryCount == 0)
@@ -700,6 +1008,7 @@ namespace WPEFramework
             else
             {
                 string defaultIface = _instance->getDefaultInterface();
+                m_states.setMonitored(defaultIface, std::chrono::seconds(NMCONNECTIVITY_MONITORED_STATE_MAX_AGE));
 
                 if(defaultIface.empty())
                 {
@@ -710,22 +1019,17 @@ namespace WPEFramework
                 }
                 else if (m_switchToInitial)
                 {
+                    phase = ProbeScheduler::PHASE_INITIAL;
                     if (InitialRetryCount == 0)
                         m_notify = true;
                     NMLOG_INFO("Initial connectivity check - index:%d, current state:%s, interface:%s", InitialRetryCount, getInternetStateString(currentInternetState), defaultIface.c_str());
-                    timeoutInSec = NMCONNECTIVITY_MONITOR_MIN_INTERVAL;
-                    TestConnectivity testInternet(m_endpoint(), NMCONNECTIVITY_CURL_REQUEST_TIMEOUT_MS,
-                                                    NMCONNECTIVITY_CURL_HEAD_REQUEST, 2, defaultIface);
-                    currentInternetState = testInternet.getInternetState();
+                    currentInternetState = probeInternet(defaultIface);
 
                     if (currentInternetState == INTERNET_NOT_AVAILABLE) {
                         NMLOG_DEBUG("interface connected but no internet");
                         InitialRetryCount = 1; // continue same check for 5 sec
                     }
                     else {
-                        if(currentInternetState == INTERNET_CAPTIVE_PORTAL)
-                            m_captiveURI = testInternet.getCaptivePortal();
-
                         if (currentInternetState != m_InternetState) {
                             NMLOG_DEBUG("initial connectivity state change from %s to %s", getInternetStateString(m_InternetState), getInternetStateString(currentInternetState));
                             m_InternetState = currentInternetState;
@@ -738,23 +1042,27 @@ namespace WPEFramework
                     if (InitialRetryCount > NM_CONNECTIVITY_MONITOR_RETRY_COUNT) {
                         m_switchToInitial = false;
                         m_notify = true;
+                        m_scheduler.resetBackoff();
                         NMLOG_INFO("switching to ideal ccm check interface: %s", defaultIface.c_str());
                     }
                 }
                 else
                 {
-                    // ideal case check every 30 sec happenses when captive portal or limited internet
-                    timeoutInSec = NMCONNECTIVITY_MONITOR_RETRY_INTERVAL;
+                    // settled: back off while captive portal or limited internet; while fully connected, the
+                    // first round only arms the long timer and the next ones refresh the interface's entries
                     InitialRetryCount = 0;
+                    phase = ProbeScheduler::PHASE_CONNECTED;
+                    bool probe = (lastPhase == ProbeScheduler::PHASE_CONNECTED);
 
                     if(m_InternetState != INTERNET_FULLY_CONNECTED)
                     {
-                        TestConnectivity testInternet(m_endpoint(), NMCONNECTIVITY_CURL_REQUEST_TIMEOUT_MS,
-                                NMCONNECTIVITY_CURL_HEAD_REQUEST, 2, defaultIface); // check both IP versions
-                        currentInternetState = testInternet.getInternetState();
+                        phase = ProbeScheduler::PHASE_DEGRADED;
+                        probe = true;
+                    }
 
-                        if (currentInternetState == INTERNET_CAPTIVE_PORTAL) // if captive portal found copy the URL
-                            m_captiveURI = testInternet.getCaptivePortal();
+                    if (probe)
+                    {
+                        currentInternetState = probeInternet(defaultIface);
 
                         if (currentInternetState != m_InternetState)
                         {
@@ -762,7 +1070,8 @@ namespace WPEFramework
                             m_switchToInitial = true;
                             m_notify = true;
                             InitialRetryCount = 1;
-                            timeoutInSec = NMCONNECTIVITY_MONITOR_MIN_INTERVAL; // retry in 5 sec
+                            m_scheduler.resetBackoff();
+                            phase = ProbeScheduler::PHASE_INITIAL; // retry in 5 sec
                         }
                     }
                 }
@@ -777,12 +1086,14 @@ namespace WPEFramework
             if (!m_cmRunning)
                 break;
 
-            // Wait for next interval
-            std::unique_lock<std::mutex> lock(m_cmMutex);
-            if (m_cmCv.wait_for(lock, std::chrono::seconds(timeoutInSec), [this] { return m_wakeupMonitoring.load(); }))
+            // Wait for next interval, or for an interface, address or route event
+            std::chrono::milliseconds delay = m_scheduler.next(phase);
+            NMLOG_DEBUG("next connectivity check in %lld ms (%s)", static_cast<long long>(delay.count()), ProbeScheduler::phaseName(phase));
+            lastPhase = phase;
+            if (m_scheduler.wait(delay))
             {
-                NMLOG_INFO("connectivity monitor received signal. skipping %d sec interval", timeoutInSec);
-                m_wakeupMonitoring = false;
+                NMLOG_INFO("connectivity monitor received signal. skipping %lld ms interval", static_cast<long long>(delay.count()));
+                m_scheduler.resetBackoff();
             }
         }
     }
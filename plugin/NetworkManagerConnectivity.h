@@ -27,9 +27,12 @@
 #include <cerrno>
 #include <cstdlib>
 #include <fstream>
+#include <map>
+#include <memory>
 #include <curl/curl.h>
 
 #include "INetworkManager.h"
+#include "NetworkManagerProbeScheduler.h"
 
 enum nsm_connectivity_httpcode {
     HttpStatus_response_error               = 99,
@@ -49,7 +52,14 @@ enum nsm_connectivity_httpcode {
 #define NMCONNECTIVITY_MONITOR_CACHE_FILE         "/tmp/nm.plugin.endpoints"
 #define NMCONNECTIVITY_MONITOR_MIN_INTERVAL         5      // sec
 #define NMCONNECTIVITY_MONITOR_RETRY_INTERVAL       30     //  sec
+#define NMCONNECTIVITY_MONITOR_MAX_INTERVAL         300    // sec, cap of the backoff; a portal login or a new upstream is not signalled
+#define NMCONNECTIVITY_MONITOR_LINK_DOWN_INTERVAL    60     // sec, cap while there is nothing to probe
+#define NMCONNECTIVITY_MONITOR_BACKOFF_FACTOR       2.0
+#define NMCONNECTIVITY_MONITOR_BACKOFF_JITTER       0.2    // +/- 20%
 #define NMCONNECTIVITY_CURL_REQUEST_TIMEOUT_MS      5000   // ms
+#define NMCONNECTIVITY_STATE_MAX_AGE                60     // sec, trust in the state of an interface the monitor does not watch
+#define NMCONNECTIVITY_MONITORED_STATE_MAX_AGE      400    // sec, outlives the longest monitor interval (300 s + 20% jitter) and a probe
+#define NMCONNECTIVITY_PROBE_HANDLES_MAX            16     // easy handles kept by a prober
 #define NM_CONNECTIVITY_MONITOR_RETRY_COUNT         3      // 3 retry
 
 namespace WPEFramework
@@ -92,36 +102,128 @@ namespace WPEFramework
             std::mutex m_endpointMutex;
         };
 
+        /*
+         * Long lived HTTP prober. DNS answers and TLS sessions are kept in a CURLSH shared
+         * by every prober; connections stay in the cache of the prober's own multi handle.
+         * Each (endpoint, IP version, interface) keeps its easy handle, so a steady state
+         * check is one keep-alive request per endpoint.
+         * A prober runs one probe at a time.
+         */
+        class ConnectivityProber
+        {
+            ConnectivityProber(const ConnectivityProber&) = delete;
+            const ConnectivityProber& operator=(const ConnectivityProber&) = delete;
+
+        public:
+            ConnectivityProber();
+            ~ConnectivityProber();
+
+            struct ProbeResult {
+                std::vector<int> responses;
+                std::string captivePortalURI;
+                int curlErrorCode = 0;
+            };
+
+            /* Collects the HTTP response code of every endpoint, -1 for a curl error */
+            void probe(const std::vector<std::string>& endpoints, long timeout_ms, bool headReq, uint8_t ipversion,
+                       const std::string& interface, std::vector<int>& responses, std::string& captivePortalURI, int& curlErrorCode);
+            /* Same, for several IP versions at once: all requests share one deadline; results[i] is for ipversions[i] */
+            void probe(const std::vector<std::string>& endpoints, long timeout_ms, bool headReq, const std::vector<uint8_t>& ipversions,
+                       const std::string& interface, std::vector<ProbeResult>& results);
+            /* round trip of the fastest endpoint that answered in the last probe, -1 if none did */
+            long lastLatencyMs() const { return m_lastLatencyMs.load(); }
+
+        private:
+            struct ProbeHandle {
+                CURL* easy;
+                std::string endpoint;
+                std::string interface;
+                uint8_t ipversion;
+                bool headReq;
+                std::string logmsg;
+            };
+
+            ProbeHandle* acquireHandle(const std::string& endpoint, bool headReq, uint8_t ipversion, const std::string& interface);
+            void releaseHandles();
+
+            template<typename curlValue>
+            void curlSetOpt(CURL *curl, CURLoption option, curlValue value)
+            {
+                CURLcode response = curl_easy_setopt(curl, option, value);
+                if (response != CURLE_OK) {
+                    NMLOG_ERROR("Error setting option %d with error: %s", option, curl_easy_strerror(response));
+                }
+                return;
+            }
+
+            std::mutex m_probeMutex;
+            CURLM* m_multi = nullptr;
+            struct curl_slist* m_headers = nullptr;
+            std::string m_userAgent;
+            std::vector<std::unique_ptr<ProbeHandle>> m_handles;
+            std::atomic<long> m_lastLatencyMs{-1};
+        };
+
         class TestConnectivity
         {
             TestConnectivity(const TestConnectivity&) = delete;
             const TestConnectivity& operator=(const TestConnectivity&) = delete;
 
         public:
-            TestConnectivity(const std::vector<std::string>& endpoints, long timeout_ms, bool headReq,
+            TestConnectivity(ConnectivityProber& prober, const std::vector<std::string>& endpoints, long timeout_ms, bool headReq,
                         uint8_t ipversion, std::string interface = "");
             ~TestConnectivity(){}
             std::string getCaptivePortal() {return captivePortalURI;}
             Exchange::INetworkManager::InternetStatus getInternetState(){return internetSate;}
             int getCurlError(){return curlErrorCode;}
+            static Exchange::INetworkManager::InternetStatus checkInternetStateFromResponseCode(const std::vector<int>& responses);
         private:
-            Exchange::INetworkManager::InternetStatus checkCurlResponse(const std::vector<std::string>& endpoints, 
-                            long timeout_ms, bool headReq, uint8_t ipversion, std::string interface);
-            Exchange::INetworkManager::InternetStatus checkInternetStateFromResponseCode(const std::vector<int>& responses);
             std::string captivePortalURI;
-            std::string m_deviceModel{};
-            std::string m_buildVersion{};
             Exchange::INetworkManager::InternetStatus internetSate;
             int curlErrorCode = 0;
-            template<typename curlValue>
-            void curlSetOpt(CURL *curl, CURLoption option, curlValue value)
-            {
-                CURLcode response = curl_easy_setopt(curl, option, value);
-                if (response != CURLE_OK) {
-                    NMLOG_ERROR("Error setting option %d with error: %s", option, curl_easy_strerror(response));
-                }
-                return;
-            }
+        };
+
+        /*
+         * Last known internet state of each (interface, IP version), filled by the monitor and by
+         * API requests. The entries of the interface the monitor watches are refreshed by it at
+         * least every monitor interval and are trusted for the longer monitored age; the entries
+         * of any other interface come from API requests and are trusted for maxAge.
+         */
+        class ConnectivityStateTable
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+            using InternetStatus = Exchange::INetworkManager::InternetStatus;
+
+            /* Returns the state the entry had before, INTERNET_UNKNOWN if there was none */
+            InternetStatus update(const std::string& interface, uint8_t ipversion, InternetStatus state,
+                                  const std::string& captivePortalURI, Clock::time_point now = Clock::now());
+            /* false if there is no entry, it was invalidated, or it is older than the age allowed for its interface */
+            bool lookup(const std::string& interface, uint8_t ipversion, std::chrono::milliseconds maxAge,
+                        InternetStatus& state, Clock::time_point now = Clock::now()) const;
+            /* URI of the family found behind a captive portal, empty if none is */
+            std::string captivePortalURI(const std::string& interface) const;
+            /* The next lookups miss until the entries are updated; the states are kept for the change events */
+            void invalidate(const std::string& interface);
+            /* entries of this interface are trusted for maxAge instead of the one given to lookup() */
+            void setMonitored(const std::string& interface, std::chrono::milliseconds maxAge);
+            void clear();
+
+            /* FULLY_CONNECTED > CAPTIVE_PORTAL > LIMITED_INTERNET > NO_INTERNET > UNKNOWN */
+            static bool better(InternetStatus state, InternetStatus than);
+
+        private:
+            struct Entry {
+                InternetStatus state;
+                std::string captivePortalURI;
+                Clock::time_point updated;
+                bool stale;
+            };
+
+            mutable std::mutex m_lock;
+            std::map<std::pair<std::string, uint8_t>, Entry> m_entries;
+            std::string m_monitored;
+            std::chrono::milliseconds m_monitoredMaxAge{0};
         };
 
         class ConnectivityMonitor
@@ -131,7 +233,11 @@ namespace WPEFramework
             ~ConnectivityMonitor();
             bool stopConnectivityMonitor();
             bool startConnectivityMonitor();
-            bool switchToInitialCheck();
+            bool switchToInitialCheck(ProbeScheduler::WakeReason reason = ProbeScheduler::WAKE_REQUEST);
+            /* Re-evaluates at once instead of at the end of the current backoff */
+            void wakeup(ProbeScheduler::WakeReason reason);
+            void setBackoffPolicy(ProbeScheduler::Phase phase, const BackoffPolicy& policy) { m_scheduler.setPolicy(phase, policy); }
+            void getStatistics(std::string& json) { m_scheduler.statsToJson(json); }
             void setConnectivityMonitorEndpoints(const std::vector<std::string> &endpoints);
             std::vector<std::string> getConnectivityMonitorEndpoints();
             Exchange::INetworkManager::InternetStatus getInternetState(std::string& interface, Exchange::INetworkManager::IPVersion& ipversion, bool ipVersionNotSpecified = false);
@@ -142,18 +248,30 @@ namespace WPEFramework
             ConnectivityMonitor& operator=(const ConnectivityMonitor&) = delete;
             void connectivityMonitorFunction();
             void notifyInternetStatusChangedEvent(Exchange::INetworkManager::InternetStatus newState);
+            /* Link pre-check, then the HTTP probe of the IP versions the link can carry */
+            Exchange::INetworkManager::InternetStatus probeInternet(const std::string& interface);
+            /* Drops the IP versions without a usable default route, recording them as NO_INTERNET */
+            std::vector<uint8_t> routableFamilies(const std::string& interface, const std::vector<uint8_t>& families);
+            /* One HTTP round over the given IP versions; records each of them and returns the best state */
+            Exchange::INetworkManager::InternetStatus probeFamilies(ConnectivityProber& prober, const std::string& interface,
+                                                                    const std::vector<uint8_t>& families, uint8_t& bestFamily);
+            /* Updates the state table; a family whose state changed is published */
+            void recordState(const std::string& interface, uint8_t ipversion, Exchange::INetworkManager::InternetStatus state,
+                             const std::string& captivePortalURI);
             /* connectivity monitor */
             std::thread m_cmThrdID;
             std::atomic<bool> m_cmRunning;
-            std::condition_variable m_cmCv;
-            std::mutex m_cmMutex;
             std::atomic<bool> m_notify;
             std::atomic<bool> m_switchToInitial;
-            std::atomic<bool> m_wakeupMonitoring;
-            std::string m_captiveURI;
+            ProbeScheduler m_scheduler;
+            LinkPrecheck m_precheck;
             std::atomic<Exchange::INetworkManager::InternetStatus> m_InternetState;
+            ConnectivityStateTable m_states;
             /* manages endpoints */
             EndpointManager m_endpoint;
+            /* the monitor thread and API requests probe independently, sharing one curl cache */
+            ConnectivityProber m_monitorProber;
+            ConnectivityProber m_requestProber;
         };
     } // namespace Plugin
 } // namespace WPEFramework
@@ -0,0 +1,195 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#define NM_EVENT_QUEUE_DEFAULT_LIMIT    128
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Event dispatch queue with two priority lanes and coalescing.
+         *
+         * Events pushed with a non empty coalesce key replace the queued event of
+         * the same kind and key, keeping its position, so that subscribers only see
+         * the latest payload. High priority events are always handed out before bulk
+         * ones; FIFO order is kept inside a lane. When the limit is reached the oldest
+         * bulk event is dropped first, and a bulk event never displaces a high priority one.
+         *
+         * The queue itself is not thread safe; the owner serializes access.
+         */
+        template <typename Payload>
+        class EventDispatchQueue
+        {
+        public:
+            enum Priority {
+                PRIORITY_HIGH = 0,
+                PRIORITY_BULK
+            };
+
+            struct Stats {
+                size_t depth;
+                size_t highWaterMark;
+                uint64_t enqueued;
+                uint64_t coalesced;
+                uint64_t dropped;
+            };
+
+            /* Default merge policy: last writer wins. Returning false removes the queued event. */
+            struct ReplacePayload {
+                bool operator()(Payload& queued, Payload&& incoming) const
+                {
+                    queued = std::move(incoming);
+                    return true;
+                }
+            };
+
+        private:
+            struct Entry {
+                int kind;
+                Priority priority;
+                std::string key;
+                Payload payload;
+            };
+            using Lane = std::list<Entry>;
+            using Index = std::map<std::pair<int, std::string>, typename Lane::iterator>;
+
+        public:
+            explicit EventDispatchQueue(size_t limit = NM_EVENT_QUEUE_DEFAULT_LIMIT)
+                : m_limit(limit > 0 ? limit : 1)
+            {
+            }
+
+            void setLimit(size_t limit) { m_limit = (limit > 0 ? limit : 1); }
+            size_t limit() const { return m_limit; }
+            size_t size() const { return m_lanes[PRIORITY_HIGH].size() + m_lanes[PRIORITY_BULK].size(); }
+            bool empty() const { return size() == 0; }
+
+            Stats stats() const
+            {
+                return Stats{size(), m_highWaterMark, m_enqueued, m_coalesced, m_dropped};
+            }
+
+            /* Returns true when the event was coalesced into an already queued one */
+            template <typename Merge = ReplacePayload>
+            bool push(int kind, const std::string& coalesceKey, Priority priority, Payload&& payload, Merge merge = Merge())
+            {
+                m_enqueued++;
+                if (!coalesceKey.empty())
+                {
+                    auto found = m_index.find(std::make_pair(kind, coalesceKey));
+                    if (found != m_index.end())
+                    {
+                        auto entry = found->second;
+                        m_coalesced++;
+                        if (!merge(entry->payload, std::move(payload)))
+                        {
+                            /* the pair cancelled out; neither is delivered */
+                            eraseEntry(found);
+                        }
+                        return true;
+                    }
+                }
+
+                if (size() >= m_limit)
+                {
+                    /* never push out a state change to make room for a bulk payload */
+                    if (priority == PRIORITY_BULK && m_lanes[PRIORITY_BULK].empty())
+                    {
+                        m_dropped++;
+                        return false;
+                    }
+                    dropOldest();
+                }
+
+                Lane& lane = m_lanes[priority];
+                lane.push_back(Entry{kind, priority, coalesceKey, std::move(payload)});
+                if (!coalesceKey.empty())
+                {
+                    auto last = lane.end();
+                    m_index.emplace(std::make_pair(kind, coalesceKey), --last);
+                }
+                if (size() > m_highWaterMark)
+                    m_highWaterMark = size();
+                return false;
+            }
+
+            bool pop(int& kind, Payload& payload)
+            {
+                for (Lane& lane : m_lanes)
+                {
+                    if (lane.empty())
+                        continue;
+
+                    Entry& entry = lane.front();
+                    if (!entry.key.empty())
+                        m_index.erase(std::make_pair(entry.kind, entry.key));
+                    kind = entry.kind;
+                    payload = std::move(entry.payload);
+                    lane.pop_front();
+                    return true;
+                }
+                return false;
+            }
+
+            void clear()
+            {
+                m_index.clear();
+                for (Lane& lane : m_lanes)
+                    lane.clear();
+            }
+
+        private:
+            void eraseEntry(typename Index::iterator found)
+            {
+                auto entry = found->second;
+                m_index.erase(found);
+                m_lanes[entry->priority].erase(entry);
+            }
+
+            void dropOldest()
+            {
+                Lane& lane = m_lanes[PRIORITY_BULK].empty() ? m_lanes[PRIORITY_HIGH] : m_lanes[PRIORITY_BULK];
+                Entry& entry = lane.front();
+                if (!entry.key.empty())
+                    m_index.erase(std::make_pair(entry.kind, entry.key));
+                lane.pop_front();
+                m_dropped++;
+            }
+
+        private:
+            Lane m_lanes[2];
+            Index m_index;
+            size_t m_limit;
+            size_t m_highWaterMark{0};
+            uint64_t m_enqueued{0};
+            uint64_t m_coalesced{0};
+            uint64_t m_dropped{0};
+        };
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,119 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "NetworkManagerGlibReactor.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        static gboolean runTask(gpointer data)
+        {
+            (*static_cast<std::function<void()>*>(data))();
+            return G_SOURCE_REMOVE;
+        }
+
+        static void deleteTask(gpointer data)
+        {
+            delete static_cast<std::function<void()>*>(data);
+        }
+
+        GlibReactor::~GlibReactor()
+        {
+            stop();
+        }
+
+        bool GlibReactor::start()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return startLocked();
+        }
+
+        bool GlibReactor::startLocked()
+        {
+            if (m_thread.joinable())
+                return true;
+
+            m_loop = g_main_loop_new(context(), FALSE);
+            if (m_loop == nullptr)
+            {
+                NMLOG_ERROR("failed to create the glib reactor loop");
+                return false;
+            }
+            m_thread = std::thread(&GlibReactor::reactorThread, this);
+            NMLOG_INFO("glib reactor started");
+            return true;
+        }
+
+        void GlibReactor::stop()
+        {
+            if (isCurrent())
+            {
+                NMLOG_ERROR("glib reactor cannot be stopped from its own thread");
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_thread.joinable())
+                return;
+
+            g_main_loop_quit(m_loop);
+            m_thread.join();
+            g_main_loop_unref(m_loop);
+            m_loop = nullptr;
+            NMLOG_INFO("glib reactor stopped");
+        }
+
+        bool GlibReactor::post(std::function<void()> task)
+        {
+            /*
+             * Always a source, never g_main_context_invoke(): that would run the task on the
+             * calling thread whenever it manages to acquire the default context first.
+             */
+            auto attach = [this](std::function<void()>&& work) {
+                GSource* source = g_idle_source_new();
+                g_source_set_priority(source, G_PRIORITY_DEFAULT);
+                g_source_set_callback(source, runTask, new std::function<void()>(std::move(work)), deleteTask);
+                g_source_attach(source, context());
+                g_source_unref(source);
+            };
+
+            if (isCurrent())
+            {
+                /* a follow up from a task; stop() drains the context before it returns */
+                attach(std::move(task));
+                return true;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!startLocked())
+                return false;
+            attach(std::move(task));
+            return true;
+        }
+
+        void GlibReactor::reactorThread(GlibReactor* self)
+        {
+            /* nothing is pushed: sources and D-Bus replies fall back to the default context when no thread default is set */
+            g_main_loop_run(self->m_loop);
+            while (g_main_context_iteration(self->context(), FALSE));
+        }
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,107 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+#include <glib.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * One thread serving the process default GMainContext for the whole plugin.
+         * The event monitor, the secret agent, the wifi operations and the gdbus async
+         * client attach their D-Bus signals, replies and timers to that context, so no
+         * component runs a loop of its own. Other threads hand work over with post(),
+         * submit() or run() instead of pushing a context themselves.
+         */
+        class GlibReactor
+        {
+            public:
+                static GlibReactor* getInstance()
+                {
+                    static GlibReactor instance;
+                    return &instance;
+                }
+
+                GlibReactor(const GlibReactor&) = delete;
+                GlibReactor& operator=(const GlibReactor&) = delete;
+
+                /* started lazily by the first task; stop() drains the tasks already posted */
+                bool start();
+                void stop();
+
+                GMainContext* context() const { return g_main_context_default(); }
+                /* true on the reactor thread, also inside a nested loop of a task */
+                bool isCurrent() const { return g_main_context_is_owner(context()); }
+
+                /* queues task behind the pending sources; false if the reactor could not start */
+                bool post(std::function<void()> task);
+
+                /*
+                 * Runs task on the reactor and hands back its result. Runs inline when already
+                 * on the reactor thread, or when the reactor could not start.
+                 */
+                template <typename R>
+                std::future<R> submit(std::function<R()> task)
+                {
+                    std::shared_ptr<std::promise<R>> promise = std::make_shared<std::promise<R>>();
+                    std::future<R> result = promise->get_future();
+                    if (isCurrent() || !post([promise, task]() { settle(*promise, task); }))
+                        settle(*promise, task);
+                    return result;
+                }
+
+                /* submit() and wait; tasks bound their own waits, this one has no deadline */
+                template <typename R>
+                R run(std::function<R()> task)
+                {
+                    return submit<R>(std::move(task)).get();
+                }
+
+            private:
+                GlibReactor() = default;
+                ~GlibReactor();
+
+                template <typename R>
+                static void settle(std::promise<R>& promise, const std::function<R()>& task)
+                {
+                    promise.set_value(task());
+                }
+
+                static void settle(std::promise<void>& promise, const std::function<void()>& task)
+                {
+                    task();
+                    promise.set_value();
+                }
+
+                bool startLocked();     /* caller holds m_lock */
+                static void reactorThread(GlibReactor* self);
+
+                GMainLoop* m_loop = nullptr;
+                std::thread m_thread;
+                std::mutex m_lock;      /* start, stop and posting from other threads */
+        };
+    } // Plugin
+} // WPEFramework
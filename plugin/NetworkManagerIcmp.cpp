@@ -0,0 +1,656 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/ip.h>
+#include <netinet/ip_icmp.h>
+#include <netinet/icmp6.h>
+#include <linux/errqueue.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "NetworkManagerIcmp.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+
+    using Clock = std::chrono::steady_clock;
+
+    namespace {
+
+        struct Probe {
+            IcmpEchoResult* result;
+            int fd{-1};
+            bool raw{false};
+            sockaddr_storage address{};
+            socklen_t addressLength{0};
+            uint16_t ident{0};
+            uint32_t count{0};
+            std::chrono::milliseconds interval{0};
+            std::chrono::milliseconds timeout{0};
+            uint32_t sent{0};
+            std::vector<Clock::time_point> sendTimes;
+            Clock::time_point nextSend;
+            bool done{false};
+        };
+
+        std::atomic<uint16_t> s_ident{0};
+
+        bool sameAddress(const sockaddr_storage& a, const sockaddr_storage& b)
+        {
+            if (a.ss_family != b.ss_family)
+                return false;
+            if (a.ss_family == AF_INET)
+                return reinterpret_cast<const sockaddr_in&>(a).sin_addr.s_addr == reinterpret_cast<const sockaddr_in&>(b).sin_addr.s_addr;
+            return memcmp(&reinterpret_cast<const sockaddr_in6&>(a).sin6_addr, &reinterpret_cast<const sockaddr_in6&>(b).sin6_addr, sizeof(in6_addr)) == 0;
+        }
+
+        void sendRequest(Probe& probe, Clock::time_point now)
+        {
+            uint8_t packet[8 + NM_ICMP_PAYLOAD_SIZE];
+            const uint16_t seq = static_cast<uint16_t>(probe.sent);
+
+            packet[0] = (probe.address.ss_family == AF_INET) ? ICMP_ECHO : ICMP6_ECHO_REQUEST;
+            packet[1] = 0;
+            packet[2] = packet[3] = 0;
+            packet[4] = probe.ident >> 8;
+            packet[5] = probe.ident & 0xFF;
+            packet[6] = seq >> 8;
+            packet[7] = seq & 0xFF;
+            for (size_t i = 0; i < NM_ICMP_PAYLOAD_SIZE; i++)
+                packet[8 + i] = static_cast<uint8_t>(i);
+
+            /* the kernel fills the ICMPv6 checksum, and the IPv4 one too on ping sockets */
+            if (probe.address.ss_family == AF_INET)
+            {
+                uint16_t sum = IcmpEchoEngine::checksum(packet, sizeof(packet));
+                memcpy(&packet[2], &sum, sizeof(sum));
+            }
+
+            probe.sendTimes.push_back(now);
+            probe.result->rtt.push_back(-1.0);
+            probe.sent++;
+            probe.result->transmitted++;
+
+            if (sendto(probe.fd, packet, sizeof(packet), 0, reinterpret_cast<const sockaddr*>(&probe.address), probe.addressLength) < 0)
+                NMLOG_DEBUG("echo request %u to %s failed: %s", seq, probe.result->address.c_str(), strerror(errno));
+        }
+
+        void receiveReplies(Probe& probe)
+        {
+            uint8_t packet[1500];
+            for (;;)
+            {
+                sockaddr_storage from{};
+                socklen_t fromLength = sizeof(from);
+                ssize_t length = recvfrom(probe.fd, packet, sizeof(packet), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&from), &fromLength);
+                if (length < 0)
+                    break;
+
+                const Clock::time_point now = Clock::now();
+                const uint8_t* icmp = packet;
+                size_t icmpLength = static_cast<size_t>(length);
+                uint8_t replyType = ICMP6_ECHO_REPLY;
+
+                if (probe.address.ss_family == AF_INET)
+                {
+                    replyType = ICMP_ECHOREPLY;
+                    /* raw IPv4 sockets hand over the IP header as well */
+                    if (probe.raw)
+                    {
+                        if (icmpLength < sizeof(struct ip))
+                            continue;
+                        size_t headerLength = (packet[0] & 0x0F) * 4;
+                        if (headerLength < sizeof(struct ip) || icmpLength < headerLength)
+                            continue;
+                        icmp += headerLength;
+                        icmpLength -= headerLength;
+                    }
+                }
+
+                if (icmpLength < 8 || icmp[0] != replyType || !sameAddress(from, probe.address))
+                    continue;
+
+                /* a ping socket rewrites the identifier and only delivers its own replies */
+                const uint16_t ident = static_cast<uint16_t>((icmp[4] << 8) | icmp[5]);
+                if (probe.raw && ident != probe.ident)
+                    continue;
+
+                const uint16_t seq = static_cast<uint16_t>((icmp[6] << 8) | icmp[7]);
+                if (seq >= probe.sent)
+                    continue;
+
+                double& rtt = probe.result->rtt[seq];
+                if (rtt >= 0)
+                {
+                    probe.result->duplicates++;
+                    continue;
+                }
+                rtt = std::chrono::duration<double, std::milli>(now - probe.sendTimes[seq]).count();
+                probe.result->received++;
+            }
+        }
+    }
+
+    void IcmpEchoResult::summarize()
+    {
+        double sum = 0, squares = 0, deltas = 0, previous = -1;
+        uint32_t samples = 0, pairs = 0;
+
+        tripMin = tripMax = tripAvg = tripStdDev = jitter = 0;
+        for (double value : rtt)
+        {
+            if (value < 0)
+                continue;
+            if (samples == 0 || value < tripMin)
+                tripMin = value;
+            if (value > tripMax)
+                tripMax = value;
+            sum += value;
+            squares += value * value;
+            if (previous >= 0)
+            {
+                deltas += std::fabs(value - previous);
+                pairs++;
+            }
+            previous = value;
+            samples++;
+        }
+
+        if (samples)
+        {
+            tripAvg = sum / samples;
+            /* same mdev that ping reports */
+            tripStdDev = std::sqrt(std::max(0.0, squares / samples - tripAvg * tripAvg));
+        }
+        if (pairs)
+            jitter = deltas / pairs;
+    }
+
+    uint16_t IcmpEchoEngine::checksum(const uint8_t* data, size_t length)
+    {
+        uint32_t sum = 0;
+        for (size_t i = 0; i + 1 < length; i += 2)
+        {
+            uint16_t word;
+            memcpy(&word, data + i, sizeof(word));
+            sum += word;
+        }
+        if (length & 1)
+        {
+            uint16_t word = 0;
+            memcpy(&word, data + length - 1, 1);
+            sum += word;
+        }
+        while (sum >> 16)
+            sum = (sum & 0xFFFF) + (sum >> 16);
+        return static_cast<uint16_t>(~sum);
+    }
+
+    int IcmpEchoEngine::openSocket(int family, bool& raw)
+    {
+        const int protocol = (family == AF_INET) ? static_cast<int>(IPPROTO_ICMP) : static_cast<int>(IPPROTO_ICMPV6);
+        raw = false;
+        int fd = socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+        if (fd < 0)
+        {
+            fd = socket(family, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+            if (fd < 0)
+                return -1;
+            raw = true;
+            if (family == AF_INET6)
+            {
+                struct icmp6_filter filter;
+                ICMP6_FILTER_SETBLOCKALL(&filter);
+                ICMP6_FILTER_SETPASS(ICMP6_ECHO_REPLY, &filter);
+                setsockopt(fd, IPPROTO_ICMPV6, ICMP6_FILTER, &filter, sizeof(filter));
+            }
+        }
+        return fd;
+    }
+
+    bool IcmpEchoEngine::available(int family)
+    {
+        bool raw = false;
+        int fd = openSocket(family, raw);
+        if (fd < 0)
+            return false;
+        close(fd);
+        return true;
+    }
+
+    bool IcmpEchoEngine::resolve(const std::string& endpoint, int family, sockaddr_storage& address, std::string& text)
+    {
+        struct addrinfo hints{};
+        struct addrinfo* list = nullptr;
+        hints.ai_family = family;
+        hints.ai_socktype = SOCK_DGRAM;
+
+        if (endpoint.empty() || getaddrinfo(endpoint.c_str(), nullptr, &hints, &list) != 0 || list == nullptr)
+            return false;
+
+        memcpy(&address, list->ai_addr, list->ai_addrlen);
+        freeaddrinfo(list);
+
+        char buffer[INET6_ADDRSTRLEN] = "";
+        if (family == AF_INET)
+            inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in&>(address).sin_addr, buffer, sizeof(buffer));
+        else
+            inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6&>(address).sin6_addr, buffer, sizeof(buffer));
+        text = buffer;
+        return true;
+    }
+
+    bool IcmpEchoEngine::run(const std::vector<IcmpEchoTarget>& targets, std::vector<IcmpEchoResult>& results)
+    {
+        std::vector<Probe> probes;
+        bool socketFailed = false;
+        bool socketOpened = false;
+
+        results.clear();
+        results.resize(targets.size());
+        probes.reserve(targets.size());
+
+        int epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0)
+        {
+            NMLOG_ERROR("epoll_create1 failed: %s", strerror(errno));
+            return false;
+        }
+
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < targets.size(); i++)
+        {
+            const IcmpEchoTarget& target = targets[i];
+            IcmpEchoResult& result = results[i];
+            result.endpoint = target.endpoint;
+
+            Probe probe;
+            probe.result = &result;
+            if (!resolve(target.endpoint, target.family, probe.address, result.address))
+            {
+                NMLOG_WARNING("cannot resolve '%s'", target.endpoint.c_str());
+                result.error = "Bad Address";
+                continue;
+            }
+            result.resolved = true;
+
+            probe.fd = openSocket(target.family, probe.raw);
+            if (probe.fd < 0)
+            {
+                NMLOG_WARNING("cannot open an ICMP socket: %s", strerror(errno));
+                result.error = "Could not open ICMP socket";
+                socketFailed = true;
+                continue;
+            }
+            socketOpened = true;
+
+            probe.addressLength = (target.family == AF_INET) ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+            probe.ident = static_cast<uint16_t>(getpid() + s_ident.fetch_add(1));
+            probe.count = std::min<uint32_t>(target.count ? target.count : 1, NM_ICMP_MAX_REQUESTS);
+            probe.interval = std::chrono::milliseconds(target.intervalMs);
+            probe.timeout = std::chrono::milliseconds(target.timeoutMs);
+            probe.nextSend = start;
+            probe.sendTimes.reserve(probe.count);
+            result.rtt.reserve(probe.count);
+            probes.push_back(std::move(probe));
+        }
+
+        /* probes does not grow from here on, so the pointers handed to epoll stay valid */
+        for (Probe& probe : probes)
+        {
+            struct epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = &probe;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, probe.fd, &event);
+        }
+
+        size_t pending = probes.size();
+        while (pending)
+        {
+            Clock::time_point now = Clock::now();
+            Clock::time_point wakeup = Clock::time_point::max();
+
+            for (Probe& probe : probes)
+            {
+                if (probe.done)
+                    continue;
+
+                if (probe.sent < probe.count && now >= probe.nextSend)
+                {
+                    sendRequest(probe, now);
+                    probe.nextSend += probe.interval;
+                }
+
+                if (probe.sent < probe.count)
+                {
+                    wakeup = std::min(wakeup, probe.nextSend);
+                    continue;
+                }
+
+                const Clock::time_point deadline = probe.sendTimes.back() + probe.timeout;
+                if (probe.result->received == probe.count || now >= deadline)
+                {
+                    probe.done = true;
+                    pending--;
+                    continue;
+                }
+                wakeup = std::min(wakeup, deadline);
+            }
+
+            if (!pending)
+                break;
+
+            /* round up, or the loop spins through the last partial millisecond */
+            int waitMs = 0;
+            if (wakeup > now)
+                waitMs = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wakeup - now).count());
+
+            struct epoll_event events[16];
+            int ready = epoll_wait(epollFd, events, 16, waitMs);
+            for (int i = 0; i < ready; i++)
+                receiveReplies(*static_cast<Probe*>(events[i].data.ptr));
+        }
+
+        for (Probe& probe : probes)
+        {
+            close(probe.fd);
+            probe.result->summarize();
+        }
+        close(epollFd);
+
+        return socketOpened || !socketFailed;
+    }
+
+    void TraceResult::toLines(uint32_t maxHops, std::vector<std::string>& lines) const
+    {
+        char line[256];
+        const bool ipv4 = (address.find(':') == std::string::npos);
+
+        snprintf(line, sizeof(line), "traceroute to %s (%s), %u hops max, %u byte packets",
+                 endpoint.c_str(), address.c_str(), maxHops, ipv4 ? 52u : 64u);
+        lines.push_back(line);
+
+        for (const TraceHop& hop : hops)
+        {
+            std::string text = std::to_string(hop.ttl) + " ";
+            if (!hop.address.empty())
+                text += " " + hop.address;
+            for (double rtt : hop.rtt)
+            {
+                if (rtt < 0)
+                    text += "  *";
+                else
+                {
+                    snprintf(line, sizeof(line), "  %.3f ms", rtt);
+                    text += line;
+                    if (!hop.annotation.empty())
+                        text += " " + hop.annotation;
+                }
+            }
+            lines.push_back(text);
+        }
+    }
+
+    namespace {
+
+        /* sized so that the IPv4 probe is 52 bytes and the IPv6 one 64, as traceroute sends them */
+        constexpr size_t TracePayloadV4 = 24;
+        constexpr size_t TracePayloadV6 = 16;
+        constexpr uint8_t TraceMagic[2] = { 'N', 'M' };
+
+        const char* unreachableAnnotation(bool ipv4, uint8_t code)
+        {
+            if (ipv4)
+            {
+                switch (code)
+                {
+                    case ICMP_NET_UNREACH:      return "!N";
+                    case ICMP_HOST_UNREACH:     return "!H";
+                    case ICMP_PROT_UNREACH:     return "!P";
+                    case ICMP_PKT_FILTERED:     return "!X";
+                    default:                    return "!U";
+                }
+            }
+            switch (code)
+            {
+                case ICMP6_DST_UNREACH_NOROUTE:     return "!N";
+                case ICMP6_DST_UNREACH_ADMIN:       return "!X";
+                case ICMP6_DST_UNREACH_ADDR:        return "!H";
+                default:                            return "!U";
+            }
+        }
+    }
+
+    bool TraceRouteEngine::run(const TraceTarget& target, TraceResult& result)
+    {
+        const bool ipv4 = (target.family == AF_INET);
+        const uint32_t perHop = std::min<uint32_t>(target.probesPerHop ? target.probesPerHop : NM_TRACE_DEFAULT_PROBES, NM_TRACE_MAX_PROBES);
+        const uint32_t maxHops = std::min<uint32_t>(target.maxHops ? target.maxHops : NM_TRACE_DEFAULT_MAX_HOPS, 64);
+        const uint32_t total = perHop * maxHops;
+        sockaddr_storage destination{};
+
+        result = TraceResult();
+        result.endpoint = target.endpoint;
+
+        /* the socket comes first so that a kernel without the error queue falls back before any lookup */
+        int fd = socket(target.family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            NMLOG_ERROR("cannot open a UDP socket: %s", strerror(errno));
+            result.error = "Could not open socket";
+            return false;
+        }
+
+        const int on = 1;
+        if (setsockopt(fd, ipv4 ? IPPROTO_IP : IPPROTO_IPV6, ipv4 ? IP_RECVERR : IPV6_RECVERR, &on, sizeof(on)) < 0)
+        {
+            NMLOG_ERROR("cannot enable the error queue: %s", strerror(errno));
+            result.error = "Could not open socket";
+            close(fd);
+            return false;
+        }
+
+        if (!IcmpEchoEngine::resolve(target.endpoint, target.family, destination, result.address))
+        {
+            NMLOG_WARNING("cannot resolve '%s'", target.endpoint.c_str());
+            result.error = "Bad Address";
+            close(fd);
+            return true;
+        }
+        result.resolved = true;
+
+        std::vector<Clock::time_point> sendTimes(total);
+        std::vector<double> rtts(total, -1.0);
+        std::vector<std::string> responders(maxHops);
+        std::vector<std::string> annotations(maxHops);
+        uint32_t reachedTtl = 0;
+        uint8_t payload[TracePayloadV4] = {};
+        const size_t payloadLength = ipv4 ? TracePayloadV4 : TracePayloadV6;
+        const socklen_t destinationLength = ipv4 ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+
+        /* every TTL goes out now; only the replies are waited for */
+        for (uint32_t index = 0; index < total; index++)
+        {
+            const int ttl = static_cast<int>(index / perHop) + 1;
+            setsockopt(fd, ipv4 ? IPPROTO_IP : IPPROTO_IPV6, ipv4 ? IP_TTL : IPV6_UNICAST_HOPS, &ttl, sizeof(ttl));
+
+            const uint16_t port = static_cast<uint16_t>(NM_TRACE_BASE_PORT + index);
+            if (ipv4)
+                reinterpret_cast<sockaddr_in&>(destination).sin_port = htons(port);
+            else
+                reinterpret_cast<sockaddr_in6&>(destination).sin6_port = htons(port);
+
+            payload[0] = TraceMagic[0];
+            payload[1] = TraceMagic[1];
+            payload[2] = index >> 8;
+            payload[3] = index & 0xFF;
+
+            /*
+             * An ICMP error for an earlier probe is also latched as the socket error, and the
+             * next send returns it instead of sending. The error queue keeps the details, so
+             * just send again.
+             */
+            ssize_t sent = -1;
+            for (int attempt = 0; attempt < 4 && sent < 0; attempt++)
+            {
+                sendTimes[index] = Clock::now();
+                sent = sendto(fd, payload, payloadLength, 0, reinterpret_cast<const sockaddr*>(&destination), destinationLength);
+                if (sent < 0 && errno != ECONNREFUSED && errno != EHOSTUNREACH && errno != ENETUNREACH && errno != EPROTO)
+                    break;
+            }
+            if (sent < 0)
+                NMLOG_DEBUG("probe %u (ttl %d) failed: %s", index, ttl, strerror(errno));
+        }
+
+        const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(target.waitMs);
+        for (;;)
+        {
+            /* done once every probe up to the destination (or the last hop) has an answer */
+            const uint32_t lastTtl = reachedTtl ? reachedTtl : maxHops;
+            bool complete = true;
+            for (uint32_t index = 0; index < lastTtl * perHop && complete; index++)
+                complete = rtts[index] >= 0;
+            if (complete)
+                break;
+
+            const Clock::time_point now = Clock::now();
+            if (now >= deadline)
+                break;
+
+            struct pollfd pfd = { fd, POLLIN | POLLERR, 0 };
+            /* round up, or the loop spins through the last partial millisecond */
+            if (poll(&pfd, 1, static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count())) <= 0)
+                continue;
+
+            for (;;)
+            {
+                uint8_t data[64];
+                uint8_t control[512];
+                sockaddr_storage original{};
+                struct iovec iov = { data, sizeof(data) };
+                struct msghdr msg{};
+                msg.msg_name = &original;
+                msg.msg_namelen = sizeof(original);
+                msg.msg_iov = &iov;
+                msg.msg_iovlen = 1;
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+
+                ssize_t length = recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+                if (length < 0)
+                {
+                    /* drain datagrams a service on the probed port sends back; they are not matched to a probe */
+                    ssize_t regular = recv(fd, data, sizeof(data), MSG_DONTWAIT);
+                    if (regular < 0)
+                        break;
+                    continue;
+                }
+
+                const Clock::time_point received = Clock::now();
+                /*
+                 * The probe is told by its destination port, which msg_name returns. Only the bytes the
+                 * router quoted come back as data, and an RFC 792 router quotes 8 bytes past the IP
+                 * header: the UDP header alone. The payload index is checked only when it was quoted.
+                 */
+                uint16_t port = 0;
+                if (original.ss_family == AF_INET)
+                    port = ntohs(reinterpret_cast<const sockaddr_in&>(original).sin_port);
+                else if (original.ss_family == AF_INET6)
+                    port = ntohs(reinterpret_cast<const sockaddr_in6&>(original).sin6_port);
+                if (port < NM_TRACE_BASE_PORT)
+                    continue;
+                const uint32_t index = port - NM_TRACE_BASE_PORT;
+                if (index >= total || rtts[index] >= 0)
+                    continue;
+                if (length >= 4 && data[0] == TraceMagic[0] && data[1] == TraceMagic[1] &&
+                    ((static_cast<uint32_t>(data[2]) << 8) | data[3]) != index)
+                    continue;
+
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+                {
+                    const bool isError = ipv4 ? (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR)
+                                              : (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+                    if (!isError)
+                        continue;
+
+                    const struct sock_extended_err* error = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cmsg));
+                    if (error->ee_origin != (ipv4 ? SO_EE_ORIGIN_ICMP : SO_EE_ORIGIN_ICMP6))
+                        continue;
+
+                    const uint32_t hop = index / perHop;
+                    const bool timeExceeded = ipv4 ? (error->ee_type == ICMP_TIME_EXCEEDED) : (error->ee_type == ICMP6_TIME_EXCEEDED);
+                    const bool unreachable = ipv4 ? (error->ee_type == ICMP_DEST_UNREACH) : (error->ee_type == ICMP6_DST_UNREACH);
+                    if (!timeExceeded && !unreachable)
+                        continue;
+
+                    rtts[index] = std::chrono::duration<double, std::milli>(received - sendTimes[index]).count();
+
+                    const struct sockaddr* offender = SO_EE_OFFENDER(error);
+                    char text[INET6_ADDRSTRLEN] = "";
+                    if (offender->sa_family == AF_INET)
+                        inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(offender)->sin_addr, text, sizeof(text));
+                    else if (offender->sa_family == AF_INET6)
+                        inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(offender)->sin6_addr, text, sizeof(text));
+                    if (responders[hop].empty())
+                        responders[hop] = text;
+
+                    if (unreachable)
+                    {
+                        const bool portUnreachable = ipv4 ? (error->ee_code == ICMP_PORT_UNREACH) : (error->ee_code == ICMP6_DST_UNREACH_NOPORT);
+                        if (!portUnreachable)
+                            annotations[hop] = unreachableAnnotation(ipv4, error->ee_code);
+                        /* either the destination or a router that will not forward: the trace ends here */
+                        if (reachedTtl == 0 || hop + 1 < reachedTtl)
+                            reachedTtl = hop + 1;
+                        result.reached = result.reached || portUnreachable;
+                    }
+                }
+            }
+        }
+        close(fd);
+
+        const uint32_t lastTtl = reachedTtl ? reachedTtl : maxHops;
+        result.hops.resize(lastTtl);
+        for (uint32_t hop = 0; hop < lastTtl; hop++)
+        {
+            TraceHop& entry = result.hops[hop];
+            entry.ttl = hop + 1;
+            entry.address = responders[hop];
+            entry.annotation = annotations[hop];
+            entry.reached = (hop + 1 == reachedTtl) && result.reached;
+            entry.rtt.assign(rtts.begin() + hop * perHop, rtts.begin() + (hop + 1) * perHop);
+        }
+        return true;
+    }
+
+    } // Plugin
+} // WPEFramework
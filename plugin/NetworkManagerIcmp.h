@@ -0,0 +1,139 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define NM_ICMP_PAYLOAD_SIZE            56      // data bytes per echo request, as ping sends by default
+#define NM_ICMP_DEFAULT_INTERVAL_MS     200     // gap between two requests to the same target
+#define NM_ICMP_MAX_REQUESTS            100     // upper bound on the requests sent to one target
+
+#define NM_TRACE_BASE_PORT              33434   // destination port of the first probe, as traceroute uses
+#define NM_TRACE_DEFAULT_MAX_HOPS       6
+#define NM_TRACE_DEFAULT_WAIT_MS        3000    // how long the whole trace waits for replies
+#define NM_TRACE_DEFAULT_PROBES         3       // probes per hop when the caller asks for none
+#define NM_TRACE_MAX_PROBES             10
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        struct IcmpEchoTarget {
+            std::string endpoint;               // host name or address literal
+            int family;                         // AF_INET or AF_INET6
+            uint32_t count;                     // echo requests to send
+            uint32_t timeoutMs;                 // how long each request waits for its reply
+            uint32_t intervalMs;
+        };
+
+        struct IcmpEchoResult {
+            std::string endpoint;
+            std::string address;                // the resolved address that was pinged
+            bool resolved{false};
+            std::string error;                  // empty unless the target could not be pinged at all
+            uint32_t transmitted{0};
+            uint32_t received{0};
+            uint32_t duplicates{0};
+            std::vector<double> rtt;            // per request in ms, negative when the reply was lost
+            double tripMin{0};
+            double tripAvg{0};
+            double tripMax{0};
+            double tripStdDev{0};
+            double jitter{0};                   // mean difference between consecutive round trips
+
+            double packetLoss() const { return transmitted ? 100.0 * (transmitted - received) / transmitted : 0.0; }
+            /* Fills the trip statistics from rtt */
+            void summarize();
+        };
+
+        /*
+         * In-process ICMP/ICMPv6 echo. Every target gets its own socket and all of them
+         * are served by one epoll loop on the calling thread, so pinging several hosts
+         * costs the longest of them rather than the sum and no helper process is forked.
+         * Unprivileged SOCK_DGRAM ping sockets are used where net.ipv4.ping_group_range
+         * allows it; otherwise a SOCK_RAW socket, which needs CAP_NET_RAW.
+         */
+        class IcmpEchoEngine
+        {
+        public:
+            /* true when an ICMP socket of that family can be opened at all */
+            static bool available(int family);
+
+            /*
+             * Pings every target and fills one result per target, in the same order.
+             * Returns false only when no socket could be opened for any target; the
+             * caller may then fall back to the ping binary.
+             */
+            static bool run(const std::vector<IcmpEchoTarget>& targets, std::vector<IcmpEchoResult>& results);
+
+            /* Opens an ICMP socket of the family; sets raw when SOCK_RAW had to be used */
+            static int openSocket(int family, bool& raw);
+            static bool resolve(const std::string& endpoint, int family, sockaddr_storage& address, std::string& text);
+            static uint16_t checksum(const uint8_t* data, size_t length);
+        };
+
+        struct TraceTarget {
+            std::string endpoint;
+            int family;                         // AF_INET or AF_INET6
+            uint32_t probesPerHop;
+            uint32_t maxHops;
+            uint32_t waitMs;
+        };
+
+        struct TraceHop {
+            uint32_t ttl{0};
+            std::string address;                // first router that answered, empty if none did
+            std::vector<double> rtt;            // per probe in ms, negative when nothing came back
+            std::string annotation;             // traceroute style !H, !N, !P, !X for unreachables
+            bool reached{false};                // the answer came from the destination itself
+        };
+
+        struct TraceResult {
+            std::string endpoint;
+            std::string address;
+            bool resolved{false};
+            bool reached{false};
+            std::string error;
+            std::vector<TraceHop> hops;         // hop 1 up to the destination, or up to maxHops
+
+            /* The output traceroute would have printed, one line per entry */
+            void toLines(uint32_t maxHops, std::vector<std::string>& lines) const;
+        };
+
+        /*
+         * In-process traceroute. The probes for every TTL go out at once from one UDP
+         * socket with IP_RECVERR/IPV6_RECVERR set, so the ICMP time exceeded and port
+         * unreachable answers come back on that socket's error queue without any
+         * privilege. Each probe goes to its own destination port, which the kernel hands
+         * back with the error even when the router quoted no payload. A trace therefore
+         * takes one wait, not one per hop.
+         */
+        class TraceRouteEngine
+        {
+        public:
+            /* Returns false when no socket could be opened; result.error says why otherwise */
+            static bool run(const TraceTarget& target, TraceResult& result);
+        };
+    } // Plugin
+} // WPEFramework
@@ -22,6 +22,10 @@
 #include <algorithm>
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include "NetworkManagerImplementation.h"
 
 #if USE_TELEMETRY
@@ -66,8 +70,19 @@ namespace WPEFramework
             /* Initialize Network Manager */
             NetworkManagerLogger::Init();
             SYSLOG(::WPEFramework::Logging::Startup, (_T("NWMgrPlugin Out-Of-Process Instantiation; SHA: ") _T(EXPAND_AND_QUOTE(PLUGIN_BUILD_REFERENCE))));
+            /* Background operations started through the *Async calls */
+            m_operations.reset(new OperationScheduler([this](const OperationScheduler::Completion& completion) { ReportOperationComplete(completion); }));
+            m_operations->start();
             m_processMonThread = std::thread(&NetworkManagerImplementation::processMonitor, this, NM_PROCESS_MONITOR_INTERVAL_SEC);
             
+            /* Per subscriber delivery lanes; the lanes hold their own reference on each subscriber */
+            NotificationLanes::Hooks hooks;
+            hooks.addRef = [](Exchange::INetworkManager::INotification* notification) { notification->AddRef(); };
+            hooks.release = [](Exchange::INetworkManager::INotification* notification) { notification->Release(); };
+            hooks.slowSubscriber = [this](Exchange::INetworkManager::INotification* notification) { dropSlowSubscriber(notification); };
+            m_notificationLanes.reset(new NotificationLanes(hooks));
+            m_notificationLanes->start();
+
             /* Start dedicated event dispatch thread */
             m_eventThreadStop.store(false);
             m_eventThread = std::thread(&NetworkManagerImplementation::eventThreadFunction, this);
@@ -82,6 +97,9 @@ namespace WPEFramework
         NetworkManagerImplementation::~NetworkManagerImplementation()
         {
             NMLOG_INFO("NetworkManager Out-Of-Process Shutdown/Cleanup");
+            /* let the running backend calls return before the backend goes away */
+            m_operations->stop();
+            m_rtnetlink.stop();
             m_powerClient.reset();
             connectivityMonitor.stopConnectivityMonitor();
             _instance = nullptr;
@@ -103,6 +121,7 @@ namespace WPEFramework
                 m_eventThread.join();
                 NMLOG_INFO("Event dispatch thread stopped");
             }
+            m_notificationLanes->stop();
 
             {
                 std::unique_lock<std::mutex> lock(m_processMonMutex);
@@ -126,6 +145,7 @@ namespace WPEFramework
             if (std::find(_notificationCallbacks.begin(), _notificationCallbacks.end(), notification) == _notificationCallbacks.end()) {
                 _notificationCallbacks.push_back(notification);
                 notification->AddRef();
+                m_notificationLanes->addSubscriber(notification);
             }
 
             _notificationLock.Unlock();
@@ -144,6 +164,7 @@ namespace WPEFramework
             // Make sure we can't register the same notification callback multiple times
             auto itr = std::find(_notificationCallbacks.begin(), _notificationCallbacks.end(), notification);
             if (itr != _notificationCallbacks.end()) {
+                m_notificationLanes->removeSubscriber(notification);
                 (*itr)->Release();
                 _notificationCallbacks.erase(itr);
             }
@@ -171,6 +192,29 @@ namespace WPEFramework
             NetworkManagerLogger::SetLevel(static_cast <NetworkManagerLogger::LogLevel>(config.loglevel.Value()));
             NMLOG_DEBUG("loglevel %d", config.loglevel.Value());
 
+            {
+                std::lock_guard<std::mutex> lock(m_eventMutex);
+                m_eventQueue.setLimit(config.eventQueueLimit.Value());
+                NMLOG_DEBUG("event queue limit %zu", m_eventQueue.limit());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_scanIndexMutex);
+                m_scanIndex.setHysteresis(config.scanDeltaHysteresis.Value());
+                m_scanIndex.reset();
+                m_scanDeltaEnabled = config.scanDelta.Value();
+                NMLOG_DEBUG("scan delta %s, hysteresis %u dB", m_scanDeltaEnabled ? "enabled" : "disabled", m_scanIndex.hysteresis());
+            }
+
+            m_ipRefreshWindow = config.ipRefreshWindow.Value();
+            m_ipBatchEnabled = config.ipAddressBatch.Value();
+            m_ipBatchOnly = config.ipAddressBatchOnly.Value();
+            NMLOG_DEBUG("ip refresh window %u ms, batched address events %s", m_ipRefreshWindow.load(),
+                        m_ipBatchEnabled ? (m_ipBatchOnly ? "enabled, replacing the per-address ones" : "enabled") : "disabled");
+
+            m_operations->setLimit(config.operationLimit.Value());
+            NMLOG_DEBUG("operation limit %zu", m_operations->limit());
+
             /* STUN configuration copy */
             m_stunEndpoint = config.stun.stunEndpoint.Value();
             m_stunPort = config.stun.port.Value();
@@ -180,6 +224,20 @@ namespace WPEFramework
             NMLOG_DEBUG("stun port %d", m_stunPort);
             NMLOG_DEBUG("stun interval %d", m_stunBindTimeout);
 
+            m_stunAlternates.clear();
+            Core::JSON::ArrayType<Core::JSON::String>::Iterator stunServer(config.stun.servers.Elements());
+            while (stunServer.Next())
+            {
+                stun::server server("", 0);
+                if (stun::parse_server(stunServer.Current().Value(), m_stunPort, server))
+                {
+                    NMLOG_INFO("stun alternate %s:%u", server.hostname.c_str(), server.port);
+                    m_stunAlternates.push_back(server);
+                }
+                else
+                    NMLOG_WARNING("invalid stun server '%s' ignored", stunServer.Current().Value().c_str());
+            }
+
 
             /* Connectivity monitor endpoints configuration */
             std::vector<std::string> connectEndpts;
@@ -220,12 +278,127 @@ namespace WPEFramework
 
             /* As all the configuration is set, lets instantiate platform */
             NetworkManagerImplementation::platform_init();
+            /* Addresses, routes and links straight from the kernel, whatever the backend */
+            if (config.kernelMonitor.Value() && !m_rtnetlink.start([this](const RtnetlinkChanges& changes) { onKernelChanges(changes); }))
+                NMLOG_WARNING("rtnetlink monitor not started; IP state follows the backend events only");
             /* change gnome networkmanager or netsrvmgr logg level */
             NetworkManagerImplementation::platform_logging(static_cast <NetworkManagerLogger::LogLevel>(config.loglevel.Value()));
             m_powerClient.reset(new NetworkManagerPowerClient(*this));
             return(Core::ERROR_NONE);
         }
 
+        uint32_t NetworkManagerImplementation::scheduleOperation(OperationScheduler::Request&& request, uint32_t& operationId)
+        {
+            switch (m_operations->submit(std::move(request), operationId))
+            {
+                case OperationScheduler::ADMIT_QUEUED:
+                case OperationScheduler::ADMIT_DUPLICATE:
+                    return Core::ERROR_NONE;
+                case OperationScheduler::ADMIT_FULL:
+                    return Core::ERROR_UNAVAILABLE;
+                default:
+                    return Core::ERROR_ILLEGAL_STATE;
+            }
+        }
+
+        /*
+         * Connect, known SSID and WPS requests share the "wifi" lane and supersede each
+         * other while queued; only the latest association request is worth running.
+         * Interface state and IP settings run on the lane of their interface, which for
+         * the Wi-Fi interface is that same "wifi" lane, so nothing mutates it concurrently.
+         */
+        std::string NetworkManagerImplementation::operationLane(const string& interface) const
+        {
+            return (interface == m_ipCache.interfaceOf(IpCacheStore::SLOT_WLAN_IPV4)) ? "wifi" : interface;
+        }
+
+        uint32_t NetworkManagerImplementation::WiFiConnectAsync(const WiFiConnectTo& ssid, const uint32_t timeout, uint32_t& operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationScheduler::Request request;
+            request.kind = "WiFiConnect";
+            request.key = "WiFiConnect/" + ssid.ssid + "/" + ssid.bssid + "/" + std::to_string(std::hash<std::string>{}(ssid.passphrase + ssid.eap_identity));
+            request.lane = "wifi";
+            request.group = "association";
+            request.timeoutMs = timeout;
+            request.run = [this, ssid]() { return WiFiConnect(ssid); };
+            return scheduleOperation(std::move(request), operationId);
+        }
+
+        uint32_t NetworkManagerImplementation::ConnectToKnownSSIDAsync(const string& ssid, const uint32_t timeout, uint32_t& operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationScheduler::Request request;
+            request.kind = "ConnectToKnownSSID";
+            request.key = "ConnectToKnownSSID/" + ssid;
+            request.lane = "wifi";
+            request.group = "association";
+            request.timeoutMs = timeout;
+            request.run = [this, ssid]() { return ConnectToKnownSSID(ssid); };
+            return scheduleOperation(std::move(request), operationId);
+        }
+
+        uint32_t NetworkManagerImplementation::StartWPSAsync(const WiFiWPS& method, const string& pin, const uint32_t timeout, uint32_t& operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationScheduler::Request request;
+            request.kind = "StartWPS";
+            request.key = "StartWPS/" + std::to_string(method) + "/" + pin;
+            request.lane = "wifi";
+            request.group = "association";
+            request.timeoutMs = timeout;
+            request.run = [this, method, pin]() { return StartWPS(method, pin); };
+            return scheduleOperation(std::move(request), operationId);
+        }
+
+        uint32_t NetworkManagerImplementation::SetInterfaceStateAsync(const string& interface, const bool enabled, const uint32_t timeout, uint32_t& operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationScheduler::Request request;
+            request.kind = "SetInterfaceState";
+            request.key = "SetInterfaceState/" + interface + (enabled ? "/up" : "/down");
+            request.lane = operationLane(interface);
+            request.group = "state/" + interface;
+            request.timeoutMs = timeout;
+            request.run = [this, interface, enabled]() { return SetInterfaceState(interface, enabled); };
+            return scheduleOperation(std::move(request), operationId);
+        }
+
+        uint32_t NetworkManagerImplementation::SetIPSettingsAsync(const string& interface, const IPAddress& address, const uint32_t timeout, uint32_t& operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationScheduler::Request request;
+            request.kind = "SetIPSettings";
+            request.key = "SetIPSettings/" + interface + "/" + address.ipversion + "/" + (address.autoconfig ? "auto" : address.ipaddress + "/" + std::to_string(address.prefix) + "/" + address.gateway + "/" + address.primarydns + "/" + address.secondarydns);
+            request.lane = operationLane(interface);
+            request.group = "ip/" + interface + "/" + address.ipversion;
+            request.timeoutMs = timeout;
+            request.run = [this, interface, address]() { return SetIPSettings(interface, address); };
+            return scheduleOperation(std::move(request), operationId);
+        }
+
+        uint32_t NetworkManagerImplementation::CancelOperation(const uint32_t operationId)
+        {
+            LOG_ENTRY_FUNCTION();
+            return m_operations->cancel(operationId) ? Core::ERROR_NONE : Core::ERROR_UNKNOWN_KEY;
+        }
+
+        uint32_t NetworkManagerImplementation::GetOperationStatistics(string& statistics)
+        {
+            LOG_ENTRY_FUNCTION();
+            statistics.clear();
+            m_operations->statsToJson(statistics);
+            return Core::ERROR_NONE;
+        }
+
+        uint32_t NetworkManagerImplementation::GetConnectivityMonitorStatistics(string& statistics)
+        {
+            LOG_ENTRY_FUNCTION();
+            statistics.clear();
+            connectivityMonitor.getStatistics(statistics);
+            return Core::ERROR_NONE;
+        }
+
         /* @brief Get STUN Endpoint to be used for identifying Public IP */
         uint32_t NetworkManagerImplementation::GetStunEndpoint (string &endpoint /* @out */, uint32_t& port /* @out */, uint32_t& bindTimeout /* @out */, uint32_t& cacheTimeout /* @out */) const
         {
@@ -385,7 +558,7 @@ namespace WPEFramework
             }
 
             stun::protocol  proto (isIPv6 ? stun::protocol::af_inet6  : stun::protocol::af_inet);
-            if(stunClient.bind(m_stunEndpoint, m_stunPort, interface, proto, m_stunBindTimeout, m_stunCacheTimeout, result))
+            if(stunClient.bind(stunServers(), interface, proto, m_stunBindTimeout, m_stunCacheTimeout, result))
             {
                 if (isIPv6)
                     ipversion = "IPv6";
@@ -417,6 +590,53 @@ namespace WPEFramework
             }
         }
 
+        std::vector<stun::server> NetworkManagerImplementation::stunServers() const
+        {
+            std::vector<stun::server> servers;
+            servers.emplace_back(m_stunEndpoint, m_stunPort);
+            servers.insert(servers.end(), m_stunAlternates.begin(), m_stunAlternates.end());
+            return servers;
+        }
+
+        /* @brief Get the IPv4 and IPv6 Public IPs; the two binding requests run concurrently on separate sockets */
+        uint32_t NetworkManagerImplementation::GetDualStackPublicIP (string& interface /* @inout */, string& ipv4address /* @out */, string& ipv6address /* @out */)
+        {
+            LOG_ENTRY_FUNCTION();
+            stun::bind_result ipv4Result;
+            stun::bind_result ipv6Result;
+
+            if (!(m_ethConnected.load() || m_wlanConnected.load()))
+            {
+                NMLOG_WARNING("No interface Connected");
+                return Core::ERROR_GENERAL;
+            }
+
+            if (!stunClient.bind_dual_stack(stunServers(), interface, m_stunBindTimeout, m_stunCacheTimeout, ipv4Result, ipv6Result))
+            {
+                NMLOG_ERROR("stun dual stack bind failed for endpoint %s:%d", m_stunEndpoint.c_str(), m_stunPort);
+                return Core::ERROR_GENERAL;
+            }
+
+            if (interface.empty())
+                interface = getDefaultInterface();
+
+            ipv4address = ipv4Result.public_ip;
+            ipv6address = ipv6Result.public_ip;
+#if USE_TELEMETRY
+            if (!ipv4address.empty())
+            {
+                NMLOG_INFO("NM_PUBLIC_IPV4 = %s", ipv4address.c_str());
+                logTelemetry("NM_PUBLIC_IPV4", ipv4address);
+            }
+            if (!ipv6address.empty())
+            {
+                NMLOG_INFO("NM_PUBLIC_IPV6 = %s", ipv6address.c_str());
+                logTelemetry("NM_PUBLIC_IPV6", ipv6address);
+            }
+#endif
+            return Core::ERROR_NONE;
+        }
+
         /* @brief Set the network manager plugin log level */
         uint32_t NetworkManagerImplementation::SetLogLevel(const Logging& level /* @in */)
         {
@@ -438,32 +658,92 @@ namespace WPEFramework
             return Core::ERROR_NONE;
         }
 
+        static string formatMs(double value)
+        {
+            char text[32];
+            snprintf(text, sizeof(text), "%.3f", value);
+            return text;
+        }
+
+        /*
+         * Same fields, in the same text, as the ping output parser produces from
+         * "N packets transmitted, N received, L% packet loss" and
+         * "min/avg/max/mdev = a/b/c/d ms", plus the per request round trips.
+         */
+        static void pingResultToJson(const IcmpEchoResult& result, JsonObject& json)
+        {
+            char loss[16];
+            snprintf(loss, sizeof(loss), " %g", result.packetLoss());
+
+            json["packetsTransmitted"] = result.transmitted;
+            json["packetsReceived"] = result.received;
+            json["packetLoss"] = string(loss);
+            if (result.duplicates)
+                json["duplicates"] = result.duplicates;
+
+            if (result.received)
+            {
+                json["tripMin"] = " " + formatMs(result.tripMin);
+                json["tripAvg"] = formatMs(result.tripAvg);
+                json["tripMax"] = formatMs(result.tripMax);
+                json["tripStdDev"] = formatMs(result.tripStdDev) + " ms";
+                json["tripJitter"] = formatMs(result.jitter);
+            }
+
+            JsonArray rtt;
+            for (double value : result.rtt)
+                rtt.Add(value < 0 ? string() : formatMs(value));
+            json["rtt"] = rtt;
+
+            if (!result.error.empty())
+            {
+                json["success"] = false;
+                json["error"] = result.error;
+            }
+            else if (result.received == 0)
+            {
+                /* as the ping binary's exit status was: no reply is a failure */
+                json["success"] = false;
+                json["error"] = "Could not ping endpoint";
+            }
+            else
+                json["success"] = true;
+        }
+
         /* @brief Request for ping and get the response in as event. The GUID used in the request will be returned in the event. */
         uint32_t NetworkManagerImplementation::Ping (const string ipversion /* @in */,  const string endpoint /* @in */, const uint32_t noOfRequest /* @in */, const uint16_t timeOutInSeconds /* @in */, const string guid /* @in */, string& response /* @out */)
         {
             LOG_ENTRY_FUNCTION();
-            char cmd[100] = "";
             string tempResult = "";
             if (endpoint.empty() || (ipversion != "IPv4" && ipversion != "IPv6"))
             {
                 NMLOG_WARNING("Invalid arguments: endpoint=%s, ipversion=%s", endpoint.c_str(), ipversion.c_str());
                 return Core::ERROR_BAD_REQUEST;
             }
-            if(0 == strcasecmp("IPv6", ipversion.c_str()))
+
+            const bool ipv6 = (0 == strcasecmp("IPv6", ipversion.c_str()));
+            std::vector<IcmpEchoResult> results;
+            IcmpEchoTarget target{endpoint, ipv6 ? AF_INET6 : AF_INET, noOfRequest, std::max<uint32_t>(timeOutInSeconds, 1) * 1000u, NM_ICMP_DEFAULT_INTERVAL_MS};
+
+            JsonObject temp;
+            if (IcmpEchoEngine::run({target}, results))
             {
-                snprintf(cmd, sizeof(cmd), "ping6 -c %d -W %d -i 0.2 '%s' 2>&1", noOfRequest, timeOutInSeconds, endpoint.c_str());
+                pingResultToJson(results[0], temp);
             }
             else
             {
-                snprintf(cmd, sizeof(cmd), "ping  -c %d -W %d -i 0.2 '%s' 2>&1", noOfRequest, timeOutInSeconds, endpoint.c_str());
-            }
-
-            NMLOG_DEBUG ("The Command is %s", cmd);
-            string commandToExecute(cmd);
-            executeExternally(NETMGR_PING, commandToExecute, tempResult);
+                /* no ICMP socket is permitted to this process; let the setuid ping binary do it */
+                char cmd[100] = "";
+                if (ipv6)
+                    snprintf(cmd, sizeof(cmd), "ping6 -c %d -W %d -i 0.2 '%s' 2>&1", noOfRequest, timeOutInSeconds, endpoint.c_str());
+                else
+                    snprintf(cmd, sizeof(cmd), "ping  -c %d -W %d -i 0.2 '%s' 2>&1", noOfRequest, timeOutInSeconds, endpoint.c_str());
 
-            JsonObject temp;
-            temp.FromString(tempResult);
+                NMLOG_DEBUG ("The Command is %s", cmd);
+                string commandToExecute(cmd);
+                executeExternally(NETMGR_PING, commandToExecute, tempResult);
+                temp.FromString(tempResult);
+            }
             temp["endpoint"] = endpoint;
             temp.ToString(response);
 
@@ -474,29 +754,71 @@ namespace WPEFramework
         uint32_t NetworkManagerImplementation::Trace (const string ipversion /* @in */,  const string endpoint /* @in */, const uint32_t noOfRequest /* @in */, const string guid /* @in */, string& response /* @out */)
         {
             LOG_ENTRY_FUNCTION();
-            char cmd[256] = "";
             string tempResult = "";
             if (endpoint.empty() || (ipversion != "IPv4" && ipversion != "IPv6"))
             {
                 NMLOG_WARNING("Invalid arguments: endpoint=%s, ipversion=%s", endpoint.c_str(), ipversion.c_str());
                 return Core::ERROR_BAD_REQUEST;
             }
-            if(0 == strcasecmp("IPv6", ipversion.c_str()))
+
+            const bool ipv6 = (0 == strcasecmp("IPv6", ipversion.c_str()));
+            TraceTarget target{endpoint, ipv6 ? AF_INET6 : AF_INET, noOfRequest, NM_TRACE_DEFAULT_MAX_HOPS, NM_TRACE_DEFAULT_WAIT_MS};
+            TraceResult trace;
+
+            JsonObject temp;
+            temp["endpoint"] = endpoint;
+            const bool traced = TraceRouteEngine::run(target, trace);
+            if (traced && !trace.resolved)
             {
-                snprintf(cmd, 256, "traceroute6 -w 3 -m 6 -q %d %s 64 2>&1", noOfRequest, endpoint.c_str());
+                /* the same text traceroute prints for a name it cannot resolve */
+                JsonArray list;
+                list.Add(string(ipv6 ? "traceroute6" : "traceroute") + ": bad address '" + endpoint + "'");
+                list.ToString(tempResult);
+                temp["results"] = tempResult;
             }
-            else
+            else if (traced)
             {
-                snprintf(cmd, 256, "traceroute -w 3 -m 6 -q %d %s 52 2>&1", noOfRequest, endpoint.c_str());
-            }
+                std::vector<string> lines;
+                JsonArray list;
+                JsonArray hops;
 
-            NMLOG_DEBUG ("The Command is %s", cmd);
-            string commandToExecute(cmd);
-            executeExternally(NETMGR_TRACE, commandToExecute, tempResult);
+                trace.toLines(NM_TRACE_DEFAULT_MAX_HOPS, lines);
+                for (const string& line : lines)
+                    list.Add(line);
 
-            JsonObject temp;
-            temp["endpoint"] = endpoint;
-            temp["results"] = tempResult;
+                for (const TraceHop& hop : trace.hops)
+                {
+                    JsonObject entry;
+                    JsonArray rtt;
+                    entry["hop"] = hop.ttl;
+                    entry["address"] = hop.address;
+                    for (double value : hop.rtt)
+                        rtt.Add(value < 0 ? string() : formatMs(value));
+                    entry["rtt"] = rtt;
+                    if (!hop.annotation.empty())
+                        entry["annotation"] = hop.annotation;
+                    hops.Add(entry);
+                }
+
+                /* results keeps the traceroute text for existing clients */
+                list.ToString(tempResult);
+                temp["results"] = tempResult;
+                temp["hops"] = hops;
+                temp["reached"] = trace.reached;
+            }
+            else
+            {
+                char cmd[256] = "";
+                if (ipv6)
+                    snprintf(cmd, 256, "traceroute6 -w 3 -m 6 -q %d %s 64 2>&1", noOfRequest, endpoint.c_str());
+                else
+                    snprintf(cmd, 256, "traceroute -w 3 -m 6 -q %d %s 52 2>&1", noOfRequest, endpoint.c_str());
+
+                NMLOG_DEBUG ("The Command is %s", cmd);
+                string commandToExecute(cmd);
+                executeExternally(NETMGR_TRACE, commandToExecute, tempResult);
+                temp["results"] = tempResult;
+            }
             temp.ToString(response);
 
             return Core::ERROR_NONE;
@@ -625,59 +947,6 @@ namespace WPEFramework
             return;
         }
 
-        void NetworkManagerImplementation::filterScanResults(JsonArray &ssids,
-											                 const std::vector<std::string>& filterSsidslist,
-											                 const std::vector<std::string>& filterFrequencies)
-        {
-            LOG_ENTRY_FUNCTION();
-            JsonArray result;
-            double filterFreq = 0.0;
-            std::unordered_set<std::string> scanForSsidsSet(filterSsidslist.begin(), filterSsidslist.end());
-
-            // If neither SSID list nor frequency is provided, exit
-            if (filterSsidslist.empty() && filterFrequencies.empty())
-            {
-                NMLOG_DEBUG("Neither SSID nor Frequency is provided. Exiting function.");
-                return;
-            }
-
-            for (int i = 0; i < ssids.Length(); i++)
-            {
-                JsonObject object = ssids[i].Object();
-                string ssid = object["ssid"].String();
-                string frequency = object["frequency"].String();
-
-                double frequencyValue = std::stod(frequency);
-                bool ssidMatches = scanForSsidsSet.empty() || scanForSsidsSet.find(ssid) != scanForSsidsSet.end();
-                bool freqMatches = filterFrequencies.empty();
-                if (!freqMatches)
-                {
-                    for (const auto& selectedFrequency : filterFrequencies)
-                    {
-                        if (selectedFrequency == "ALL")
-                        {
-                            freqMatches = true;
-                            break;
-                        }
-                        else
-                        {
-                            filterFreq = std::stod(selectedFrequency);
-                            if (filterFreq == frequencyValue)
-                            {
-                                freqMatches = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (ssidMatches && freqMatches)
-                    result.Add(object);
-            }
-            ssids = result;
-            NMLOG_DEBUG("After filtering, found %d SSIDs.", ssids.Length());
-        }
-
         // WiFi Specific Methods
         /* @brief Initiate a WIFI Scan; This is Async method and returns the scan results as Event */
         uint32_t NetworkManagerImplementation::GetSupportedSecurityModes(ISecurityModeIterator*& security /* @out */) const
@@ -707,10 +976,65 @@ namespace WPEFramework
                 NMLOG_WARNING("Dropping event %d because event thread is stopping", event);
                 return;
             }
+
+            /*
+             * Bulk payloads and status snapshots are superseded by the next event of the same
+             * kind, so only the latest one is kept queued. State transitions are never merged
+             * and are delivered ahead of the bulk payloads. Scan deltas build on each other and
+             * are queued in the bulk lane without a coalesce key.
+             */
+            std::string coalesceKey{};
+            auto priority = EventDispatchQueue<EventDataVariant>::PRIORITY_HIGH;
+            switch (event)
+            {
+                case NM_ON_AVAILABLESSIDS:
+                    coalesceKey = "availablessids";
+                    priority = EventDispatchQueue<EventDataVariant>::PRIORITY_BULK;
+                    break;
+                case NM_ON_WIFISIGNALQUALITY_CHANGE:
+                    coalesceKey = "wifisignalquality";
+                    priority = EventDispatchQueue<EventDataVariant>::PRIORITY_BULK;
+                    break;
+                case NM_ON_AVAILABLESSIDS_DELTA:
+                    priority = EventDispatchQueue<EventDataVariant>::PRIORITY_BULK;
+                    break;
+                case NM_ON_INTERNETSTATUS_CHANGE:
+                    /* one entry per interface; a change on eth0 never absorbs one on wlan0 */
+                    if (auto* status = std::get_if<InternetStatusChangeData>(&data))
+                        coalesceKey = "internetstatus:" + status->interface;
+                    break;
+                default:
+                    break;
+            }
+
+            /*
+             * Keys name a single event kind, so both payloads hold the same alternative.
+             * Merged internet status keeps the previous state the subscribers have actually seen.
+             */
+            auto merge = [](EventDataVariant& queued, EventDataVariant&& incoming) -> bool {
+                if (queued.index() != incoming.index())
+                    return true;
+                auto* queuedStatus = std::get_if<InternetStatusChangeData>(&queued);
+                auto* incomingStatus = std::get_if<InternetStatusChangeData>(&incoming);
+                if (queuedStatus && incomingStatus)
+                {
+                    incomingStatus->prevState = queuedStatus->prevState;
+                    if (incomingStatus->prevState == incomingStatus->currState)
+                        return false;
+                }
+                queued = std::move(incoming);
+                return true;
+            };
+
             {
                 std::lock_guard<std::mutex> lock(m_eventMutex);
-                m_eventQueue.push({event, std::move(data)});
-                NMLOG_DEBUG("Event %d queued, queue size: %zu", event, m_eventQueue.size());
+                uint64_t dropped = m_eventQueue.stats().dropped;
+                if (m_eventQueue.push(event, coalesceKey, priority, std::move(data), merge))
+                    NMLOG_DEBUG("Event %d coalesced, queue size: %zu", event, m_eventQueue.size());
+                else
+                    NMLOG_DEBUG("Event %d queued, queue size: %zu", event, m_eventQueue.size());
+                if (m_eventQueue.stats().dropped != dropped)
+                    NMLOG_WARNING("Event queue full (limit %zu); dropped an event", m_eventQueue.limit());
             }
             m_eventCondVar.notify_one();
         }
@@ -727,16 +1051,15 @@ namespace WPEFramework
                     return !m_eventQueue.empty() || m_eventThreadStop.load(); 
                 });
                 
-                // Process all queued events
-                while (!m_eventQueue.empty() && !m_eventThreadStop.load()) {
-                    EventData eventData = std::move(m_eventQueue.front());
-                    m_eventQueue.pop();
-                    
+                // Process all queued events; state changes come out ahead of bulk payloads
+                int event = 0;
+                EventDataVariant data;
+                while (!m_eventThreadStop.load() && m_eventQueue.pop(event, data)) {
                     // Unlock while processing to avoid blocking new events
                     lock.unlock();
                     
-                    NMLOG_DEBUG("Processing event %d from queue", eventData.event);
-                    dispatchEvent(eventData.event, eventData.data);
+                    NMLOG_DEBUG("Processing event %d from queue", event);
+                    dispatchEvent(static_cast<NMPublishEvents>(event), std::move(data));
                     
                     lock.lock();
                 }
@@ -745,102 +1068,136 @@ namespace WPEFramework
             NMLOG_INFO("Event thread exiting");
         }
 
-        void NetworkManagerImplementation::dispatchEvent(NMPublishEvents event, const EventDataVariant& data)
+        void NetworkManagerImplementation::dispatchEvent(NMPublishEvents event, EventDataVariant&& data)
         {
             LOG_ENTRY_FUNCTION();
-            std::list<Exchange::INetworkManager::INotification*> callbacks;
+            using INotification = Exchange::INetworkManager::INotification;
+            std::shared_ptr<const NotificationLanes::Delivery> delivery;
             /*
-             * Avoid holding _notificationLock while notifying subscribers: callbacks can be slow and may
-             * call back into NetworkManager, risking deadlock. Take a snapshot of callbacks with an
-             * extra reference, then release each reference after the invocation.
+             * Subscribers are not called from this thread: the event is handed to the per subscriber
+             * lanes, so that one slow (out-of-process) subscriber cannot hold back the others or the
+             * events queued behind it.
              */
-            _notificationLock.Lock();
-            for (auto* tmpCB : _notificationCallbacks) {
-                tmpCB->AddRef();
-                callbacks.push_back(tmpCB);
-            }
-            _notificationLock.Unlock();
-
             switch(event)
             {
                 case NM_ON_INTERFACESTATE_CHANGE:
                 {
                     NMLOG_INFO("Publishing onInterfaceStateChange Event");
-                    const auto& eventData = std::get<InterfaceStateChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<InterfaceStateChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onInterfaceStateChange(eventData.state, eventData.interface);
-                        callback->Release();
-                    }
+                    });
                 }
                 break;
                 case NM_ON_ACTIVEINTERFACE_CHANGE:
                 {
                     NMLOG_INFO("Publishing onActiveInterfaceChange Event");
-                    const auto& eventData = std::get<ActiveInterfaceChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<ActiveInterfaceChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onActiveInterfaceChange(eventData.prevActiveInterface, eventData.currentActiveInterface);
-                        callback->Release();
-                    }
+                    });
                 }
                 break;
                 case NM_ON_IPADDRESS_CHANGE:
                 {
                     NMLOG_INFO("Publishing onIPAddressChange Event");
-                    const auto& eventData = std::get<IPAddressChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<IPAddressChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onIPAddressChange(eventData.interface, eventData.ipversion, eventData.ipaddress, eventData.status);
-                        callback->Release();
-                    }
+                    });
                 }
                 break;
                 case NM_ON_INTERNETSTATUS_CHANGE:
                 {
                     NMLOG_INFO("Publishing onInternetStatusChange Event");
-                    const auto& eventData = std::get<InternetStatusChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<InternetStatusChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onInternetStatusChange(eventData.prevState, eventData.currState, eventData.interface);
-                        callback->Release();
-                    }
+                    });
+                }
+                break;
+                case NM_ON_INTERNETSTATUS_CHANGE_BY_FAMILY:
+                {
+                    NMLOG_INFO("Publishing onInternetStatusChangeByFamily Event");
+                    auto eventData = std::get<InternetStatusChangeByFamilyData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
+                        callback->onInternetStatusChangeByFamily(eventData.prevState, eventData.currState, eventData.interface, eventData.ipversion);
+                    });
                 }
                 break;
                 case NM_ON_AVAILABLESSIDS:
                 {
                     NMLOG_INFO("Publishing onAvailableSSIDs Event");
-                    const auto& eventData = std::get<AvailableSSIDsData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<AvailableSSIDsData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onAvailableSSIDs(eventData.jsonResult);
-                        callback->Release();
-                    }
+                    });
+                }
+                break;
+                case NM_ON_IPADDRESSES_CHANGE:
+                {
+                    NMLOG_INFO("Publishing onIPAddressesChanged Event");
+                    auto eventData = std::get<IPAddressesChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
+                        callback->onIPAddressesChanged(eventData.interface, eventData.ipversion, eventData.jsonChanges);
+                    });
+                }
+                break;
+                case NM_ON_AVAILABLESSIDS_DELTA:
+                {
+                    NMLOG_INFO("Publishing onAvailableSSIDsDelta Event");
+                    auto eventData = std::get<AvailableSSIDsDeltaData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
+                        callback->onAvailableSSIDsDelta(eventData.jsonDelta);
+                    });
                 }
                 break;
                 case NM_ON_WIFISTATE_CHANGE:
                 {
                     NMLOG_INFO("Publishing onWiFiStateChange Event");
-                    const auto& eventData = std::get<WiFiStateChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<WiFiStateChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onWiFiStateChange(eventData.state);
-                        callback->Release();
-                    }
+                    });
                 }
                 break;
                 case NM_ON_WIFISIGNALQUALITY_CHANGE:
                 {
                     NMLOG_INFO("Publishing onWiFiSignalQualityChange Event");
-                    const auto& eventData = std::get<WiFiSignalQualityChangeData>(data);
-                    for (const auto callback : callbacks) {
+                    auto eventData = std::get<WiFiSignalQualityChangeData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
                         callback->onWiFiSignalQualityChange(eventData.ssid, eventData.strength, eventData.noise, eventData.snr, eventData.quality);
-                        callback->Release();
-                    }
+                    });
                 }
                 break;
-                default:
+                case NM_ON_OPERATION_COMPLETE:
                 {
-                    for (const auto callback : callbacks) {
-                        callback->Release();
-                    }
+                    NMLOG_INFO("Publishing onOperationComplete Event");
+                    auto eventData = std::get<OperationCompleteData>(std::move(data));
+                    delivery = std::make_shared<const NotificationLanes::Delivery>([eventData](INotification* callback) {
+                        callback->onOperationComplete(eventData.operationId, eventData.operation, eventData.status, eventData.result, eventData.latency);
+                    });
                 }
                 break;
+                default:
+                    NMLOG_WARNING("Unknown event %d; not published", event);
+                break;
             }
+
+            if (delivery)
+                m_notificationLanes->publish(delivery);
+        }
+
+        void NetworkManagerImplementation::dropSlowSubscriber(Exchange::INetworkManager::INotification* notification)
+        {
+            NMLOG_ERROR("Subscriber %p has more than %d undelivered events; dropping it", notification, NM_NOTIFICATION_LANE_LIMIT);
+            _notificationLock.Lock();
+            auto itr = std::find(_notificationCallbacks.begin(), _notificationCallbacks.end(), notification);
+            if (itr != _notificationCallbacks.end()) {
+                (*itr)->Release();
+                _notificationCallbacks.erase(itr);
+            }
+            _notificationLock.Unlock();
         }
 
         void NetworkManagerImplementation::ReportInterfaceStateChange(const Exchange::INetworkManager::InterfaceState state, const string interface)
@@ -857,7 +1214,7 @@ namespace WPEFramework
                     m_ethConnected.store(false);
                     setDefaultInterface("wlan0"); // If WiFi is connected, make it the default interface
                     // As default interface is changed to wlan0, switch connectivity monitor to initial check
-                    connectivityMonitor.switchToInitialCheck();
+                    connectivityMonitor.switchToInitialCheck(ProbeScheduler::WAKE_INTERFACE);
                 }
                 else if(interface == "wlan0")
                 {
@@ -874,7 +1231,7 @@ namespace WPEFramework
                     {
                         // When WiFi is disconnected while Ethernet is connected, we don't need to trigger connectivity monitor.
                         // For WiFi-only state and WiFi disconnected, we should trigger connectivity monitor.
-                        connectivityMonitor.switchToInitialCheck();
+                        connectivityMonitor.switchToInitialCheck(ProbeScheduler::WAKE_INTERFACE);
                     }
                 }
             }
@@ -892,8 +1249,9 @@ namespace WPEFramework
                     m_wlanConnected.store(true);
                     m_wlanEnabled.store(true);
                 }
-                // connectivityMonitor.switchToInitialCheck();
                 // FIXME : Availability of interface does not mean that it has internet connection, so not triggering connectivity monitor check here.
+                // Only wake the monitor; it re-checks the link before probing anything.
+                connectivityMonitor.wakeup(ProbeScheduler::WAKE_INTERFACE);
             }
 
             if(Exchange::INetworkManager::INTERFACE_ADDED == state)
@@ -927,6 +1285,9 @@ namespace WPEFramework
                 m_wlanEnabled.store(true);
             }
 
+            /* the default route moved */
+            connectivityMonitor.switchToInitialCheck(ProbeScheduler::WAKE_ROUTE);
+
             {
                 ActiveInterfaceChangeData eventData{prevActiveInterface, currentActiveinterface};
                 NMLOG_INFO("Posting onActiveInterfaceChange %s", currentActiveinterface.c_str());
@@ -938,7 +1299,7 @@ namespace WPEFramework
 #endif 
         }
 
-        void NetworkManagerImplementation::ReportIPAddressChange(const string interface, const string ipversion, const string ipaddress, const Exchange::INetworkManager::IPStatus status)
+        void NetworkManagerImplementation::ReportIPAddressChange(const string interface, const string ipversion, const string ipaddress, const Exchange::INetworkManager::IPStatus status, bool publish)
         {
             LOG_ENTRY_FUNCTION();
             if (Exchange::INetworkManager::IP_ACQUIRED == status) {
@@ -965,12 +1326,13 @@ namespace WPEFramework
 
                 if(isDefaultIface) {
                     // As default interface is connected, switch connectivity monitor to initial check any way
-                    connectivityMonitor.switchToInitialCheck();
+                    connectivityMonitor.switchToInitialCheck(ProbeScheduler::WAKE_ADDRESS);
                 }
                 else
                     NMLOG_DEBUG("No need to trigger connectivity monitor interface is %s", interface.c_str());
             }
 
+            if (publish)
             {
                 IPAddressChangeData eventData{interface, ipversion, ipaddress, status};
                 NMLOG_INFO("Posting onIPAddressChange %s: %s %s %s", (Exchange::INetworkManager::IP_ACQUIRED == status) ? "IP acquired" : "IP lost",
@@ -1006,39 +1368,40 @@ namespace WPEFramework
 #endif
         }
 
-        int32_t NetworkManagerImplementation::logSSIDs(Logging level, const JsonArray &ssids)
+        void NetworkManagerImplementation::ReportInternetStatusChangeByFamily(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface, const Exchange::INetworkManager::IPVersion ipversion)
+        {
+            LOG_ENTRY_FUNCTION();
+            InternetStatusChangeByFamilyData eventData{prevState, currState, interface, (ipversion == Exchange::INetworkManager::IP_ADDRESS_V6) ? "IPv6" : "IPv4"};
+            NMLOG_INFO("Posting onInternetStatusChangeByFamily %s %s with current state as %u", interface.c_str(), eventData.ipversion.c_str(), (unsigned)currState);
+            enqueueEvent(NM_ON_INTERNETSTATUS_CHANGE_BY_FAMILY, std::move(eventData));
+        }
+
+        int32_t NetworkManagerImplementation::logSSIDs(Logging level, const ScanResultSet &ssids)
         {
             LOG_ENTRY_FUNCTION();
             Logging inLevel;
             GetLogLevel(inLevel);
             if (level > inLevel)
-                return ssids.Length();
+                return ssids.size();
 
+            string json;
             printf ("{\n"); fflush(stdout);
-            for (int i = 0; i < ssids.Length(); i++)
+            for (size_t i = 0; i < ssids.size(); i++)
             {
-                JsonObject ssid = ssids[i].Object();
-                string json;
-                ssid.ToString(json);
+                json.clear();
+                ssids.entryToJson(i, json);
                 printf("\t%s\n", json.c_str()); fflush(stdout);
             }
             printf("}\n"); fflush(stdout);
-            return ssids.Length();
+            return ssids.size();
         }
 
-        void NetworkManagerImplementation::ReportAvailableSSIDs(const JsonArray &arrayofWiFiScanResults)
+        void NetworkManagerImplementation::ReportAvailableSSIDs(ScanResultSet &scanResults)
         {
             LOG_ENTRY_FUNCTION();
-            string jsonOfWiFiScanResults;
-            string jsonOfFilterScanResults;
-            JsonArray filterResult = arrayofWiFiScanResults;
-
-            arrayofWiFiScanResults.ToString(jsonOfWiFiScanResults);
-            NMLOG_DEBUG("Discovered %d SSIDs before filtering as,", filterResult.Length());
-            logSSIDs(LOG_LEVEL_DEBUG, filterResult);
+            NMLOG_DEBUG("Discovered %d SSIDs before filtering as,", static_cast<int>(scanResults.size()));
+            logSSIDs(LOG_LEVEL_DEBUG, scanResults);
 
-			// Snapshot filter vectors under lock, then release before calling filterScanResults
-            // to ensure exception-safety (std::stod can throw).
             std::vector<std::string> ssidsSnapshot;
             std::vector<std::string> frequenciesSnapshot;
             m_filterVectorsLock.Lock();
@@ -1046,17 +1409,32 @@ namespace WPEFramework
             frequenciesSnapshot = m_filterFrequencies;
             m_filterVectorsLock.Unlock();
 
-            // Call filterScanResults outside the lock with snapshots (exception-safe)
-            filterScanResults(filterResult, ssidsSnapshot, frequenciesSnapshot);
-            filterResult.ToString(jsonOfFilterScanResults);
-
-            NMLOG_INFO("Posting onAvailableSSIDs event with %d SSIDs as,", filterResult.Length());
-            logSSIDs(LOG_LEVEL_INFO, filterResult);
+            size_t count = scanResults.filter(ssidsSnapshot, frequenciesSnapshot);
+            NMLOG_INFO("Posting onAvailableSSIDs event with %d SSIDs as,", static_cast<int>(count));
+            logSSIDs(LOG_LEVEL_INFO, scanResults);
 
             {
-                AvailableSSIDsData eventData{jsonOfFilterScanResults};
+                AvailableSSIDsData eventData;
+                scanResults.toJson(eventData.jsonResult);
                 enqueueEvent(NM_ON_AVAILABLESSIDS, std::move(eventData));
             }
+
+            if (m_scanDeltaEnabled.load())
+            {
+                AvailableSSIDsDeltaData deltaData;
+                bool changed = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_scanIndexMutex);
+                    changed = m_scanIndex.update(scanResults, deltaData.jsonDelta);
+                }
+                if (changed)
+                {
+                    NMLOG_DEBUG("Posting onAvailableSSIDsDelta event, %zu bytes", deltaData.jsonDelta.size());
+                    enqueueEvent(NM_ON_AVAILABLESSIDS_DELTA, std::move(deltaData));
+                }
+                else
+                    NMLOG_DEBUG("No change since the previous scan; onAvailableSSIDsDelta not posted");
+            }
         }
 
         void NetworkManagerImplementation::startWiFiSignalQualityMonitor(int interval)
@@ -1084,6 +1462,12 @@ namespace WPEFramework
             {
                 std::lock_guard<std::mutex> lock(m_condVariableMutex);
                 m_stopThread.store(true);
+                /* wake up the event driven monitor blocked in poll() */
+                if (m_monitorWakeFd >= 0) {
+                    uint64_t wake = 1;
+                    if (write(m_monitorWakeFd, &wake, sizeof(wake)) < 0)
+                        NMLOG_WARNING("failed to wake WiFiSignalQualityMonitor: %s", strerror(errno));
+                }
             }
             m_condVariable.notify_one();
 
@@ -1093,97 +1477,84 @@ namespace WPEFramework
             m_isRunning.store(false);
         }
 
-        /* The below implementation of GetWiFiSignalQuality is a temporary mitigation. Need to be revisited */
-        uint32_t NetworkManagerImplementation::GetWiFiSignalQuality(string& ssid /* @out */, int& strength /* @out */, int& noise /* @out */, int& snr /* @out */, WiFiSignalQuality& quality /* @out */)
+        /* Fallback used when the wpa_supplicant control socket is not reachable; parses the same key=value output */
+        bool NetworkManagerImplementation::readSignalInfoFromCli(WpaSignalInfo& info)
         {
-            std::string key{}, value{}, bssid{}, band{};
             char buff[512] = {'\0'};
             FILE *fp = NULL;
 
+            info.clear();
+
             /* Get BSSID and SSID from wpa_cli status */
             fp = popen(SSID_COMMAND, "r");
             if (!fp)
             {
                 NMLOG_ERROR("Failed in getting output from command %s", SSID_COMMAND);
-                return Core::ERROR_GENERAL;
+                return false;
             }
 
             while ((!feof(fp)) && (fgets(buff, sizeof (buff), fp) != NULL))
             {
-                std::istringstream mystream(buff);
-                if(std::getline(std::getline(mystream, key, '=') >> std::ws, value))
-                {
-                    if (key == "ssid") {
-                        ssid = value;
-                    }
-                    else if (key == "bssid") {
-                        bssid = value;
-                    }
-                    if (!ssid.empty() && !bssid.empty())
-                        break;
-                }
+                WpaCtrlClient::parseStatus(buff, strlen(buff), info);
+                if (info.ssid[0] != '\0' && info.bssid[0] != '\0')
+                    break;
             }
             pclose(fp);
 
             /* If BSSID is empty, WiFi is disconnected */
-            if (bssid.empty()) {
-                NMLOG_WARNING("WiFi is disconnected (BSSID is empty)");
-                quality = WiFiSignalQuality::WIFI_SIGNAL_DISCONNECTED;
-                ssid = "";
-                strength = 0;
-                noise = 0;
-                snr = 0;
-                return Core::ERROR_NONE;
-            }
+            if (info.bssid[0] == '\0')
+                return true;
 
             /*Get real-time signal data from wpa_cli signal_poll */
             fp = popen(SIGNAL_POLL_COMMAND, "r");
             if (!fp)
             {
                 NMLOG_ERROR("Failed in getting output from command %s", SIGNAL_POLL_COMMAND);
-                return Core::ERROR_GENERAL;
+                return false;
             }
 
-            // Collect raw values during parsing
-            std::string linkSpeed, rssiValue, noiseValue, avgRssiValue, freqValue;
             while ((!feof(fp)) && (fgets(buff, sizeof (buff), fp) != NULL))
             {
-                std::istringstream mystream(buff);
-                if(std::getline(std::getline(mystream, key, '=') >> std::ws, value))
-                {
-                    if (key == "RSSI") {
-                        rssiValue = value;
-                    }
-                    else if (key == "NOISE") {
-                        noiseValue = value;
-                    }
-                    else if (key == "AVG_RSSI") {
-                        avgRssiValue = value;
-                    }
-                    else if (key == "FREQUENCY")
-                    {
-                        freqValue = value;
-                    }
-		    else if (key == "LINKSPEED")
-                    {
-                        linkSpeed = value;
-                    }
-                }
+                WpaCtrlClient::parseSignalPoll(buff, strlen(buff), info);
             }
             pclose(fp);
 
-            // Helper to safely convert string to int
-            auto toInt = [](const std::string& str, int defaultVal = 0) -> int {
-                return str.empty() ? defaultVal : std::stoi(str);
-            };
+            return true;
+        }
+
+        uint32_t NetworkManagerImplementation::GetWiFiSignalQuality(string& ssid /* @out */, int& strength /* @out */, int& noise /* @out */, int& snr /* @out */, WiFiSignalQuality& quality /* @out */)
+        {
+            std::string band{};
+            WpaSignalInfo info;
 
-            // Perform conversions - use RSSI if available, otherwise fallback to AVG_RSSI
-            strength = toInt(!rssiValue.empty() ? rssiValue : avgRssiValue, 0);
-            noise = toInt(noiseValue, 0);
+            /* Query wpa_supplicant directly over its control socket; spawn wpa_cli only when that is not possible */
+            if (!m_wpaCtrl.getSignalInfo(info))
+            {
+                NMLOG_DEBUG("wpa_supplicant control socket %s not usable; using wpa_cli", m_wpaCtrl.ctrlPath().c_str());
+                if (!readSignalInfoFromCli(info))
+                    return Core::ERROR_GENERAL;
+            }
+
+            /* If BSSID is empty, WiFi is disconnected */
+            if (info.bssid[0] == '\0') {
+                NMLOG_WARNING("WiFi is disconnected (BSSID is empty)");
+                quality = WiFiSignalQuality::WIFI_SIGNAL_DISCONNECTED;
+                ssid = "";
+                strength = 0;
+                noise = 0;
+                snr = 0;
+                return Core::ERROR_NONE;
+            }
+
+            ssid = info.ssid;
+
+            // Use RSSI if available, otherwise fallback to AVG_RSSI
+            strength = info.hasRssi ? info.rssi : (info.hasAvgRssi ? info.avgRssi : 0);
+            noise = info.hasNoise ? info.noise : 0;
 
             // Determine band from frequency
-            if (!freqValue.empty()) {
-                int freq = std::stoi(freqValue);
+            if (info.hasFrequency) {
+                int freq = info.frequency;
                 band = (freq >= 2400 && freq < 5000) ? "2.4GHz" :
                        (freq >= 5000 && freq < 6000) ? "5GHz" :
                        (freq >= 6000) ? "6GHz" : "not known";
@@ -1232,8 +1603,8 @@ namespace WPEFramework
                 snr = calculatedSnr;
             }
 
-            NMLOG_INFO("SSID:%s, BSSID:%s, Band:%s, RSSI:%d, Noise:%d, SNR:%d", ssid.c_str(), bssid.c_str(), band.c_str(), strength, noise, snr);
-            NMLOG_INFO("bssid=%s,ssid=%s,rssi=%d,phyrate=%s,noise=%d,Band=%s", bssid.c_str(), ssid.c_str(), strength, linkSpeed.c_str(), noise, band.c_str());
+            NMLOG_INFO("SSID:%s, BSSID:%s, Band:%s, RSSI:%d, Noise:%d, SNR:%d", ssid.c_str(), info.bssid, band.c_str(), strength, noise, snr);
+            NMLOG_INFO("bssid=%s,ssid=%s,rssi=%d,phyrate=%d,noise=%d,Band=%s", info.bssid, ssid.c_str(), strength, info.linkSpeed, noise, band.c_str());
 
             if (calculatedSnr == 0)
             {
@@ -1301,6 +1672,32 @@ namespace WPEFramework
                     NMLOG_INFO("VSS = %d KB   RSS = %d KB", processSize, processRSS);
                 }
 
+                {
+                    std::lock_guard<std::mutex> eventLock(m_eventMutex);
+                    auto stats = m_eventQueue.stats();
+                    NMLOG_INFO("Event queue depth = %zu (max %zu)   enqueued = %llu   coalesced = %llu   dropped = %llu",
+                               stats.depth, stats.highWaterMark, static_cast<unsigned long long>(stats.enqueued),
+                               static_cast<unsigned long long>(stats.coalesced), static_cast<unsigned long long>(stats.dropped));
+                }
+
+                for (const auto& kind : m_operations->stats())
+                {
+                    NMLOG_INFO("Operation %s completed = %llu   timedout = %llu   cancelled = %llu   superseded = %llu   max = %u ms",
+                               kind.kind.c_str(), static_cast<unsigned long long>(kind.outcomes[OperationScheduler::OUTCOME_COMPLETED]),
+                               static_cast<unsigned long long>(kind.outcomes[OperationScheduler::OUTCOME_TIMEDOUT]),
+                               static_cast<unsigned long long>(kind.outcomes[OperationScheduler::OUTCOME_CANCELLED]),
+                               static_cast<unsigned long long>(kind.outcomes[OperationScheduler::OUTCOME_SUPERSEDED]), kind.maxLatencyMs);
+                }
+
+                for (const auto& lane : m_notificationLanes->stats())
+                {
+                    NMLOG_INFO("Subscriber %p depth = %zu   delivered = %llu   callback last/avg/max = %llu/%llu/%llu us   max wait = %llu us",
+                               lane.subscriber, lane.depth, static_cast<unsigned long long>(lane.delivered),
+                               static_cast<unsigned long long>(lane.lastCallbackUs),
+                               static_cast<unsigned long long>(lane.delivered ? lane.totalCallbackUs / lane.delivered : 0),
+                               static_cast<unsigned long long>(lane.maxCallbackUs), static_cast<unsigned long long>(lane.maxQueueWaitUs));
+                }
+
                 std::unique_lock<std::mutex> lock(m_processMonMutex);
                 // Wait for the specified interval or until notified to stop
                 if (m_processMonCondVar.wait_for(lock, std::chrono::seconds(interval), [this](){ return m_processMonThreadStop.load(); }))
@@ -1312,12 +1709,166 @@ namespace WPEFramework
             return;
         }
 
+        /* Quality buckets are SNR based; arm the single driver threshold on the bucket boundary nearest to the current RSSI */
+        static int signalMonitorThreshold(int strength, int noise)
+        {
+            const int snrBoundaries[] = { NM_WIFI_SNR_THRESHOLD_FAIR, NM_WIFI_SNR_THRESHOLD_GOOD, NM_WIFI_SNR_THRESHOLD_EXCELLENT };
+            int threshold = 0;
+            int distance = -1;
+
+            for (int snrBoundary : snrBoundaries)
+            {
+                /* without a valid noise floor GetWiFiSignalQuality maps the SNR to |RSSI| */
+                int rssiBoundary = (noise < 0) ? (noise + snrBoundary) : -snrBoundary;
+                if (distance < 0 || std::abs(strength - rssiBoundary) < distance)
+                {
+                    distance = std::abs(strength - rssiBoundary);
+                    threshold = rssiBoundary;
+                }
+            }
+            return threshold;
+        }
+
+        /*
+         * Event driven variant of the signal quality monitor. The thread sleeps until
+         * wpa_supplicant reports CTRL-EVENT-SIGNAL-CHANGE (or a connection event) and
+         * re-evaluates the quality only then; the threshold is re-armed only on those events.
+         * The driver watches a single threshold, the boundary nearest to the current RSSI, so
+         * a drift across the other boundary is only seen by the next event or by the long
+         * safety re-check. The commands go on m_wpaCtrl: a request on the attached socket
+         * would discard the events that arrive meanwhile. Returns false when the control
+         * interface or the driver does not support it, so that the caller falls back to polling.
+         */
+        bool NetworkManagerImplementation::signalEventMonitor(Exchange::INetworkManager::WiFiSignalQuality& lastQuality)
+        {
+            char event[256];
+            bool finished = false;
+            bool armed = false;
+            bool refresh = true;
+            bool rearm = true;
+            ssize_t len = 0;
+
+            if (!m_wpaEvents.open() || !m_wpaEvents.attach())
+            {
+                m_wpaEvents.close();
+                return false;
+            }
+
+            int wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (wakeFd < 0)
+            {
+                NMLOG_ERROR("eventfd creation failed: %s", strerror(errno));
+                m_wpaEvents.detach();
+                m_wpaEvents.close();
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_condVariableMutex);
+                m_monitorWakeFd = wakeFd;
+            }
+
+            NMLOG_INFO("WiFiSignalQualityMonitor waiting for wpa_supplicant signal events");
+            while (!m_stopThread.load())
+            {
+                if (refresh)
+                {
+                    std::string ssid{};
+                    int strength = 0;
+                    int noise = 0;
+                    int snr = 0;
+                    Exchange::INetworkManager::WiFiSignalQuality newSignalQuality;
+
+                    GetWiFiSignalQuality(ssid, strength, noise, snr, newSignalQuality);
+
+                    if (!ssid.empty())
+                        m_lastConnectedSSID = ssid; // last connected ssid used in wifiConnect
+
+                    if (lastQuality != newSignalQuality) {
+                        lastQuality = newSignalQuality;
+                        NetworkManagerImplementation::ReportWiFiSignalQualityChange(ssid, strength, noise, snr, newSignalQuality);
+                    }
+
+                    if (newSignalQuality == Exchange::INetworkManager::WIFI_SIGNAL_DISCONNECTED) {
+                        NMLOG_WARNING("WiFiSignalQualityChanged to disconnect - WiFiSignalQualityMonitor exiting");
+                        finished = true;
+                        break;
+                    }
+
+                    if (rearm)
+                    {
+                        armed = m_wpaCtrl.setSignalMonitor(signalMonitorThreshold(strength, noise), NM_WIFI_SIGNAL_MONITOR_HYSTERESIS);
+                        if (!armed)
+                            break;
+                        rearm = false;
+                    }
+                    refresh = false;
+                }
+
+                struct pollfd fds[2] = { { m_wpaEvents.fd(), POLLIN, 0 }, { wakeFd, POLLIN, 0 } };
+                int ret = poll(fds, 2, DEFAULT_WIFI_SIGNAL_EVENT_RECHECK_SEC * 1000);
+                if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    NMLOG_ERROR("WiFiSignalQualityMonitor poll failed: %s", strerror(errno));
+                    break;
+                }
+                if (ret == 0)
+                {
+                    /* safety net only; the threshold stays as armed */
+                    refresh = true;
+                    continue;
+                }
+                if (fds[1].revents & POLLIN)
+                    break;
+
+                while ((len = m_wpaEvents.receiveEvent(event, sizeof(event))) > 0)
+                {
+                    if (WpaCtrlClient::isEvent(event, WPA_EVENT_TERMINATING)) {
+                        len = -1;
+                        break;
+                    }
+                    if (WpaCtrlClient::isEvent(event, WPA_EVENT_SIGNAL_CHANGE) ||
+                        WpaCtrlClient::isEvent(event, WPA_EVENT_CONNECTED) ||
+                        WpaCtrlClient::isEvent(event, WPA_EVENT_DISCONNECTED)) {
+                        NMLOG_DEBUG("wpa_supplicant event: %s", event);
+                        refresh = true;
+                        rearm = true;
+                    }
+                }
+                if (len < 0) {
+                    NMLOG_WARNING("wpa_supplicant event socket closed");
+                    break;
+                }
+            }
+
+            finished = finished || m_stopThread.load();
+            {
+                std::lock_guard<std::mutex> lock(m_condVariableMutex);
+                m_monitorWakeFd = -1;
+                close(wakeFd);
+            }
+            if (armed)
+                m_wpaCtrl.setSignalMonitor(0, 0); /* threshold 0 disables the driver monitor */
+            m_wpaEvents.detach();
+            m_wpaEvents.close();
+            return finished;
+        }
+
         void NetworkManagerImplementation::monitorThreadFunction(int interval)
         {
             LOG_ENTRY_FUNCTION();
             static Exchange::INetworkManager::WiFiSignalQuality oldSignalQuality = Exchange::INetworkManager::WIFI_SIGNAL_DISCONNECTED;
             NMLOG_INFO("WiFiSignalQualityMonitor thread started ! (%d)", interval);
-            while (true)
+
+            if (signalEventMonitor(oldSignalQuality))
+            {
+                m_stopThread.store(false);
+                return;
+            }
+
+            NMLOG_INFO("WiFiSignalQualityMonitor polling every %d sec", interval);
+            while (!m_stopThread.load())
             {
                 std::string ssid{};
                 int strength = 0;
@@ -1358,6 +1909,7 @@ namespace WPEFramework
             if(INetworkManager::WiFiState::WIFI_STATE_CONNECTED == state)
             {
                 m_wlanConnected.store(true);
+                connectivityMonitor.wakeup(ProbeScheduler::WAKE_INTERFACE);
                 startWiFiSignalQualityMonitor(DEFAULT_WIFI_SIGNAL_TEST_INTERVAL_SEC);
             }
             else
@@ -1388,6 +1940,31 @@ namespace WPEFramework
             }
         }
 
+        void NetworkManagerImplementation::ReportOperationComplete(const OperationScheduler::Completion& completion)
+        {
+            LOG_ENTRY_FUNCTION();
+            OperationCompleteData eventData{completion.id, completion.kind, Exchange::INetworkManager::OPERATION_COMPLETED, completion.result, completion.latencyMs};
+            switch (completion.outcome)
+            {
+                case OperationScheduler::OUTCOME_TIMEDOUT:
+                    eventData.status = Exchange::INetworkManager::OPERATION_TIMEDOUT;
+                    eventData.result = Core::ERROR_TIMEDOUT;
+                    break;
+                case OperationScheduler::OUTCOME_CANCELLED:
+                    eventData.status = Exchange::INetworkManager::OPERATION_CANCELLED;
+                    eventData.result = Core::ERROR_ABORTED;
+                    break;
+                case OperationScheduler::OUTCOME_SUPERSEDED:
+                    eventData.status = Exchange::INetworkManager::OPERATION_SUPERSEDED;
+                    eventData.result = Core::ERROR_ABORTED;
+                    break;
+                default:
+                    break;
+            }
+            NMLOG_INFO("Posting onOperationComplete %u %s %s", completion.id, completion.kind.c_str(), OperationScheduler::outcomeName(completion.outcome));
+            enqueueEvent(NM_ON_OPERATION_COMPLETE, std::move(eventData));
+        }
+
         void NetworkManagerImplementation::logTelemetry(const std::string& eventName, const std::string& message)
         {
             LOG_ENTRY_FUNCTION();
@@ -1523,151 +2100,268 @@ namespace WPEFramework
 
         bool isIPv4LinkLocal(const std::string& addr)
         {
-            struct in_addr sa{};
-            return inet_pton(AF_INET, addr.c_str(), &sa) == 1 &&
-                   (ntohl(sa.s_addr) & 0xffff0000u) == 0xa9fe0000u;
+            IpAddr address;
+            return IpAddr::parse(addr, AF_INET, address) && address.isIPv4LinkLocal();
         }
 
         bool isIPv6LinkLocal(const std::string& addr)
         {
-            struct in6_addr sa6{};
-            return inet_pton(AF_INET6, addr.c_str(), &sa6) == 1 &&
-                   sa6.s6_addr[0] == 0xfe && (sa6.s6_addr[1] & 0xc0) == 0x80;
+            IpAddr address;
+            return IpAddr::parse(addr, AF_INET6, address) && address.isIPv6LinkLocal();
         }
 
         bool isIPv6ULA(const std::string& addr)
         {
-            struct in6_addr sa6{};
-            return inet_pton(AF_INET6, addr.c_str(), &sa6) == 1 &&
-                   (sa6.s6_addr[0] & 0xfe) == 0xfc;
+            IpAddr address;
+            return IpAddr::parse(addr, AF_INET6, address) && address.isIPv6ULA();
         }
 
-        /* Parse a MAC string into 6 bytes.  Accepts both "AA:BB:CC:DD:EE:FF" and "aabbccddeeff". */
-        static bool parseMac(const std::string& mac, uint8_t out[6])
+        bool isIPv6MacBased(const std::string& ipv6Addr, const std::string& macAddr)
         {
-            unsigned int b[6];
-            if (mac.size() >= 17 &&
-                sscanf(mac.c_str(), "%02x:%02x:%02x:%02x:%02x:%02x",
-                       &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) == 6)
-            {
-                for (int i = 0; i < 6; ++i) out[i] = static_cast<uint8_t>(b[i]);
-                return true;
-            }
-            if (mac.size() >= 12 &&
-                sscanf(mac.c_str(), "%02x%02x%02x%02x%02x%02x",
-                       &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) == 6)
+            IpAddr address;
+            MacAddr mac;
+            if (!IpAddr::parse(ipv6Addr, AF_INET6, address) || !MacAddr::parse(macAddr, mac))
+                return false;
+            if (address.isEui64Of(mac))
             {
-                for (int i = 0; i < 6; ++i) out[i] = static_cast<uint8_t>(b[i]);
+                NMLOG_DEBUG("MAC %s based global v6 address %s", macAddr.c_str(), ipv6Addr.c_str());
                 return true;
             }
             return false;
         }
 
-        bool isIPv6MacBased(const std::string& ipv6Addr, const std::string& macAddr)
+        /* Libnm reports addresses as text; the cache keeps them binary */
+        static IpFamilySnapshot snapshotFromCache(const IpFamilyCache& cache, bool isIPv6)
         {
-            struct in6_addr sa6{};
-            uint8_t mac[6];
-            if (inet_pton(AF_INET6, ipv6Addr.c_str(), &sa6) != 1 || !parseMac(macAddr, mac))
-                return false;
+            const int family = isIPv6 ? AF_INET6 : AF_INET;
+            IpFamilySnapshot snapshot;
+            IpAddr address;
+            snapshot.valid = cache.valid;
+            snapshot.autoconfig = cache.autoconfig;
+            for (const auto& kv : cache.globalAddresses) {
+                if (IpAddr::parse(kv.first, family, address))
+                    snapshot.globalAddresses.emplace_back(address, static_cast<uint8_t>(kv.second.prefix), kv.second.type);
+            }
+            for (const auto& text : cache.linkLocalAddresses) {
+                if (IpAddr::parse(text, family, address))
+                    snapshot.linkLocalAddresses.emplace_back(address);
+            }
+            for (const auto& text : cache.uniqueLocalAddresses) {
+                if (IpAddr::parse(text, family, address))
+                    snapshot.uniqueLocalAddresses.emplace_back(address);
+            }
+            IpAddr::parse(cache.gateway, family, snapshot.gateway);
+            /* the DNS servers of an IPv4 configuration may still be IPv6 ones */
+            IpAddr::parseAny(cache.primarydns, snapshot.primaryDns);
+            IpAddr::parseAny(cache.secondarydns, snapshot.secondaryDns);
+            IpAddr::parseAny(cache.dhcpserver, snapshot.dhcpServer);
+            return snapshot;
+        }
 
-            /* Build 8-byte EUI-64 identifier from 6-byte MAC:
-               mac[0..2] | ff:fe | mac[3..5], then flip the U/L bit (bit 1) of byte 0. */
-            uint8_t eui64[8];
-            eui64[0] = mac[0] ^ 0x02;   // flip Universal/Local bit
-            eui64[1] = mac[1];
-            eui64[2] = mac[2];
-            eui64[3] = 0xff;
-            eui64[4] = 0xfe;
-            eui64[5] = mac[3];
-            eui64[6] = mac[4];
-            eui64[7] = mac[5];
-
-            /* Compare against the interface-ID (last 8 bytes) of the IPv6 address. */
-            if (memcmp(&sa6.s6_addr[8], eui64, 8) == 0)
-            {
-                NMLOG_DEBUG("MAC %s based global v6 address %s", macAddr.c_str(), ipv6Addr.c_str());
-                return true;
+        static Exchange::INetworkManager::IPAddress toIPAddress(const IpFamilySnapshot& snapshot, const std::string& ipFamily)
+        {
+            Exchange::INetworkManager::IPAddress addr{};
+            addr.ipversion    = ipFamily;
+            addr.autoconfig   = snapshot.autoconfig;
+            addr.dhcpserver   = snapshot.dhcpServer.toString();
+            addr.ula          = snapshot.uniqueLocalAddresses.empty() ? "" : snapshot.uniqueLocalAddresses.front().toString();
+            addr.gateway      = snapshot.gateway.toString();
+            addr.primarydns   = snapshot.primaryDns.toString();
+            addr.secondarydns = snapshot.secondaryDns.toString();
+            if (snapshot.preferredGlobal >= 0) {
+                const CachedAddress& preferred = snapshot.globalAddresses[snapshot.preferredGlobal];
+                addr.ipaddress = preferred.toString();
+                addr.prefix    = preferred.prefix;
             }
-            return false;
+            return addr;
         }
 
         bool NetworkManagerImplementation::lookupIpCache(
             const std::string& iface, const std::string& ipFamily,
             Exchange::INetworkManager::IPAddress& out) const
         {
-            std::lock_guard<std::mutex> lock(m_ipCacheMutex);
-            auto it = m_ipCacheMap.find({iface, ipFamily});
-            if (it != m_ipCacheMap.end() && it->second.valid) {
-                out = it->second.toIPAddress();
-                out.ipversion = ipFamily;
-                return true;
+            IpCacheStore::Slot slot;
+            if (!m_ipCache.slotFor(iface, ipFamily == "IPv6", slot))
+                return false;
+            std::shared_ptr<const IpFamilySnapshot> snapshot = m_ipCache.load(slot);
+            if (!snapshot->valid)
+                return false;
+            out = toIPAddress(*snapshot, ipFamily);
+            return true;
+        }
+
+        bool NetworkManagerImplementation::storeIpFamily(const std::string& iface, bool isIPv6, IpFamilySnapshot& next,
+                                                         std::shared_ptr<const IpFamilySnapshot>& previous,
+                                                         std::shared_ptr<const IpFamilySnapshot>& current)
+        {
+            IpCacheStore::Slot slot;
+            if (!m_ipCache.slotFor(iface, isIPv6, slot)) {
+                NMLOG_DEBUG("%s is not cached", iface.c_str());
+                return false;
             }
-            return false;
+
+            /* libnm may lag behind the kernel; take the addresses from where they are set */
+            if (next.valid)
+                readKernelAddresses(iface, isIPv6, next);
+            previous = m_ipCache.publish(slot, next, &current);
+            return true;
+        }
+
+        void NetworkManagerImplementation::reportGlobalChanges(const std::string& iface, bool isIPv6,
+                                                               const IpFamilySnapshot& previous,
+                                                               const IpFamilySnapshot& current)
+        {
+            if (&previous == &current)
+                return;
+
+            /* both lists are sorted binary addresses; only what changed is turned back into text */
+            std::vector<IpAddr> acquired;
+            std::vector<IpAddr> lost;
+            current.diffGlobal(previous, acquired, lost);
+            if (acquired.empty() && lost.empty())
+                return;
+
+            const std::string ipFamily = isIPv6 ? "IPv6" : "IPv4";
+            const bool batched = m_ipBatchEnabled.load();
+            /* the batch replaces the per-address events only when configured to */
+            const bool perAddress = !(batched && m_ipBatchOnly.load());
+            for (const auto& address : acquired)
+                ReportIPAddressChange(iface, ipFamily, address.toString(), Exchange::INetworkManager::IP_ACQUIRED, perAddress);
+            for (const auto& address : lost)
+                ReportIPAddressChange(iface, ipFamily, address.toString(), Exchange::INetworkManager::IP_LOST, perAddress);
+
+            if (batched)
+            {
+                /* addresses need no escaping */
+                IPAddressesChangeData batch;
+                batch.interface = iface;
+                batch.ipversion = ipFamily;
+                batch.jsonChanges = "{\"acquired\":[";
+                for (size_t i = 0; i < acquired.size(); ++i)
+                    batch.jsonChanges += (i ? ",\"" : "\"") + acquired[i].toString() + "\"";
+                batch.jsonChanges += "],\"lost\":[";
+                for (size_t i = 0; i < lost.size(); ++i)
+                    batch.jsonChanges += (i ? ",\"" : "\"") + lost[i].toString() + "\"";
+                batch.jsonChanges += "]}";
+                NMLOG_DEBUG("Posting onIPAddressesChanged for %s %s, %zu acquired, %zu lost",
+                            iface.c_str(), ipFamily.c_str(), acquired.size(), lost.size());
+                enqueueEvent(NM_ON_IPADDRESSES_CHANGE, std::move(batch));
+            }
+        }
+
+        void NetworkManagerImplementation::publishIpFamily(const std::string& iface, bool isIPv6, IpFamilySnapshot next)
+        {
+            std::shared_ptr<const IpFamilySnapshot> previous;
+            std::shared_ptr<const IpFamilySnapshot> current;
+            if (storeIpFamily(iface, isIPv6, next, previous, current))
+                reportGlobalChanges(iface, isIPv6, *previous, *current);
         }
 
         std::set<std::string> NetworkManagerImplementation::swapIpCache(
             const std::string& iface, const std::string& ipFamily,
-            IpFamilyCache newCache)
+            IpFamilyCache& newCache)
         {
             std::set<std::string> oldKeys;
-            std::lock_guard<std::mutex> lock(m_ipCacheMutex);
-            IpFamilyCache& cache = m_ipCacheMap[{iface, ipFamily}];
-            for (const auto& kv : cache.globalAddresses)
-                oldKeys.insert(kv.first);
-            cache = std::move(newCache);
+            bool isIPv6 = (ipFamily == "IPv6");
+            IpFamilySnapshot next = snapshotFromCache(newCache, isIPv6);
+            std::shared_ptr<const IpFamilySnapshot> previous;
+            std::shared_ptr<const IpFamilySnapshot> current;
+            if (!storeIpFamily(iface, isIPv6, next, previous, current))
+                return oldKeys;
+            for (const auto& address : previous->globalAddresses)
+                oldKeys.insert(address.toString());
+
+            /* hand back what was stored, so that the caller diffs against the kernel addresses too */
+            newCache.globalAddresses.clear();
+            for (const auto& address : current->globalAddresses)
+                newCache.globalAddresses.emplace(address.toString(), GlobalAddressInfo{address.prefix, address.type});
             return oldKeys;
         }
 
-        Exchange::INetworkManager::IPAddress IpFamilyCache::toIPAddress() const
+        bool NetworkManagerImplementation::readKernelAddresses(const std::string& iface, bool isIPv6, IpFamilySnapshot& snapshot) const
         {
-            LOG_ENTRY_FUNCTION();
-            Exchange::INetworkManager::IPAddress addr{};
-            /* Detect IP version from any available address. */
-            bool isIPv6 = false;
-            {
-                const std::string* sample = nullptr;
-                if (!globalAddresses.empty())
-                    sample = &globalAddresses.begin()->first;
-                else if (!uniqueLocalAddresses.empty())
-                    sample = &(*uniqueLocalAddresses.begin());
-                else if (!linkLocalAddresses.empty())
-                    sample = &(*linkLocalAddresses.begin());
-                if (sample) {
-                    struct in6_addr sa6{};
-                    isIPv6 = (inet_pton(AF_INET6, sample->c_str(), &sa6) == 1);
-                }
+            RtnetlinkLink link;
+            if (!m_rtnetlink.running() || !m_rtnetlink.getLink(iface, link))
+                return false;
+
+            const int family = isIPv6 ? AF_INET6 : AF_INET;
+            snapshot.globalAddresses.clear();
+            snapshot.linkLocalAddresses.clear();
+            snapshot.uniqueLocalAddresses.clear();
+            for (const RtnetlinkAddress& addr : m_rtnetlink.getAddresses(iface, family))
+            {
+                if (addr.scope != RT_SCOPE_HOST)
+                    snapshot.addAddress(addr.address, addr.prefix, link.mac);
             }
-            addr.ipversion    = isIPv6 ? "IPv6" : "IPv4";
-            addr.autoconfig   = autoconfig;
-            addr.dhcpserver   = dhcpserver;
-            addr.ula          = uniqueLocalAddresses.empty() ? "" : *uniqueLocalAddresses.begin();
-            addr.gateway      = gateway;
-            addr.primarydns   = primarydns;
-            addr.secondarydns = secondarydns;
-            /* Prefer non-MAC-based global; fall back to MAC-based if all are MAC-based. */
-            const std::string* bestGlobal = nullptr;
-            uint32_t bestPrefix = 0;
-            const std::string* fallbackMac = nullptr;
-            uint32_t fallbackMacPrefix = 0;
-            for (const auto& kv : globalAddresses) {
-                if (kv.second.type == ADDR_GLOBAL) {
-                    bestGlobal = &kv.first;
-                    bestPrefix = kv.second.prefix;
-                    break;
+
+            /* a connection that never sets the default route keeps the gateway libnm reported */
+            RtnetlinkRoute route;
+            if (m_rtnetlink.getDefaultRoute(family, route, iface) && !route.gateway.empty())
+                snapshot.gateway = route.gateway;
+            return true;
+        }
+
+        /* Brings a valid cache entry up to the kernel state and reports the global addresses that came and went */
+        void NetworkManagerImplementation::applyKernelAddresses(const std::string& iface, const std::string& ipFamily)
+        {
+            bool isIPv6 = (ipFamily == "IPv6");
+            IpCacheStore::Slot slot;
+            if (!m_ipCache.slotFor(iface, isIPv6, slot))
+                return;
+
+            std::shared_ptr<const IpFamilySnapshot> current;
+            std::shared_ptr<const IpFamilySnapshot> previous = m_ipCache.update(slot, [&](IpFamilySnapshot& snapshot) {
+                return snapshot.valid && readKernelAddresses(iface, isIPv6, snapshot);
+            }, &current);
+            reportGlobalChanges(iface, isIPv6, *previous, *current);
+        }
+
+        void NetworkManagerImplementation::onKernelChanges(const RtnetlinkChanges& changes)
+        {
+            std::set<std::pair<std::string, std::string>> entries;
+            for (const auto& address : changes.addresses)
+                entries.insert({address.first, (address.second == AF_INET6) ? "IPv6" : "IPv4"});
+            /* the gateway of every cached interface of that family may have moved */
+            for (int slot = 0; slot < IpCacheStore::SLOT_COUNT; ++slot)
+            {
+                IpCacheStore::Slot cached = static_cast<IpCacheStore::Slot>(slot);
+                bool isIPv6 = IpCacheStore::isIPv6(cached);
+                if (changes.routes.count(isIPv6 ? AF_INET6 : AF_INET))
+                    entries.insert({m_ipCache.interfaceOf(cached), isIPv6 ? "IPv6" : "IPv4"});
+            }
+            for (const auto& entry : entries)
+                applyKernelAddresses(entry.first, entry.second);
+
+            string defaultIface = getDefaultInterface();
+            if (!changes.routes.empty())
+            {
+                string kernelIface = m_rtnetlink.getDefaultInterface();
+                bool moved;
+                {
+                    std::lock_guard<std::mutex> lock(m_defaultInterfaceMutex);
+                    moved = (kernelIface != m_kernelDefaultInterface);
+                    m_kernelDefaultInterface = kernelIface;
                 }
-                if (!fallbackMac) {
-                    fallbackMac = &kv.first;
-                    fallbackMacPrefix = kv.second.prefix;
+                if (moved)
+                {
+                    NMLOG_INFO("kernel default route now through '%s'", kernelIface.c_str());
+                    /* the backend names the default interface; the kernel only fills in while it has not */
+                    if (defaultIface.empty() && (kernelIface == "eth0" || kernelIface == "wlan0"))
+                    {
+                        setDefaultInterface(kernelIface);
+                        defaultIface = kernelIface;
+                    }
+                    connectivityMonitor.wakeup(ProbeScheduler::WAKE_ROUTE);
                 }
             }
-            if (bestGlobal) {
-                addr.ipaddress = *bestGlobal;
-                addr.prefix    = bestPrefix;
-            } else if (fallbackMac) {
-                addr.ipaddress = *fallbackMac;
-                addr.prefix    = fallbackMacPrefix;
-            }
-            return addr;
+
+            if (defaultIface.empty())
+                return;
+            if (changes.links.count(defaultIface))
+                connectivityMonitor.wakeup(ProbeScheduler::WAKE_INTERFACE);
+            if (changes.addresses.count({defaultIface, AF_INET}) || changes.addresses.count({defaultIface, AF_INET6}))
+                connectivityMonitor.wakeup(ProbeScheduler::WAKE_ADDRESS);
         }
+
     }
 }
@@ -39,10 +39,15 @@ using namespace std;
 #include "NetworkManagerLogger.h"
 #include "NetworkManagerConnectivity.h"
 #include "NetworkManagerStunClient.h"
+#include "NetworkManagerIcmp.h"
 #include "NetworkManagerPowerClient.h"
-
-/* Forward declarations to avoid pulling GLib/libnm headers into this header */
-typedef struct _GMainContext GMainContext;
+#include "NetworkManagerWpaCtrl.h"
+#include "NetworkManagerScanResults.h"
+#include "NetworkManagerEventQueue.h"
+#include "NetworkManagerNotificationFanout.h"
+#include "NetworkManagerOperationScheduler.h"
+#include "NetworkManagerRtnetlink.h"
+#include "NetworkManagerIpCache.h"
 
 /*
  * Receiver thermal noise + BW factor + assumed noise figure (NF) (dB)
@@ -56,17 +61,25 @@ typedef struct _GMainContext GMainContext;
 #define MAX_SNR_VALUE                              180
 
 #define DEFAULT_WIFI_SIGNAL_TEST_INTERVAL_SEC      60
+#define DEFAULT_WIFI_SIGNAL_EVENT_RECHECK_SEC      600
+#define NM_WIFI_SIGNAL_MONITOR_HYSTERESIS          2
 #define NM_PROCESS_MONITOR_INTERVAL_SEC            60
 #define NM_WIFI_SNR_THRESHOLD_EXCELLENT            40
 #define NM_WIFI_SNR_THRESHOLD_GOOD                 25
 #define NM_WIFI_SNR_THRESHOLD_FAIR                 18
 #define ROUTE_METRIC_PRIORITY_HIGH                 1
 #define ROUTE_METRIC_PRIORITY_LOW                  100
+#define NM_IP_REFRESH_WINDOW_MS                    50      // address, gateway, DNS and DHCP triggers merged into one refresh
 
 namespace WPEFramework
 {
     namespace Plugin
     {
+        /*
+         * Text forms of the IpAddr classifiers; each call parses its arguments again, so code
+         * that walks address lists parses once into IpAddr and MacAddr instead.
+         */
+
         /* Returns true if the given string is an IPv4 link-local address (169.254.0.0/16). */
         bool isIPv4LinkLocal(const std::string& addr);
 
@@ -79,12 +92,6 @@ namespace WPEFramework
         /* Returns true if the given global IPv6 address is derived (EUI-64) from the MAC. */
         bool isIPv6MacBased(const std::string& ipv6Addr, const std::string& macAddr);
 
-        /* Sub-classification of global-scope addresses in the IP cache. */
-        enum GlobalAddressType : uint8_t {
-            ADDR_GLOBAL,            // non-MAC-based global (preferred by GetIPSettings)
-            ADDR_GLOBAL_MAC_BASED,  // EUI-64 global derived from interface MAC (fallback)
-        };
-
         struct GlobalAddressInfo {
             uint32_t          prefix;
             GlobalAddressType type;
@@ -92,7 +99,13 @@ namespace WPEFramework
             GlobalAddressInfo(uint32_t p, GlobalAddressType t) : prefix(p), type(t) {}
         };
 
-        /* Per-interface, per-address-family cache populated by libnm events. */
+        /*
+         * Text form of what libnm reports for one interface and address family; swapIpCache
+         * parses it into an IpFamilySnapshot and publishes that. The gnome backend builds
+         * the snapshot directly and calls publishIpFamily. While the rtnetlink monitor runs, the address sets and the
+         * gateway of a valid entry follow the kernel; libnm keeps the DNS, DHCP and
+         * autoconfig details and the validity.
+         */
         struct IpFamilyCache {
             bool valid = false;
             std::map<std::string, GlobalAddressInfo> globalAddresses;       // event-diffable global addresses
@@ -104,7 +117,6 @@ namespace WPEFramework
             std::string dhcpserver;
             bool autoconfig = false;
 
-            Exchange::INetworkManager::IPAddress toIPAddress() const;
             void clear() { *this = IpFamilyCache{}; }
         };
 
@@ -162,6 +174,7 @@ namespace WPEFramework
                             Add(_T("endpoint"), &stunEndpoint);
                             Add(_T("port"), &port);
                             Add(_T("interval"), &interval);
+                            Add(_T("servers"), &servers);
                         }
                         ~Stun() override = default;
 
@@ -170,6 +183,7 @@ namespace WPEFramework
                         Core::JSON::String stunEndpoint;
                         Core::JSON::DecUInt32 port;
                         Core::JSON::DecUInt32 interval;
+                        Core::JSON::ArrayType<Core::JSON::String> servers;    /* alternates raced with endpoint, "host[:port]" */
             };
 
             class WiFiConfig : public Core::JSON::Container
@@ -198,10 +212,26 @@ namespace WPEFramework
             public:
                 Configuration()
                     : Core::JSON::Container()
+                    , eventQueueLimit(NM_EVENT_QUEUE_DEFAULT_LIMIT)
+                    , scanDelta(false)
+                    , scanDeltaHysteresis(NM_SCAN_DELTA_HYSTERESIS)
+                    , operationLimit(NM_OPERATION_INFLIGHT_LIMIT)
+                    , kernelMonitor(false)
+                    , ipRefreshWindow(NM_IP_REFRESH_WINDOW_MS)
+                    , ipAddressBatch(false)
+                    , ipAddressBatchOnly(false)
                     {
                         Add(_T("connectivity"), &connectivityConf);
                         Add(_T("stun"), &stun);
                         Add(_T("loglevel"), &loglevel);
+                        Add(_T("eventqueuelimit"), &eventQueueLimit);
+                        Add(_T("scandelta"), &scanDelta);
+                        Add(_T("scandeltahysteresis"), &scanDeltaHysteresis);
+                        Add(_T("operationlimit"), &operationLimit);
+                        Add(_T("kernelmonitor"), &kernelMonitor);
+                        Add(_T("iprefreshwindow"), &ipRefreshWindow);
+                        Add(_T("ipaddressbatch"), &ipAddressBatch);
+                        Add(_T("ipaddressbatchonly"), &ipAddressBatchOnly);
                     }
                 ~Configuration() override = default;
 
@@ -209,6 +239,14 @@ namespace WPEFramework
                 ConnectivityConf connectivityConf;
                 Stun stun;
                 Core::JSON::DecUInt32 loglevel;
+                Core::JSON::DecUInt32 eventQueueLimit;
+                Core::JSON::Boolean scanDelta;                  /* also publish onAvailableSSIDsDelta */
+                Core::JSON::DecUInt32 scanDeltaHysteresis;      /* dB */
+                Core::JSON::DecUInt32 operationLimit;           /* background operations queued or running */
+                Core::JSON::Boolean kernelMonitor;              /* follow addresses and routes over rtnetlink */
+                Core::JSON::DecUInt32 ipRefreshWindow;          /* ms; 0 refreshes on every trigger */
+                Core::JSON::Boolean ipAddressBatch;             /* also publish onIPAddressesChanged */
+                Core::JSON::Boolean ipAddressBatchOnly;         /* with ipAddressBatch, no onIPAddressChange for the addresses of a batch */
             };
 
             enum NMPublishEvents {
@@ -218,7 +256,11 @@ namespace WPEFramework
                 NM_ON_INTERNETSTATUS_CHANGE,
                 NM_ON_AVAILABLESSIDS,
                 NM_ON_WIFISTATE_CHANGE,
-                NM_ON_WIFISIGNALQUALITY_CHANGE
+                NM_ON_WIFISIGNALQUALITY_CHANGE,
+                NM_ON_AVAILABLESSIDS_DELTA,
+                NM_ON_OPERATION_COMPLETE,
+                NM_ON_INTERNETSTATUS_CHANGE_BY_FAMILY,
+                NM_ON_IPADDRESSES_CHANGE
             };
 
             // Typed event data structures
@@ -239,16 +281,33 @@ namespace WPEFramework
                 Exchange::INetworkManager::IPStatus status;
             };
 
+            struct IPAddressesChangeData {
+                string interface;
+                string ipversion;
+                string jsonChanges;     // Pre-serialized {"acquired","lost"}
+            };
+
             struct InternetStatusChangeData {
                 Exchange::INetworkManager::InternetStatus prevState;
                 Exchange::INetworkManager::InternetStatus currState;
                 string interface;
             };
 
+            struct InternetStatusChangeByFamilyData {
+                Exchange::INetworkManager::InternetStatus prevState;
+                Exchange::INetworkManager::InternetStatus currState;
+                string interface;
+                string ipversion;
+            };
+
             struct AvailableSSIDsData {
                 string jsonResult;  // Pre-serialized JSON string
             };
 
+            struct AvailableSSIDsDeltaData {
+                string jsonDelta;   // Pre-serialized {"sequence","added","changed","removed"}
+            };
+
             struct WiFiStateChangeData {
                 Exchange::INetworkManager::WiFiState state;
             };
@@ -261,6 +320,14 @@ namespace WPEFramework
                 Exchange::INetworkManager::WiFiSignalQuality quality;
             };
 
+            struct OperationCompleteData {
+                uint32_t operationId;
+                string operation;
+                Exchange::INetworkManager::OperationStatus status;
+                uint32_t result;
+                uint32_t latency;   // ms from submission
+            };
+
             using EventDataVariant = std::variant<
                 std::monostate,
                 InterfaceStateChangeData,
@@ -268,15 +335,14 @@ namespace WPEFramework
                 IPAddressChangeData,
                 InternetStatusChangeData,
                 AvailableSSIDsData,
+                AvailableSSIDsDeltaData,
                 WiFiStateChangeData,
-                WiFiSignalQualityChangeData
+                WiFiSignalQualityChangeData,
+                OperationCompleteData,
+                InternetStatusChangeByFamilyData,
+                IPAddressesChangeData
             >;
 
-            struct EventData {
-                NMPublishEvents event;
-                EventDataVariant data;
-            };
-
             public:
                 NetworkManagerImplementation();
                 ~NetworkManagerImplementation() override;
@@ -366,12 +432,29 @@ namespace WPEFramework
                 /* @brief configure network manager plugin */
                 uint32_t Configure(const string configLine) override;
 
+                /* @brief Background forms of the mutating calls; completion is published as onOperationComplete */
+                uint32_t WiFiConnectAsync(const WiFiConnectTo& ssid /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) override;
+                uint32_t ConnectToKnownSSIDAsync(const string& ssid /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) override;
+                uint32_t SetInterfaceStateAsync(const string& interface /* @in */, const bool enabled /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) override;
+                uint32_t SetIPSettingsAsync(const string& interface /* @in */, const IPAddress& address /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) override;
+                uint32_t StartWPSAsync(const WiFiWPS& method /* @in */, const string& pin /* @in */, const uint32_t timeout /* @in */, uint32_t& operationId /* @out */) override;
+                uint32_t CancelOperation(const uint32_t operationId /* @in */) override;
+                uint32_t GetOperationStatistics(string& statistics /* @out */) override;
+
+                /* @brief Get the IPv4 and IPv6 Public IPs with concurrent binding requests */
+                uint32_t GetDualStackPublicIP(string& interface /* @inout */, string& ipv4address /* @out */, string& ipv6address /* @out */) override;
+
+                /* @brief Probe counts, wakeups and the next delay of the connectivity monitor */
+                uint32_t GetConnectivityMonitorStatistics(string& statistics /* @out */) override;
+
                 /* Events */
                 void ReportInterfaceStateChange(const Exchange::INetworkManager::InterfaceState state, const string interface);
                 void ReportActiveInterfaceChange(const string prevActiveInterface, const string currentActiveinterface);
-                void ReportIPAddressChange(const string interface, const string ipversion, const string ipaddress, const Exchange::INetworkManager::IPStatus status);
+                /* publish false keeps the bookkeeping of the change but posts no onIPAddressChange */
+                void ReportIPAddressChange(const string interface, const string ipversion, const string ipaddress, const Exchange::INetworkManager::IPStatus status, bool publish = true);
                 void ReportInternetStatusChange(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface);
-                void ReportAvailableSSIDs(const JsonArray &arrayofWiFiScanResults);
+                void ReportInternetStatusChangeByFamily(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface, const Exchange::INetworkManager::IPVersion ipversion);
+                void ReportAvailableSSIDs(ScanResultSet &scanResults);
                 void ReportWiFiStateChange(const Exchange::INetworkManager::WiFiState state);
                 void ReportWiFiSignalQualityChange(const string ssid, const int strength, const int noise, const int snr, const Exchange::INetworkManager::WiFiSignalQuality quality);
                 void logTelemetry(const std::string& eventName, const std::string& message);
@@ -390,30 +473,62 @@ namespace WPEFramework
                 void getInitialConnectionState(void);
                 void executeExternally(NetworkEvents event, const string commandToExecute, string& response);
                 void threadEventRegistration(bool iarmInit, bool iarmConnect);
-                void filterScanResults(JsonArray &ssids, const std::vector<std::string>& filterSsidslist, const std::vector<std::string>& filterFrequencies);
                 void startWiFiSignalQualityMonitor(int interval);
                 void stopWiFiSignalQualityMonitor();
                 void monitorThreadFunction(int interval);
-                int32_t logSSIDs(Logging level, const JsonArray &ssids);
+                bool readSignalInfoFromCli(WpaSignalInfo& info);
+                bool signalEventMonitor(Exchange::INetworkManager::WiFiSignalQuality& lastQuality);
+                int32_t logSSIDs(Logging level, const ScanResultSet &ssids);
                 void processMonitor(uint16_t interval);
                 void eventThreadFunction();
                 void enqueueEvent(NMPublishEvents event, EventDataVariant&& data);
-                void dispatchEvent(NMPublishEvents event, const EventDataVariant& data);
+                void dispatchEvent(NMPublishEvents event, EventDataVariant&& data);
+                void dropSlowSubscriber(Exchange::INetworkManager::INotification* notification);
+                uint32_t scheduleOperation(OperationScheduler::Request&& request, uint32_t& operationId);
+                /* lane of the operations that mutate interface */
+                std::string operationLane(const string& interface) const;
+                void ReportOperationComplete(const OperationScheduler::Completion& completion);
+                /* the configured endpoint followed by the alternates */
+                std::vector<stun::server> stunServers() const;
+                void onKernelChanges(const RtnetlinkChanges& changes);
+                /* Fills the address sets and gateway of snapshot from the kernel; false while the monitor is not running */
+                bool readKernelAddresses(const std::string& iface, bool isIPv6, IpFamilySnapshot& snapshot) const;
+                void applyKernelAddresses(const std::string& iface, const std::string& ipFamily);
+                /* Overlays the kernel addresses and publishes next; false if iface is not cached */
+                bool storeIpFamily(const std::string& iface, bool isIPv6, IpFamilySnapshot& next,
+                                   std::shared_ptr<const IpFamilySnapshot>& previous,
+                                   std::shared_ptr<const IpFamilySnapshot>& current);
+                /* IP_ACQUIRED / IP_LOST for the global addresses that differ between the snapshots */
+                void reportGlobalChanges(const std::string& iface, bool isIPv6,
+                                         const IpFamilySnapshot& previous, const IpFamilySnapshot& current);
 
             private:
                 std::list<Exchange::INetworkManager::INotification *> _notificationCallbacks;
+                using NotificationLanes = NotificationFanout<Exchange::INetworkManager::INotification>;
+                std::unique_ptr<NotificationLanes> m_notificationLanes;
+                std::unique_ptr<OperationScheduler> m_operations;
                 Core::CriticalSection _notificationLock;
                 Core::CriticalSection m_filterVectorsLock;
                 string m_publicIP;
                 stun::client stunClient;
                 string m_stunEndpoint;
+                std::vector<stun::server> m_stunAlternates;
                 uint16_t m_stunPort;
                 uint16_t m_stunBindTimeout;
                 uint16_t m_stunCacheTimeout;
                 std::thread m_registrationThread;
                 std::vector<std::string> m_filterFrequencies;
                 std::vector<std::string> m_filterSsidslist;
+                std::atomic<bool> m_scanDeltaEnabled{false};
+                std::atomic<bool> m_ipBatchEnabled{false};
+                std::atomic<bool> m_ipBatchOnly{false};
+                std::atomic<uint32_t> m_ipRefreshWindow{NM_IP_REFRESH_WINDOW_MS};
+                ScanResultIndex m_scanIndex;        /* guarded by m_scanIndexMutex */
+                std::mutex m_scanIndexMutex;
                 std::thread m_monitorThread;
+                WpaCtrlClient m_wpaCtrl;
+                WpaCtrlClient m_wpaEvents;
+                int m_monitorWakeFd{-1};    /* guarded by m_condVariableMutex */
 
                 std::thread m_processMonThread;
                 std::mutex m_processMonMutex;
@@ -421,7 +536,7 @@ namespace WPEFramework
                 std::condition_variable m_processMonCondVar;
 
                 std::thread m_eventThread;
-                std::queue<EventData> m_eventQueue;
+                EventDispatchQueue<EventDataVariant> m_eventQueue;  /* guarded by m_eventMutex */
                 std::mutex m_eventMutex;
                 std::condition_variable m_eventCondVar;
                 std::atomic<bool> m_eventThreadStop{false};
@@ -440,9 +555,14 @@ namespace WPEFramework
 #endif
                 bool lookupIpCache(const std::string& iface, const std::string& ipFamily,
                                    Exchange::INetworkManager::IPAddress& out) const;
+                /* Stores what libnm reports for iface and family and reports the global addresses that came and went */
+                void publishIpFamily(const std::string& iface, bool isIPv6, IpFamilySnapshot next);
+                /* How long the backend gathers refresh triggers of one interface and family, in ms */
+                uint32_t ipRefreshWindow() const { return m_ipRefreshWindow.load(std::memory_order_relaxed); }
+                /* Text form of publishIpFamily; newCache is updated to what was stored, kernel addresses included */
                 std::set<std::string> swapIpCache(const std::string& iface,
                                                   const std::string& ipFamily,
-                                                  IpFamilyCache newCache);
+                                                  IpFamilyCache& newCache);
 
                 std::atomic<bool> m_ethConnected;
                 std::atomic<bool> m_wlanConnected;
@@ -451,7 +571,7 @@ namespace WPEFramework
                 std::atomic<bool> m_ethDisconnectedForSleep;
                 std::atomic<bool> m_wlanDisconnectedForSleep;
                 std::string m_lastConnectedSSID;
-                GMainContext *m_nmContext{nullptr};     /* isolated context for per-call NMClient creation */
+                std::atomic<bool> m_nmReady{false};     /* platform_init reached NetworkManager */
                 mutable ConnectivityMonitor connectivityMonitor;
 
                 string getDefaultInterface() const
@@ -469,8 +589,9 @@ namespace WPEFramework
             private:
                 string m_defaultInterface;
                 mutable std::mutex m_defaultInterfaceMutex;
-                std::map<std::pair<std::string, std::string>, IpFamilyCache> m_ipCacheMap;
-                mutable std::mutex m_ipCacheMutex;
+                IpCacheStore m_ipCache;
+                RtnetlinkMonitor m_rtnetlink;
+                string m_kernelDefaultInterface;    /* guarded by m_defaultInterfaceMutex */
         };
     }
 }
@@ -0,0 +1,225 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <arpa/inet.h>
+#include <cstring>
+
+#include "NetworkManagerIpAddr.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        namespace
+        {
+            int hexValue(char c)
+            {
+                if (c >= '0' && c <= '9')
+                    return c - '0';
+                if (c >= 'a' && c <= 'f')
+                    return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F')
+                    return c - 'A' + 10;
+                return -1;
+            }
+
+            char* formatIPv4(const uint8_t* bytes, char* out)
+            {
+                for (int index = 0; index < 4; ++index)
+                {
+                    unsigned value = bytes[index];
+                    if (index)
+                        *out++ = '.';
+                    if (value >= 100)
+                        *out++ = static_cast<char>('0' + value / 100);
+                    if (value >= 10)
+                        *out++ = static_cast<char>('0' + (value / 10) % 10);
+                    *out++ = static_cast<char>('0' + value % 10);
+                }
+                return out;
+            }
+
+            char* formatHex(unsigned value, char* out)
+            {
+                static const char digits[] = "0123456789abcdef";
+                bool started = false;
+                for (int shift = 12; shift >= 0; shift -= 4)
+                {
+                    unsigned digit = (value >> shift) & 0x0f;
+                    if (digit || started || shift == 0)
+                    {
+                        *out++ = digits[digit];
+                        started = true;
+                    }
+                }
+                return out;
+            }
+
+            /*
+             * RFC 5952 text: lower case hex without leading zeros and the first longest run of
+             * two or more zero groups written as "::". Mapped and compatible addresses end in
+             * dotted IPv4 as inet_ntop() writes them, so the text stays what it was, but without
+             * the cost of the printf machinery inet_ntop() goes through.
+             */
+            char* formatIPv6(const uint8_t* bytes, char* out)
+            {
+                uint16_t words[8];
+                for (int index = 0; index < 8; ++index)
+                    words[index] = static_cast<uint16_t>((bytes[2 * index] << 8) | bytes[2 * index + 1]);
+
+                int bestBase = -1, bestLength = 0, base = -1, length = 0;
+                for (int index = 0; index <= 8; ++index)
+                {
+                    if (index < 8 && words[index] == 0)
+                    {
+                        if (base < 0)
+                            base = index;
+                        length++;
+                    }
+                    else if (base >= 0)
+                    {
+                        if (length > bestLength)
+                        {
+                            bestBase = base;
+                            bestLength = length;
+                        }
+                        base = -1;
+                        length = 0;
+                    }
+                }
+                if (bestLength < 2)
+                    bestBase = -1;
+
+                for (int index = 0; index < 8; ++index)
+                {
+                    if (bestBase >= 0 && index >= bestBase && index < bestBase + bestLength)
+                    {
+                        if (index == bestBase)
+                            *out++ = ':';
+                        continue;
+                    }
+                    if (index != 0)
+                        *out++ = ':';
+                    if (index == 6 && bestBase == 0 &&
+                        (bestLength == 6 || (bestLength == 7 && words[7] != 0x0001) || (bestLength == 5 && words[5] == 0xffff)))
+                        return formatIPv4(bytes + 12, out);
+                    out = formatHex(words[index], out);
+                }
+                if (bestBase >= 0 && bestBase + bestLength == 8)
+                    *out++ = ':';
+                return out;
+            }
+        }
+
+        bool MacAddr::parse(const char* text, MacAddr& mac)
+        {
+            mac = MacAddr();
+            if (text == nullptr)
+                return false;
+            const size_t length = strlen(text);
+            const bool separated = (length == 17);
+            if (!separated && length != 12)
+                return false;
+
+            for (int index = 0; index < 6; ++index)
+            {
+                const char* digits = text + index * (separated ? 3 : 2);
+                int high = hexValue(digits[0]);
+                int low = hexValue(digits[1]);
+                if (high < 0 || low < 0 || (separated && index < 5 && digits[2] != ':'))
+                {
+                    mac = MacAddr();
+                    return false;
+                }
+                mac.bytes[index] = static_cast<uint8_t>((high << 4) | low);
+            }
+            mac.valid = true;
+            return true;
+        }
+
+        std::string MacAddr::toString() const
+        {
+            static const char digits[] = "0123456789abcdef";
+            if (!valid)
+                return std::string();
+            std::string text(17, ':');
+            for (int index = 0; index < 6; ++index)
+            {
+                text[index * 3] = digits[bytes[index] >> 4];
+                text[index * 3 + 1] = digits[bytes[index] & 0x0f];
+            }
+            return text;
+        }
+
+        IpAddr IpAddr::fromBytes(int family, const void* bytes)
+        {
+            IpAddr address;
+            if (bytes == nullptr || (family != AF_INET && family != AF_INET6))
+                return address;
+            address.m_family = static_cast<uint8_t>(family);
+            memcpy(address.m_bytes, bytes, (family == AF_INET6) ? 16 : 4);
+            return address;
+        }
+
+        bool IpAddr::parse(const char* text, int family, IpAddr& out)
+        {
+            out = IpAddr();
+            if (text == nullptr || (family != AF_INET && family != AF_INET6))
+                return false;
+            if (inet_pton(family, text, out.m_bytes) != 1)
+            {
+                out = IpAddr();
+                return false;
+            }
+            out.m_family = static_cast<uint8_t>(family);
+            return true;
+        }
+
+        bool IpAddr::parseAny(const char* text, IpAddr& out)
+        {
+            /* an IPv6 address always has a colon, an IPv4 one never */
+            return parse(text, (text && strchr(text, ':')) ? AF_INET6 : AF_INET, out);
+        }
+
+        const char* IpAddr::format(char* text, size_t size) const
+        {
+            char buffer[INET6_ADDRSTRLEN];
+            char* end = buffer;
+            if (m_family == AF_INET)
+                end = formatIPv4(m_bytes, buffer);
+            else if (m_family == AF_INET6)
+                end = formatIPv6(m_bytes, buffer);
+
+            size_t length = static_cast<size_t>(end - buffer);
+            if (size == 0)
+                return text;
+            if (length >= size)
+                length = 0;
+            memcpy(text, buffer, length);
+            text[length] = '\0';
+            return text;
+        }
+
+        std::string IpAddr::toString() const
+        {
+            char text[INET6_ADDRSTRLEN];
+            return format(text, sizeof(text));
+        }
+    } // Plugin
+} // WPEFramework
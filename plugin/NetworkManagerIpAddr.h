@@ -0,0 +1,177 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /* A hardware address, parsed once per interface rather than once per address checked */
+        struct MacAddr {
+            uint8_t bytes[6] = {};
+            bool valid{false};
+
+            /* Accepts "aa:bb:cc:dd:ee:ff" (either case) and "aabbccddeeff" */
+            static bool parse(const char* text, MacAddr& mac);
+            static bool parse(const std::string& text, MacAddr& mac) { return parse(text.c_str(), mac); }
+            std::string toString() const;
+
+            bool operator==(const MacAddr& other) const { return valid == other.valid && memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+            bool operator!=(const MacAddr& other) const { return !(*this == other); }
+        };
+
+        /*
+         * An IPv4 or IPv6 address in network byte order. Text is parsed once, where an address
+         * enters the plugin; classification, comparison and the EUI-64 check then work on the
+         * bytes, and text is produced again only for what is reported. IPv4 uses the first four
+         * bytes and the rest stay zero, so that equality and order can look at all sixteen.
+         */
+        class IpAddr
+        {
+        public:
+            constexpr IpAddr() = default;
+
+            static constexpr IpAddr v4(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+            {
+                IpAddr address;
+                address.m_family = AF_INET;
+                address.m_bytes[0] = a;
+                address.m_bytes[1] = b;
+                address.m_bytes[2] = c;
+                address.m_bytes[3] = d;
+                return address;
+            }
+
+            /* From eight 16-bit groups, as they are written */
+            static constexpr IpAddr v6(uint16_t g0, uint16_t g1, uint16_t g2, uint16_t g3,
+                                       uint16_t g4, uint16_t g5, uint16_t g6, uint16_t g7)
+            {
+                IpAddr address;
+                const uint16_t groups[8] = { g0, g1, g2, g3, g4, g5, g6, g7 };
+                address.m_family = AF_INET6;
+                for (int index = 0; index < 8; ++index)
+                {
+                    address.m_bytes[2 * index] = static_cast<uint8_t>(groups[index] >> 8);
+                    address.m_bytes[2 * index + 1] = static_cast<uint8_t>(groups[index] & 0xff);
+                }
+                return address;
+            }
+
+            /* bytes holds 4 (AF_INET) or 16 (AF_INET6) bytes in network order */
+            static IpAddr fromBytes(int family, const void* bytes);
+
+            /* false, and out left empty, if text is not an address of the family */
+            static bool parse(const char* text, int family, IpAddr& out);
+            static bool parse(const std::string& text, int family, IpAddr& out) { return parse(text.c_str(), family, out); }
+            /* Either family; for DNS servers, which need not match the configuration */
+            static bool parseAny(const char* text, IpAddr& out);
+            static bool parseAny(const std::string& text, IpAddr& out) { return parseAny(text.c_str(), out); }
+
+            constexpr int family() const { return m_family; }
+            constexpr bool empty() const { return m_family == 0; }
+            constexpr bool isIPv6() const { return m_family == AF_INET6; }
+            const uint8_t* bytes() const { return m_bytes; }
+            constexpr uint8_t byte(int index) const { return m_bytes[index]; }
+
+            /* true if the first length bits equal those of network */
+            constexpr bool inPrefix(const IpAddr& network, unsigned length) const
+            {
+                if (m_family != network.m_family || length > (isIPv6() ? 128u : 32u))
+                    return false;
+                unsigned index = 0;
+                for (; length >= 8; ++index, length -= 8)
+                {
+                    if (m_bytes[index] != network.m_bytes[index])
+                        return false;
+                }
+                const uint8_t mask = static_cast<uint8_t>(0xff00u >> length);
+                return length == 0 || ((m_bytes[index] ^ network.m_bytes[index]) & mask) == 0;
+            }
+
+            constexpr bool isIPv4LinkLocal() const { return inPrefix(v4(169, 254, 0, 0), 16); }
+            constexpr bool isIPv6LinkLocal() const { return inPrefix(v6(0xfe80, 0, 0, 0, 0, 0, 0, 0), 10); }
+            constexpr bool isIPv6ULA() const { return inPrefix(v6(0xfc00, 0, 0, 0, 0, 0, 0, 0), 7); }
+            constexpr bool isLinkLocal() const { return isIPv6() ? isIPv6LinkLocal() : isIPv4LinkLocal(); }
+
+            /* Modified EUI-64 interface identifier: mac[0..2] ff:fe mac[3..5], universal/local bit flipped */
+            constexpr bool isEui64Of(const MacAddr& mac) const
+            {
+                return isIPv6() && mac.valid &&
+                       m_bytes[8] == (mac.bytes[0] ^ 0x02) && m_bytes[9] == mac.bytes[1] &&
+                       m_bytes[10] == mac.bytes[2] && m_bytes[11] == 0xff && m_bytes[12] == 0xfe &&
+                       m_bytes[13] == mac.bytes[3] && m_bytes[14] == mac.bytes[4] && m_bytes[15] == mac.bytes[5];
+            }
+
+            /* The SLAAC address the MAC gives in a /64 */
+            static constexpr IpAddr eui64(const IpAddr& prefix, const MacAddr& mac)
+            {
+                IpAddr address = prefix;
+                address.m_bytes[8] = mac.bytes[0] ^ 0x02;
+                address.m_bytes[9] = mac.bytes[1];
+                address.m_bytes[10] = mac.bytes[2];
+                address.m_bytes[11] = 0xff;
+                address.m_bytes[12] = 0xfe;
+                address.m_bytes[13] = mac.bytes[3];
+                address.m_bytes[14] = mac.bytes[4];
+                address.m_bytes[15] = mac.bytes[5];
+                return address;
+            }
+
+            /* Canonical text (RFC 5952 for IPv6) into text, which holds INET6_ADDRSTRLEN; "" when empty */
+            const char* format(char* text, size_t size) const;
+            std::string toString() const;
+
+            constexpr bool operator==(const IpAddr& other) const
+            {
+                if (m_family != other.m_family)
+                    return false;
+                for (int index = 0; index < 16; ++index)
+                {
+                    if (m_bytes[index] != other.m_bytes[index])
+                        return false;
+                }
+                return true;
+            }
+            constexpr bool operator!=(const IpAddr& other) const { return !(*this == other); }
+            /* IPv4 before IPv6, then numeric order */
+            constexpr bool operator<(const IpAddr& other) const
+            {
+                if (m_family != other.m_family)
+                    return m_family < other.m_family;
+                for (int index = 0; index < 16; ++index)
+                {
+                    if (m_bytes[index] != other.m_bytes[index])
+                        return m_bytes[index] < other.m_bytes[index];
+                }
+                return false;
+            }
+
+        private:
+            uint8_t m_family{0};
+            uint8_t m_bytes[16] = {};
+        };
+    } // Plugin
+} // WPEFramework
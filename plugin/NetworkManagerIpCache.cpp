@@ -0,0 +1,152 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+
+#include "NetworkManagerIpCache.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        void IpFamilySnapshot::addAddress(const IpAddr& address, uint8_t prefix, const MacAddr& mac)
+        {
+            if (address.isLinkLocal())
+                linkLocalAddresses.emplace_back(address, prefix);
+            else if (address.isIPv6ULA())
+                uniqueLocalAddresses.emplace_back(address, prefix);
+            else
+                globalAddresses.emplace_back(address, prefix, address.isEui64Of(mac) ? ADDR_GLOBAL_MAC_BASED : ADDR_GLOBAL);
+        }
+
+        void IpFamilySnapshot::seal()
+        {
+            std::sort(globalAddresses.begin(), globalAddresses.end());
+            std::sort(linkLocalAddresses.begin(), linkLocalAddresses.end());
+            std::sort(uniqueLocalAddresses.begin(), uniqueLocalAddresses.end());
+
+            /* Prefer non-MAC-based global; fall back to MAC-based if all are MAC-based. */
+            preferredGlobal = globalAddresses.empty() ? -1 : 0;
+            for (size_t index = 0; index < globalAddresses.size(); ++index)
+            {
+                if (globalAddresses[index].type == ADDR_GLOBAL)
+                {
+                    preferredGlobal = static_cast<int>(index);
+                    break;
+                }
+            }
+        }
+
+        bool IpFamilySnapshot::sameContent(const IpFamilySnapshot& other) const
+        {
+            return valid == other.valid && autoconfig == other.autoconfig &&
+                   globalAddresses == other.globalAddresses &&
+                   linkLocalAddresses == other.linkLocalAddresses &&
+                   uniqueLocalAddresses == other.uniqueLocalAddresses &&
+                   gateway == other.gateway && primaryDns == other.primaryDns &&
+                   secondaryDns == other.secondaryDns && dhcpServer == other.dhcpServer;
+        }
+
+        bool IpFamilySnapshot::hasGlobal(const IpAddr& address) const
+        {
+            auto it = std::lower_bound(globalAddresses.begin(), globalAddresses.end(), address,
+                                       [](const CachedAddress& entry, const IpAddr& key) { return entry.address < key; });
+            return it != globalAddresses.end() && it->address == address;
+        }
+
+        void IpFamilySnapshot::diffGlobal(const IpFamilySnapshot& previous, std::vector<IpAddr>& acquired, std::vector<IpAddr>& lost) const
+        {
+            /* one merge pass over the two sorted lists */
+            auto mine = globalAddresses.begin();
+            auto theirs = previous.globalAddresses.begin();
+            while (mine != globalAddresses.end() || theirs != previous.globalAddresses.end())
+            {
+                if (theirs == previous.globalAddresses.end() || (mine != globalAddresses.end() && mine->address < theirs->address))
+                    acquired.push_back((mine++)->address);
+                else if (mine == globalAddresses.end() || theirs->address < mine->address)
+                    lost.push_back((theirs++)->address);
+                else
+                {
+                    ++mine;
+                    ++theirs;
+                }
+            }
+        }
+
+        IpCacheStore::IpCacheStore()
+        {
+            for (auto& slot : m_slots)
+                slot = std::make_shared<const IpFamilySnapshot>();
+        }
+
+        void IpCacheStore::setInterfaces(const std::string& ethernet, const std::string& wifi)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            m_ethernet = ethernet;
+            m_wifi = wifi;
+        }
+
+        bool IpCacheStore::slotFor(const std::string& interface, bool ipv6, Slot& slot) const
+        {
+            if (interface == m_ethernet)
+                slot = ipv6 ? SLOT_ETH_IPV6 : SLOT_ETH_IPV4;
+            else if (interface == m_wifi)
+                slot = ipv6 ? SLOT_WLAN_IPV6 : SLOT_WLAN_IPV4;
+            else
+                return false;
+            return true;
+        }
+
+        std::shared_ptr<const IpFamilySnapshot> IpCacheStore::load(Slot slot) const
+        {
+            return std::atomic_load_explicit(&m_slots[slot], std::memory_order_acquire);
+        }
+
+        std::shared_ptr<const IpFamilySnapshot> IpCacheStore::update(Slot slot, const Update& update,
+                                                                     std::shared_ptr<const IpFamilySnapshot>* current)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            std::shared_ptr<const IpFamilySnapshot> previous = m_slots[slot];
+            if (current)
+                *current = previous;
+            auto next = std::make_shared<IpFamilySnapshot>(*previous);
+            if (!update(*next))
+                return previous;
+            next->seal();
+            if (next->sameContent(*previous))
+                return previous;
+
+            next->version = ++m_version;
+            std::shared_ptr<const IpFamilySnapshot> published(std::move(next));
+            std::atomic_store_explicit(&m_slots[slot], published, std::memory_order_release);
+            if (current)
+                *current = std::move(published);
+            return previous;
+        }
+
+        std::shared_ptr<const IpFamilySnapshot> IpCacheStore::publish(Slot slot, const IpFamilySnapshot& snapshot,
+                                                                      std::shared_ptr<const IpFamilySnapshot>* current)
+        {
+            return update(slot, [&snapshot](IpFamilySnapshot& next) {
+                next = snapshot;
+                return true;
+            }, current);
+        }
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,137 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "NetworkManagerIpAddr.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /* Sub-classification of global-scope addresses in the IP cache. */
+        enum GlobalAddressType : uint8_t {
+            ADDR_GLOBAL,            // non-MAC-based global (preferred by GetIPSettings)
+            ADDR_GLOBAL_MAC_BASED,  // EUI-64 global derived from interface MAC (fallback)
+        };
+
+        /* An address of the cache with its prefix length; ordered by the address alone */
+        struct CachedAddress {
+            IpAddr address;
+            uint8_t prefix{0};
+            GlobalAddressType type{ADDR_GLOBAL};
+
+            CachedAddress() = default;
+            CachedAddress(const IpAddr& ip, uint8_t length = 0, GlobalAddressType kind = ADDR_GLOBAL)
+                : address(ip), prefix(length), type(kind) {}
+
+            bool empty() const { return address.empty(); }
+            bool operator==(const CachedAddress& other) const
+            {
+                return address == other.address && prefix == other.prefix && type == other.type;
+            }
+            bool operator!=(const CachedAddress& other) const { return !(*this == other); }
+            bool operator<(const CachedAddress& other) const { return address < other.address; }
+            std::string toString() const { return address.toString(); }
+        };
+
+        /* One published state of an interface and address family; never modified once published */
+        struct IpFamilySnapshot {
+            uint64_t version{0};                // IpCacheStore version that published it
+            bool valid{false};
+            bool autoconfig{false};
+            std::vector<CachedAddress> globalAddresses;         // sorted; event-diffable
+            std::vector<CachedAddress> linkLocalAddresses;      // sorted; not diffed for events
+            std::vector<CachedAddress> uniqueLocalAddresses;    // sorted; not diffed for events
+            IpAddr gateway;
+            IpAddr primaryDns;
+            IpAddr secondaryDns;
+            IpAddr dhcpServer;
+            int preferredGlobal{-1};            // index of the address GetIPSettings reports, -1 if none
+
+            /* Files address as link-local, unique local or global; a global one derived from mac is MAC-based */
+            void addAddress(const IpAddr& address, uint8_t prefix, const MacAddr& mac);
+            /* Sorts the address lists and picks the preferred global address */
+            void seal();
+            bool sameContent(const IpFamilySnapshot& other) const;
+            bool hasGlobal(const IpAddr& address) const;
+            /* Global addresses found here but not in previous, and the other way round; both lists come out sorted */
+            void diffGlobal(const IpFamilySnapshot& previous, std::vector<IpAddr>& acquired, std::vector<IpAddr>& lost) const;
+        };
+
+        /*
+         * The IP cache: one immutable snapshot per interface and family, published through
+         * std::atomic_load/atomic_store on a shared pointer. That is not lock-free: libstdc++
+         * guards it with a small pool of mutexes picked by address, held only while the pointer
+         * is copied and its count bumped. Readers never wait for a writer's copy and modify,
+         * nor allocate; writers copy, modify and publish under one writer lock. The
+         * store version grows only when a publish changes something, and each snapshot
+         * carries the version it was published with, so comparing versions is enough to
+         * tell whether a slot moved.
+         */
+        class IpCacheStore
+        {
+        public:
+            enum Slot : uint8_t {
+                SLOT_ETH_IPV4,
+                SLOT_ETH_IPV6,
+                SLOT_WLAN_IPV4,
+                SLOT_WLAN_IPV6,
+                SLOT_COUNT
+            };
+
+            /* Returns false to leave the slot as it is */
+            using Update = std::function<bool(IpFamilySnapshot& snapshot)>;
+
+            IpCacheStore();
+            IpCacheStore(const IpCacheStore&) = delete;
+            IpCacheStore& operator=(const IpCacheStore&) = delete;
+
+            /* Names of the Ethernet and Wi-Fi interfaces; set before the first publish */
+            void setInterfaces(const std::string& ethernet, const std::string& wifi);
+            bool slotFor(const std::string& interface, bool ipv6, Slot& slot) const;
+            const std::string& interfaceOf(Slot slot) const { return (slot < SLOT_WLAN_IPV4) ? m_ethernet : m_wifi; }
+            static bool isIPv6(Slot slot) { return slot == SLOT_ETH_IPV6 || slot == SLOT_WLAN_IPV6; }
+
+            std::shared_ptr<const IpFamilySnapshot> load(Slot slot) const;
+            /*
+             * Runs update on a copy of the slot and publishes the result. Returns the snapshot it
+             * replaced; current, when given, receives the one in the slot afterwards.
+             */
+            std::shared_ptr<const IpFamilySnapshot> update(Slot slot, const Update& update,
+                                                           std::shared_ptr<const IpFamilySnapshot>* current = nullptr);
+            std::shared_ptr<const IpFamilySnapshot> publish(Slot slot, const IpFamilySnapshot& snapshot,
+                                                            std::shared_ptr<const IpFamilySnapshot>* current = nullptr);
+
+        private:
+            std::shared_ptr<const IpFamilySnapshot> m_slots[SLOT_COUNT];
+            std::mutex m_writeLock;
+            uint64_t m_version{0};              // guarded by m_writeLock
+            std::string m_ethernet{"eth0"};
+            std::string m_wifi{"wlan0"};
+        };
+    } // Plugin
+} // WPEFramework
@@ -103,4 +103,11 @@ ENUM_CONVERSION_BEGIN(Exchange::INetworkManager::WIFIFrequency)
     { Exchange::INetworkManager::WIFIFrequency::WIFI_FREQUENCY_6_GHZ, _TXT("6") },
 ENUM_CONVERSION_END(Exchange::INetworkManager::WIFIFrequency)
 
+ENUM_CONVERSION_BEGIN(Exchange::INetworkManager::OperationStatus)
+    { Exchange::INetworkManager::OperationStatus::OPERATION_COMPLETED, _TXT("COMPLETED") },
+    { Exchange::INetworkManager::OperationStatus::OPERATION_TIMEDOUT, _TXT("TIMEDOUT") },
+    { Exchange::INetworkManager::OperationStatus::OPERATION_CANCELLED, _TXT("CANCELLED") },
+    { Exchange::INetworkManager::OperationStatus::OPERATION_SUPERSEDED, _TXT("SUPERSEDED") },
+ENUM_CONVERSION_END(Exchange::INetworkManager::OperationStatus)
+
 }
@@ -67,6 +67,7 @@ namespace WPEFramework
             Register("IsConnectedToInternet",             &NetworkManager::IsConnectedToInternet, this);
             Register("GetCaptivePortalURI",               &NetworkManager::GetCaptivePortalURI, this);
             Register("GetPublicIP",                       &NetworkManager::GetPublicIP, this);
+            Register("GetDualStackPublicIP",              &NetworkManager::GetDualStackPublicIP, this);
             Register("Ping",                              &NetworkManager::Ping, this);
             Register("Trace",                             &NetworkManager::Trace, this);
             Register("SetHostname",                       &NetworkManager::SetHostname, this);
@@ -84,6 +85,9 @@ namespace WPEFramework
             Register("GetWifiState",                      &NetworkManager::GetWifiState, this);
             Register("GetWiFiSignalQuality",              &NetworkManager::GetWiFiSignalQuality, this);
             Register("GetSupportedSecurityModes",         &NetworkManager::GetSupportedSecurityModes, this);
+            Register("CancelOperation",                   &NetworkManager::CancelOperation, this);
+            Register("GetOperationStatistics",            &NetworkManager::GetOperationStatistics, this);
+            Register("GetConnectivityMonitorStatistics",  &NetworkManager::GetConnectivityMonitorStatistics, this);
         }
 
         /**
@@ -105,6 +109,7 @@ namespace WPEFramework
             Unregister("IsConnectedToInternet");
             Unregister("GetCaptivePortalURI");
             Unregister("GetPublicIP");
+            Unregister("GetDualStackPublicIP");
             Unregister("Ping");
             Unregister("Trace");
             Unregister("SetHostname");
@@ -122,6 +127,9 @@ namespace WPEFramework
             Unregister("GetWifiState");
             Unregister("GetWiFiSignalQuality");
             Unregister("GetSupportedSecurityModes");
+            Unregister("CancelOperation");
+            Unregister("GetOperationStatistics");
+            Unregister("GetConnectivityMonitorStatistics");
         }
 
         uint32_t NetworkManager::SetLogLevel (const JsonObject& parameters, JsonObject& response)
@@ -157,6 +165,18 @@ namespace WPEFramework
             returnJson(rc);
         }
 
+        /* "async": true runs a mutating call in the background; its result comes as onOperationComplete */
+        static inline bool isAsyncRequest(const JsonObject& parameters)
+        {
+            return parameters.HasLabel("async") && parameters["async"].Boolean();
+        }
+
+        /* deadline of a background call in milliseconds; 0 selects the default */
+        static inline uint32_t asyncTimeout(const JsonObject& parameters)
+        {
+            return parameters.HasLabel("timeout") ? static_cast<uint32_t>(parameters["timeout"].Number()) : 0;
+        }
+
         uint32_t NetworkManager::GetAvailableInterfaces (const JsonObject& parameters, JsonObject& response)
         {
             LOG_INPARAM();
@@ -225,10 +245,17 @@ namespace WPEFramework
 
                 if ("wlan0" != interface && "eth0" != interface)
                     rc = Core::ERROR_BAD_REQUEST;
-                else if (_networkManager)
-                    rc = _networkManager->SetInterfaceState(interface, enabled);
-                else
+                else if (!_networkManager)
                     rc = Core::ERROR_UNAVAILABLE;
+                else if (isAsyncRequest(parameters))
+                {
+                    uint32_t operationId = 0;
+                    rc = _networkManager->SetInterfaceStateAsync(interface, enabled, asyncTimeout(parameters), operationId);
+                    if (Core::ERROR_NONE == rc)
+                        response["operationId"] = operationId;
+                }
+                else
+                    rc = _networkManager->SetInterfaceState(interface, enabled);
             }
             else
                 rc = Core::ERROR_BAD_REQUEST;
@@ -326,10 +353,17 @@ namespace WPEFramework
                     address.secondarydns   = parameters["secondarydns"].String();
                 }
 
-                if (_networkManager)
-                    rc = _networkManager->SetIPSettings(interface, address);
-                else
+                if (!_networkManager)
                     rc = Core::ERROR_UNAVAILABLE;
+                else if (isAsyncRequest(parameters))
+                {
+                    uint32_t operationId = 0;
+                    rc = _networkManager->SetIPSettingsAsync(interface, address, asyncTimeout(parameters), operationId);
+                    if (Core::ERROR_NONE == rc)
+                        response["operationId"] = operationId;
+                }
+                else
+                    rc = _networkManager->SetIPSettings(interface, address);
             }
             returnJson(rc);
         }
@@ -524,6 +558,38 @@ namespace WPEFramework
             returnJson(rc);
         }
 
+        uint32_t NetworkManager::GetDualStackPublicIP(const JsonObject& parameters, JsonObject& response)
+        {
+            LOG_INPARAM();
+            uint32_t rc = Core::ERROR_GENERAL;
+            string interface{};
+            string ipv4address{};
+            string ipv6address{};
+
+            if (parameters.HasLabel("interface"))
+                interface = parameters["interface"].String();
+
+            if (_networkManager)
+                rc = _networkManager->GetDualStackPublicIP(interface, ipv4address, ipv6address);
+            else
+                rc = Core::ERROR_UNAVAILABLE;
+
+            if (Core::ERROR_NONE == rc)
+            {
+                response["interface"] = interface;
+                response["ipv4address"] = ipv4address;
+                response["ipv6address"] = ipv6address;
+
+                m_publicIPAddress = ipv4address.empty() ? ipv6address : ipv4address;
+                m_publicIPAddressType = ipv4address.empty() ? "IPv6" : "IPv4";
+                if (!m_publicIPAddress.empty())
+                {
+                    PublishToThunderAboutInternet();
+                }
+            }
+            returnJson(rc);
+        }
+
         void NetworkManager::PublishToThunderAboutInternet()
         {
             PluginHost::ISubSystem* subSystem = _service->SubSystems();
@@ -815,11 +881,17 @@ namespace WPEFramework
                 NMLOG_WARNING("ssid not provided or empty in ConnectToKnownSSID request!");
                 rc = Core::ERROR_BAD_REQUEST;
             }
-            else if (_networkManager) {
-                rc = _networkManager->ConnectToKnownSSID(ssid);
+            else if (!_networkManager) {
+                rc = Core::ERROR_UNAVAILABLE;
+            }
+            else if (isAsyncRequest(parameters)) {
+                uint32_t operationId = 0;
+                rc = _networkManager->ConnectToKnownSSIDAsync(ssid, asyncTimeout(parameters), operationId);
+                if (Core::ERROR_NONE == rc)
+                    response["operationId"] = operationId;
             }
             else {
-                rc = Core::ERROR_UNAVAILABLE;
+                rc = _networkManager->ConnectToKnownSSID(ssid);
             }
 
             returnJson(rc);
@@ -875,10 +947,17 @@ namespace WPEFramework
             else
                 NMLOG_WARNING("ssid not included in wifi connect request !");
 
-            if (_networkManager)
-                rc = _networkManager->WiFiConnect(ssid);
-            else
+            if (!_networkManager)
                 rc = Core::ERROR_UNAVAILABLE;
+            else if (isAsyncRequest(parameters))
+            {
+                uint32_t operationId = 0;
+                rc = _networkManager->WiFiConnectAsync(ssid, asyncTimeout(parameters), operationId);
+                if (Core::ERROR_NONE == rc)
+                    response["operationId"] = operationId;
+            }
+            else
+                rc = _networkManager->WiFiConnect(ssid);
 
             returnJson(rc);
         }
@@ -940,10 +1019,17 @@ namespace WPEFramework
                 }
             }
 
-            if (_networkManager)
-                rc = _networkManager->StartWPS(method, wps_pin);
-            else
+            if (!_networkManager)
                 rc = Core::ERROR_UNAVAILABLE;
+            else if (isAsyncRequest(parameters))
+            {
+                uint32_t operationId = 0;
+                rc = _networkManager->StartWPSAsync(method, wps_pin, asyncTimeout(parameters), operationId);
+                if (Core::ERROR_NONE == rc)
+                    response["operationId"] = operationId;
+            }
+            else
+                rc = _networkManager->StartWPS(method, wps_pin);
 
             returnJson(rc);
         }
@@ -1037,6 +1123,61 @@ namespace WPEFramework
             returnJson(rc);
         }
 
+        uint32_t NetworkManager::CancelOperation(const JsonObject& parameters, JsonObject& response)
+        {
+            LOG_INPARAM();
+            uint32_t rc = Core::ERROR_GENERAL;
+
+            if (!parameters.HasLabel("operationId"))
+                rc = Core::ERROR_BAD_REQUEST;
+            else if (_networkManager)
+                rc = _networkManager->CancelOperation(static_cast<uint32_t>(parameters["operationId"].Number()));
+            else
+                rc = Core::ERROR_UNAVAILABLE;
+
+            returnJson(rc);
+        }
+
+        uint32_t NetworkManager::GetOperationStatistics(const JsonObject& parameters, JsonObject& response)
+        {
+            LOG_INPARAM();
+            uint32_t rc = Core::ERROR_GENERAL;
+            string statistics{};
+
+            if (_networkManager)
+                rc = _networkManager->GetOperationStatistics(statistics);
+            else
+                rc = Core::ERROR_UNAVAILABLE;
+
+            if (Core::ERROR_NONE == rc)
+            {
+                JsonObject operations;
+                operations.FromString(statistics);
+                response["operations"] = operations;
+            }
+            returnJson(rc);
+        }
+
+        uint32_t NetworkManager::GetConnectivityMonitorStatistics(const JsonObject& parameters, JsonObject& response)
+        {
+            LOG_INPARAM();
+            uint32_t rc = Core::ERROR_GENERAL;
+            string statistics{};
+
+            if (_networkManager)
+                rc = _networkManager->GetConnectivityMonitorStatistics(statistics);
+            else
+                rc = Core::ERROR_UNAVAILABLE;
+
+            if (Core::ERROR_NONE == rc)
+            {
+                JsonObject connectivity;
+                connectivity.FromString(statistics);
+                response["connectivity"] = connectivity;
+            }
+            returnJson(rc);
+        }
+
         void NetworkManager::onInterfaceStateChange(const Exchange::INetworkManager::InterfaceState state, const string interface)
         {
             Core::JSON::EnumType<Exchange::INetworkManager::InterfaceState> iState{state};
@@ -1072,6 +1213,20 @@ namespace WPEFramework
             Notify(_T("onIPAddressChange"), parameters);
         }
 
+        void NetworkManager::onIPAddressesChanged(const string interface, const string ipversion, const string jsonOfChanges)
+        {
+            JsonObject changes;
+            changes.FromString(jsonOfChanges);
+            JsonObject parameters;
+            parameters["interface"] = interface;
+            parameters["ipversion"] = ipversion;
+            parameters["acquired"] = changes["acquired"];
+            parameters["lost"] = changes["lost"];
+
+            LOG_INPARAM();
+            Notify(_T("onIPAddressesChanged"), parameters);
+        }
+
         void NetworkManager::onInternetStatusChange(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface)
         {
             JsonObject parameters;
@@ -1094,6 +1249,22 @@ namespace WPEFramework
             }
         }
 
+        void NetworkManager::onInternetStatusChangeByFamily(const Exchange::INetworkManager::InternetStatus prevState, const Exchange::INetworkManager::InternetStatus currState, const string interface, const string ipversion)
+        {
+            JsonObject parameters;
+            Core::JSON::EnumType<Exchange::INetworkManager::InternetStatus> prevStatus(prevState);
+            Core::JSON::EnumType<Exchange::INetworkManager::InternetStatus> currStatus(currState);
+            parameters["prevState"] = JsonValue(prevState);
+            parameters["prevStatus"] = prevStatus.Data();
+            parameters["state"] = JsonValue(currState);
+            parameters["status"] = currStatus.Data();
+            parameters["interface"] = interface;
+            parameters["ipversion"] = ipversion;
+
+            LOG_INPARAM();
+            Notify(_T("onInternetStatusChangeByFamily"), parameters);
+        }
+
         void NetworkManager::onAvailableSSIDs(const string jsonOfScanResults)
         {
             JsonObject parameters;
@@ -1105,6 +1276,15 @@ namespace WPEFramework
             Notify(_T("onAvailableSSIDs"), parameters);
         }
 
+        void NetworkManager::onAvailableSSIDsDelta(const string jsonOfScanDelta)
+        {
+            JsonObject parameters;
+            parameters.FromString(jsonOfScanDelta);
+
+            NMLOG_INFO("Event with scan delta %s", jsonOfScanDelta.c_str());
+            Notify(_T("onAvailableSSIDsDelta"), parameters);
+        }
+
         void NetworkManager::onWiFiStateChange(const Exchange::INetworkManager::WiFiState state)
         {
             JsonObject parameters;
@@ -1129,5 +1309,20 @@ namespace WPEFramework
             LOG_INPARAM();
             Notify(_T("onWiFiSignalQualityChange"), parameters);
         }
+
+        void NetworkManager::onOperationComplete(const uint32_t operationId, const string operation, const Exchange::INetworkManager::OperationStatus status, const uint32_t result, const uint32_t latency)
+        {
+            Core::JSON::EnumType<Exchange::INetworkManager::OperationStatus> iStatus(status);
+            JsonObject parameters;
+            parameters["operationId"] = operationId;
+            parameters["operation"]   = operation;
+            parameters["status"]      = iStatus.Data();
+            parameters["success"]     = (status == Exchange::INetworkManager::OPERATION_COMPLETED && result == Core::ERROR_NONE);
+            parameters["result"]      = result;
+            parameters["latency"]     = latency;
+
+            LOG_INPARAM();
+            Notify(_T("onOperationComplete"), parameters);
+        }
     }
 }
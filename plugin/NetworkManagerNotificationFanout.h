@@ -0,0 +1,285 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#define NM_NOTIFICATION_WORKERS             2
+#define NM_NOTIFICATION_LANE_LIMIT          32
+#define NM_NOTIFICATION_BATCH               4      // callbacks per lane before yielding the worker
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Fans events out to the registered subscribers through one bounded lane per
+         * subscriber. Lanes are drained by a small worker pool; a lane is served by at
+         * most one worker at a time, so each subscriber still sees its events in order,
+         * but a slow subscriber only delays itself. A subscriber whose lane overflows is
+         * dropped and reported through the slow subscriber handler.
+         */
+        template <typename Subscriber>
+        class NotificationFanout
+        {
+        public:
+            using Delivery = std::function<void(Subscriber*)>;
+
+            struct Hooks {
+                std::function<void(Subscriber*)> addRef;
+                std::function<void(Subscriber*)> release;
+                std::function<void(Subscriber*)> slowSubscriber;    /* invoked after the lane was dropped */
+            };
+
+            struct LaneStats {
+                Subscriber* subscriber;
+                size_t depth;
+                uint64_t delivered;
+                uint64_t lastCallbackUs;
+                uint64_t maxCallbackUs;
+                uint64_t totalCallbackUs;
+                uint64_t maxQueueWaitUs;
+            };
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Item {
+                std::shared_ptr<const Delivery> delivery;
+                Clock::time_point queued;
+            };
+
+            struct Lane {
+                Subscriber* subscriber;
+                std::deque<Item> items;
+                bool scheduled;
+                bool removed;
+                LaneStats stats;
+            };
+
+        public:
+            NotificationFanout(const Hooks& hooks, size_t workers = NM_NOTIFICATION_WORKERS, size_t laneLimit = NM_NOTIFICATION_LANE_LIMIT)
+                : m_hooks(hooks)
+                , m_workerCount(workers > 0 ? workers : 1)
+                , m_laneLimit(laneLimit > 0 ? laneLimit : 1)
+            {
+            }
+
+            ~NotificationFanout()
+            {
+                stop();
+            }
+
+            NotificationFanout(const NotificationFanout&) = delete;
+            NotificationFanout& operator=(const NotificationFanout&) = delete;
+
+            void start()
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (!m_workers.empty())
+                    return;
+                m_stop = false;
+                for (size_t i = 0; i < m_workerCount; i++)
+                    m_workers.emplace_back(&NotificationFanout::worker, this);
+            }
+
+            /* Joins the workers; undelivered events are discarded and every lane is released */
+            void stop()
+            {
+                std::vector<std::thread> workers;
+                std::vector<std::shared_ptr<Lane>> lanes;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    m_stop = true;
+                    workers.swap(m_workers);
+                    lanes.swap(m_lanes);
+                    m_ready.clear();
+                }
+                m_cond.notify_all();
+                for (auto& worker : workers)
+                {
+                    if (worker.joinable())
+                        worker.join();
+                }
+                for (auto& lane : lanes)
+                    m_hooks.release(lane->subscriber);
+            }
+
+            void addSubscriber(Subscriber* subscriber)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (findLane(subscriber) != m_lanes.end())
+                    return;
+                auto lane = std::make_shared<Lane>();
+                lane->subscriber = subscriber;
+                lane->scheduled = false;
+                lane->removed = false;
+                lane->stats = LaneStats{subscriber, 0, 0, 0, 0, 0, 0};
+                m_hooks.addRef(subscriber);
+                m_lanes.push_back(lane);
+            }
+
+            void removeSubscriber(Subscriber* subscriber)
+            {
+                std::shared_ptr<Lane> lane = detachLane(subscriber);
+                /* a worker in the middle of a callback keeps its own reference to the lane */
+                if (lane)
+                    releaseLane(lane);
+            }
+
+            void publish(std::shared_ptr<const Delivery> delivery)
+            {
+                std::vector<std::shared_ptr<Lane>> overflowed;
+                const auto now = Clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    for (auto& lane : m_lanes)
+                    {
+                        if (lane->items.size() >= m_laneLimit)
+                        {
+                            overflowed.push_back(lane);
+                            continue;
+                        }
+                        lane->items.push_back(Item{delivery, now});
+                        if (!lane->scheduled)
+                        {
+                            lane->scheduled = true;
+                            m_ready.push_back(lane);
+                        }
+                    }
+                    for (auto& lane : overflowed)
+                    {
+                        lane->removed = true;
+                        lane->items.clear();
+                        m_lanes.erase(std::find(m_lanes.begin(), m_lanes.end(), lane));
+                    }
+                }
+                m_cond.notify_all();
+
+                for (auto& lane : overflowed)
+                {
+                    if (m_hooks.slowSubscriber)
+                        m_hooks.slowSubscriber(lane->subscriber);
+                    releaseLane(lane);
+                }
+            }
+
+            std::vector<LaneStats> stats() const
+            {
+                std::vector<LaneStats> result;
+                std::lock_guard<std::mutex> lock(m_lock);
+                for (const auto& lane : m_lanes)
+                {
+                    LaneStats laneStats = lane->stats;
+                    laneStats.depth = lane->items.size();
+                    result.push_back(laneStats);
+                }
+                return result;
+            }
+
+        private:
+            typename std::vector<std::shared_ptr<Lane>>::iterator findLane(Subscriber* subscriber)
+            {
+                return std::find_if(m_lanes.begin(), m_lanes.end(),
+                                    [subscriber](const std::shared_ptr<Lane>& lane) { return lane->subscriber == subscriber; });
+            }
+
+            std::shared_ptr<Lane> detachLane(Subscriber* subscriber)
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto it = findLane(subscriber);
+                if (it == m_lanes.end())
+                    return nullptr;
+                std::shared_ptr<Lane> lane = *it;
+                lane->removed = true;
+                lane->items.clear();
+                m_lanes.erase(it);
+                return lane;
+            }
+
+            void releaseLane(const std::shared_ptr<Lane>& lane)
+            {
+                m_hooks.release(lane->subscriber);
+            }
+
+            void worker()
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                while (true)
+                {
+                    m_cond.wait(lock, [this]() { return m_stop || !m_ready.empty(); });
+                    if (m_stop)
+                        break;
+
+                    std::shared_ptr<Lane> lane = m_ready.front();
+                    m_ready.pop_front();
+
+                    for (size_t served = 0; served < NM_NOTIFICATION_BATCH && !lane->removed && !lane->items.empty() && !m_stop; served++)
+                    {
+                        Item item = std::move(lane->items.front());
+                        lane->items.pop_front();
+
+                        /* the lane reference held by m_lanes can go away during the callback */
+                        m_hooks.addRef(lane->subscriber);
+                        lock.unlock();
+                        const auto started = Clock::now();
+                        (*item.delivery)(lane->subscriber);
+                        const auto finished = Clock::now();
+                        m_hooks.release(lane->subscriber);
+                        lock.lock();
+
+                        uint64_t waitUs = std::chrono::duration_cast<std::chrono::microseconds>(started - item.queued).count();
+                        uint64_t callbackUs = std::chrono::duration_cast<std::chrono::microseconds>(finished - started).count();
+                        lane->stats.delivered++;
+                        lane->stats.lastCallbackUs = callbackUs;
+                        lane->stats.totalCallbackUs += callbackUs;
+                        lane->stats.maxCallbackUs = std::max(lane->stats.maxCallbackUs, callbackUs);
+                        lane->stats.maxQueueWaitUs = std::max(lane->stats.maxQueueWaitUs, waitUs);
+                    }
+
+                    if (!lane->removed && !lane->items.empty() && !m_stop)
+                        m_ready.push_back(lane);    /* more pending; give the other lanes a turn first */
+                    else
+                        lane->scheduled = false;
+                }
+            }
+
+        private:
+            Hooks m_hooks;
+            size_t m_workerCount;
+            size_t m_laneLimit;
+            mutable std::mutex m_lock;
+            std::condition_variable m_cond;
+            std::vector<std::shared_ptr<Lane>> m_lanes;
+            std::deque<std::shared_ptr<Lane>> m_ready;
+            std::vector<std::thread> m_workers;
+            bool m_stop{false};
+        };
+    } // Plugin
+} // WPEFramework
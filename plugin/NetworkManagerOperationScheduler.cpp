@@ -0,0 +1,388 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+
+#include "NetworkManagerOperationScheduler.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        static const uint32_t s_latencyBounds[NM_OPERATION_LATENCY_BUCKETS] = { 100, 250, 500, 1000, 2500, 5000, 10000, 30000, 60000, 0 };
+        static const char* s_outcomeNames[] = { "completed", "timedout", "cancelled", "superseded" };
+
+        const uint32_t* OperationScheduler::latencyBounds()
+        {
+            return s_latencyBounds;
+        }
+
+        const char* OperationScheduler::outcomeName(Outcome outcome)
+        {
+            return outcome <= OUTCOME_SUPERSEDED ? s_outcomeNames[outcome] : "unknown";
+        }
+
+        OperationScheduler::OperationScheduler(const CompletionHandler& handler, size_t workers, size_t limit)
+            : m_handler(handler)
+            , m_workerCount(workers > 0 ? workers : 1)
+            , m_limit(limit > 0 ? limit : 1)
+        {
+        }
+
+        OperationScheduler::~OperationScheduler()
+        {
+            stop();
+        }
+
+        void OperationScheduler::start()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_workers.empty())
+                return;
+            m_stop = false;
+            for (size_t i = 0; i < m_workerCount; i++)
+                m_workers.emplace_back(&OperationScheduler::worker, this);
+            m_watchdog = std::thread(&OperationScheduler::watchdog, this);
+        }
+
+        void OperationScheduler::stop()
+        {
+            std::vector<std::thread> workers;
+            std::thread watchdog;
+            std::vector<Completion> cancelled;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_stop = true;
+                workers.swap(m_workers);
+                watchdog.swap(m_watchdog);
+                for (auto it = m_operations.begin(); it != m_operations.end();)
+                {
+                    if ((*it)->running)
+                    {
+                        ++it;
+                        continue;
+                    }
+                    Completion completion;
+                    if (reportLocked(**it, OUTCOME_CANCELLED, 0, completion))
+                        cancelled.push_back(std::move(completion));
+                    it = m_operations.erase(it);
+                }
+            }
+            m_cond.notify_all();
+            m_watchCond.notify_all();
+
+            if (!cancelled.empty())
+                NMLOG_INFO("cancelling %zu queued operations", cancelled.size());
+            for (const auto& completion : cancelled)
+                m_handler(completion);
+
+            for (auto& worker : workers)
+            {
+                if (worker.joinable())
+                    worker.join();
+            }
+            if (watchdog.joinable())
+                watchdog.join();
+        }
+
+        void OperationScheduler::setLimit(size_t limit)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_limit = limit > 0 ? limit : 1;
+        }
+
+        size_t OperationScheduler::limit() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_limit;
+        }
+
+        size_t OperationScheduler::inFlight() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_operations.size();
+        }
+
+        OperationScheduler::Admission OperationScheduler::submit(Request&& request, uint32_t& id)
+        {
+            std::vector<Completion> superseded;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (m_stop)
+                    return ADMIT_STOPPED;
+
+                size_t supersedable = 0;
+                for (const auto& operation : m_operations)
+                {
+                    if (operation->reported)
+                        continue;
+                    if (operation->request.key == request.key)
+                    {
+                        id = operation->id;
+                        NMLOG_INFO("%s joins pending operation %u", request.kind.c_str(), id);
+                        return ADMIT_DUPLICATE;
+                    }
+                    if (!request.group.empty() && !operation->running && operation->request.group == request.group)
+                        supersedable++;
+                }
+
+                if (m_operations.size() - supersedable >= m_limit)
+                {
+                    NMLOG_WARNING("%s refused; %zu operations in flight", request.kind.c_str(), m_operations.size());
+                    return ADMIT_FULL;
+                }
+
+                if (supersedable > 0)
+                {
+                    for (auto it = m_operations.begin(); it != m_operations.end();)
+                    {
+                        Operation& operation = **it;
+                        if (!operation.running && !operation.reported && operation.request.group == request.group)
+                        {
+                            Completion completion;
+                            reportLocked(operation, OUTCOME_SUPERSEDED, 0, completion);
+                            superseded.push_back(std::move(completion));
+                            it = m_operations.erase(it);
+                        }
+                        else
+                            ++it;
+                    }
+                }
+
+                if (++m_nextId == 0)
+                    m_nextId = 1;
+                auto operation = std::make_shared<Operation>();
+                operation->id = m_nextId;
+                operation->submitted = Clock::now();
+                operation->deadline = operation->submitted + std::chrono::milliseconds(request.timeoutMs > 0 ? request.timeoutMs : NM_OPERATION_DEFAULT_TIMEOUT_MS);
+                operation->running = false;
+                operation->reported = false;
+                operation->request = std::move(request);
+                m_operations.push_back(operation);
+                id = operation->id;
+                NMLOG_INFO("operation %u %s queued (%zu in flight)", id, operation->request.kind.c_str(), m_operations.size());
+            }
+            m_cond.notify_all();
+            m_watchCond.notify_one();
+
+            for (const auto& completion : superseded)
+            {
+                NMLOG_INFO("operation %u %s superseded by %u", completion.id, completion.kind.c_str(), id);
+                m_handler(completion);
+            }
+            return ADMIT_QUEUED;
+        }
+
+        bool OperationScheduler::cancel(uint32_t id)
+        {
+            Completion completion;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                auto it = std::find_if(m_operations.begin(), m_operations.end(), [id](const OperationPtr& operation) { return operation->id == id; });
+                if (it == m_operations.end() || !reportLocked(**it, OUTCOME_CANCELLED, 0, completion))
+                    return false;
+                /* a running backend call cannot be stopped; its result is dropped when it returns */
+                if (!(*it)->running)
+                    m_operations.erase(it);
+            }
+            NMLOG_INFO("operation %u %s cancelled", completion.id, completion.kind.c_str());
+            m_handler(completion);
+            return true;
+        }
+
+        bool OperationScheduler::reportLocked(Operation& operation, Outcome outcome, uint32_t result, Completion& completion)
+        {
+            if (operation.reported)
+                return false;
+            operation.reported = true;
+
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - operation.submitted).count();
+            completion.id = operation.id;
+            completion.kind = operation.request.kind;
+            completion.outcome = outcome;
+            completion.result = result;
+            completion.latencyMs = static_cast<uint32_t>(std::max<int64_t>(elapsed, 0));
+
+            auto entry = m_stats.find(operation.request.kind);
+            if (entry == m_stats.end())
+            {
+                KindStats kindStats{};
+                kindStats.kind = operation.request.kind;
+                entry = m_stats.emplace(operation.request.kind, kindStats).first;
+            }
+            KindStats& kindStats = entry->second;
+            kindStats.outcomes[outcome]++;
+            size_t bucket = 0;
+            while (bucket < NM_OPERATION_LATENCY_BUCKETS - 1 && completion.latencyMs > s_latencyBounds[bucket])
+                bucket++;
+            kindStats.buckets[bucket]++;
+            kindStats.maxLatencyMs = std::max(kindStats.maxLatencyMs, completion.latencyMs);
+            return true;
+        }
+
+        void OperationScheduler::eraseLocked(uint32_t id)
+        {
+            auto it = std::find_if(m_operations.begin(), m_operations.end(), [id](const OperationPtr& operation) { return operation->id == id; });
+            if (it != m_operations.end())
+                m_operations.erase(it);
+        }
+
+        OperationScheduler::OperationPtr OperationScheduler::nextRunnableLocked()
+        {
+            /* the first queued operation of a lane is the one to run next on that lane */
+            for (const auto& operation : m_operations)
+            {
+                if (!operation->running && m_busyLanes.find(operation->request.lane) == m_busyLanes.end())
+                    return operation;
+            }
+            return nullptr;
+        }
+
+        void OperationScheduler::worker()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            while (true)
+            {
+                OperationPtr operation;
+                m_cond.wait(lock, [this, &operation]() {
+                    if (m_stop)
+                        return true;
+                    operation = nextRunnableLocked();
+                    return operation != nullptr;
+                });
+                if (m_stop)
+                    return;
+
+                operation->running = true;
+                m_busyLanes[operation->request.lane] = operation->id;
+                lock.unlock();
+
+                NMLOG_DEBUG("operation %u %s started", operation->id, operation->request.kind.c_str());
+                uint32_t result = operation->request.run();
+
+                lock.lock();
+                m_busyLanes.erase(operation->request.lane);
+                eraseLocked(operation->id);
+                Completion completion;
+                bool report = reportLocked(*operation, OUTCOME_COMPLETED, result, completion);
+                lock.unlock();
+
+                if (report)
+                {
+                    NMLOG_INFO("operation %u %s completed in %u ms, result %u", completion.id, completion.kind.c_str(), completion.latencyMs, result);
+                    m_handler(completion);
+                }
+                else
+                    NMLOG_WARNING("operation %u %s returned %u after it was reported; result dropped", operation->id, operation->request.kind.c_str(), result);
+
+                m_cond.notify_all();
+                lock.lock();
+            }
+        }
+
+        void OperationScheduler::watchdog()
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            while (!m_stop)
+            {
+                auto now = Clock::now();
+                auto next = Clock::time_point::max();
+                std::vector<Completion> expired;
+
+                for (auto it = m_operations.begin(); it != m_operations.end();)
+                {
+                    Operation& operation = **it;
+                    if (!operation.reported && operation.deadline <= now)
+                    {
+                        Completion completion;
+                        reportLocked(operation, OUTCOME_TIMEDOUT, 0, completion);
+                        expired.push_back(std::move(completion));
+                        if (!operation.running)
+                        {
+                            it = m_operations.erase(it);
+                            continue;
+                        }
+                    }
+                    else if (!operation.reported)
+                        next = std::min(next, operation.deadline);
+                    ++it;
+                }
+
+                if (!expired.empty())
+                {
+                    lock.unlock();
+                    for (const auto& completion : expired)
+                    {
+                        NMLOG_WARNING("operation %u %s timed out after %u ms", completion.id, completion.kind.c_str(), completion.latencyMs);
+                        m_handler(completion);
+                    }
+                    m_cond.notify_all();
+                    lock.lock();
+                    continue;
+                }
+
+                if (next == Clock::time_point::max())
+                    m_watchCond.wait(lock);
+                else
+                    m_watchCond.wait_until(lock, next);
+            }
+        }
+
+        std::vector<OperationScheduler::KindStats> OperationScheduler::stats() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            std::vector<KindStats> result;
+            result.reserve(m_stats.size());
+            for (const auto& entry : m_stats)
+                result.push_back(entry.second);
+            return result;
+        }
+
+        void OperationScheduler::statsToJson(std::string& json) const
+        {
+            json += '{';
+            bool firstKind = true;
+            for (const auto& kindStats : stats())
+            {
+                if (!firstKind)
+                    json += ',';
+                firstKind = false;
+                json += '"' + kindStats.kind + "\":{";
+                for (int outcome = OUTCOME_COMPLETED; outcome <= OUTCOME_SUPERSEDED; outcome++)
+                {
+                    json += '"';
+                    json += s_outcomeNames[outcome];
+                    json += "\":" + std::to_string(kindStats.outcomes[outcome]) + ',';
+                }
+                json += "\"max\":" + std::to_string(kindStats.maxLatencyMs) + ",\"histogram\":[";
+                for (size_t bucket = 0; bucket < NM_OPERATION_LATENCY_BUCKETS; bucket++)
+                {
+                    if (bucket > 0)
+                        json += ',';
+                    /* the last bucket has no upper bound */
+                    std::string bound = (bucket < NM_OPERATION_LATENCY_BUCKETS - 1) ? std::to_string(s_latencyBounds[bucket]) : "+Inf";
+                    json += "{\"le\":\"" + bound + "\",\"count\":" + std::to_string(kindStats.buckets[bucket]) + '}';
+                }
+                json += "]}";
+            }
+            json += '}';
+        }
+    } // Plugin
+} // WPEFramework
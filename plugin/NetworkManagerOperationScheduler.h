@@ -0,0 +1,166 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define NM_OPERATION_WORKERS                2
+#define NM_OPERATION_INFLIGHT_LIMIT         8
+#define NM_OPERATION_DEFAULT_TIMEOUT_MS     60000
+#define NM_OPERATION_LATENCY_BUCKETS        10
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Runs mutating requests (connect, interface state, IP settings, WPS) in the
+         * background so the caller gets an operation ID back at once.
+         *
+         * - A request with the key of a pending operation returns that operation's ID.
+         * - A request supersedes the queued requests of its group that have not started.
+         * - Requests of one lane run one at a time, in submission order.
+         * - Queued plus running requests are bounded; a request over the limit is refused.
+         * - Each operation has a deadline counted from submission. The completion of an
+         *   operation past its deadline is reported as timed out at the deadline; a backend
+         *   call cannot be interrupted, so it keeps its lane and slot until it returns and
+         *   its late result is discarded.
+         *
+         * Every admitted operation is completed exactly once through the completion handler,
+         * which runs on a scheduler thread, or on the caller of stop() for the operations it
+         * cancels, without any scheduler lock held.
+         */
+        class OperationScheduler
+        {
+        public:
+            enum Outcome : uint8_t {
+                OUTCOME_COMPLETED,
+                OUTCOME_TIMEDOUT,
+                OUTCOME_CANCELLED,
+                OUTCOME_SUPERSEDED
+            };
+
+            enum Admission : uint8_t {
+                ADMIT_QUEUED,
+                ADMIT_DUPLICATE,        /* id is the pending operation with the same key */
+                ADMIT_FULL,
+                ADMIT_STOPPED
+            };
+
+            struct Request {
+                std::string kind;       /* operation name, also the statistics bucket */
+                std::string key;        /* identifies duplicates; never logged */
+                std::string lane;
+                std::string group;      /* empty: supersedes nothing */
+                uint32_t timeoutMs = NM_OPERATION_DEFAULT_TIMEOUT_MS;
+                std::function<uint32_t()> run;
+            };
+
+            struct Completion {
+                uint32_t id;
+                std::string kind;
+                Outcome outcome;
+                uint32_t result;        /* return code of run(), valid for OUTCOME_COMPLETED */
+                uint32_t latencyMs;     /* from submission */
+            };
+
+            struct KindStats {
+                std::string kind;
+                uint64_t outcomes[4];   /* indexed by Outcome */
+                uint64_t buckets[NM_OPERATION_LATENCY_BUCKETS];
+                uint32_t maxLatencyMs;
+            };
+
+            using CompletionHandler = std::function<void(const Completion&)>;
+
+            OperationScheduler(const CompletionHandler& handler, size_t workers = NM_OPERATION_WORKERS, size_t limit = NM_OPERATION_INFLIGHT_LIMIT);
+            ~OperationScheduler();
+
+            OperationScheduler(const OperationScheduler&) = delete;
+            OperationScheduler& operator=(const OperationScheduler&) = delete;
+
+            void start();
+            /* Reports the queued operations as cancelled, then joins the threads after the running ones return */
+            void stop();
+
+            void setLimit(size_t limit);
+            size_t limit() const;
+
+            Admission submit(Request&& request, uint32_t& id);
+            /* false if the operation is unknown or already completed */
+            bool cancel(uint32_t id);
+
+            size_t inFlight() const;
+            std::vector<KindStats> stats() const;
+            /* {"<kind>":{"completed":n,"timedout":n,"cancelled":n,"superseded":n,"max":ms,"histogram":[{"le":"ms","count":n},...,{"le":"+Inf","count":n}]},...} */
+            void statsToJson(std::string& json) const;
+
+            /* Upper bound in ms of each latency bucket; the last bucket is unbounded (0) */
+            static const uint32_t* latencyBounds();
+            static const char* outcomeName(Outcome outcome);
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Operation {
+                uint32_t id;
+                Request request;
+                Clock::time_point submitted;
+                Clock::time_point deadline;
+                bool running;
+                bool reported;
+            };
+
+            using OperationPtr = std::shared_ptr<Operation>;
+
+            void worker();
+            void watchdog();
+            /* caller holds m_lock; fills completion and updates the statistics */
+            bool reportLocked(Operation& operation, Outcome outcome, uint32_t result, Completion& completion);
+            void eraseLocked(uint32_t id);
+            OperationPtr nextRunnableLocked();
+
+            CompletionHandler m_handler;
+            size_t m_workerCount;
+            size_t m_limit;                                 /* guarded by m_lock */
+
+            mutable std::mutex m_lock;
+            std::condition_variable m_cond;                 /* work available, lane freed or stop */
+            std::condition_variable m_watchCond;            /* new deadline or stop */
+            bool m_stop = true;
+            uint32_t m_nextId = 0;
+            std::deque<OperationPtr> m_operations;          /* queued and running, in submission order */
+            std::map<std::string, uint32_t> m_busyLanes;    /* lane -> id of its running operation */
+            std::map<std::string, KindStats> m_stats;
+            std::vector<std::thread> m_workers;
+            std::thread m_watchdog;
+        };
+    } // Plugin
+} // WPEFramework
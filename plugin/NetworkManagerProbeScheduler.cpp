@@ -0,0 +1,250 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "NetworkManagerProbeScheduler.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        static const char* s_phaseNames[] = { "initial", "degraded", "connected", "linkdown" };
+        static const char* s_wakeNames[] = { "interface", "address", "route", "request" };
+
+        ProbeScheduler::ProbeScheduler(uint32_t seed)
+            : m_random(seed)
+        {
+            for (BackoffPolicy& policy : m_policies)
+                policy = { std::chrono::milliseconds(5000), std::chrono::milliseconds(5000), 1.0, 0.0 };
+        }
+
+        void ProbeScheduler::setPolicy(Phase phase, const BackoffPolicy& policy)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            BackoffPolicy& slot = m_policies[phase];
+            slot = policy;
+            slot.maximum = std::max(policy.maximum, policy.initial);
+            slot.multiplier = std::max(policy.multiplier, 1.0);
+            slot.jitter = std::min(std::max(policy.jitter, 0.0), 0.9);
+            m_attempts[phase] = 0;
+        }
+
+        BackoffPolicy ProbeScheduler::policy(Phase phase) const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_policies[phase];
+        }
+
+        std::chrono::milliseconds ProbeScheduler::next(Phase phase)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            const BackoffPolicy& policy = m_policies[phase];
+            const uint32_t attempt = m_attempts[phase];
+
+            double delay = static_cast<double>(policy.initial.count()) * std::pow(policy.multiplier, attempt);
+            /* stop counting once the cap is reached, the power only grows from there */
+            if (delay < static_cast<double>(policy.maximum.count()))
+                m_attempts[phase]++;
+            else
+                delay = static_cast<double>(policy.maximum.count());
+
+            if (policy.jitter > 0)
+            {
+                std::uniform_real_distribution<double> spread(-policy.jitter, policy.jitter);
+                delay *= 1.0 + spread(m_random);
+            }
+
+            m_phase = phase;
+            m_nextDelay = std::chrono::milliseconds(std::max<long long>(1, std::llround(delay)));
+            return m_nextDelay;
+        }
+
+        void ProbeScheduler::resetBackoff()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            std::fill(std::begin(m_attempts), std::end(m_attempts), 0);
+        }
+
+        bool ProbeScheduler::wait(std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            bool early = m_cv.wait_for(lock, timeout, [this] { return m_woken || m_stopped; });
+            m_woken = false;
+            return early;
+        }
+
+        void ProbeScheduler::wake(WakeReason reason)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_woken = true;
+                m_wakeups[reason]++;
+            }
+            m_cv.notify_one();
+        }
+
+        void ProbeScheduler::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_stopped = true;
+            }
+            m_cv.notify_all();
+        }
+
+        void ProbeScheduler::restart()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stopped = false;
+            m_woken = false;
+        }
+
+        bool ProbeScheduler::stopped() const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_stopped;
+        }
+
+        void ProbeScheduler::recordProbe(Clock::time_point now)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_probes++;
+            m_probeTimes.push_back(now);
+            const Clock::time_point horizon = now - std::chrono::seconds(NM_PROBE_WINDOW_SEC);
+            while (!m_probeTimes.empty() && m_probeTimes.front() <= horizon)
+                m_probeTimes.pop_front();
+        }
+
+        void ProbeScheduler::recordSkippedProbe()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_skipped++;
+        }
+
+        uint32_t ProbeScheduler::probesLastHour(Clock::time_point now)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            const Clock::time_point horizon = now - std::chrono::seconds(NM_PROBE_WINDOW_SEC);
+            while (!m_probeTimes.empty() && m_probeTimes.front() <= horizon)
+                m_probeTimes.pop_front();
+            return static_cast<uint32_t>(m_probeTimes.size());
+        }
+
+        void ProbeScheduler::statsToJson(std::string& json)
+        {
+            const uint32_t lastHour = probesLastHour();
+            std::lock_guard<std::mutex> lock(m_lock);
+            json += "{\"probesLastHour\":" + std::to_string(lastHour);
+            json += ",\"probes\":" + std::to_string(m_probes);
+            json += ",\"skipped\":" + std::to_string(m_skipped);
+            json += ",\"wakeups\":{";
+            for (int reason = 0; reason < WAKE_COUNT; reason++)
+            {
+                if (reason > 0)
+                    json += ',';
+                json += '"';
+                json += s_wakeNames[reason];
+                json += "\":" + std::to_string(m_wakeups[reason]);
+            }
+            json += "},\"phase\":\"";
+            json += s_phaseNames[m_phase];
+            json += "\",\"nextDelayMs\":" + std::to_string(m_nextDelay.count()) + '}';
+        }
+
+        const char* ProbeScheduler::phaseName(Phase phase)
+        {
+            return (phase < PHASE_COUNT) ? s_phaseNames[phase] : "unknown";
+        }
+
+        LinkPrecheck::Result LinkPrecheck::check(const std::string& interface) const
+        {
+            Result result;
+            std::string line;
+
+            /* Iface Destination Gateway Flags RefCnt Use Metric Mask ...; addresses in host order hex */
+            std::ifstream route(m_procNet + "/route");
+            std::getline(route, line);
+            while (std::getline(route, line))
+            {
+                std::istringstream fields(line);
+                std::string iface, destination, gateway, mask;
+                unsigned flags = 0, refcnt = 0, use = 0, metric = 0;
+                if (!(fields >> iface >> destination >> gateway >> std::hex >> flags >> std::dec >> refcnt >> use >> metric >> mask))
+                    continue;
+                if ((!interface.empty() && iface != interface) || destination != "00000000" || mask != "00000000" || !(flags & 0x1))
+                    continue;
+
+                result.ipv4Route = true;
+                uint32_t address = static_cast<uint32_t>(strtoul(gateway.c_str(), nullptr, 16));
+                if (address != 0)
+                {
+                    char text[16];
+                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&address);
+                    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+                    result.ipv4Gateway = text;
+                }
+                break;
+            }
+
+            /* destination prefix-len source prefix-len next-hop metric refcnt use flags iface */
+            std::ifstream route6(m_procNet + "/ipv6_route");
+            while (std::getline(route6, line))
+            {
+                std::istringstream fields(line);
+                std::string destination, prefix, source, sourcePrefix, nextHop, metric, refcnt, use, flags, iface;
+                if (!(fields >> destination >> prefix >> source >> sourcePrefix >> nextHop >> metric >> refcnt >> use >> flags >> iface))
+                    continue;
+                const unsigned long routeFlags = strtoul(flags.c_str(), nullptr, 16);
+                /* RTF_UP without RTF_REJECT; the kernel keeps rejecting ::/0 routes on lo */
+                if (destination != std::string(32, '0') || prefix != "00" || !(routeFlags & 0x1) || (routeFlags & 0x200))
+                    continue;
+                if (!interface.empty() && iface != interface)
+                    continue;
+                result.ipv6Route = true;
+                break;
+            }
+
+            /* IP address, HW type, Flags, HW address, Mask, Device; flags 0x2 is ATF_COM */
+            if (!result.ipv4Gateway.empty())
+            {
+                std::ifstream arp(m_procNet + "/arp");
+                std::getline(arp, line);
+                while (std::getline(arp, line))
+                {
+                    std::istringstream fields(line);
+                    std::string address, type, flags, hwAddress, mask, device;
+                    if (!(fields >> address >> type >> flags >> hwAddress >> mask >> device))
+                        continue;
+                    if (address != result.ipv4Gateway || (!interface.empty() && device != interface))
+                        continue;
+                    result.ipv4GatewayFailed = !(strtoul(flags.c_str(), nullptr, 16) & 0x2);
+                    break;
+                }
+            }
+            return result;
+        }
+    } // Plugin
+} // WPEFramework
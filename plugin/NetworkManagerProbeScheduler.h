@@ -0,0 +1,143 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <string>
+
+#define NM_PROBE_WINDOW_SEC                 3600    // window of the probes per hour metric
+#define NM_PROBE_PROC_NET                   "/proc/net"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * delay(n) = min(initial * multiplier^n, maximum), then moved by up to
+         * +/- jitter of itself so that a fleet does not probe in lock step.
+         */
+        struct BackoffPolicy {
+            std::chrono::milliseconds initial;
+            std::chrono::milliseconds maximum;
+            double multiplier;
+            double jitter;                      // fraction, 0 disables it
+        };
+
+        /*
+         * Decides when the connectivity monitor probes next and lets the event thread
+         * wake it. Each phase has its own policy and its own attempt count; the counts
+         * start over on resetBackoff(), which the monitor calls whenever the state
+         * changes or an event wakes it. Also keeps the probe metrics.
+         */
+        class ProbeScheduler
+        {
+        public:
+            enum Phase : uint8_t {
+                PHASE_INITIAL,                  // confirming a state after a change
+                PHASE_DEGRADED,                 // settled, but not fully connected
+                PHASE_CONNECTED,                // settled and fully connected; only refreshed once per interval
+                PHASE_LINK_DOWN,                // no interface or no default route; nothing is probed
+                PHASE_COUNT
+            };
+
+            enum WakeReason : uint8_t {
+                WAKE_INTERFACE,
+                WAKE_ADDRESS,
+                WAKE_ROUTE,
+                WAKE_REQUEST,
+                WAKE_COUNT
+            };
+
+            explicit ProbeScheduler(uint32_t seed = std::random_device{}());
+
+            void setPolicy(Phase phase, const BackoffPolicy& policy);
+            BackoffPolicy policy(Phase phase) const;
+
+            /* Delay before the next round of the phase; advances that phase's attempt count */
+            std::chrono::milliseconds next(Phase phase);
+            void resetBackoff();
+
+            /* Sleeps up to timeout; returns true if woken or stopped before that */
+            bool wait(std::chrono::milliseconds timeout);
+            void wake(WakeReason reason);
+            void stop();
+            void restart();
+            bool stopped() const;
+
+            using Clock = std::chrono::steady_clock;
+            void recordProbe(Clock::time_point now = Clock::now());
+            /* a round answered by the link pre-check, without an HTTP request */
+            void recordSkippedProbe();
+            uint32_t probesLastHour(Clock::time_point now = Clock::now());
+
+            /* {"probesLastHour":N,"probes":N,"skipped":N,"wakeups":{...},"phase":"...","nextDelayMs":N} */
+            void statsToJson(std::string& json);
+
+            static const char* phaseName(Phase phase);
+
+        private:
+            mutable std::mutex m_lock;
+            std::condition_variable m_cv;
+            bool m_woken{false};
+            bool m_stopped{false};
+            BackoffPolicy m_policies[PHASE_COUNT];
+            uint32_t m_attempts[PHASE_COUNT] = {};
+            std::mt19937 m_random;
+            Phase m_phase{PHASE_INITIAL};
+            std::chrono::milliseconds m_nextDelay{0};
+            std::deque<Clock::time_point> m_probeTimes;
+            uint64_t m_probes{0};
+            uint64_t m_skipped{0};
+            uint64_t m_wakeups[WAKE_COUNT] = {};
+        };
+
+        /*
+         * Cheap checks made before an HTTP probe: is there a default route on the interface,
+         * and has the IPv4 gateway answered ARP. The answers come from the kernel tables under
+         * /proc/net, so no packet is sent. A gateway missing from the ARP table is not a
+         * failure, since nothing may have talked to it yet; an incomplete entry is.
+         */
+        class LinkPrecheck
+        {
+        public:
+            struct Result {
+                bool ipv4Route{false};
+                bool ipv6Route{false};
+                bool ipv4GatewayFailed{false};
+                std::string ipv4Gateway;
+
+                bool usable() const { return (ipv4Route && !ipv4GatewayFailed) || ipv6Route; }
+            };
+
+            explicit LinkPrecheck(const std::string& procNet = NM_PROBE_PROC_NET) : m_procNet(procNet) {}
+
+            /* an empty interface matches any interface */
+            Result check(const std::string& interface) const;
+
+        private:
+            std::string m_procNet;
+        };
+    } // Plugin
+} // WPEFramework
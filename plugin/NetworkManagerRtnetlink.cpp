@@ -0,0 +1,671 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_addr.h>
+#include <linux/if.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include "NetworkManagerRtnetlink.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        namespace
+        {
+            /* Indexes the attributes of a message; later duplicates win, as in the kernel */
+            template <size_t N>
+            void parseAttributes(const struct rtattr* (&table)[N], const struct rtattr* attribute, int length)
+            {
+                for (auto& entry : table)
+                    entry = nullptr;
+                for (; RTA_OK(attribute, length); attribute = RTA_NEXT(attribute, length))
+                {
+                    if (attribute->rta_type < N)
+                        table[attribute->rta_type] = attribute;
+                }
+            }
+
+            IpAddr addressOf(int family, const struct rtattr* attribute)
+            {
+                size_t expected = (family == AF_INET6) ? 16 : 4;
+                if (attribute == nullptr || RTA_PAYLOAD(attribute) < expected)
+                    return IpAddr();
+                return IpAddr::fromBytes(family, RTA_DATA(attribute));
+            }
+
+            /* Calls changed(key, value) for every entry added, removed or modified between two maps */
+            template <typename Map, typename Changed>
+            void diffMaps(const Map& before, const Map& after, Changed changed)
+            {
+                for (const auto& entry : before)
+                {
+                    auto it = after.find(entry.first);
+                    if (it == after.end() || !(it->second == entry.second))
+                        changed(entry.first, entry.second);
+                }
+                for (const auto& entry : after)
+                {
+                    if (before.find(entry.first) == before.end())
+                        changed(entry.first, entry.second);
+                }
+            }
+        }
+
+        RtnetlinkMonitor::~RtnetlinkMonitor()
+        {
+            stop();
+        }
+
+        bool RtnetlinkMonitor::start(Handler handler)
+        {
+            if (m_running.load())
+                return true;
+
+            m_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+            if (m_fd < 0)
+            {
+                NMLOG_ERROR("cannot open a rtnetlink socket: %s", strerror(errno));
+                return false;
+            }
+
+            /* SO_RCVBUFFORCE goes past rmem_max but needs CAP_NET_ADMIN */
+            int size = NM_RTNETLINK_RCVBUF_SIZE;
+            if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+                setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+            struct sockaddr_nl local{};
+            local.nl_family = AF_NETLINK;
+            local.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+            socklen_t length = sizeof(local);
+            if (bind(m_fd, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) < 0 ||
+                getsockname(m_fd, reinterpret_cast<struct sockaddr*>(&local), &length) < 0)
+            {
+                NMLOG_ERROR("cannot bind the rtnetlink socket: %s", strerror(errno));
+                close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+            m_portId = local.nl_pid;
+
+            m_stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (m_stopFd < 0)
+            {
+                NMLOG_ERROR("eventfd creation failed: %s", strerror(errno));
+                close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+
+            m_handler = std::move(handler);
+            m_pendingDumps = { DUMP_LINKS, DUMP_ADDRESSES, DUMP_ROUTES };
+            m_dumping = DUMP_NONE;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                m_synced = false;
+            }
+            m_running.store(true);
+            m_thread = std::thread(&RtnetlinkMonitor::run, this);
+
+            std::unique_lock<std::mutex> lock(m_lock);
+            if (!m_syncCondition.wait_for(lock, std::chrono::milliseconds(NM_RTNETLINK_SYNC_TIMEOUT_MS), [this]() { return m_synced; }))
+                NMLOG_WARNING("rtnetlink dumps did not complete within %d ms", NM_RTNETLINK_SYNC_TIMEOUT_MS);
+            return true;
+        }
+
+        void RtnetlinkMonitor::stop()
+        {
+            if (m_thread.joinable())
+            {
+                uint64_t wake = 1;
+                if (write(m_stopFd, &wake, sizeof(wake)) < 0)
+                    NMLOG_WARNING("cannot wake the rtnetlink thread: %s", strerror(errno));
+                m_thread.join();
+            }
+            if (m_fd >= 0)
+                close(m_fd);
+            if (m_stopFd >= 0)
+                close(m_stopFd);
+            m_fd = m_stopFd = -1;
+            m_portId = 0;
+            m_running.store(false);
+            m_handler = nullptr;
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_links.clear();
+            m_addresses.clear();
+            m_routes.clear();
+            m_dumpLinks.clear();
+            m_dumpAddresses.clear();
+            m_dumpRoutes.clear();
+            m_synced = false;
+        }
+
+        void RtnetlinkMonitor::run()
+        {
+            std::vector<uint8_t> buffer(NM_RTNETLINK_READ_SIZE);
+            RtnetlinkChanges changes;
+            bool synced = false;
+
+            while (true)
+            {
+                if (m_dumping == DUMP_NONE && !m_pendingDumps.empty())
+                {
+                    DumpType type = m_pendingDumps.front();
+                    m_pendingDumps.erase(m_pendingDumps.begin());
+                    if (!sendDump(type))
+                        m_pendingDumps.clear();
+                }
+
+                struct pollfd fds[2] = { { m_fd, POLLIN, 0 }, { m_stopFd, POLLIN, 0 } };
+                if (poll(fds, 2, -1) < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    NMLOG_ERROR("rtnetlink poll failed: %s", strerror(errno));
+                    break;
+                }
+                if (fds[1].revents)
+                    break;
+
+                /* take everything that is queued before anyone hears about it */
+                bool decoded = false;
+                while (true)
+                {
+                    ssize_t received = recv(m_fd, buffer.data(), buffer.size(), 0);
+                    if (received < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        if (errno == ENOBUFS)
+                        {
+                            /* multicast messages were dropped; only a fresh dump tells what they said */
+                            m_overruns++;
+                            NMLOG_WARNING("rtnetlink socket overrun, dumping the state again");
+                            requestResync();
+                            continue;
+                        }
+                        if (errno != EAGAIN && errno != EWOULDBLOCK)
+                            NMLOG_ERROR("rtnetlink recv failed: %s", strerror(errno));
+                        break;
+                    }
+                    if (received == 0)
+                        break;
+                    decode(buffer.data(), static_cast<size_t>(received), changes);
+                    decoded = true;
+                }
+                if (decoded)
+                    m_batches++;
+
+                if (!synced)
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    synced = m_synced;
+                }
+                /* the dumped state goes out as one batch, then every wakeup is a batch */
+                if (synced && !changes.empty())
+                {
+                    if (m_handler)
+                        m_handler(changes);
+                    changes = RtnetlinkChanges();
+                }
+            }
+        }
+
+        void RtnetlinkMonitor::requestResync()
+        {
+            /* a dump in flight is not affected by an overrun; let it finish and queue the others after it */
+            m_pendingDumps = { DUMP_LINKS, DUMP_ADDRESSES, DUMP_ROUTES };
+        }
+
+        bool RtnetlinkMonitor::sendDump(DumpType type)
+        {
+            struct {
+                struct nlmsghdr header;
+                union {
+                    struct ifinfomsg link;
+                    struct ifaddrmsg address;
+                    struct rtmsg route;
+                } body;
+            } request{};
+
+            switch (type)
+            {
+                case DUMP_LINKS:
+                    request.header.nlmsg_type = RTM_GETLINK;
+                    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+                    request.body.link.ifi_family = AF_UNSPEC;
+                    break;
+                case DUMP_ADDRESSES:
+                    request.header.nlmsg_type = RTM_GETADDR;
+                    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifaddrmsg));
+                    request.body.address.ifa_family = AF_UNSPEC;
+                    break;
+                case DUMP_ROUTES:
+                    request.header.nlmsg_type = RTM_GETROUTE;
+                    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+                    request.body.route.rtm_family = AF_UNSPEC;
+                    break;
+                default:
+                    return false;
+            }
+            request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+            request.header.nlmsg_seq = ++m_sequence;
+            request.header.nlmsg_pid = m_portId;
+
+            struct sockaddr_nl kernel{};
+            kernel.nl_family = AF_NETLINK;
+            if (sendto(m_fd, &request, request.header.nlmsg_len, 0, reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) < 0)
+            {
+                NMLOG_ERROR("rtnetlink dump request failed: %s", strerror(errno));
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_dumping = type;
+            m_dumpSequence = request.header.nlmsg_seq;
+            m_dumpLinks.clear();
+            m_dumpAddresses.clear();
+            m_dumpRoutes.clear();
+            return true;
+        }
+
+        void RtnetlinkMonitor::decode(const uint8_t* data, size_t length, RtnetlinkChanges& changes)
+        {
+            const struct nlmsghdr* header = reinterpret_cast<const struct nlmsghdr*>(data);
+            int remaining = static_cast<int>(length);
+            for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining))
+            {
+                m_messages++;
+                bool reply = (m_portId != 0 && header->nlmsg_pid == m_portId);
+                if (reply && header->nlmsg_seq != m_dumpSequence)
+                    continue;
+
+                switch (header->nlmsg_type)
+                {
+                    case NLMSG_DONE:
+                        if (reply)
+                            finishDump(changes);
+                        break;
+                    case NLMSG_ERROR:
+                        if (reply && header->nlmsg_len >= NLMSG_LENGTH(sizeof(struct nlmsgerr)))
+                        {
+                            const struct nlmsgerr* error = reinterpret_cast<const struct nlmsgerr*>(NLMSG_DATA(header));
+                            if (error->error != 0)
+                            {
+                                NMLOG_WARNING("rtnetlink dump failed: %s", strerror(-error->error));
+                                /* EBUSY means an earlier dump still runs; ask again once it is through */
+                                if (error->error == -EBUSY)
+                                    m_pendingDumps.insert(m_pendingDumps.begin(), m_dumping);
+                                m_dumping = DUMP_NONE;
+                            }
+                        }
+                        break;
+                    case RTM_NEWLINK:
+                    case RTM_DELLINK:
+                        onLink(header, changes);
+                        break;
+                    case RTM_NEWADDR:
+                    case RTM_DELADDR:
+                        onAddress(header, changes);
+                        break;
+                    case RTM_NEWROUTE:
+                    case RTM_DELROUTE:
+                        onRoute(header, changes);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void RtnetlinkMonitor::finishDump(RtnetlinkChanges& changes)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            switch (m_dumping)
+            {
+                case DUMP_LINKS:
+                    diffMaps(m_links, m_dumpLinks, [&](int, const RtnetlinkLink& link) { changes.links.insert(link.name); });
+                    m_links.swap(m_dumpLinks);
+                    break;
+                case DUMP_ADDRESSES:
+                    diffMaps(m_addresses, m_dumpAddresses, [&](const AddressKey&, const RtnetlinkAddress& address) {
+                        std::string name = nameOf(address.index);
+                        if (!name.empty())
+                            changes.addresses.insert({name, address.family});
+                    });
+                    m_addresses.swap(m_dumpAddresses);
+                    break;
+                case DUMP_ROUTES:
+                    diffMaps(m_routes, m_dumpRoutes, [&](const RouteKey&, const RtnetlinkRoute& route) { changes.routes.insert(route.family); });
+                    m_routes.swap(m_dumpRoutes);
+                    break;
+                default:
+                    break;
+            }
+            m_dumpLinks.clear();
+            m_dumpAddresses.clear();
+            m_dumpRoutes.clear();
+            m_dumping = DUMP_NONE;
+
+            if (!m_synced && m_pendingDumps.empty())
+            {
+                m_synced = true;
+                m_syncCondition.notify_all();
+            }
+        }
+
+        void RtnetlinkMonitor::onLink(const struct nlmsghdr* header, RtnetlinkChanges& changes)
+        {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg)))
+                return;
+            const struct ifinfomsg* info = reinterpret_cast<const struct ifinfomsg*>(NLMSG_DATA(header));
+            const struct rtattr* attributes[IFLA_MAX + 1];
+            parseAttributes(attributes, IFLA_RTA(info), static_cast<int>(IFLA_PAYLOAD(header)));
+
+            RtnetlinkLink link;
+            link.index = info->ifi_index;
+            link.up = (info->ifi_flags & IFF_UP) != 0;
+            link.lowerUp = (info->ifi_flags & IFF_LOWER_UP) != 0;
+            if (attributes[IFLA_IFNAME])
+                link.name.assign(static_cast<const char*>(RTA_DATA(attributes[IFLA_IFNAME])), strnlen(static_cast<const char*>(RTA_DATA(attributes[IFLA_IFNAME])), RTA_PAYLOAD(attributes[IFLA_IFNAME])));
+            if (attributes[IFLA_ADDRESS] && RTA_PAYLOAD(attributes[IFLA_ADDRESS]) == 6)
+            {
+                memcpy(link.mac.bytes, RTA_DATA(attributes[IFLA_ADDRESS]), sizeof(link.mac.bytes));
+                link.mac.valid = true;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (header->nlmsg_pid == m_portId && m_portId != 0)
+            {
+                if (m_dumping == DUMP_LINKS)
+                    m_dumpLinks[link.index] = link;
+                return;
+            }
+
+            auto it = m_links.find(link.index);
+            if (header->nlmsg_type == RTM_DELLINK)
+            {
+                if (it == m_links.end())
+                    return;
+                changes.links.insert(it->second.name);
+                /* the kernel drops everything bound to the link with it, not always with a message */
+                for (auto address = m_addresses.begin(); address != m_addresses.end();)
+                {
+                    if (address->second.index == link.index)
+                    {
+                        changes.addresses.insert({it->second.name, address->second.family});
+                        address = m_addresses.erase(address);
+                    }
+                    else
+                        ++address;
+                }
+                for (auto route = m_routes.begin(); route != m_routes.end();)
+                {
+                    if (route->second.index == link.index)
+                    {
+                        changes.routes.insert(route->second.family);
+                        route = m_routes.erase(route);
+                    }
+                    else
+                        ++route;
+                }
+                m_links.erase(it);
+                m_dumpLinks.erase(link.index);
+                return;
+            }
+
+            /* wireless extension events arrive as RTM_NEWLINK too; only report real changes */
+            if (link.name.empty() && it != m_links.end())
+                link.name = it->second.name;
+            if (it != m_links.end() && it->second == link)
+                return;
+            /* IPv4 routes through a link that went down are flushed without any RTM_DELROUTE */
+            if (it != m_links.end() && it->second.up && !link.up)
+            {
+                for (auto route = m_routes.begin(); route != m_routes.end();)
+                {
+                    if (route->second.index == link.index && route->second.family == AF_INET)
+                    {
+                        changes.routes.insert(AF_INET);
+                        route = m_routes.erase(route);
+                    }
+                    else
+                        ++route;
+                }
+            }
+            m_links[link.index] = link;
+            if (m_dumping == DUMP_LINKS)
+                m_dumpLinks[link.index] = link;
+            changes.links.insert(link.name);
+        }
+
+        void RtnetlinkMonitor::onAddress(const struct nlmsghdr* header, RtnetlinkChanges& changes)
+        {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifaddrmsg)))
+                return;
+            const struct ifaddrmsg* info = reinterpret_cast<const struct ifaddrmsg*>(NLMSG_DATA(header));
+            if (info->ifa_family != AF_INET && info->ifa_family != AF_INET6)
+                return;
+            const struct rtattr* attributes[IFA_MAX + 1];
+            parseAttributes(attributes, IFA_RTA(info), static_cast<int>(IFA_PAYLOAD(header)));
+
+            RtnetlinkAddress address;
+            address.index = static_cast<int>(info->ifa_index);
+            address.family = info->ifa_family;
+            address.prefix = info->ifa_prefixlen;
+            address.scope = info->ifa_scope;
+            /* on point to point links IFA_ADDRESS is the peer and IFA_LOCAL our own address */
+            const struct rtattr* local = attributes[IFA_LOCAL] ? attributes[IFA_LOCAL] : attributes[IFA_ADDRESS];
+            address.address = addressOf(address.family, local);
+            if (address.address.empty())
+                return;
+
+            uint32_t flags = info->ifa_flags;
+            if (attributes[IFA_FLAGS] && RTA_PAYLOAD(attributes[IFA_FLAGS]) >= sizeof(uint32_t))
+                memcpy(&flags, RTA_DATA(attributes[IFA_FLAGS]), sizeof(flags));
+            bool usable = (header->nlmsg_type == RTM_NEWADDR) && !(flags & (IFA_F_TENTATIVE | IFA_F_DADFAILED));
+
+            AddressKey key{address.index, address.family, address.address};
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (header->nlmsg_pid == m_portId && m_portId != 0)
+            {
+                if (m_dumping == DUMP_ADDRESSES && usable)
+                    m_dumpAddresses[key] = address;
+                return;
+            }
+
+            if (m_dumping == DUMP_ADDRESSES)
+            {
+                if (usable)
+                    m_dumpAddresses[key] = address;
+                else
+                    m_dumpAddresses.erase(key);
+            }
+
+            auto it = m_addresses.find(key);
+            if (usable)
+            {
+                if (it != m_addresses.end() && it->second == address)
+                    return;
+                m_addresses[key] = address;
+            }
+            else
+            {
+                if (it == m_addresses.end())
+                    return;
+                m_addresses.erase(it);
+                /* removing an IPv4 address flushes the routes that depended on it, silently */
+                if (address.family == AF_INET && std::find(m_pendingDumps.begin(), m_pendingDumps.end(), DUMP_ROUTES) == m_pendingDumps.end())
+                    m_pendingDumps.push_back(DUMP_ROUTES);
+            }
+
+            std::string name = nameOf(address.index);
+            if (!name.empty())
+                changes.addresses.insert({name, address.family});
+        }
+
+        void RtnetlinkMonitor::onRoute(const struct nlmsghdr* header, RtnetlinkChanges& changes)
+        {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+                return;
+            const struct rtmsg* info = reinterpret_cast<const struct rtmsg*>(NLMSG_DATA(header));
+            if ((info->rtm_family != AF_INET && info->rtm_family != AF_INET6) || info->rtm_dst_len != 0 || info->rtm_type != RTN_UNICAST)
+                return;
+            const struct rtattr* attributes[RTA_MAX + 1];
+            parseAttributes(attributes, RTM_RTA(info), static_cast<int>(RTM_PAYLOAD(header)));
+
+            uint32_t table = info->rtm_table;
+            if (attributes[RTA_TABLE] && RTA_PAYLOAD(attributes[RTA_TABLE]) >= sizeof(uint32_t))
+                memcpy(&table, RTA_DATA(attributes[RTA_TABLE]), sizeof(table));
+            if (table != RT_TABLE_MAIN)
+                return;
+
+            RtnetlinkRoute route;
+            route.family = info->rtm_family;
+            if (attributes[RTA_OIF] && RTA_PAYLOAD(attributes[RTA_OIF]) >= sizeof(int))
+                memcpy(&route.index, RTA_DATA(attributes[RTA_OIF]), sizeof(route.index));
+            if (attributes[RTA_PRIORITY] && RTA_PAYLOAD(attributes[RTA_PRIORITY]) >= sizeof(uint32_t))
+                memcpy(&route.metric, RTA_DATA(attributes[RTA_PRIORITY]), sizeof(route.metric));
+            route.gateway = addressOf(route.family, attributes[RTA_GATEWAY]);
+
+            /* a multipath default route is tracked by its first hop */
+            if (route.index == 0 && attributes[RTA_MULTIPATH] && RTA_PAYLOAD(attributes[RTA_MULTIPATH]) >= sizeof(struct rtnexthop))
+            {
+                const struct rtnexthop* hop = static_cast<const struct rtnexthop*>(RTA_DATA(attributes[RTA_MULTIPATH]));
+                if (hop->rtnh_len >= sizeof(struct rtnexthop) && hop->rtnh_len <= RTA_PAYLOAD(attributes[RTA_MULTIPATH]))
+                {
+                    route.index = hop->rtnh_ifindex;
+                    const struct rtattr* hopAttributes[RTA_MAX + 1];
+                    parseAttributes(hopAttributes, RTNH_DATA(hop), static_cast<int>(hop->rtnh_len - sizeof(struct rtnexthop)));
+                    route.gateway = addressOf(route.family, hopAttributes[RTA_GATEWAY]);
+                }
+            }
+            if (route.index == 0)
+                return;
+
+            RouteKey key{route.family, route.index, route.gateway, route.metric};
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (header->nlmsg_pid == m_portId && m_portId != 0)
+            {
+                if (m_dumping == DUMP_ROUTES && header->nlmsg_type == RTM_NEWROUTE)
+                    m_dumpRoutes[key] = route;
+                return;
+            }
+
+            if (header->nlmsg_type == RTM_NEWROUTE)
+            {
+                /* a replaced route keeps its family and metric but may move to another hop */
+                if (header->nlmsg_flags & NLM_F_REPLACE)
+                {
+                    for (auto it = m_routes.begin(); it != m_routes.end();)
+                    {
+                        if (it->second.family == route.family && it->second.metric == route.metric)
+                            it = m_routes.erase(it);
+                        else
+                            ++it;
+                    }
+                }
+                if (m_routes.find(key) != m_routes.end())
+                    return;
+                m_routes[key] = route;
+                if (m_dumping == DUMP_ROUTES)
+                    m_dumpRoutes[key] = route;
+            }
+            else
+            {
+                if (m_dumping == DUMP_ROUTES)
+                    m_dumpRoutes.erase(key);
+                if (m_routes.erase(key) == 0)
+                    return;
+            }
+            changes.routes.insert(route.family);
+        }
+
+        std::string RtnetlinkMonitor::nameOf(int index) const
+        {
+            auto it = m_links.find(index);
+            return (it == m_links.end()) ? std::string() : it->second.name;
+        }
+
+        bool RtnetlinkMonitor::getLink(const std::string& name, RtnetlinkLink& link) const
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (const auto& entry : m_links)
+            {
+                if (entry.second.name == name)
+                {
+                    link = entry.second;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::vector<RtnetlinkAddress> RtnetlinkMonitor::getAddresses(const std::string& name, int family) const
+        {
+            std::vector<RtnetlinkAddress> addresses;
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (const auto& entry : m_addresses)
+            {
+                if (entry.second.family == family && nameOf(entry.second.index) == name)
+                    addresses.push_back(entry.second);
+            }
+            return addresses;
+        }
+
+        bool RtnetlinkMonitor::getDefaultRoute(int family, RtnetlinkRoute& route, const std::string& interface) const
+        {
+            bool found = false;
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (const auto& entry : m_routes)
+            {
+                const RtnetlinkRoute& candidate = entry.second;
+                if (candidate.family != family || (!interface.empty() && nameOf(candidate.index) != interface))
+                    continue;
+                if (!found || candidate.metric < route.metric)
+                {
+                    route = candidate;
+                    found = true;
+                }
+            }
+            return found;
+        }
+
+        std::string RtnetlinkMonitor::getDefaultInterface() const
+        {
+            RtnetlinkRoute route;
+            if (getDefaultRoute(AF_INET, route) || getDefaultRoute(AF_INET6, route))
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                return nameOf(route.index);
+            }
+            return std::string();
+        }
+    } // Plugin
+} // WPEFramework
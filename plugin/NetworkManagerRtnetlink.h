@@ -0,0 +1,178 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <sys/socket.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "NetworkManagerIpAddr.h"
+
+#define NM_RTNETLINK_RCVBUF_SIZE        (1024 * 1024)   // socket buffer that absorbs a burst of kernel events
+#define NM_RTNETLINK_READ_SIZE          (32 * 1024)     // one recv(); netlink datagrams stay below this
+#define NM_RTNETLINK_SYNC_TIMEOUT_MS    2000            // how long start() waits for the first dump
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        struct RtnetlinkLink {
+            int index{0};
+            std::string name;
+            MacAddr mac;                        // not valid when the link has none
+            bool up{false};                     // IFF_UP, administratively up
+            bool lowerUp{false};                // IFF_LOWER_UP, carrier present
+
+            bool operator==(const RtnetlinkLink& other) const
+            {
+                return name == other.name && mac == other.mac && up == other.up && lowerUp == other.lowerUp;
+            }
+        };
+
+        struct RtnetlinkAddress {
+            int index{0};
+            int family{0};                      // AF_INET or AF_INET6
+            IpAddr address;
+            uint8_t prefix{0};
+            uint8_t scope{0};                   // RT_SCOPE_*
+
+            bool operator==(const RtnetlinkAddress& other) const
+            {
+                return prefix == other.prefix && scope == other.scope;
+            }
+        };
+
+        /* A default route of the main table */
+        struct RtnetlinkRoute {
+            int family{0};
+            int index{0};                       // outgoing interface
+            IpAddr gateway;                     // empty for a device route
+            uint32_t metric{0};
+
+            bool operator==(const RtnetlinkRoute&) const { return true; }
+        };
+
+        /* What one batch of kernel messages touched; only the keys, the state is queried */
+        struct RtnetlinkChanges {
+            std::set<std::string> links;                        // interface names
+            std::set<std::pair<std::string, int>> addresses;    // interface name, family
+            std::set<int> routes;                               // families whose default routes changed
+
+            bool empty() const { return links.empty() && addresses.empty() && routes.empty(); }
+        };
+
+        /*
+         * Follows links, addresses and default routes straight from the kernel. One
+         * NETLINK_ROUTE socket joins the link, address and route groups; a thread sleeps
+         * in poll() on it, drains every pending datagram when it wakes and decodes them
+         * all before the handler sees one RtnetlinkChanges for the lot. The state starts
+         * from link, address and route dumps; when the socket overruns it is dumped
+         * again, so no event loss is ever permanent. Tentative and DAD-failed IPv6
+         * addresses are left out until the kernel reports them usable.
+         */
+        class RtnetlinkMonitor
+        {
+        public:
+            using Handler = std::function<void(const RtnetlinkChanges& changes)>;
+
+            RtnetlinkMonitor() = default;
+            ~RtnetlinkMonitor();
+            RtnetlinkMonitor(const RtnetlinkMonitor&) = delete;
+            RtnetlinkMonitor& operator=(const RtnetlinkMonitor&) = delete;
+
+            /*
+             * Opens the socket in the calling thread's network namespace and starts the
+             * thread. Returns once the initial dumps completed, or false if the socket could
+             * not be set up. The handler runs on the monitor thread; the first call carries
+             * everything the dumps found.
+             */
+            bool start(Handler handler);
+            void stop();
+            bool running() const { return m_running.load(); }
+
+            bool getLink(const std::string& name, RtnetlinkLink& link) const;
+            /* Usable addresses of the interface for the family, sorted by address */
+            std::vector<RtnetlinkAddress> getAddresses(const std::string& name, int family) const;
+            /* Preferred default route (lowest metric) of the family, optionally only through interface */
+            bool getDefaultRoute(int family, RtnetlinkRoute& route, const std::string& interface = "") const;
+            /* Interface of the preferred IPv4 default route, else of the IPv6 one; empty if there is none */
+            std::string getDefaultInterface() const;
+
+            /* Applies every message of a datagram to the state and notes what changed */
+            void decode(const uint8_t* data, size_t length, RtnetlinkChanges& changes);
+
+            uint64_t messages() const { return m_messages.load(); }
+            uint64_t batches() const { return m_batches.load(); }
+            uint64_t overruns() const { return m_overruns.load(); }
+
+        private:
+            using AddressKey = std::tuple<int, int, IpAddr>;               // index, family, address
+            using RouteKey = std::tuple<int, int, IpAddr, uint32_t>;       // family, index, gateway, metric
+
+            enum DumpType { DUMP_LINKS, DUMP_ADDRESSES, DUMP_ROUTES, DUMP_NONE };
+
+            void run();
+            void requestResync();
+            bool sendDump(DumpType type);
+            void finishDump(RtnetlinkChanges& changes);
+            void onLink(const struct nlmsghdr* header, RtnetlinkChanges& changes);
+            void onAddress(const struct nlmsghdr* header, RtnetlinkChanges& changes);
+            void onRoute(const struct nlmsghdr* header, RtnetlinkChanges& changes);
+            /* caller holds m_lock */
+            std::string nameOf(int index) const;
+
+            int m_fd{-1};
+            int m_stopFd{-1};
+            uint32_t m_portId{0};
+            uint32_t m_sequence{0};
+            Handler m_handler;
+            std::thread m_thread;
+            std::atomic<bool> m_running{false};
+
+            /* Dumps run one at a time; replies collect in the m_dump* maps and replace the state on NLMSG_DONE */
+            std::vector<DumpType> m_pendingDumps;       /* only touched by the thread running the socket */
+            DumpType m_dumping{DUMP_NONE};
+            uint32_t m_dumpSequence{0};
+            bool m_synced{false};                       /* guarded by m_lock */
+            std::condition_variable m_syncCondition;
+
+            mutable std::mutex m_lock;
+            std::map<int, RtnetlinkLink> m_links;
+            std::map<AddressKey, RtnetlinkAddress> m_addresses;
+            std::map<RouteKey, RtnetlinkRoute> m_routes;
+            std::map<int, RtnetlinkLink> m_dumpLinks;
+            std::map<AddressKey, RtnetlinkAddress> m_dumpAddresses;
+            std::map<RouteKey, RtnetlinkRoute> m_dumpRoutes;
+
+            std::atomic<uint64_t> m_messages{0};
+            std::atomic<uint64_t> m_batches{0};
+            std::atomic<uint64_t> m_overruns{0};
+        };
+    } // Plugin
+} // WPEFramework
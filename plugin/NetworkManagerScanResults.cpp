@@ -0,0 +1,295 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+
+#include "NetworkManagerScanResults.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+
+    static const char* s_bandNames[] = { "0", "2.4", "5", "6" };
+
+    static void appendEscaped(std::string& json, std::string_view value)
+    {
+        static const char hex[] = "0123456789abcdef";
+        json += '"';
+        for (char ch : value)
+        {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '"' || c == '\\')
+            {
+                json += '\\';
+                json += ch;
+            }
+            else if (c < 0x20)
+            {
+                json += "\\u00";
+                json += hex[c >> 4];
+                json += hex[c & 0x0F];
+            }
+            else
+                json += ch;
+        }
+        json += '"';
+    }
+
+    void ScanResultSet::clear()
+    {
+        m_text.clear();
+        m_ssids.clear();
+        m_bssids.clear();
+        m_frequencies.clear();
+        m_strengths.clear();
+        m_securities.clear();
+    }
+
+    void ScanResultSet::reserve(size_t count)
+    {
+        /* an SSID is up to 32 bytes and a BSSID 17; most SSIDs are much shorter */
+        m_text.reserve(count * 32);
+        m_ssids.reserve(count);
+        m_bssids.reserve(count);
+        m_frequencies.reserve(count);
+        m_strengths.reserve(count);
+        m_securities.reserve(count);
+    }
+
+    ScanResultSet::TextRef ScanResultSet::store(std::string_view value)
+    {
+        TextRef ref{static_cast<uint32_t>(m_text.size()), static_cast<uint32_t>(value.size())};
+        m_text.append(value.data(), value.size());
+        return ref;
+    }
+
+    void ScanResultSet::add(std::string_view ssid, std::string_view bssid, uint32_t frequency, int16_t strength, uint8_t security)
+    {
+        m_ssids.push_back(store(ssid));
+        m_bssids.push_back(store(bssid));
+        m_frequencies.push_back(frequency);
+        m_strengths.push_back(strength);
+        m_securities.push_back(security);
+    }
+
+    ScanResultSet::Band ScanResultSet::bandFromFrequency(uint32_t frequency)
+    {
+        /* 6 GHz channels start at 5955 MHz (5925 MHz band edge), above the last 5 GHz channel */
+        if (frequency >= 2400 && frequency < 5000)
+            return BAND_2_4GHZ;
+        else if (frequency >= 5000 && frequency < 5925)
+            return BAND_5GHZ;
+        else if (frequency >= 5925)
+            return BAND_6GHZ;
+        return BAND_UNKNOWN;
+    }
+
+    bool ScanResultSet::parseBand(const std::string& token, Band& band)
+    {
+        char* end = nullptr;
+        double ghz = strtod(token.c_str(), &end);
+        if (token.empty() || end == nullptr || *end != '\0')
+            return false;
+        band = bandFromFrequency(static_cast<uint32_t>(std::lround(ghz * 1000)));
+        return band != BAND_UNKNOWN;
+    }
+
+    size_t ScanResultSet::filter(const std::vector<std::string>& ssidFilter, const std::vector<std::string>& frequencyFilter)
+    {
+        if (ssidFilter.empty() && frequencyFilter.empty())
+            return size();
+
+        /* the filter tokens are parsed once per scan, not once per AP */
+        uint8_t bandMask = frequencyFilter.empty() ? 0xFF : 0;
+        for (const auto& token : frequencyFilter)
+        {
+            Band band = BAND_UNKNOWN;
+            if (token == NM_SCAN_FILTER_ALL)
+                bandMask = 0xFF;
+            else if (parseBand(token, band))
+                bandMask |= (1 << band);
+            else
+                NMLOG_WARNING("ignoring invalid frequency filter '%s'", token.c_str());
+        }
+
+        std::unordered_set<std::string_view> ssids(ssidFilter.begin(), ssidFilter.end());
+        size_t kept = 0;
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (!(bandMask & (1 << band(i))))
+                continue;
+            if (!ssids.empty() && ssids.find(ssid(i)) == ssids.end())
+                continue;
+
+            if (kept != i)
+            {
+                m_ssids[kept] = m_ssids[i];
+                m_bssids[kept] = m_bssids[i];
+                m_frequencies[kept] = m_frequencies[i];
+                m_strengths[kept] = m_strengths[i];
+                m_securities[kept] = m_securities[i];
+            }
+            kept++;
+        }
+
+        /* the text of dropped entries stays in the buffer until clear() */
+        m_ssids.resize(kept);
+        m_bssids.resize(kept);
+        m_frequencies.resize(kept);
+        m_strengths.resize(kept);
+        m_securities.resize(kept);
+        return kept;
+    }
+
+    void ScanResultSet::entryToJson(size_t index, std::string& json) const
+    {
+        char number[16];
+        json += "{\"ssid\":";
+        appendEscaped(json, ssid(index));
+        json += ",\"bssid\":";
+        appendEscaped(json, bssid(index));
+        snprintf(number, sizeof(number), "%u", static_cast<unsigned int>(m_securities[index]));
+        json += ",\"security\":";
+        json += number;
+        snprintf(number, sizeof(number), "%d", static_cast<int>(m_strengths[index]));
+        json += ",\"strength\":";
+        json += number;
+        /* published as the band in GHz, the same values StartWiFiScan takes as filter */
+        json += ",\"frequency\":";
+        json += s_bandNames[band(index)];
+        json += '}';
+    }
+
+    void ScanResultSet::toJson(std::string& json) const
+    {
+        json.reserve(json.size() + size() * 96 + 2);
+        json += '[';
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (i > 0)
+                json += ',';
+            entryToJson(i, json);
+        }
+        json += ']';
+    }
+
+    void ScanResultIndex::reset()
+    {
+        m_entries.clear();
+        m_sequence = 0;
+    }
+
+    std::string ScanResultIndex::keyOf(const ScanResultSet& scan, size_t index)
+    {
+        /* backends that do not report the BSSID fall back to the SSID on each band */
+        if (!scan.bssid(index).empty())
+            return std::string(scan.bssid(index));
+        std::string key(scan.ssid(index));
+        key += '/';
+        key += s_bandNames[scan.band(index)];
+        return key;
+    }
+
+    bool ScanResultIndex::update(const ScanResultSet& scan, std::string& json)
+    {
+        std::vector<size_t> added;
+        std::vector<size_t> changed;
+
+        for (auto& entry : m_entries)
+            entry.second.seen = false;
+
+        for (size_t i = 0; i < scan.size(); i++)
+        {
+            auto result = m_entries.emplace(keyOf(scan, i), Entry{});
+            Entry& entry = result.first->second;
+            if (!result.second && entry.seen)
+                continue;   /* same AP listed twice in one scan */
+
+            bool isNew = result.second;
+            bool isChanged = false;
+            if (!isNew)
+            {
+                int delta = std::abs(static_cast<int>(scan.strength(i)) - static_cast<int>(entry.strength));
+                isChanged = (entry.ssid != scan.ssid(i)) || (entry.band != scan.band(i)) ||
+                            (entry.security != scan.security(i)) || (static_cast<uint32_t>(delta) >= m_hysteresis);
+            }
+
+            entry.seen = true;
+            if (isNew || isChanged)
+            {
+                entry.ssid.assign(scan.ssid(i));
+                entry.bssid.assign(scan.bssid(i));
+                entry.band = scan.band(i);
+                entry.strength = scan.strength(i);
+                entry.security = scan.security(i);
+                (isNew ? added : changed).push_back(i);
+            }
+        }
+
+        std::string removed;
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (it->second.seen)
+            {
+                ++it;
+                continue;
+            }
+            removed += removed.empty() ? "{\"ssid\":" : ",{\"ssid\":";
+            appendEscaped(removed, it->second.ssid);
+            removed += ",\"bssid\":";
+            appendEscaped(removed, it->second.bssid);
+            removed += '}';
+            it = m_entries.erase(it);
+        }
+
+        if (added.empty() && changed.empty() && removed.empty())
+            return false;
+
+        char number[24];
+        snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(++m_sequence));
+        json.reserve(json.size() + (added.size() + changed.size()) * 96 + removed.size() + 64);
+        json += "{\"sequence\":";
+        json += number;
+        json += ",\"added\":[";
+        for (size_t i = 0; i < added.size(); i++)
+        {
+            if (i > 0)
+                json += ',';
+            scan.entryToJson(added[i], json);
+        }
+        json += "],\"changed\":[";
+        for (size_t i = 0; i < changed.size(); i++)
+        {
+            if (i > 0)
+                json += ',';
+            scan.entryToJson(changed[i], json);
+        }
+        json += "],\"removed\":[";
+        json += removed;
+        json += "]}";
+        return true;
+    }
+
+    } // Plugin
+} // WPEFramework
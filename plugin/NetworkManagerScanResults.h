@@ -0,0 +1,145 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#define NM_SCAN_FILTER_ALL              "ALL"
+#define NM_SCAN_DELTA_HYSTERESIS        5       // dB a published strength has to move before it is reported again
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Scan results kept as parallel arrays. SSID and BSSID text lives in one shared
+         * buffer, so collecting a scan of a few hundred APs costs a handful of allocations.
+         * The set is filtered in place and serialized straight into the onAvailableSSIDs
+         * payload; no intermediate JsonObject is built.
+         */
+        class ScanResultSet
+        {
+        public:
+            enum Band : uint8_t {
+                BAND_UNKNOWN = 0,
+                BAND_2_4GHZ,
+                BAND_5GHZ,
+                BAND_6GHZ
+            };
+
+            void clear();
+            void reserve(size_t count);
+            size_t size() const { return m_frequencies.size(); }
+            bool empty() const { return m_frequencies.empty(); }
+
+            /* frequency in MHz, strength in dBm, security is the WIFISecurityMode value */
+            void add(std::string_view ssid, std::string_view bssid, uint32_t frequency, int16_t strength, uint8_t security);
+
+            std::string_view ssid(size_t index) const { return text(m_ssids[index]); }
+            std::string_view bssid(size_t index) const { return text(m_bssids[index]); }
+            uint32_t frequency(size_t index) const { return m_frequencies[index]; }
+            int16_t strength(size_t index) const { return m_strengths[index]; }
+            uint8_t security(size_t index) const { return m_securities[index]; }
+            Band band(size_t index) const { return bandFromFrequency(m_frequencies[index]); }
+
+            /*
+             * Keeps the entries whose SSID is in ssidFilter and whose band is in
+             * frequencyFilter ("2.4", "5", "6" or "ALL"). An empty filter matches
+             * everything. Returns the number of entries left.
+             */
+            size_t filter(const std::vector<std::string>& ssidFilter, const std::vector<std::string>& frequencyFilter);
+
+            /* Appends the set as the JSON array published by onAvailableSSIDs */
+            void toJson(std::string& json) const;
+            void entryToJson(size_t index, std::string& json) const;
+
+            static Band bandFromFrequency(uint32_t frequency);
+            static bool parseBand(const std::string& token, Band& band);
+
+        private:
+            struct TextRef {
+                uint32_t offset;
+                uint32_t length;
+            };
+
+            std::string_view text(const TextRef& ref) const { return std::string_view(m_text.data() + ref.offset, ref.length); }
+            TextRef store(std::string_view value);
+
+        private:
+            std::string m_text;
+            std::vector<TextRef> m_ssids;
+            std::vector<TextRef> m_bssids;
+            std::vector<uint32_t> m_frequencies;
+            std::vector<int16_t> m_strengths;
+            std::vector<uint8_t> m_securities;
+        };
+
+        /*
+         * BSSID keyed view of the last published scan, used for onAvailableSSIDsDelta.
+         * Each update reports the APs that appeared, disappeared or changed since the
+         * previous scan. A strength change is only reported once it moves by at least
+         * the hysteresis from the value last published for that AP.
+         */
+        class ScanResultIndex
+        {
+        public:
+            explicit ScanResultIndex(uint32_t hysteresis = NM_SCAN_DELTA_HYSTERESIS)
+                : m_hysteresis(hysteresis)
+            {
+            }
+
+            void setHysteresis(uint32_t hysteresis) { m_hysteresis = hysteresis; }
+            uint32_t hysteresis() const { return m_hysteresis; }
+            size_t size() const { return m_entries.size(); }
+            uint64_t sequence() const { return m_sequence; }
+            void reset();
+
+            /*
+             * Indexes the scan and writes the delta against the previous one as
+             * {"sequence":N,"added":[..],"changed":[..],"removed":[..]}. Returns false,
+             * leaving json untouched, when nothing changed. The sequence grows by one per
+             * delta so that a subscriber can tell when it missed one.
+             */
+            bool update(const ScanResultSet& scan, std::string& json);
+
+        private:
+            struct Entry {
+                std::string ssid;
+                std::string bssid;
+                ScanResultSet::Band band;
+                int16_t strength;
+                uint8_t security;
+                bool seen;
+            };
+
+            static std::string keyOf(const ScanResultSet& scan, size_t index);
+
+        private:
+            std::unordered_map<std::string, Entry> m_entries;
+            uint32_t m_hysteresis;
+            uint64_t m_sequence{0};
+        };
+    } // Plugin
+} // WPEFramework
@@ -21,9 +21,7 @@
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
-#include <condition_variable>
-#include <mutex>
-#include <thread>
+#include <list>
 #include <glib.h>
 #include <gio/gio.h>
 
@@ -31,15 +29,22 @@
 #include <libnm/NetworkManager.h>
 
 #include "NetworkManagerLogger.h"
+#include "NetworkManagerGlibReactor.h"
 #include "NetworkManagerSecretAgent.h"
 
+#define SECRET_AGENT_WAIT_SEC   10  // NetworkManager runs the WPS exchange meanwhile
+
 namespace WPEFramework
 {
     namespace Plugin
     {
-        std::condition_variable m_SecretsAgentCv;
-        std::mutex m_SecretsAgentMutex;
-        bool cvCondition = false;  // avoid spurious wakeup
+        /* GetSecrets calls answered later; only touched on the reactor thread */
+        struct PendingSecrets {
+            GDBusMethodInvocation *invocation;
+            guint timer;
+        };
+        static std::list<PendingSecrets> pendingSecrets;
+
         static const gchar interfaceXml[] =
             "<node>"
             "  <interface name='org.freedesktop.NetworkManager.SecretAgent'>"
@@ -66,6 +71,41 @@ namespace WPEFramework
             "  </interface>"
             "</node>";
 
+        static void returnNoSecrets(GDBusMethodInvocation *invocation)
+        {
+            g_dbus_method_invocation_return_value(invocation, g_variant_new("(a{sa{sv}})", NULL));
+        }
+
+        static gboolean pendingSecretsTimeoutCb(gpointer userData)
+        {
+            GDBusMethodInvocation *invocation = static_cast<GDBusMethodInvocation*>(userData);
+            for (auto it = pendingSecrets.begin(); it != pendingSecrets.end(); ++it)
+            {
+                if (it->invocation == invocation)
+                {
+                    pendingSecrets.erase(it);
+                    break;
+                }
+            }
+            NMLOG_INFO("SecretAgent wait time %d sec complete", SECRET_AGENT_WAIT_SEC);
+            returnNoSecrets(invocation);
+            return G_SOURCE_REMOVE;
+        }
+
+        static void releasePendingSecrets()
+        {
+            if (pendingSecrets.empty())
+                return;
+
+            NMLOG_INFO("SecretAgent received a cancel request. skipping %d sec wait", SECRET_AGENT_WAIT_SEC);
+            for (PendingSecrets& pending : pendingSecrets)
+            {
+                g_source_remove(pending.timer);
+                returnNoSecrets(pending.invocation);
+            }
+            pendingSecrets.clear();
+        }
+
         static void handleSecretsAgentMethods( GDBusConnection *connection, const gchar *sender,
             const gchar *object_path, const gchar *interface_name, const gchar *method_name,
             GVariant *parameters, GDBusMethodInvocation *invocation, gpointer user_data) {
@@ -85,6 +125,7 @@ namespace WPEFramework
                 GVariant *hints = NULL;
                 GVariant *flagVar = NULL;
                 guint flags=0;
+                bool deferReply = false;
 
                 g_variant_get(parameters, "(@a{sa{sv}}@o@s@as@u)",  &settingConn,  &connectionPath, &settingName, &hints, &flagVar);
 
@@ -101,8 +142,8 @@ namespace WPEFramework
                         flagStr += ", wps_pbc_active";
                     if(flags & NM_SECRET_AGENT_GET_SECRETS_FLAG_ALLOW_INTERACTION) {
                         flagStr += ", allow_interaction";
-                        /* wait for 10 sec mean time in the background networkmanager will do wps operation */
-                        SecretAgent::wait(10); // 10 sec
+                        /* answer in 10 sec; mean time in the background networkmanager will do wps operation */
+                        deferReply = true;
                     }
                     if(flags & NM_SECRET_AGENT_GET_SECRETS_FLAG_USER_REQUESTED)
                         flagStr += ", user_requested";
@@ -119,7 +160,15 @@ namespace WPEFramework
                 if(flagVar)
                     g_variant_unref(flagVar);
 
-                g_dbus_method_invocation_return_value(invocation, g_variant_new("(a{sa{sv}})", NULL));
+                if(deferReply)
+                {
+                    /* the reactor keeps serving other sources while NetworkManager waits for the reply */
+                    NMLOG_INFO("wait started %d Sec", SECRET_AGENT_WAIT_SEC);
+                    guint timer = g_timeout_add_full(G_PRIORITY_DEFAULT, SECRET_AGENT_WAIT_SEC * 1000, pendingSecretsTimeoutCb, invocation, NULL);
+                    pendingSecrets.push_back({invocation, timer});
+                }
+                else
+                    returnNoSecrets(invocation);
             }
             else if (g_strcmp0(method_name, "CancelGetSecrets") == 0)
             {
@@ -149,9 +198,10 @@ namespace WPEFramework
         SecretAgent::SecretAgent()
         {
             GError *error = NULL;
-            isSecretAgentLoopRunning = false;
             isSecurityAgentRegistered = false;
             NMLOG_INFO("SecretAgent Constructor");
+            /* constructed first, so the reactor outlives the agent */
+            GlibReactor::getInstance();
             GDBusconn = g_bus_get_sync(G_BUS_TYPE_SYSTEM, NULL, &error);
             if (!GDBusconn) {
                 NMLOG_ERROR("Failed to connect to system bus: %s", error->message);
@@ -170,63 +220,37 @@ namespace WPEFramework
                 g_object_unref(GDBusconn);
         }
 
-        void SecretAgent::wait(int timeoutInSec)
-        {
-            NMLOG_INFO("wait started %d Sec", timeoutInSec);
-            std::unique_lock<std::mutex> lock(m_SecretsAgentMutex);
-            if (m_SecretsAgentCv.wait_for(lock, std::chrono::seconds(timeoutInSec), [] { return cvCondition; })) {
-                NMLOG_INFO("SecretAgent received a cancel request. skipping %d sec wait", timeoutInSec);
-                // Reset the flag to avoid spurious wakeup on a condition variable
-                cvCondition = false;
-            } else {
-                NMLOG_INFO("SecretAgent wait time %d sec complete", timeoutInSec);
-            }
-        }
-
         void SecretAgent::stopWait()
         {
             NMLOG_INFO("stopWait Entry");
-            {
-                std::unique_lock<std::mutex> lock(m_SecretsAgentMutex);
-                cvCondition = true;
-            }
-            m_SecretsAgentCv.notify_one();
+            GlibReactor::getInstance()->post(releasePendingSecrets);
             NMLOG_INFO("stopWait Exit");
         }
 
-        void SecretAgent::SecretAgentLoop(SecretAgent* SecretAgentPtr)
+        bool SecretAgent::exportAgentObject()
         {
             GError *error = NULL;
-            GMainContext *secretAgentContext = NULL;
-            SecretAgent* agent = static_cast<SecretAgent*>(SecretAgentPtr);
-            secretAgentContext = g_main_context_new();
-            if(secretAgentContext == NULL)
+            if(agentRegID != 0)
             {
-                NMLOG_ERROR("Failed to create Security Agent gmain loop context");
-                return;
+                NMLOG_INFO("Security Agent already running.");
+                return true;
             }
 
-            g_main_context_push_thread_default(secretAgentContext);
-            agent->agentGmainLoop = g_main_loop_new(secretAgentContext, FALSE);
-            if(agent->agentGmainLoop == NULL)
+            if(agentNodeInfo == NULL)
             {
-                NMLOG_ERROR("Failed to create Security Agent gmain loop");
-                g_main_context_pop_thread_default(secretAgentContext);
-                g_main_context_unref(secretAgentContext);
-                return;
-            }
-
-            GDBusNodeInfo *node_info = g_dbus_node_info_new_for_xml(interfaceXml, &error);
-            if (!node_info) {
-                NMLOG_ERROR("Failed to parse XML: %s", error->message);
-                g_error_free(error);
-                return;
+                agentNodeInfo = g_dbus_node_info_new_for_xml(interfaceXml, &error);
+                if (!agentNodeInfo) {
+                    NMLOG_ERROR("Failed to parse XML: %s", error->message);
+                    g_error_free(error);
+                    return false;
+                }
             }
 
-            guint agentRegID = g_dbus_connection_register_object(
-                            agent->GDBusconn,
+            /* method calls are dispatched to the thread default context, here the reactor context */
+            agentRegID = g_dbus_connection_register_object(
+                            GDBusconn,
                             "/org/freedesktop/NetworkManager/SecretAgent",
-                            g_dbus_node_info_lookup_interface(node_info, "org.freedesktop.NetworkManager.SecretAgent"),  // Interface,
+                            g_dbus_node_info_lookup_interface(agentNodeInfo, "org.freedesktop.NetworkManager.SecretAgent"),  // Interface,
                             &interfaceVtable,
                             NULL,
                             NULL,
@@ -239,47 +263,41 @@ namespace WPEFramework
                     NMLOG_ERROR("Error : %s", error->message);
                     g_error_free(error);
                 }
-                g_dbus_node_info_unref(node_info);
-                return;
+                return false;
             }
 
             NMLOG_INFO("Object registered with ID: %u", agentRegID);
-            NMLOG_DEBUG("Security Agent gmain loop running...");
-            g_main_loop_run(agent->agentGmainLoop);
-
-            g_main_loop_unref(agent->agentGmainLoop);
-            g_dbus_connection_unregister_object(agent->GDBusconn, agentRegID);
-            g_dbus_node_info_unref(node_info);
-            g_main_context_pop_thread_default(secretAgentContext);
-            g_main_context_unref(secretAgentContext);
-            agent->isSecretAgentLoopRunning = false;
-            NMLOG_WARNING("Security Agent loop ended !");
+            return true;
         }
 
-        void SecretAgent::startSecurityAgent()
+        void SecretAgent::unexportAgentObject()
         {
-            NMLOG_DEBUG("staring Security Agent...");
-            if(isSecretAgentLoopRunning)
+            releasePendingSecrets();
+            if(agentRegID != 0)
             {
-                NMLOG_INFO("Security Agent already running.");
-                return;
+                g_dbus_connection_unregister_object(GDBusconn, agentRegID);
+                agentRegID = 0;
+            }
+            if(agentNodeInfo != NULL)
+            {
+                g_dbus_node_info_unref(agentNodeInfo);
+                agentNodeInfo = NULL;
             }
+        }
 
-            isSecretAgentLoopRunning = true;
-            agentThrID = std::thread(&SecretAgentLoop, this);
+        void SecretAgent::startSecurityAgent()
+        {
+            NMLOG_DEBUG("staring Security Agent...");
+            if(GDBusconn == NULL)
+                return;
+            GlibReactor::getInstance()->run<bool>([this]() { return exportAgentObject(); });
         }
 
         void SecretAgent::stopSecurityAgent()
         {
-            stopWait();
-            if (agentGmainLoop) {
-                g_main_loop_quit(agentGmainLoop);
-            }
-
-            if (agentThrID.joinable()) {
-                agentThrID.join();
-            }
-
+            if(GDBusconn == NULL)
+                return;
+            GlibReactor::getInstance()->run<void>([this]() { unexportAgentObject(); });
             NMLOG_INFO("Security Agent stopped.");
         }
 
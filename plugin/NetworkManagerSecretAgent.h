@@ -19,6 +19,7 @@
 
 #pragma once
 #include <gio/gio.h>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <list>
@@ -30,6 +31,11 @@ namespace WPEFramework
 {
     namespace Plugin
     {
+        /*
+         * NetworkManager secret agent object. It is exported on the GlibReactor thread,
+         * and a GetSecrets that allows interaction is answered later, from a timer or
+         * from stopWait(), instead of holding up the reactor.
+         */
         class SecretAgent
         {
             public:
@@ -39,14 +45,16 @@ namespace WPEFramework
                 void stopSecurityAgent();
                 bool RegisterAgent();
                 bool UnregisterAgent();
-                static void SecretAgentLoop(SecretAgent* agent);
-                static void wait(int timeout);
+                /* answers every pending GetSecrets now */
                 static void stopWait();
             private:
-                std::atomic<bool> isSecretAgentLoopRunning;
-                GMainLoop *agentGmainLoop = nullptr;
+                /* both run on the reactor thread */
+                bool exportAgentObject();
+                void unexportAgentObject();
+
                 GDBusConnection *GDBusconn;
-                std::thread agentThrID;
+                GDBusNodeInfo *agentNodeInfo = nullptr;
+                guint agentRegID = 0;
                 std::atomic<bool> isSecurityAgentRegistered;
         };
     } // Plugin
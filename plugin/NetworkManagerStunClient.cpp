@@ -23,6 +23,7 @@
 #include <fcntl.h>
 #include <ifaddrs.h>
 #include <netdb.h>
+#include <poll.h>
 #include <net/if.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -38,8 +39,6 @@
 #include <thread>
 #include <iostream>
 
-#define STUN_DEFAULT_WAIT_INTERVAL 2000 //miliseconds
-#define STUN_DEFAULT_MAX_ATTEMPTS 30
 
 //#define _STUN_DEBUG 1
 //#define _STUN_USE_MSGHDR
@@ -61,21 +60,32 @@ namespace details {
   public:
     file_descriptor(int n) : m_fd(n) { }
     ~file_descriptor() {
-      if (m_fd > 0)
-        close(m_fd);
+      reset(-1);
     }
+    file_descriptor(file_descriptor const &) = delete;
+    file_descriptor & operator=(file_descriptor const &) = delete;
     operator int() const { return m_fd; }
+    void reset(int n) {
+      if (m_fd >= 0)
+        close(m_fd);
+      m_fd = n;
+    }
+    int release() {
+      int n = m_fd;
+      m_fd = -1;
+      return n;
+    }
   private:
     int m_fd;
   };
 
 #ifdef _STUN_DEBUG
-  void dump_buffer(char const * prefix, buffer const & buff)
+  void dump_buffer(char const * prefix, uint8_t const * buff, size_t size)
   {
     if (prefix)
       printf("%s", prefix);
-    for (uint8_t b : buff)
-      printf("0x%02x ", b);
+    for (size_t i = 0; i < size; ++i)
+      printf("0x%02x ", buff[i]);
     printf("\n");
     return;
   }
@@ -122,7 +132,7 @@ namespace details {
     for (auto * addr = address_list; addr != nullptr; addr = addr->ifa_next) {
       if (iface != addr->ifa_name)
         continue;
-      if (family != addr->ifa_addr->sa_family)
+      if (!addr->ifa_addr || family != addr->ifa_addr->sa_family)
         continue;
       iface_info = * reinterpret_cast<sockaddr_storage *>(addr->ifa_addr);
       iface_info.ss_family = addr->ifa_addr->sa_family;
@@ -253,62 +263,134 @@ namespace details {
 
 attribute const * message::find_attribute(uint16_t attr_type) const
 {
-  std::vector<attribute>::const_iterator itr = std::find_if (
-    std::begin(m_attrs), std::end(m_attrs), [attr_type](attribute const & attr) {
-      return attr_type == attr.type;
-    });
-  if (itr == m_attrs.end())
-    return nullptr;
-  attribute const & temp = *itr;
-  return &temp;
+  for (attribute const & attr : *this) {
+    if (attr.type == attr_type)
+      return &attr;
+  }
+  return nullptr;
 }
 
+bool message::add_attribute(uint16_t type, uint8_t const * value, uint16_t length)
+{
+  if (m_attr_count == m_attrs.size())
+    return false;
+  m_attrs[m_attr_count++] = attribute{type, length, value};
+  return true;
+}
 
-buffer message::encode() const
+size_t message::encode(packet & out) const
 {
-  buffer bytes;
-  encoder::encode_u16(bytes, m_header.message_type);
-  encoder::encode_u16(bytes, m_header.message_length);
-  for (uint8_t b : m_header.transaction_id)
-    bytes.push_back(static_cast<uint8_t>(b));
-  for (attribute const & v : m_attrs) {
-    encoder::encode_u16(bytes, v.type);
-    encoder::encode_u16(bytes, v.length);
-    bytes.insert(std::end(bytes), std::begin(v.value), std::end(v.value));
+  size_t offset = 0;
+  uint8_t * bytes = out.data();
+  // the length is recomputed from the attributes, padded as in RFC 5389 section 15
+  size_t length = 0;
+  for (attribute const & v : *this)
+    length += 4 + ((v.length + 3) & ~size_t(3));
+  if (header_size + length > out.size())
+    return 0;
+
+  encoder::encode_u16(bytes, out.size(), offset, m_header.message_type);
+  encoder::encode_u16(bytes, out.size(), offset, static_cast<uint16_t>(length));
+  memcpy(bytes + offset, m_header.transaction_id.data(), m_header.transaction_id.size());
+  offset += m_header.transaction_id.size();
+  for (attribute const & v : *this) {
+    encoder::encode_u16(bytes, out.size(), offset, v.type);
+    encoder::encode_u16(bytes, out.size(), offset, v.length);
+    if (v.length)
+      memcpy(bytes + offset, v.value, v.length);
+    size_t padded = (v.length + 3) & ~size_t(3);
+    memset(bytes + offset + v.length, 0, padded - v.length);
+    offset += padded;
   }
-  return bytes;
+  return offset;
 }
 
-message * message_factory::create_binding_request()
+bool message::is_rfc5389() const
 {
-  message * change_request = new message();
-  change_request->m_header.message_type = 1;
-  change_request->m_header.message_length = 8;
-  details::random_fill(std::begin(change_request->m_header.transaction_id),
-    std::end(change_request->m_header.transaction_id));
-
-  // CHANGE-REQUEST
-  change_request->m_attrs.push_back({3, 4, {0, 0, 0, 0}});
+  return m_header.transaction_id[0] == ((magic_cookie >> 24) & 0xff)
+      && m_header.transaction_id[1] == ((magic_cookie >> 16) & 0xff)
+      && m_header.transaction_id[2] == ((magic_cookie >> 8) & 0xff)
+      && m_header.transaction_id[3] == (magic_cookie & 0xff);
+}
 
-  return change_request;
+void message_factory::create_binding_request(message & request)
+{
+  // RFC 5389 binding request: no attributes, the magic cookie followed by a
+  // 96 bit random transaction id. RFC 3489 servers treat the whole 128 bits as
+  // the transaction id and answer with MAPPED-ADDRESS.
+  request = message();
+  request.m_header.message_type = message_type::binding_request;
+  request.m_header.message_length = 0;
+  request.m_header.transaction_id[0] = (magic_cookie >> 24) & 0xff;
+  request.m_header.transaction_id[1] = (magic_cookie >> 16) & 0xff;
+  request.m_header.transaction_id[2] = (magic_cookie >> 8) & 0xff;
+  request.m_header.transaction_id[3] = magic_cookie & 0xff;
+  details::random_fill(std::begin(request.m_header.transaction_id) + 4,
+    std::end(request.m_header.transaction_id));
 }
 
 client::client()
-    : m_server("", 0)
-    , m_protocol(protocol::af_inet)
-    , m_interface("")
-    , m_bind_timeout(30)
-    , m_cache_timeout(30)
-    , m_last_cache_time()
-    , m_last_result()
-    , m_fd(-1)
 {
 }
 
 client::~client()
 {
-  if (m_fd != -1)
-    close(m_fd);
+}
+
+void client::clear_cache()
+{
+    std::lock_guard<std::mutex> lock(m_cache_lock);
+    m_cache.clear();
+}
+
+bool client::cached_result(cache_key const & key, uint16_t cache_timeout, bind_result& result)
+{
+    if(cache_timeout == 0)  /*caching disabled*/
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_cache_lock);
+    auto it = m_cache.find(key);
+    if(it == m_cache.end() || !it->second.result.is_valid())
+        return false;
+
+    auto time_in_cache = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - it->second.time);
+
+    NMLOG_DEBUG("client::bind cache time=%lld", (long long int) time_in_cache.count());
+
+    if(time_in_cache.count() >= cache_timeout)
+    {
+        NMLOG_DEBUG("client::bind cached result expired");
+        m_cache.erase(it);
+        return false;
+    }
+
+    result = it->second.result;
+    return true;
+}
+
+void client::store_result(cache_key const & key, uint16_t cache_timeout, bind_result const & result)
+{
+    if(cache_timeout == 0)
+        return;
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_cache_lock);
+    /*entries of an old server or a removed interface would otherwise stay forever*/
+    for(auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        if(now - it->second.time >= std::chrono::seconds(cache_timeout))
+            it = m_cache.erase(it);
+        else
+            ++it;
+    }
+    m_cache[key] = cache_entry{result, now};
+}
+
+void client::set_retransmission(retransmission const & schedule)
+{
+    std::lock_guard<std::mutex> lock(m_cache_lock);
+    m_retransmission = schedule;
 }
 
 bool client::bind(
@@ -320,165 +402,239 @@ bool client::bind(
     uint16_t cache_timeout,
     bind_result& result)
 {
-    /*if params change then we force a bind request now instead of using any cached value*/
-    bool dirty = false;
-    bool ret_ok = false;
+    return bind(std::vector<server>{server(hostname, port)}, interface, proto, bind_timeout, cache_timeout, result);
+}
 
-    if(m_server.hostname != hostname)
+bool client::bind(
+    std::vector<server> const & servers,
+    std::string const & interface,
+    protocol proto,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& result)
+{
+    cache_key key{interface, proto, ""};
+    for (server const & srv : servers)
     {
-        m_server.hostname = hostname;
-        dirty = true;
+        if (!key.servers.empty())
+            key.servers += ",";
+        key.servers += srv.hostname + ":" + std::to_string(srv.port);
     }
 
-    if(m_server.port != port)
-    {
-        m_server.port = port;
-        dirty = true;
-    }
+    NMLOG_DEBUG("client::bind enter: servers=%s iface=%s ipv6=%u timeout=%u cache_timeout=%u",
+        key.servers.c_str(), interface.c_str(), proto == stun::protocol::af_inet6, bind_timeout, cache_timeout);
 
-    if(m_interface != interface)
+    if(cached_result(key, cache_timeout, result))
     {
-      m_interface = interface;
-      dirty = true;
+        NMLOG_DEBUG("client::bind returning cached result: %s", result.public_ip.c_str());
+        return true;
     }
 
-    if(m_protocol != proto)
+    if(bind_uncached(servers, interface, proto, bind_timeout, result))
     {
-      m_protocol = proto;
-      dirty = true;
+        store_result(key, cache_timeout, result);
+        return true;
     }
+    return false;
+}
 
-    if(m_bind_timeout != bind_timeout)
-    {
-      m_bind_timeout = bind_timeout;
-      dirty = true;
-    }
+bool client::bind_dual_stack(
+    std::string const & hostname,
+    uint16_t port,
+    std::string const & interface,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& ipv4_result,
+    bind_result& ipv6_result)
+{
+    return bind_dual_stack(std::vector<server>{server(hostname, port)}, interface, bind_timeout, cache_timeout, ipv4_result, ipv6_result);
+}
 
-    if(m_cache_timeout != cache_timeout)
-    {
-      m_cache_timeout = cache_timeout;
-      dirty = true;
-    }
+bool client::bind_dual_stack(
+    std::vector<server> const & servers,
+    std::string const & interface,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& ipv4_result,
+    bind_result& ipv6_result)
+{
+    /*the IPv6 request runs on its own thread while this one sends the IPv4 request*/
+    std::thread ipv6_thread([&]() {
+        bind(servers, interface, protocol::af_inet6, bind_timeout, cache_timeout, ipv6_result);
+    });
+    bool ipv4_ok = bind(servers, interface, protocol::af_inet, bind_timeout, cache_timeout, ipv4_result);
+    ipv6_thread.join();
 
-    NMLOG_DEBUG("client::bind enter: server=%s port=%u iface=%s ipv6=%u timeout=%u cache_timeout=%u dirty=%u",
-        hostname.c_str(), port, interface.c_str(), proto == stun::protocol::af_inet6, bind_timeout, cache_timeout, dirty);
+    NMLOG_DEBUG("client::bind_dual_stack: ipv4=%s ipv6=%s", ipv4_result.public_ip.c_str(), ipv6_result.public_ip.c_str());
+    return ipv4_ok || ipv6_result.is_valid();
+}
 
-    if(m_cache_timeout > 0        /*asking if caching is enabled*/
-    && !dirty                     /*if dirty then the caller has changed our settings and wants a new bind no matter what*/
-    && m_last_result.is_valid())  /*we actually have a valid cached response*/
-    {
-        auto time_in_cache = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::steady_clock::now() - m_last_cache_time);
+namespace details {
+  /* one binding request in flight to one server address, on its own socket */
+  struct transaction {
+    transaction(int n) : fd(n) { }
+    file_descriptor fd;
+    sockaddr_storage addr = {};
+    message request;
+    packet bytes;
+    size_t length = 0;
+  };
 
-        NMLOG_DEBUG("client::bind cache time=%lld", (long long int) time_in_cache.count());
+  /* the public address from a response to request, or false if it is not a valid answer */
+  bool mapped_address_of(message const & request, message const & response, sockaddr_storage & addr)
+  {
+    if (response.header().transaction_id != request.header().transaction_id)
+      return false;
+
+    attribute const * attr = response.find_attribute(attribute_type::xor_mapped_address);
+    if (attr && response.is_rfc5389() && attributes::address::decode(*attr, &response.header().transaction_id, addr))
+      return true;
+    attr = response.find_attribute(attribute_type::mapped_address);
+    if (attr && attributes::address::decode(*attr, nullptr, addr))
+      return true;
+    NMLOG_DEBUG("client::bind: ip missing from binding response");
+    return false;
+  }
+}
 
-        if(time_in_cache.count() < m_cache_timeout)
-        {
-            result = m_last_result;
+bool client::bind_uncached(std::vector<server> const & servers, std::string const & interface,
+    protocol proto, uint16_t bind_timeout, bind_result& result)
+{
+    using clock = std::chrono::steady_clock;
+    bool ret_ok = false;
+    retransmission schedule;
+    {
+        std::lock_guard<std::mutex> lock(m_cache_lock);
+        schedule = m_retransmission;
+    }
+    clock::time_point const deadline = clock::now() + std::chrono::seconds(bind_timeout);
 
-            NMLOG_DEBUG("client::bind returning cached result: %s", result.public_ip.c_str());
-            return true;
+    /*one socket and transaction per server address; a server that fails to resolve does not stop the others*/
+    std::vector<std::unique_ptr<details::transaction>> transactions;
+    for (server const & srv : servers)
+    {
+        #ifdef __cpp_exceptions
+        try
+        #endif
+        {
+            for (sockaddr_storage const & addr : details::resolve_hostname(srv.hostname, srv.port, proto))
+            {
+                std::unique_ptr<details::transaction> t(new details::transaction(create_udp_socket(addr.ss_family, interface)));
+                if (t->fd < 0)
+                    continue;
+                t->addr = addr;
+                message_factory::create_binding_request(t->request);
+                t->length = t->request.encode(t->bytes);
+                transactions.push_back(std::move(t));
+            }
         }
-        else
+        #ifdef __cpp_exceptions
+        catch (std::exception const & err)
         {
-            NMLOG_DEBUG("client::client::bind cached result expired");
+            NMLOG_WARNING("client::bind skipping server %s: %s", srv.hostname.c_str(), err.what());
         }
+        #endif
     }
 
-    #ifdef __cpp_exceptions
-    try
-    #endif
+    if (transactions.empty())
     {
-        int interval_wait_time = STUN_DEFAULT_WAIT_INTERVAL;
-        int num_attempts = STUN_DEFAULT_MAX_ATTEMPTS;
-        int total_time = 0;
-        int sleep_time = 1;
+        NMLOG_WARNING("client::bind failed: no usable server");
+        result.invalidate();
+        return false;
+    }
 
-        std::chrono::milliseconds wait_time(interval_wait_time);
-        for (int i = 0; i < num_attempts && total_time < m_bind_timeout; ++i)
+    packet response;
+    message binding_response;
+    std::vector<pollfd> fds(transactions.size());
+    std::chrono::milliseconds rto = schedule.rto;
+    for (int attempt = 0; attempt < schedule.max_requests && !ret_ok && clock::now() < deadline; ++attempt)
+    {
+        for (size_t i = 0; i < transactions.size(); ++i)
         {
-            NMLOG_DEBUG("client::bind sending bind request");
-
-            std::unique_ptr<stun::message> binding_response = send_binding_request(wait_time);
+            details::transaction & t = *transactions[i];
+            ssize_t n = sendto(t.fd, t.bytes.data(), t.length, 0,
+                reinterpret_cast<sockaddr const *>(&t.addr), details::socket_length(t.addr));
+            if (n < 0)
+                NMLOG_DEBUG("client::bind send to %s failed: %s", sockaddr_to_string(t.addr).c_str(), strerror(errno));
+            fds[i] = { t.fd, POLLIN, 0 };
+        }
+        NMLOG_DEBUG("client::bind request %d sent to %zu addresses, rto %lld ms", attempt + 1, transactions.size(), (long long int) rto.count());
 
-            total_time += interval_wait_time;/*FXIME should do a clock delta and not use wait_time which is the max*/
-            /*do a multiple of 2 sleep -- FIXIME should use cond variable so user to cancel this*/
-            if (i > 0)
+        bool last = (attempt + 1 == schedule.max_requests);
+        clock::time_point wait_until = std::min(deadline, clock::now() + (last ? schedule.rto * schedule.last_wait_factor : rto));
+        while (!ret_ok)
+        {
+            /*rounded up: a sub-millisecond remainder must not turn into a busy loop of retransmits*/
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(wait_until - clock::now()).count();
+            if (remaining <= 0)
+                break;
+            int ready = poll(fds.data(), fds.size(), static_cast<int>(remaining));
+            if (ready < 0 && errno != EINTR)
             {
-                if (total_time + sleep_time > m_bind_timeout)
-                    sleep_time = m_bind_timeout - total_time;
-                if (sleep_time < 0)
-                    break;
-                sleep(sleep_time);
-                total_time += sleep_time;
-                if (sleep_time < 32)/*put some max limit on how long we wait*/
-                    sleep_time *= 2;
+                NMLOG_WARNING("client::bind poll failed: %s", strerror(errno));
+                break;
             }
-            if (binding_response)
+            for (size_t i = 0; ready > 0 && i < fds.size() && !ret_ok; ++i)
             {
-                stun::attribute const * mapped_address = binding_response->find_attribute(stun::attribute_type::mapped_address);
-                if (mapped_address)
+                if (!(fds[i].revents & POLLIN))
+                    continue;
+                ssize_t n = recv(fds[i].fd, response.data(), response.size(), 0);
+                if (n <= 0)
+                    continue;
+
+                sockaddr_storage addr = {};
+                if (!decoder::decode_message(response, static_cast<size_t>(n), binding_response))
                 {
-                    sockaddr_storage addr = stun::attributes::mapped_address(*mapped_address).addr();
-
-                    result.public_ip = m_last_result.public_ip = stun::sockaddr_to_string(addr);
-
-                    m_last_cache_time = std::chrono::steady_clock::now();
-
-                    NMLOG_DEBUG("client::bind success: public_ip=%s", result.public_ip.c_str());
-
-                    ret_ok = true;
+                    NMLOG_DEBUG("client::bind ignoring malformed response of %zd bytes", n);
+                    continue;
                 }
-                else
+                if (details::mapped_address_of(transactions[i]->request, binding_response, addr))
                 {
-                    NMLOG_DEBUG("client::bind failed: ip missing from binding response");
+                    result.public_ip = stun::sockaddr_to_string(addr);
+                    NMLOG_DEBUG("client::bind success: public_ip=%s from %s", result.public_ip.c_str(),
+                        sockaddr_to_string(transactions[i]->addr).c_str());
+                    ret_ok = true;
                 }
             }
-            else
-            {
-                NMLOG_INFO("client::bind failed: no response received from server");
-            }
         }
-    }
-#ifdef __cpp_exceptions
-    catch (std::exception const & err)
-    {
-        NMLOG_WARNING("client::bind failed: %s", err.what());
-    }
-#endif
-
-    if (m_fd != -1)
-    {
-        close(m_fd);
-        m_fd = -1;
+        rto *= 2;
     }
 
     if(!ret_ok)
+    {
+      NMLOG_INFO("client::bind failed: no response received from %zu server addresses", transactions.size());
       result.invalidate();
+    }
 
     return ret_ok;
 }
 
-void client::create_udp_socket(int inet_family)
+int client::create_udp_socket(int inet_family, std::string const & interface)
 {
-  if (inet_family != AF_INET && inet_family != AF_INET6)
+  if (inet_family != AF_INET && inet_family != AF_INET6) {
     details::throw_error("invalid inet family:%d", inet_family);
+    return -1;
+  }
 
   NMLOG_DEBUG("creating udp/%s socket", details::family_to_string(inet_family));
 
   int soc = socket(inet_family, SOCK_DGRAM | SOCK_CLOEXEC, 0);
-  if (soc < 0)
+  if (soc < 0) {
     details::throw_error("error creating socket. %s", strerror(errno));
+    return -1;
+  }
 
   #ifdef _STUN_USE_MSGHDR
   int optval = 1;
   setsockopt(soc, IPPROTO_IP, IP_PKTINFO, &optval, sizeof(int));
   #endif
 
-  if (!m_interface.empty()) {
-    sockaddr_storage local_addr = details::get_interface_address(m_interface, inet_family);
+  if (!interface.empty()) {
+    details::file_descriptor guard(soc);
+    sockaddr_storage local_addr = details::get_interface_address(interface, inet_family);
+    guard.release();
 
-    NMLOG_DEBUG("binding to local interface %s/%s", m_interface.c_str(),
+    NMLOG_DEBUG("binding to local interface %s/%s", interface.c_str(),
       sockaddr_to_string(local_addr).c_str());
 
     int ret = ::bind(soc, reinterpret_cast<sockaddr const *>(&local_addr), details::socket_length(local_addr));
@@ -487,6 +643,7 @@ void client::create_udp_socket(int inet_family)
       close(soc);
       details::throw_error("failed to bind socket to local address '%s'. %s",
           sockaddr_to_string(local_addr).c_str(), strerror(err));
+      return -1;
     }
     else {
         sockaddr_storage local_endpoint;
@@ -500,41 +657,38 @@ void client::create_udp_socket(int inet_family)
   else
     NMLOG_DEBUG("no local interface supplied to bind to");
 
-  if (m_fd != -1)
-    close(m_fd);
-  m_fd = soc;
-  return;
+  return soc;
 }
 
-message * client::send_message(sockaddr_storage const & remote_addr, message const & req,
-  std::chrono::milliseconds wait_time, int * local_iface_index)
+bool client::send_message(int fd, sockaddr_storage const & remote_addr, message const & req,
+  std::chrono::milliseconds wait_time, packet & bytes, message & response, int * local_iface_index)
 {
-  if (m_fd < 0)
-      return nullptr;
+  if (fd < 0)
+      return false;
 
-  buffer bytes = req.encode();
+  size_t length = req.encode(bytes);
+  if (length == 0)
+      return false;
 
   NMLOG_DEBUG("remote_addr:%s", sockaddr_to_string(remote_addr).c_str());
 
   #ifdef _STUN_DEBUG
-  details::dump_buffer("STUN >>> ", bytes);
+  details::dump_buffer("STUN >>> ", bytes.data(), length);
   #endif
 
   NMLOG_DEBUG("sending messsage");
 
-  ssize_t n = sendto(m_fd, &bytes[0], bytes.size(), 0, (sockaddr *) &remote_addr, details::socket_length(remote_addr));
-  if (n < 0)
+  ssize_t n = sendto(fd, bytes.data(), length, 0, (sockaddr *) &remote_addr, details::socket_length(remote_addr));
+  if (n < 0) {
     details::throw_error("failed to send packet. %s", strerror(errno));
-
-  bytes.resize(0);
-  bytes.reserve(256);
-  bytes.resize(256);
+    return false;
+  }
 
   sockaddr_storage from_addr = {};
 
   fd_set rfds;
   FD_ZERO(&rfds);
-  FD_SET(m_fd, &rfds);
+  FD_SET(fd, &rfds);
 
   timeval timeout;
   timeout.tv_usec = 1000 * wait_time.count();
@@ -546,10 +700,10 @@ message * client::send_message(sockaddr_storage const & remote_addr, message con
     timeout.tv_usec -= (timeout.tv_sec * kMicrosecondsPerSecond);
   }
   NMLOG_DEBUG("waiting for response, timeout set to %lus - %luus", timeout.tv_sec, timeout.tv_usec);
-  int ret = select(m_fd + 1, &rfds, nullptr, nullptr, &timeout);
-  if (ret == 0) {
+  int ret = select(fd + 1, &rfds, nullptr, nullptr, &timeout);
+  if (ret <= 0) {
     NMLOG_DEBUG("select timeout out");
-    return nullptr;
+    return false;
   }
 
   //
@@ -574,7 +728,7 @@ message * client::send_message(sockaddr_storage const & remote_addr, message con
     struct msghdr msg = {};
     struct iovec iov = {};
 
-    iov.iov_base = &bytes[0];
+    iov.iov_base = bytes.data();
     iov.iov_len = bytes.size();
 
     msg.msg_flags = 0;
@@ -585,7 +739,7 @@ message * client::send_message(sockaddr_storage const & remote_addr, message con
     msg.msg_name = &from_addr;
     msg.msg_namelen = sizeof(from_addr);
 
-    n = recvmsg(m_fd, &msg, 0);
+    n = recvmsg(fd, &msg, 0);
     if ((n > 0) && local_iface_index) {
       for (cmsghdr * cptr = CMSG_FIRSTHDR(&msg); cptr; cptr = CMSG_NXTHDR(&msg, cptr)) {
         if (cptr->cmsg_level == IPPROTO_IP) {
@@ -600,33 +754,42 @@ message * client::send_message(sockaddr_storage const & remote_addr, message con
   #else
   do {
     socklen_t len = sizeof(sockaddr_storage);
-    n = recvfrom(m_fd, &bytes[0], bytes.size(), MSG_WAITALL, (sockaddr *) &from_addr, &len);
+    n = recvfrom(fd, bytes.data(), bytes.size(), 0, (sockaddr *) &from_addr, &len);
   } while (n == -2 && errno == EINTR);
   #endif
 
-  if (n < 0)
+  if (n < 0) {
     details::throw_error("error receiving on socket. %s", strerror(errno));
-  else
-    bytes.resize(n);
+    return false;
+  }
 
   #ifdef _STUN_DEBUG
-  details::dump_buffer("STUN <<< ", bytes);
+  details::dump_buffer("STUN <<< ", bytes.data(), n);
   #endif
 
-  return decoder::decode_message(bytes, nullptr);
+  #ifndef _STUN_USE_MSGHDR
+  (void) local_iface_index;
+  #endif
+
+  return decoder::decode_message(bytes, static_cast<size_t>(n), response)
+      && response.header().transaction_id == req.header().transaction_id;
 }
 
-network_access_type client::discover_network_access_type(server const & srv)
+network_access_type client::discover_network_access_type(server const & srv, protocol proto, std::string const & interface)
 {
   std::chrono::milliseconds wait_time(250);
-  std::vector<sockaddr_storage> addrs = details::resolve_hostname(srv.hostname, srv.port, m_protocol);
+  std::vector<sockaddr_storage> addrs = details::resolve_hostname(srv.hostname, srv.port, proto);
 
   sockaddr_storage server_addr = {};
 
-  std::unique_ptr<message> binding_response;
+  packet response_bytes;
+  message binding_response;
+  bool answered = false;
+  details::file_descriptor fd(-1);
   for (sockaddr_storage const & addr : addrs) {
-    binding_response = this->send_binding_request(addr, wait_time);
-    if (binding_response) {
+    fd.reset(this->create_udp_socket(addr.ss_family, interface));
+    answered = this->send_binding_request(fd, addr, wait_time, response_bytes, binding_response);
+    if (answered) {
       server_addr = addr;
       break;
     }
@@ -634,14 +797,14 @@ network_access_type client::discover_network_access_type(server const & srv)
       wait_time = std::min(wait_time * 2, details::binding_requests_wait_time_max);
   }
 
-  if (!binding_response)
+  if (!answered)
     return network_access_type::udp_blocked;
 
   // get endpoint binding_request was sent from and compare to the binding_response
   // if they're the same, run "test II".
   sockaddr_storage local_endpoint;
   socklen_t socklen = sizeof(sockaddr_storage);
-  int ret = getsockname(m_fd, reinterpret_cast<sockaddr *>(&local_endpoint), &socklen);
+  int ret = getsockname(fd, reinterpret_cast<sockaddr *>(&local_endpoint), &socklen);
   if (ret == -1)
     details::throw_error("failed to get local socket name:%s", strerror(errno));
 
@@ -651,132 +814,148 @@ network_access_type client::discover_network_access_type(server const & srv)
   return network_access_type::unknown;
 }
 
-std::unique_ptr<message> client::send_binding_request(std::chrono::milliseconds wait_time)
+bool client::send_binding_request(int fd, sockaddr_storage const & addr,
+  std::chrono::milliseconds wait_time, packet & response_bytes, message & response)
 {
-  std::unique_ptr<message> binding_response;
-  std::vector<sockaddr_storage> addrs = details::resolve_hostname(m_server.hostname, m_server.port, m_protocol);
-  for (sockaddr_storage const & addr : addrs) {
-    binding_response = this->send_binding_request(addr, wait_time);
-    if (binding_response)
-      break;
-    else
-      wait_time = std::min(wait_time * 2, details::binding_requests_wait_time_max);
-  }
-  return binding_response;
+  NMLOG_DEBUG("sending binding request with wait time:%lld ms", (long long int) wait_time.count());
+  message binding_request;
+  message_factory::create_binding_request(binding_request);
+  return this->send_message(fd, addr, binding_request, wait_time, response_bytes, response);
 }
 
-std::unique_ptr<message> client::send_binding_request(sockaddr_storage const & addr, 
-  std::chrono::milliseconds wait_time)
+attributes::address::address(attribute const & attr)
+  : address(attr, nullptr)
 {
-  NMLOG_DEBUG("sending binding request with wait time:%lld ms", (long long int) wait_time.count());
-  this->create_udp_socket(addr.ss_family);
-  std::unique_ptr<message> binding_request(message_factory::create_binding_request());
-  std::unique_ptr<message> binding_response(this->send_message(addr, *binding_request, wait_time));
-  return binding_response;
 }
 
-attributes::address::address(attribute const & attr)
+attributes::address::address(attribute const & attr, std::array<uint8_t, 16> const * xor_mask)
+  : m_addr()
+{
+  if (!decode(attr, xor_mask, m_addr))
+    details::throw_error("invalid address attribute 0x%04x of %u bytes", attr.type, attr.length);
+}
+
+bool attributes::address::decode(attribute const & attr, std::array<uint8_t, 16> const * xor_mask, sockaddr_storage & addr)
 {
   size_t offset = 0;
+  uint16_t family = 0;
+  uint16_t port = 0;
 
   // the family is actually 8-bits, but the pkt has a 1 byte padding
   // for alignment
-  uint16_t family = decoder::decode_u16(attr.value, &offset);
-  if (family == 1) {
-    sockaddr_in * v4 = reinterpret_cast<sockaddr_in *>(&m_addr);
-    v4->sin_port = decoder::decode_u16(attr.value, &offset);
-    v4->sin_addr.s_addr = htonl(decoder::decode_u32(attr.value, &offset));
-    m_addr = * reinterpret_cast<sockaddr_storage *>(v4);
-    m_addr.ss_family = AF_INET;
+  if (!decoder::decode_u16(attr.value, attr.length, offset, family)
+   || !decoder::decode_u16(attr.value, attr.length, offset, port))
+    return false;
+  if (xor_mask)
+    port ^= ((*xor_mask)[0] << 8) | (*xor_mask)[1];
+
+  addr = {};
+  if (family == 1 && attr.length >= offset + 4) {
+    sockaddr_in * v4 = reinterpret_cast<sockaddr_in *>(&addr);
+    v4->sin_family = AF_INET;
+    v4->sin_port = htons(port);
+    uint8_t * bytes = reinterpret_cast<uint8_t *>(&v4->sin_addr.s_addr);
+    for (int i = 0; i < 4; ++i)
+      bytes[i] = attr.value[offset + i] ^ (xor_mask ? (*xor_mask)[i] : 0);
+    return true;
   }
-  else if (family == 2) {
-    sockaddr_in6 * v6 = reinterpret_cast<sockaddr_in6 *>(&m_addr);
-    v6->sin6_port = decoder::decode_u16(attr.value, &offset);
+  if (family == 2 && attr.length >= offset + 16) {
+    sockaddr_in6 * v6 = reinterpret_cast<sockaddr_in6 *>(&addr);
+    v6->sin6_family = AF_INET6;
+    v6->sin6_port = htons(port);
     for (int i = 0; i < 16; ++i)
-      v6->sin6_addr.s6_addr[i] = attr.value[offset + i];
-    m_addr = * reinterpret_cast<sockaddr_storage *>(v6);
-    m_addr.ss_family = AF_INET6;
+      v6->sin6_addr.s6_addr[i] = attr.value[offset + i] ^ (xor_mask ? (*xor_mask)[i] : 0);
+    return true;
   }
-  else
-    details::throw_error("invalid mapped address family:%d", family);
+  return false;
 }
 
-uint32_t decoder::decode_u32(buffer const & buff, size_t * offset)
+bool decoder::decode_u32(uint8_t const * buff, size_t size, size_t & offset, uint32_t & value)
 {
-  uint32_t const * p = reinterpret_cast<uint32_t const *>(&buff[*offset]);
-  uint32_t value = ntohl(*p);
-  *offset += 4;
-  return value;
+  if (offset + 4 > size)
+    return false;
+  value = (uint32_t(buff[offset]) << 24) | (uint32_t(buff[offset + 1]) << 16)
+        | (uint32_t(buff[offset + 2]) << 8) | uint32_t(buff[offset + 3]);
+  offset += 4;
+  return true;
 }
 
-uint16_t decoder::decode_u16(buffer const & buff, size_t * offset)
+bool decoder::decode_u16(uint8_t const * buff, size_t size, size_t & offset, uint16_t & value)
 {
-  uint16_t const * p = reinterpret_cast<uint16_t const *>(&buff[*offset]);
-  uint16_t value = ntohs(*p);
-  *offset += 2;
-  return value;
+  if (offset + 2 > size)
+    return false;
+  value = static_cast<uint16_t>((buff[offset] << 8) | buff[offset + 1]);
+  offset += 2;
+  return true;
 }
 
-message * decoder::decode_message(buffer const & buff, size_t * offset)
+bool decoder::decode_message(packet const & buff, size_t size, message & msg)
 {
-  size_t temp_offset = 0;
-  if (offset)
-    temp_offset = *offset;
+  size_t offset = 0;
+  msg = message();
+
+  if (size > buff.size() || size < header_size)
+    return false;
 
   // TODO: use a factory
   // create  a map[ message_type ] = message_factory_method
 
-  message * new_message = nullptr;
-  message_header header;
-  header.message_type = decoder::decode_u16(buff, &temp_offset);
-  header.message_length = decoder::decode_u16(buff, &temp_offset);
-  if (header.message_type == message_type::binding_response) {
-    for (size_t i = 0, n = header.transaction_id.size(); i < n; ++i)
-      header.transaction_id[i] = buff[temp_offset++ + i];
-    new_message = new message();
-    new_message->m_header = header;
-    while (temp_offset < buff.size())
-      new_message->m_attrs.push_back(decoder::decode_attr(buff, &temp_offset)); 
-  }
-  else {
-    // TODO: unsupported message type
+  message_header & header = msg.m_header;
+  decoder::decode_u16(buff.data(), size, offset, header.message_type);
+  decoder::decode_u16(buff.data(), size, offset, header.message_length);
+  size_t const end = header_size + header.message_length;
+  if (end > size)
+    return false;
+
+  // only responses are of interest to a client
+  if (header.message_type != message_type::binding_response)
+    return false;
+
+  memcpy(header.transaction_id.data(), buff.data() + offset, header.transaction_id.size());
+  offset += header.transaction_id.size();
+
+  while (offset < end) {
+    attribute attr;
+    if (!decoder::decode_attr(buff.data(), end, offset, attr))
+      return false;
+    if (!msg.add_attribute(attr.type, attr.value, attr.length))
+      return false;
   }
-
-  if (offset)
-    *offset = temp_offset;
-
-  return new_message;
+  return true;
 }
 
-attribute decoder::decode_attr(buffer const & buff, size_t * offset)
+bool decoder::decode_attr(uint8_t const * buff, size_t size, size_t & offset, attribute & attr)
 {
-  attribute t = {};
-  t.type = decoder::decode_u16(buff, offset);
-  t.length = decoder::decode_u16(buff, offset);
-  t.value.insert(std::end(t.value), std::begin(buff) + *offset,
-      std::begin(buff) + *offset + t.length);
-  *offset += t.value.size();
-  return t;
+  if (!decoder::decode_u16(buff, size, offset, attr.type)
+   || !decoder::decode_u16(buff, size, offset, attr.length))
+    return false;
+  if (offset + attr.length > size)
+    return false;
+  attr.value = buff + offset;
+  // RFC 5389 pads attribute values to a multiple of four bytes; RFC 3489 values are
+  // already aligned, and a final attribute may omit its padding
+  offset = std::min(size, offset + ((attr.length + 3) & ~size_t(3)));
+  return true;
 }
 
-void encoder::encode_u16(buffer & buff, uint16_t n)
+bool encoder::encode_u16(uint8_t * buff, size_t capacity, size_t & offset, uint16_t n)
 {
-  uint16_t temp = htons(n);
-  uint8_t * p = reinterpret_cast< uint8_t * >(&temp);
-  buff.push_back(p[0]);
-  buff.push_back(p[1]);
-  return;
+  if (offset + 2 > capacity)
+    return false;
+  buff[offset++] = static_cast<uint8_t>(n >> 8);
+  buff[offset++] = static_cast<uint8_t>(n & 0xff);
+  return true;
 }
 
-void encoder::encode_u32(buffer & buff, uint32_t n)
+bool encoder::encode_u32(uint8_t * buff, size_t capacity, size_t & offset, uint32_t n)
 {
-  uint32_t temp = htons(n);
-  uint8_t * p = reinterpret_cast<uint8_t *>(&temp);
-  buff.push_back(p[0]);
-  buff.push_back(p[1]);
-  buff.push_back(p[2]);
-  buff.push_back(p[3]);
-  return;
+  if (offset + 4 > capacity)
+    return false;
+  buff[offset++] = static_cast<uint8_t>(n >> 24);
+  buff[offset++] = static_cast<uint8_t>((n >> 16) & 0xff);
+  buff[offset++] = static_cast<uint8_t>((n >> 8) & 0xff);
+  buff[offset++] = static_cast<uint8_t>(n & 0xff);
+  return true;
 }
 
 std::string sockaddr_to_string(sockaddr_storage const & addr)
@@ -785,4 +964,42 @@ std::string sockaddr_to_string(sockaddr_storage const & addr)
   return details::sockaddr_to_string2(temp, addr.ss_family);
 }
 
+bool parse_server(std::string const & text, uint16_t default_port, server & srv)
+{
+  std::string host = text;
+  std::string port;
+
+  if (!text.empty() && text[0] == '[') {
+    size_t close = text.find(']');
+    if (close == std::string::npos)
+      return false;
+    host = text.substr(1, close - 1);
+    if (close + 1 < text.size()) {
+      if (text[close + 1] != ':')
+        return false;
+      port = text.substr(close + 2);
+    }
+  }
+  else if (std::count(text.begin(), text.end(), ':') == 1) {
+    size_t colon = text.find(':');
+    host = text.substr(0, colon);
+    port = text.substr(colon + 1);
+  }
+
+  if (host.empty())
+    return false;
+
+  unsigned long value = default_port;
+  if (!port.empty()) {
+    char * end = nullptr;
+    value = strtoul(port.c_str(), &end, 10);
+    if (*end != '\0' || value == 0 || value > std::numeric_limits<uint16_t>::max())
+      return false;
+  }
+
+  srv.hostname = host;
+  srv.port = static_cast<uint16_t>(value);
+  return true;
+}
+
 } // end namespace stun
@@ -22,8 +22,11 @@
 #include <array>
 #include <chrono>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <netinet/in.h>
 #include "NetworkManagerLogger.h"
@@ -36,7 +39,16 @@ class decoder;
 class message;
 class message_factory;
 
-using buffer = std::vector<uint8_t>;
+/* RFC 5389 section 7.1: without path MTU discovery a message is at most 548 bytes */
+static size_t constexpr max_message_size = 548;
+static size_t constexpr header_size = 20;
+static size_t constexpr max_attributes = 16;
+
+/* caller owned wire buffer; messages are encoded into and decoded from it in place */
+using packet = std::array<uint8_t, max_message_size>;
+
+/* RFC 5389: the first four bytes of the 16 byte RFC 3489 transaction id */
+static uint32_t constexpr magic_cookie = 0x2112A442;
 
 enum class network_access_type {
   udp_blocked,
@@ -70,12 +82,16 @@ namespace attribute_type {
   static uint16_t constexpr error_code = 0x0009;
   static uint16_t constexpr unknown_attributes = 0x000a;
   static uint16_t constexpr reflected_from = 0x000b;
+  static uint16_t constexpr xor_mapped_address = 0x0020;
+  static uint16_t constexpr software = 0x8022;
+  static uint16_t constexpr fingerprint = 0x8028;
 }
 
+/* Non-owning view of an attribute; value points into the packet it was decoded from */
 struct attribute {
   uint16_t type;
   uint16_t length;
-  std::vector<uint8_t> value;
+  uint8_t const * value;
 };
 
 namespace attributes {
@@ -85,12 +101,23 @@ namespace attributes {
     inline sockaddr_storage addr() const {
       return m_addr;
     }
+    /*
+     * Non-throwing form: false if the attribute is too short or the family is unknown.
+     * xor_mask is the transaction id including the magic cookie, see RFC 5389 section 15.2.
+     */
+    static bool decode(attribute const & attr, std::array<uint8_t, 16> const * xor_mask, sockaddr_storage & addr);
+  protected:
+    address(attribute const & attr, std::array<uint8_t, 16> const * xor_mask);
   private:
     sockaddr_storage m_addr;
   };
   struct mapped_address : public address {
     mapped_address(attribute const & attr) : address(attr) { }
   };
+  struct xor_mapped_address : public address {
+    xor_mapped_address(attribute const & attr, std::array<uint8_t, 16> const & transaction_id)
+      : address(attr, &transaction_id) { }
+  };
   struct source_address : public address {
     source_address(attribute const & attr) : address(attr) { }
   };
@@ -105,40 +132,66 @@ struct message_header {
   std::array<uint8_t, 16> transaction_id;
 };
 
+/*
+ * Fixed size message: the header and up to max_attributes attribute views. Nothing is
+ * allocated; a decoded message is only valid while the packet it came from is.
+ */
 class message {
   friend class encoder;
   friend class decoder;
   friend class message_factory;
 public:
-  buffer encode() const;
-  inline std::vector<attribute> const & attributes() const {
-    return m_attrs;
+  message() : m_header(), m_attrs(), m_attr_count(0) { }
+
+  /* Encodes into out; returns the number of bytes written, 0 if the message does not fit */
+  size_t encode(packet & out) const;
+
+  inline size_t attribute_count() const {
+    return m_attr_count;
+  }
+  inline attribute const * begin() const {
+    return m_attrs.data();
+  }
+  inline attribute const * end() const {
+    return m_attrs.data() + m_attr_count;
+  }
+  inline message_header const & header() const {
+    return m_header;
   }
+  /* RFC 5389 message: the transaction id starts with the magic cookie */
+  bool is_rfc5389() const;
 
   attribute const * find_attribute(uint16_t attr_type) const;
 
+  /* value is not copied and must outlive the message; false when the message is full */
+  bool add_attribute(uint16_t type, uint8_t const * value, uint16_t length);
+
 private:
   message_header  m_header;
-  std::vector<attribute> m_attrs;
+  std::array<attribute, max_attributes> m_attrs;
+  size_t m_attr_count;
 };
 
 class message_factory final {
 public:
-  static message * create_binding_request();
+  static void create_binding_request(message & request);
 };
 
+/* Bounds checked readers; each returns false instead of reading past size */
 class decoder final {
 public:
-  static uint16_t  decode_u16(buffer const & buff, size_t * offset);
-  static uint32_t  decode_u32(buffer const & buff, size_t * offset);
-  static attribute decode_attr(buffer const & buff, size_t * offset);
-  static message * decode_message(buffer const & buff, size_t * offset);
+  static bool decode_u16(uint8_t const * buff, size_t size, size_t & offset, uint16_t & value);
+  static bool decode_u32(uint8_t const * buff, size_t size, size_t & offset, uint32_t & value);
+  static bool decode_attr(uint8_t const * buff, size_t size, size_t & offset, attribute & attr);
+  /* Decodes the first size bytes of buff into msg; attribute values point into buff */
+  static bool decode_message(packet const & buff, size_t size, message & msg);
 };
 
+/* Bounds checked writers; each returns false instead of writing past capacity */
 class encoder final {
 public:
-  static void encode_u16(buffer & buff, uint16_t n);
-  static void encode_u32(buffer & buff, uint32_t n);
+  static bool encode_u16(uint8_t * buff, size_t capacity, size_t & offset, uint16_t n);
+  static bool encode_u32(uint8_t * buff, size_t capacity, size_t & offset, uint32_t n);
 };
 
 struct server {
@@ -149,6 +202,16 @@ struct server {
   uint16_t port;
 };
 
+/*
+ * RFC 5389 section 7.2.1 retransmission: a request is resent after rto, the wait doubles
+ * after each one, and after the last of max_requests the client waits last_wait_factor * rto.
+ */
+struct retransmission {
+  std::chrono::milliseconds rto{500};
+  int max_requests = 7;
+  int last_wait_factor = 16;
+};
+
 enum class protocol {
   af_inet,
   af_inet6
@@ -161,6 +224,11 @@ struct bind_result {
   std::string public_ip;
 };
 
+/*
+ * Results are cached per (interface, protocol, server), so callers alternating between
+ * IPv4 and IPv6 or between interfaces keep their own entries. Every binding uses its own
+ * socket, so binds for different keys may run concurrently.
+ */
 class client {
 public:
   client();
@@ -174,32 +242,84 @@ public:
     uint16_t cache_timeout,
     bind_result& result);
 
-  network_access_type discover_network_access_type(server const & srv);
+  /*
+   * Races a binding request to every address of every server; the first valid answer wins.
+   * Requests are retransmitted as in RFC 5389 until an answer arrives or bind_timeout
+   * (seconds) runs out.
+   */
+  bool bind(std::vector<server> const & servers,
+    std::string const & interface,
+    protocol proto,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& result);
+
+  /*
+   * Sends the IPv4 and the IPv6 binding requests at the same time, each on its own socket,
+   * and fills both results. Returns true if either family succeeded.
+   */
+  bool bind_dual_stack(std::string const & hostname,
+    uint16_t port,
+    std::string const & interface,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& ipv4_result,
+    bind_result& ipv6_result);
+
+  bool bind_dual_stack(std::vector<server> const & servers,
+    std::string const & interface,
+    uint16_t bind_timeout,
+    uint16_t cache_timeout,
+    bind_result& ipv4_result,
+    bind_result& ipv6_result);
+
+  void clear_cache();
+
+  void set_retransmission(retransmission const & schedule);
+
+  network_access_type discover_network_access_type(server const & srv,
+    protocol proto = protocol::af_inet, std::string const & interface = "");
 
 private:
-  void create_udp_socket(int inet_family);
+  struct cache_key {
+    std::string interface;
+    protocol proto;
+    std::string servers;    /* host:port[,host:port...] */
+    bool operator<(cache_key const & other) const {
+      return std::tie(interface, proto, servers) < std::tie(other.interface, other.proto, other.servers);
+    }
+  };
 
-  std::unique_ptr<message> send_binding_request(std::chrono::milliseconds wait_time);
+  struct cache_entry {
+    bind_result result;
+    std::chrono::time_point<std::chrono::steady_clock> time;
+  };
 
-  std::unique_ptr<message> send_binding_request(sockaddr_storage const & addr,
-    std::chrono::milliseconds wait_time);
+  bool cached_result(cache_key const & key, uint16_t cache_timeout, bind_result& result);
+  void store_result(cache_key const & key, uint16_t cache_timeout, bind_result const & result);
+  bool bind_uncached(std::vector<server> const & servers, std::string const & interface,
+    protocol proto, uint16_t bind_timeout, bind_result& result);
 
-  message * send_message(sockaddr_storage const & remote_adr, message const & req,
-    std::chrono::milliseconds wait_time, int * local_iface_index = nullptr);
+  int create_udp_socket(int inet_family, std::string const & interface);
+
+  bool send_binding_request(int fd, sockaddr_storage const & addr,
+    std::chrono::milliseconds wait_time, packet & response_bytes, message & response);
+
+  bool send_message(int fd, sockaddr_storage const & remote_adr, message const & req,
+    std::chrono::milliseconds wait_time, packet & response_bytes, message & response,
+    int * local_iface_index = nullptr);
 
 private:
-  server m_server;
-  protocol m_protocol;
-  std::string m_interface;
-  uint16_t m_bind_timeout;
-  uint16_t m_cache_timeout;
-  std::chrono::time_point<std::chrono::steady_clock> m_last_cache_time;
-  bind_result m_last_result;
-  int m_fd;
+  std::mutex m_cache_lock;
+  retransmission m_retransmission;
+  std::map<cache_key, cache_entry> m_cache;
 };
 
 std::string sockaddr_to_string(sockaddr_storage const & addr);
 
+/* "host", "host:port" or "[v6 literal]:port"; returns false if the text is not a valid server */
+bool parse_server(std::string const & text, uint16_t default_port, server & srv);
+
 }
 
 #endif
@@ -0,0 +1,411 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "NetworkManagerWpaCtrl.h"
+#include "NetworkManagerLogger.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+
+    static std::atomic<unsigned int> s_wpaCtrlCounter{0};
+
+    static void copyValue(char* dest, size_t destSize, const char* value, size_t length)
+    {
+        if (length >= destSize)
+            length = destSize - 1;
+        memcpy(dest, value, length);
+        dest[length] = '\0';
+    }
+
+    void WpaSignalInfo::clear()
+    {
+        ssid[0] = '\0';
+        bssid[0] = '\0';
+        rssi = avgRssi = noise = frequency = linkSpeed = 0;
+        hasRssi = hasAvgRssi = hasNoise = hasFrequency = hasLinkSpeed = false;
+    }
+
+    WpaCtrlClient::WpaCtrlClient(const std::string& ctrlPath)
+        : m_ctrlPath(ctrlPath)
+        , m_sockFd(-1)
+    {
+        m_localPath[0] = '\0';
+    }
+
+    WpaCtrlClient::~WpaCtrlClient()
+    {
+        close();
+    }
+
+    bool WpaCtrlClient::open()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return openLocked();
+    }
+
+    void WpaCtrlClient::close()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        closeLocked();
+    }
+
+    bool WpaCtrlClient::isOpen() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return (m_sockFd >= 0);
+    }
+
+    bool WpaCtrlClient::openLocked()
+    {
+        if (m_sockFd >= 0)
+            return true;
+
+        struct sockaddr_un local = {};
+        struct sockaddr_un dest = {};
+
+        if (m_ctrlPath.size() >= sizeof(dest.sun_path))
+        {
+            NMLOG_ERROR("wpa_supplicant control path too long: %s", m_ctrlPath.c_str());
+            return false;
+        }
+
+        int fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            NMLOG_ERROR("wpa ctrl socket creation failed: %s", strerror(errno));
+            return false;
+        }
+
+        /* wpa_supplicant replies to the sender address, so the client needs a bound path of its own */
+        local.sun_family = AF_UNIX;
+        snprintf(local.sun_path, sizeof(local.sun_path), WPA_CTRL_LOCAL_DIR "/nm_wpa_ctrl_%d-%u",
+                 static_cast<int>(getpid()), s_wpaCtrlCounter++);
+        unlink(local.sun_path);
+        if (bind(fd, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) < 0)
+        {
+            NMLOG_ERROR("wpa ctrl bind to %s failed: %s", local.sun_path, strerror(errno));
+            ::close(fd);
+            return false;
+        }
+
+        dest.sun_family = AF_UNIX;
+        memcpy(dest.sun_path, m_ctrlPath.c_str(), m_ctrlPath.size() + 1);
+        if (connect(fd, reinterpret_cast<struct sockaddr*>(&dest), sizeof(dest)) < 0)
+        {
+            /* Not fatal; callers fall back when wpa_supplicant is not running */
+            NMLOG_DEBUG("wpa ctrl connect to %s failed: %s", m_ctrlPath.c_str(), strerror(errno));
+            unlink(local.sun_path);
+            ::close(fd);
+            return false;
+        }
+
+        memcpy(m_localPath, local.sun_path, sizeof(m_localPath));
+        m_sockFd = fd;
+        NMLOG_DEBUG("wpa ctrl connected to %s", m_ctrlPath.c_str());
+        return true;
+    }
+
+    void WpaCtrlClient::closeLocked()
+    {
+        if (m_sockFd >= 0)
+        {
+            ::close(m_sockFd);
+            m_sockFd = -1;
+        }
+        if (m_localPath[0] != '\0')
+        {
+            unlink(m_localPath);
+            m_localPath[0] = '\0';
+        }
+    }
+
+    void WpaCtrlClient::drainLocked()
+    {
+        char discard[256];
+        /* Drop late replies of timed out requests so they are not taken for the next answer */
+        while (recv(m_sockFd, discard, sizeof(discard), MSG_DONTWAIT) > 0);
+    }
+
+    ssize_t WpaCtrlClient::request(const char* cmd, char* reply, size_t replySize, int timeoutMs)
+    {
+        if (cmd == nullptr || reply == nullptr || replySize < 2)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        const size_t cmdLen = strlen(cmd);
+
+        for (int attempt = 0; attempt < 2; attempt++)
+        {
+            if (!openLocked())
+                return -1;
+
+            drainLocked();
+            if (send(m_sockFd, cmd, cmdLen, 0) < 0)
+            {
+                /* wpa_supplicant restarted and the old socket inode is gone; reconnect once */
+                NMLOG_DEBUG("wpa ctrl send '%s' failed: %s", cmd, strerror(errno));
+                closeLocked();
+                continue;
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+            while (true)
+            {
+                int remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                 deadline - std::chrono::steady_clock::now()).count());
+                if (remaining <= 0)
+                {
+                    NMLOG_WARNING("wpa ctrl request '%s' timed out", cmd);
+                    return -1;
+                }
+
+                struct pollfd pfd = { m_sockFd, POLLIN, 0 };
+                int ret = poll(&pfd, 1, remaining);
+                if (ret < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    NMLOG_ERROR("wpa ctrl poll failed: %s", strerror(errno));
+                    return -1;
+                }
+                if (ret == 0)
+                    continue;
+
+                ssize_t len = recv(m_sockFd, reply, replySize - 1, 0);
+                if (len < 0)
+                {
+                    if (errno == EINTR || errno == EAGAIN)
+                        continue;
+                    NMLOG_DEBUG("wpa ctrl recv failed: %s", strerror(errno));
+                    closeLocked();
+                    return -1;
+                }
+
+                /* Unsolicited event messages start with "<level>"; they are not the reply */
+                if (len > 0 && reply[0] == '<')
+                    continue;
+
+                reply[len] = '\0';
+                return len;
+            }
+        }
+
+        return -1;
+    }
+
+    bool WpaCtrlClient::getSignalInfo(WpaSignalInfo& info)
+    {
+        char reply[WPA_CTRL_REPLY_MAX];
+
+        info.clear();
+        ssize_t len = request("STATUS", reply, sizeof(reply));
+        if (len <= 0)
+            return false;
+        parseStatus(reply, static_cast<size_t>(len), info);
+
+        /* Not associated; SIGNAL_POLL would only fail */
+        if (info.bssid[0] == '\0')
+            return true;
+
+        len = request("SIGNAL_POLL", reply, sizeof(reply));
+        if (len <= 0)
+            return false;
+        parseSignalPoll(reply, static_cast<size_t>(len), info);
+        return true;
+    }
+
+    bool WpaCtrlClient::attach()
+    {
+        char reply[32];
+        ssize_t len = request("ATTACH", reply, sizeof(reply));
+        if (len < 2 || strncmp(reply, "OK", 2) != 0)
+        {
+            NMLOG_WARNING("wpa ctrl ATTACH to %s failed", m_ctrlPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void WpaCtrlClient::detach()
+    {
+        char reply[32];
+        if (isOpen())
+            request("DETACH", reply, sizeof(reply));
+    }
+
+    bool WpaCtrlClient::setSignalMonitor(int thresholdDbm, int hysteresis)
+    {
+        char cmd[64];
+        char reply[32];
+
+        snprintf(cmd, sizeof(cmd), "SIGNAL_MONITOR THRESHOLD=%d HYSTERESIS=%d", thresholdDbm, hysteresis);
+        ssize_t len = request(cmd, reply, sizeof(reply));
+        if (len < 2 || strncmp(reply, "OK", 2) != 0)
+        {
+            /* Driver without connection quality monitor support replies FAIL */
+            NMLOG_WARNING("wpa ctrl '%s' rejected", cmd);
+            return false;
+        }
+        return true;
+    }
+
+    int WpaCtrlClient::fd() const
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_sockFd;
+    }
+
+    ssize_t WpaCtrlClient::receiveEvent(char* event, size_t eventSize)
+    {
+        if (event == nullptr || eventSize < 2)
+            return -1;
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_sockFd < 0)
+            return -1;
+
+        while (true)
+        {
+            ssize_t len = recv(m_sockFd, event, eventSize - 1, MSG_DONTWAIT);
+            if (len < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return 0;
+                NMLOG_DEBUG("wpa ctrl event recv failed: %s", strerror(errno));
+                closeLocked();
+                return -1;
+            }
+
+            event[len] = '\0';
+            /* Late replies of earlier requests are not events */
+            if (len == 0 || event[0] != '<')
+                continue;
+
+            const char* text = static_cast<const char*>(memchr(event, '>', len));
+            if (text == nullptr)
+                continue;
+            text++;
+            len -= (text - event);
+            memmove(event, text, len + 1);
+            return len;
+        }
+    }
+
+    bool WpaCtrlClient::isEvent(const char* event, const char* name)
+    {
+        return (strncmp(event, name, strlen(name)) == 0);
+    }
+
+    bool WpaCtrlClient::findValue(const char* reply, size_t length, const char* key, const char*& value, size_t& valueLength)
+    {
+        const size_t keyLen = strlen(key);
+        const char* pos = reply;
+        const char* end = reply + length;
+
+        while (pos < end)
+        {
+            const char* eol = static_cast<const char*>(memchr(pos, '\n', end - pos));
+            if (eol == nullptr)
+                eol = end;
+
+            if (static_cast<size_t>(eol - pos) > keyLen && memcmp(pos, key, keyLen) == 0 && pos[keyLen] == '=')
+            {
+                value = pos + keyLen + 1;
+                valueLength = eol - value;
+                if (valueLength > 0 && value[valueLength - 1] == '\r')
+                    valueLength--;
+                return true;
+            }
+            pos = eol + 1;
+        }
+
+        return false;
+    }
+
+    bool WpaCtrlClient::parseInt(const char* value, size_t length, int& result)
+    {
+        size_t i = 0;
+        bool negative = false;
+        long parsed = 0;
+
+        if (length > 0 && (value[0] == '-' || value[0] == '+'))
+        {
+            negative = (value[0] == '-');
+            i = 1;
+        }
+        if (i == length)
+            return false;
+
+        for (; i < length; i++)
+        {
+            if (value[i] < '0' || value[i] > '9')
+                return false;
+            parsed = parsed * 10 + (value[i] - '0');
+            if (parsed > 0x7fffffffL)
+                return false;
+        }
+
+        result = static_cast<int>(negative ? -parsed : parsed);
+        return true;
+    }
+
+    void WpaCtrlClient::parseStatus(const char* reply, size_t length, WpaSignalInfo& info)
+    {
+        const char* value = nullptr;
+        size_t valueLen = 0;
+
+        if (findValue(reply, length, "ssid", value, valueLen))
+            copyValue(info.ssid, sizeof(info.ssid), value, valueLen);
+        if (findValue(reply, length, "bssid", value, valueLen))
+            copyValue(info.bssid, sizeof(info.bssid), value, valueLen);
+    }
+
+    void WpaCtrlClient::parseSignalPoll(const char* reply, size_t length, WpaSignalInfo& info)
+    {
+        const char* value = nullptr;
+        size_t valueLen = 0;
+
+        if (findValue(reply, length, "RSSI", value, valueLen))
+            info.hasRssi = parseInt(value, valueLen, info.rssi);
+        if (findValue(reply, length, "AVG_RSSI", value, valueLen))
+            info.hasAvgRssi = parseInt(value, valueLen, info.avgRssi);
+        if (findValue(reply, length, "NOISE", value, valueLen))
+            info.hasNoise = parseInt(value, valueLen, info.noise);
+        if (findValue(reply, length, "FREQUENCY", value, valueLen))
+            info.hasFrequency = parseInt(value, valueLen, info.frequency);
+        if (findValue(reply, length, "LINKSPEED", value, valueLen))
+            info.hasLinkSpeed = parseInt(value, valueLen, info.linkSpeed);
+    }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,124 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <string>
+#include <mutex>
+#include <cstddef>
+#include <sys/types.h>
+
+#define WPA_CTRL_DEFAULT_PATH           "/var/run/wpa_supplicant/wlan0"
+#define WPA_CTRL_LOCAL_DIR              "/tmp"
+#define WPA_CTRL_REQUEST_TIMEOUT_MS     2000    // ms
+#define WPA_CTRL_REPLY_MAX              4096
+#define WPA_CTRL_SSID_MAX               129     // 32 octets, printf escaped by wpa_supplicant
+#define WPA_CTRL_BSSID_MAX              18
+
+#define WPA_EVENT_SIGNAL_CHANGE         "CTRL-EVENT-SIGNAL-CHANGE"
+#define WPA_EVENT_CONNECTED             "CTRL-EVENT-CONNECTED"
+#define WPA_EVENT_DISCONNECTED          "CTRL-EVENT-DISCONNECTED"
+#define WPA_EVENT_TERMINATING           "CTRL-EVENT-TERMINATING"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Link information reported by wpa_supplicant STATUS and SIGNAL_POLL.
+         * Fixed size so that it can be filled without any heap allocation.
+         */
+        struct WpaSignalInfo
+        {
+            char ssid[WPA_CTRL_SSID_MAX];
+            char bssid[WPA_CTRL_BSSID_MAX];
+            int rssi;
+            int avgRssi;
+            int noise;
+            int frequency;
+            int linkSpeed;
+            bool hasRssi;
+            bool hasAvgRssi;
+            bool hasNoise;
+            bool hasFrequency;
+            bool hasLinkSpeed;
+
+            void clear();
+        };
+
+        /*
+         * Persistent client for the wpa_supplicant control interface. The unix
+         * datagram socket is opened once and reused for every request, and it is
+         * re-opened transparently when wpa_supplicant restarts.
+         */
+        class WpaCtrlClient
+        {
+        public:
+            explicit WpaCtrlClient(const std::string& ctrlPath = WPA_CTRL_DEFAULT_PATH);
+            ~WpaCtrlClient();
+
+            WpaCtrlClient(const WpaCtrlClient&) = delete;
+            WpaCtrlClient& operator=(const WpaCtrlClient&) = delete;
+
+            bool open();
+            void close();
+            bool isOpen() const;
+            const std::string& ctrlPath() const { return m_ctrlPath; }
+
+            /* Sends cmd and copies the NUL terminated reply into the caller buffer; returns reply length or -1 */
+            ssize_t request(const char* cmd, char* reply, size_t replySize, int timeoutMs = WPA_CTRL_REQUEST_TIMEOUT_MS);
+
+            /* STATUS followed by SIGNAL_POLL when associated; false when the control interface is unusable */
+            bool getSignalInfo(WpaSignalInfo& info);
+
+            /*
+             * Event monitoring. After attach() wpa_supplicant pushes unsolicited
+             * messages to this socket; wait on fd() and drain them with receiveEvent().
+             * A dedicated client instance should be used, and no request sent on it
+             * while events matter: request() discards any event that arrives before
+             * the reply. SIGNAL_MONITOR applies to the interface, so setSignalMonitor()
+             * is best sent through another, non-attached client.
+             */
+            bool attach();
+            void detach();
+            bool setSignalMonitor(int thresholdDbm, int hysteresis);
+            int fd() const;
+            /* Non blocking; returns the event text without the "<level>" prefix, 0 when none is pending, -1 on error */
+            ssize_t receiveEvent(char* event, size_t eventSize);
+            static bool isEvent(const char* event, const char* name);
+
+            /* In place parsers for "key=value\n" replies; these never allocate */
+            static bool findValue(const char* reply, size_t length, const char* key, const char*& value, size_t& valueLength);
+            static bool parseInt(const char* value, size_t length, int& result);
+            static void parseStatus(const char* reply, size_t length, WpaSignalInfo& info);
+            static void parseSignalPoll(const char* reply, size_t length, WpaSignalInfo& info);
+
+        private:
+            bool openLocked();
+            void closeLocked();
+            void drainLocked();
+
+        private:
+            std::string m_ctrlPath;
+            char m_localPath[108];
+            int m_sockFd;
+            mutable std::mutex m_lock;
+        };
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,111 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "NetworkManagerGnomeDeviceSnapshot.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+
+    const DeviceSnapshot::Device* DeviceSnapshot::View::find(const std::string& iface) const
+    {
+        for (const auto& device : devices)
+        {
+            if (device.iface == iface)
+                return &device;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<const DeviceSnapshot::View> DeviceSnapshot::view() const
+    {
+        std::lock_guard<std::mutex> lock(m_viewLock);
+        return m_view;
+    }
+
+    void DeviceSnapshot::publish(std::vector<Device>&& devices)
+    {
+        std::shared_ptr<View> next = std::make_shared<View>();
+        next->version = ++m_version;
+        next->devices = std::move(devices);
+
+        std::lock_guard<std::mutex> lock(m_viewLock);
+        m_view = std::move(next);
+    }
+
+    void DeviceSnapshot::reset(const std::vector<Device>& devices)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        publish(std::vector<Device>(devices));
+    }
+
+    void DeviceSnapshot::update(const std::string& iface, const std::string& mac, uint32_t state)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        std::shared_ptr<const View> current = view();
+        if (!current)
+            return;
+
+        const Device* existing = current->find(iface);
+        if (existing && existing->mac == mac && existing->state == state)
+            return;
+
+        std::vector<Device> devices = current->devices;
+        bool found = false;
+        for (auto& device : devices)
+        {
+            if (device.iface == iface)
+            {
+                device.mac = mac;
+                device.state = state;
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            devices.push_back(Device{iface, mac, state});
+        publish(std::move(devices));
+    }
+
+    void DeviceSnapshot::remove(const std::string& iface)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        std::shared_ptr<const View> current = view();
+        if (!current || !current->find(iface))
+            return;
+
+        std::vector<Device> devices;
+        for (const auto& device : current->devices)
+        {
+            if (device.iface != iface)
+                devices.push_back(device);
+        }
+        publish(std::move(devices));
+    }
+
+    void DeviceSnapshot::invalidate()
+    {
+        std::lock_guard<std::mutex> writeLock(m_writeLock);
+        std::lock_guard<std::mutex> lock(m_viewLock);
+        m_view.reset();
+    }
+
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,84 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * In-memory copy of the eth/wlan devices seen by the long lived NMClient of the
+         * event thread. The event thread is the only writer; API threads take a view and
+         * read it without touching libnm, so read-only calls do not need an NMClient of
+         * their own. A view is immutable and stays valid while the caller holds it.
+         */
+        class DeviceSnapshot
+        {
+        public:
+            struct Device {
+                std::string iface;
+                std::string mac;
+                uint32_t state;     /* NMDeviceState */
+            };
+
+            struct View {
+                uint64_t version;
+                std::vector<Device> devices;
+                const Device* find(const std::string& iface) const;
+            };
+
+            static DeviceSnapshot* getInstance()
+            {
+                static DeviceSnapshot instance;
+                return &instance;
+            }
+
+            DeviceSnapshot() = default;
+            DeviceSnapshot(const DeviceSnapshot&) = delete;
+            DeviceSnapshot& operator=(const DeviceSnapshot&) = delete;
+
+            /* nullptr until reset() has loaded the device list, and again after invalidate() */
+            std::shared_ptr<const View> view() const;
+
+            /* Replaces the device list and makes the snapshot usable */
+            void reset(const std::vector<Device>& devices);
+            /* Adds the device or updates it; ignored while the snapshot is not loaded */
+            void update(const std::string& iface, const std::string& mac, uint32_t state);
+            void remove(const std::string& iface);
+            /* The client lost NetworkManager; readers go back to querying libnm */
+            void invalidate();
+
+        private:
+            /* caller holds m_writeLock */
+            void publish(std::vector<Device>&& devices);
+
+            mutable std::mutex m_viewLock;      /* guards m_view only, held for a pointer copy */
+            std::mutex m_writeLock;             /* serializes writers */
+            std::shared_ptr<const View> m_view;
+            uint64_t m_version = 0;
+        };
+    } // Plugin
+} // WPEFramework
@@ -28,6 +28,8 @@
 #include "NetworkManagerGnomeEvents.h"
 #include "NetworkManagerLogger.h"
 #include "NetworkManagerGnomeUtils.h"
+#include "NetworkManagerGnomeDeviceSnapshot.h"
+#include "NetworkManagerGlibReactor.h"
 #include "NetworkManagerImplementation.h"
 #include "INetworkManager.h"
 #include <set>
@@ -76,12 +78,43 @@ namespace WPEFramework
         }
     }
 
+    /* A refresh waiting for the coalescing window of its interface and family to close */
+    struct PendingRefresh {
+        std::string ifname;
+        bool isIPv6;
+        NMDevice* device;       // reference held until the refresh ran or was cancelled
+        guint source;
+        unsigned triggers;
+    };
+
+    /* Only touched on the reactor thread */
+    static std::map<std::pair<std::string, bool>, PendingRefresh*> pendingRefreshes;
+
+    static void cancelPendingRefresh(const std::string& ifname, bool isIPv6)
+    {
+        auto it = pendingRefreshes.find({ifname, isIPv6});
+        if (it == pendingRefreshes.end())
+            return;
+        guint source = it->second->source;
+        pendingRefreshes.erase(it);
+        g_source_remove(source);    // destroy notify frees the entry
+    }
+
+    static void cancelAllPendingRefreshes()
+    {
+        while (!pendingRefreshes.empty())
+        {
+            auto key = pendingRefreshes.begin()->first;
+            cancelPendingRefresh(key.first, key.second);
+        }
+    }
+
     /* Refresh the per-interface/per-family IP cache from current libnm state and
        emit acquired/lost events for address-set differences.
 
-       Build a fresh IpFamilyCache from current libnm state for one device/family,
-       swap it into _instance under the cache mutex, then emit acquired/lost events
-       for any address-set differences outside the lock. */
+       Libnm hands out addresses as text; each one is parsed into an IpAddr once
+       here, and the MAC once per refresh, so classification and the diff in
+       publishIpFamily run on binary addresses. */
     static void refreshIpFamilyCache(NMDevice* device, bool isIPv6)
     {
         if (!device || !NM_IS_DEVICE(device) || !_instance)
@@ -95,16 +128,20 @@ namespace WPEFramework
         bool isWlan = (ifname == nmUtils::wlanIface());
         if (!isEth && !isWlan) return;
 
+        /* this read covers whatever was waiting in the coalescing window */
+        cancelPendingRefresh(ifname, isIPv6);
+
         /* Build the new snapshot locally (no locks held during NM calls).
          * Skip the NM read when the device is in a disconnected/down state
-         * so that newCache stays empty and the diff emits IP_LOST for every
+         * so that the snapshot stays empty and the diff emits IP_LOST for every
          * address still in the cache.  This also prevents spurious
          * "IP acquired" events from intermediate NM signals (nameserver,
          * gateway clearing) that fire after the cache has been emptied
          * but before NM clears addresses on the config object. */
         NMDeviceState devState = nm_device_get_state(device);
         bool skipRead = (devState <= NM_DEVICE_STATE_DISCONNECTED);
-        IpFamilyCache newCache;
+        const int family = isIPv6 ? AF_INET6 : AF_INET;
+        IpFamilySnapshot next;
         NMActiveConnection* conn = skipRead ? nullptr : nm_device_get_active_connection(device);
         if (conn) {
             /* autoconfig: method "auto" or "dhcp" → true */
@@ -115,7 +152,7 @@ namespace WPEFramework
                     : NM_SETTING_IP_CONFIG(nm_connection_get_setting_ip4_config(nmConn));
                 if (ipSetting) {
                     const char* method = nm_setting_ip_config_get_method(ipSetting);
-                    newCache.autoconfig = method &&
+                    next.autoconfig = method &&
                         (g_strcmp0(method, "auto") == 0 || g_strcmp0(method, "dhcp") == 0);
                 }
             }
@@ -128,89 +165,97 @@ namespace WPEFramework
 
         if (ipConfig) {
             GPtrArray* ipAddresses = nm_ip_config_get_addresses(ipConfig);
-            std::string macAddr;
-            if (isIPv6) {
-                const char* hw = nm_device_get_hw_address(device);
-                if (hw) macAddr = hw;
-            }
+            MacAddr mac;
+            if (isIPv6)
+                MacAddr::parse(nm_device_get_hw_address(device), mac);
             if (ipAddresses) {
+                IpAddr address;
                 for (guint i = 0; i < ipAddresses->len; i++) {
                     NMIPAddress* addr = (NMIPAddress*)g_ptr_array_index(ipAddresses, i);
-                    if (!addr) continue;
-                    const char* addrStr = nm_ip_address_get_address(addr);
-                    if (!addrStr) continue;
-                    std::string addrString = addrStr;
-                    uint32_t prefix = nm_ip_address_get_prefix(addr);
-                    if (isIPv6) {
-                        if (isIPv6LinkLocal(addrString)) {
-                            newCache.linkLocalAddresses.insert(addrString);
-                        } else if (isIPv6ULA(addrString)) {
-                            newCache.uniqueLocalAddresses.insert(addrString);
-                        } else {
-                            GlobalAddressType type = (!macAddr.empty() && isIPv6MacBased(addrString, macAddr))
-                                ? ADDR_GLOBAL_MAC_BASED : ADDR_GLOBAL;
-                            newCache.globalAddresses.emplace(addrString, GlobalAddressInfo{prefix, type});
-                        }
-                    } else {
-                        if (isIPv4LinkLocal(addrString)) {
-                            newCache.linkLocalAddresses.insert(addrString);
-                        } else {
-                            newCache.globalAddresses.emplace(addrString, GlobalAddressInfo{prefix, ADDR_GLOBAL});
-                        }
-                    }
+                    if (!addr || !IpAddr::parse(nm_ip_address_get_address(addr), family, address))
+                        continue;
+                    next.addAddress(address, static_cast<uint8_t>(nm_ip_address_get_prefix(addr)), mac);
                 }
             }
 
-            const char* gw = nm_ip_config_get_gateway(ipConfig);
-            if (gw) newCache.gateway = gw;
+            IpAddr::parse(nm_ip_config_get_gateway(ipConfig), family, next.gateway);
 
+            /* the DNS servers of an IPv4 configuration may still be IPv6 ones */
             const char* const* dnsArr = nm_ip_config_get_nameservers(ipConfig);
             if (dnsArr && dnsArr[0]) {
-                newCache.primarydns = dnsArr[0];
-                if (dnsArr[1]) newCache.secondarydns = dnsArr[1];
+                IpAddr::parseAny(dnsArr[0], next.primaryDns);
+                if (dnsArr[1]) IpAddr::parseAny(dnsArr[1], next.secondaryDns);
             }
 
             NMDhcpConfig* dhcpConfig = isIPv6
                 ? nm_device_get_dhcp6_config(device)
                 : nm_device_get_dhcp4_config(device);
-            if (dhcpConfig) {
-                const char* server = nm_dhcp_config_get_one_option(dhcpConfig, "dhcp_server_identifier");
-                if (server) newCache.dhcpserver = server;
-            }
+            if (dhcpConfig)
+                IpAddr::parseAny(nm_dhcp_config_get_one_option(dhcpConfig, "dhcp_server_identifier"), next.dhcpServer);
 
-            newCache.valid = true;
+            next.valid = true;
         }
 
-        /* Swap new snapshot into instance cache; collect old global address keys for diff. */
-        std::set<std::string> oldKeys = _instance->swapIpCache(
-            ifname, isIPv6 ? "IPv6" : "IPv4", newCache);
+        /* Publish the snapshot; acquired/lost events come from the binary diff against the previous one. */
+        _instance->publishIpFamily(ifname, isIPv6, std::move(next));
+    }
 
-        /* Emit address acquired/lost events from global-address key diff (outside the lock). */
-        std::string family = isIPv6 ? "IPv6" : "IPv4";
-        for (const auto& kv : newCache.globalAddresses) {
-            if (oldKeys.find(kv.first) == oldKeys.end()) {
-                _instance->ReportIPAddressChange(ifname, family, kv.first, Exchange::INetworkManager::IP_ACQUIRED);
-            }
+    static gboolean coalescedRefreshCb(gpointer userData)
+    {
+        PendingRefresh* pending = static_cast<PendingRefresh*>(userData);
+        pendingRefreshes.erase({pending->ifname, pending->isIPv6});
+        NMLOG_DEBUG("%s %s refresh after %u merged triggers", pending->ifname.c_str(),
+                    pending->isIPv6 ? "IPv6" : "IPv4", pending->triggers);
+        refreshIpFamilyCache(pending->device, pending->isIPv6);
+        return G_SOURCE_REMOVE;
+    }
+
+    static void freePendingRefresh(gpointer userData)
+    {
+        PendingRefresh* pending = static_cast<PendingRefresh*>(userData);
+        g_object_unref(pending->device);
+        delete pending;
+    }
+
+    /*
+     * One DHCP renewal or SLAAC update changes the addresses, the gateway, the name servers and
+     * the DHCP options in quick succession, each with its own notify signal. The first trigger
+     * opens a window of ipRefreshWindow() ms; the ones that follow only join it, and a single
+     * refresh reads the final state when it closes. The window is not extended by later
+     * triggers, so a refresh is never more than one window late.
+     */
+    static void scheduleIpRefresh(NMDevice* device, bool isIPv6)
+    {
+        const char* iface = nm_device_get_iface(device);
+        guint window = _instance ? _instance->ipRefreshWindow() : 0;
+        if (!iface || window == 0) {
+            refreshIpFamilyCache(device, isIPv6);
+            return;
         }
-        for (const auto& key : oldKeys) {
-            if (newCache.globalAddresses.find(key) == newCache.globalAddresses.end()) {
-                _instance->ReportIPAddressChange(ifname, family, key, Exchange::INetworkManager::IP_LOST);
-            }
+
+        auto it = pendingRefreshes.find({iface, isIPv6});
+        if (it != pendingRefreshes.end()) {
+            it->second->triggers++;
+            return;
         }
+
+        PendingRefresh* pending = new PendingRefresh{iface, isIPv6, NM_DEVICE(g_object_ref(device)), 0, 1};
+        pending->source = g_timeout_add_full(G_PRIORITY_DEFAULT, window, coalescedRefreshCb, pending, freePendingRefresh);
+        pendingRefreshes[{pending->ifname, isIPv6}] = pending;
     }
 
     static void ip4ChangedCb(NMIPConfig *ipConfig, GParamSpec *pspec, gpointer userData)
     {
         NMDevice *device = (NMDevice*)userData;
         if (!device || !NM_IS_DEVICE(device)) return;
-        refreshIpFamilyCache(device, false);
+        scheduleIpRefresh(device, false);
     }
 
     static void ip6ChangedCb(NMIPConfig *ipConfig, GParamSpec *pspec, gpointer userData)
     {
         NMDevice *device = (NMDevice*)userData;
         if (!device || !NM_IS_DEVICE(device)) return;
-        refreshIpFamilyCache(device, true);
+        scheduleIpRefresh(device, true);
     }
 
     /* Called when DHCP options change mid-lease (e.g. renewed with different server/options). */
@@ -218,14 +263,14 @@ namespace WPEFramework
     {
         NMDevice *device = (NMDevice*)userData;
         if (!device || !NM_IS_DEVICE(device)) return;
-        refreshIpFamilyCache(device, false);
+        scheduleIpRefresh(device, false);
     }
 
     static void dhcp6OptionsCb(NMDhcpConfig *dhcpConfig, GParamSpec *pspec, gpointer userData)
     {
         NMDevice *device = (NMDevice*)userData;
         if (!device || !NM_IS_DEVICE(device)) return;
-        refreshIpFamilyCache(device, true);
+        scheduleIpRefresh(device, true);
     }
 
     /* Called when the ip4-config or ip6-config object on a device is replaced
@@ -268,6 +313,34 @@ namespace WPEFramework
         refreshIpFamilyCache(device, true);
     }
 
+    /* Mirrors a tracked device into the DeviceSnapshot read by the API threads */
+    static void updateDeviceSnapshot(NMDevice *device, const std::string& ifname, NMDeviceState deviceState)
+    {
+        if(ifname != nmUtils::ethIface() && ifname != nmUtils::wlanIface())
+            return;
+        const char* macAddr = nm_device_get_hw_address(device);
+        DeviceSnapshot::getInstance()->update(ifname, macAddr != nullptr ? macAddr : "", static_cast<uint32_t>(deviceState));
+    }
+
+    /* Loads the DeviceSnapshot from the device list of the event client */
+    static void seedDeviceSnapshot(const GPtrArray *devices)
+    {
+        std::vector<DeviceSnapshot::Device> tracked;
+        for (guint count = 0; devices != nullptr && count < devices->len; count++)
+        {
+            NMDevice *device = NM_DEVICE(g_ptr_array_index(devices, count));
+            if(device == NULL || !NM_IS_DEVICE(device))
+                continue;
+            const char* iface = nm_device_get_iface(device);
+            if(iface == nullptr || (nmUtils::ethIface() != std::string(iface) && nmUtils::wlanIface() != std::string(iface)))
+                continue;
+            const char* macAddr = nm_device_get_hw_address(device);
+            tracked.push_back({iface, macAddr != nullptr ? macAddr : "", static_cast<uint32_t>(nm_device_get_state(device))});
+        }
+        DeviceSnapshot::getInstance()->reset(tracked);
+        NMLOG_DEBUG("device snapshot loaded with %d devices", static_cast<int>(tracked.size()));
+    }
+
     void GnomeNetworkManagerEvents::deviceStateChangeCb(NMDevice *device, GParamSpec *pspec, NMEvents *nmEvents)
     {
         static bool isEthDisabled = false;
@@ -278,6 +351,7 @@ namespace WPEFramework
         deviceState = nm_device_get_state(device);
         std::string ifname = nm_device_get_iface(device);
         NMDeviceStateReason reason = nm_device_get_state_reason(device);
+        updateDeviceSnapshot(device, ifname, deviceState);
         if(ifname == nmUtils::wlanIface())
         {
             if(!NM_IS_DEVICE_WIFI(device)) {
@@ -482,6 +556,7 @@ namespace WPEFramework
             /* ip events added only for eth0 and wlan0 */
             if(ifname == nmUtils::ethIface() || ifname == nmUtils::wlanIface())
             {
+                updateDeviceSnapshot(device, ifname, nm_device_get_state(device));
                 g_signal_connect(device, "notify::" NM_DEVICE_STATE, G_CALLBACK(GnomeNetworkManagerEvents::deviceStateChangeCb), nmEvents);
                 g_signal_connect(device, "notify::ip4-config", G_CALLBACK(ip4ConfigChangedCb), nmEvents);
                 g_signal_connect(device, "notify::ip6-config", G_CALLBACK(ip6ConfigChangedCb), nmEvents);
@@ -541,6 +616,7 @@ namespace WPEFramework
             else {
                 return; // not a tracked interface
             }
+            DeviceSnapshot::getInstance()->remove(ifname);
 
             /* Disconnect all device-level signals (state, ip4/ip6-config changes). */
             g_signal_handlers_disconnect_by_data(device, nmEvents);
@@ -563,12 +639,9 @@ namespace WPEFramework
 
             /* Clear IP cache for the removed device (emits IP_LOST for any cached addresses). */
             if (_instance) {
-                for (const char* family : {"IPv4", "IPv6"}) {
-                    IpFamilyCache empty;
-                    std::set<std::string> oldKeys = _instance->swapIpCache(ifname, family, empty);
-                    for (const auto& key : oldKeys) {
-                        _instance->ReportIPAddressChange(ifname, family, key, Exchange::INetworkManager::IP_LOST);
-                    }
+                for (bool isIPv6 : {false, true}) {
+                    cancelPendingRefresh(ifname, isIPv6);
+                    _instance->publishIpFamily(ifname, isIPv6, IpFamilySnapshot());
                 }
             }
         }
@@ -600,21 +673,16 @@ namespace WPEFramework
     {
         if (nm_client_get_nm_running (client)) {
             NMLOG_INFO("network manager daemon is running");
+            seedDeviceSnapshot(nm_client_get_devices(client));
         } else {
             NMLOG_FATAL("network manager daemon not running !");
+            DeviceSnapshot::getInstance()->invalidate();
             // TODO  check need any client reconnection or not ?
         }
     }
 
-    void* GnomeNetworkManagerEvents::networkMangerEventMonitor(void *arg)
+    void GnomeNetworkManagerEvents::registerEvents(NMEvents *nmEvents)
     {
-        if(arg == nullptr)
-        {
-            NMLOG_FATAL("function argument error: nm event monitor failed");
-            return nullptr;
-        }
-
-        NMEvents *nmEvents = static_cast<NMEvents *>(arg);
         primaryConnectionCb(nmEvents->client, NULL, nmEvents);
         g_signal_connect (nmEvents->client, "notify::" NM_CLIENT_NM_RUNNING,G_CALLBACK (managerRunningCb), nmEvents);
         g_signal_connect(nmEvents->client, "notify::" NM_CLIENT_STATE, G_CALLBACK (clientStateChangedCb),nmEvents);
@@ -629,9 +697,11 @@ namespace WPEFramework
         if(devices == nullptr)
         {
             NMLOG_ERROR("Failed to get device list.");
-            return nullptr;
+            return;
         }
 
+        std::vector<DeviceSnapshot::Device> trackedDevices;
+
         for (u_int count = 0; count < devices->len; count++)
         {
             NMDevice *device = NM_DEVICE(g_ptr_array_index(devices, count));
@@ -641,6 +711,8 @@ namespace WPEFramework
                 if((ifname == nmUtils::ethIface()) || (ifname == nmUtils::wlanIface()))
                 {
                     NMDeviceState devState =  nm_device_get_state(device);
+                    const char* macAddr = nm_device_get_hw_address(device);
+                    trackedDevices.push_back({ifname, macAddr != nullptr ? macAddr : "", static_cast<uint32_t>(devState)});
 
                     if(devState > NM_DEVICE_STATE_DISCONNECTED && devState <= NM_DEVICE_STATE_ACTIVATED)
                     {
@@ -694,15 +766,9 @@ namespace WPEFramework
                 NMLOG_WARNING("device error null");
         }
 
+        /* API threads answer read-only calls from this snapshot while the reactor keeps it current */
+        DeviceSnapshot::getInstance()->reset(trackedDevices);
         NMLOG_INFO("registered all networkmnager dbus events");
-        g_main_loop_run(nmEvents->loop);
-        // Clean up all signal handlers after thread has stopped
-        if(_nmEventInstance != nullptr)
-        {
-            _nmEventInstance->cleanupSignalHandlers();
-        }
-        //g_main_loop_unref(nmEvents->loop);
-        return nullptr;
     }
 
     bool GnomeNetworkManagerEvents::startNetworkMangerEventMonitor()
@@ -712,31 +778,23 @@ namespace WPEFramework
             NMLOG_ERROR("Client Connection NULL DBUS event Failed!");
             return false;
         }
-        if(!isEventThrdActive) {
-            isEventThrdActive = true;
-            // Create event monitor thread
-            eventThrdID = g_thread_new("nm_event_thrd", GnomeNetworkManagerEvents::networkMangerEventMonitor, &nmEvents);
+        if(!isMonitorActive) {
+            isMonitorActive = true;
+            GlibReactor::getInstance()->post([this]() { registerEvents(&nmEvents); });
         }
         return true;
     }
 
     void GnomeNetworkManagerEvents::stopNetworkMangerEventMonitor()
     {
-        // g_signal_handlers_disconnect_by_func(client, G_CALLBACK(primaryConnectionCb), NULL);
-        if (!isEventThrdActive) {
+        if (!isMonitorActive) {
             return;
         }
-        if (nmEvents.loop != NULL) {
-            g_main_loop_quit(nmEvents.loop);
-        }
-
-        if (eventThrdID) {
-            g_thread_join(eventThrdID);  // Wait for the thread to finish
-            eventThrdID = NULL;  // Reset the thread ID
-            NMLOG_WARNING("gnome event monitor stopped");
-        }
-        isEventThrdActive = false;
-
+        /* queued behind the registration; no handler of ours runs once it returns */
+        GlibReactor::getInstance()->run<void>([this]() { cleanupSignalHandlers(); });
+        isMonitorActive = false;
+        NMLOG_WARNING("gnome event monitor stopped");
+        DeviceSnapshot::getInstance()->invalidate();
     }
 
     void GnomeNetworkManagerEvents::cleanupSignalHandlers()
@@ -779,6 +837,9 @@ namespace WPEFramework
             }
         }
 
+        /* timers still pending would hold their device */
+        cancelAllPendingRefreshes();
+
         NMLOG_DEBUG("Signal handlers cleanup complete");
     }
 
@@ -787,12 +848,7 @@ namespace WPEFramework
         NMLOG_INFO("~GnomeNetworkManagerEvents");
         stopNetworkMangerEventMonitor();
         if(nmEvents.client != nullptr) {
-            g_object_unref(nmEvents.client);
-            nmEvents.client = nullptr;
-        }
-        if (nmEvents.loop != NULL) {
-            g_main_loop_unref(nmEvents.loop);
-            nmEvents.loop = NULL;
+            GlibReactor::getInstance()->run<void>([this]() { g_clear_object(&nmEvents.client); });
         }
     }
 
@@ -806,11 +862,11 @@ namespace WPEFramework
     {
         NMLOG_DEBUG("GnomeNetworkManagerEvents");
         GError *error = NULL;
-        eventThrdID = nullptr;
-        isEventThrdActive = false;
+        isMonitorActive = false;
         doScanNotify = false;
 
-        nmEvents.client = nm_client_new(NULL, &error);
+        /* made on the reactor thread, so the client delivers its signals to the reactor context */
+        nmEvents.client = GlibReactor::getInstance()->run<NMClient*>([&error]() { return nm_client_new(NULL, &error); });
         if(!nmEvents.client || error )
         {
             if (error) {
@@ -822,11 +878,6 @@ namespace WPEFramework
         }
 
         NMLOG_INFO("libnm client connection success version: %s", nm_client_get_version(nmEvents.client));
-        nmEvents.loop = g_main_loop_new(NULL, FALSE);
-        if(nmEvents.loop == NULL) {
-            NMLOG_FATAL("GMain loop failed Fatal Error: Event will not work");
-            return;
-        }
         _nmEventInstance = this;
     }
 
@@ -896,11 +947,10 @@ namespace WPEFramework
         }
     }
 
-    bool GnomeNetworkManagerEvents::apToJsonObject(NMAccessPoint *ap, JsonObject& ssidObj)
+    bool GnomeNetworkManagerEvents::apToScanResult(NMAccessPoint *ap, ScanResultSet& scanResults)
     {
          GBytes *ssid = NULL;
          int strength = 0;
-         double freq;
          int security;
          guint32 flags, wpaFlags, rsnFlags, apFreq;
          if(ap == nullptr)
@@ -916,28 +966,20 @@ namespace WPEFramework
                 ssidString = ssidStr;
                 free(ssidStr);
              }
-             ssidObj["ssid"] = ssidString;
              const char *bssidPtr = nm_access_point_get_bssid(ap);
-             std::string bssid = bssidPtr ? bssidPtr : "";
-             if (!bssid.empty()) {
-                 ssidObj["bssid"] = bssid;
-             }
-             else
+             if (bssidPtr == nullptr || *bssidPtr == '\0')
              {
                 NMLOG_WARNING("BSSID is null for SSID: %s", ssidString.c_str());
-                ssidObj["bssid"] = "";
+                bssidPtr = "";
              }
              strength = nm_access_point_get_strength(ap);
              apFreq   = nm_access_point_get_frequency(ap);
              flags    = nm_access_point_get_flags(ap);
              wpaFlags = nm_access_point_get_wpa_flags(ap);
              rsnFlags = nm_access_point_get_rsn_flags(ap);
-             freq = nmUtils::wifiFrequencyFromAp(apFreq);
              security = nmUtils::wifiSecurityModeFromAp(ssidString, flags, wpaFlags, rsnFlags, false);
 
-             ssidObj["security"] = security;
-             ssidObj["strength"] = nmUtils::convertPercentageToSignalStrength(strength);
-             ssidObj["frequency"] = freq;
+             scanResults.add(ssidString, bssidPtr, apFreq, nmUtils::convertPercentageToSignalStrength(strength), security);
              return true;
          }
          // else
@@ -969,18 +1011,17 @@ namespace WPEFramework
         
         NMLOG_INFO("No of AP Available = %d", static_cast<int>(accessPoints->len));
 
-        JsonArray ssidList = JsonArray();
+        ScanResultSet scanResults;
+        scanResults.reserve(accessPoints->len);
         for (guint i = 0; i < accessPoints->len; i++)
         {
-            JsonObject ssidObj{};
             NMAccessPoint *ap = static_cast<NMAccessPoint*>(accessPoints->pdata[i]);
-            if(GnomeNetworkManagerEvents::apToJsonObject(ap, ssidObj))
-                ssidList.Add(ssidObj);
+            GnomeNetworkManagerEvents::apToScanResult(ap, scanResults);
         }
 
         if(_instance != nullptr) {
             _nmEventInstance->doScanNotify = false;
-            _instance->ReportAvailableSSIDs(ssidList);
+            _instance->ReportAvailableSSIDs(scanResults);
         }
     }
 
@@ -23,6 +23,7 @@
 #include <string.h>
 #include <iostream>
 #include <atomic>
+#include "NetworkManagerScanResults.h"
 
 namespace WPEFramework
 {
@@ -31,7 +32,6 @@ namespace WPEFramework
 
     typedef struct {
         NMClient *client;
-        GMainLoop *loop;
         NMDevice *device;
         NMDeviceWifi *wifiDevice;
         NMActiveConnection *activeConn;
@@ -56,15 +56,15 @@ namespace WPEFramework
         void setwifiScanOptions(bool doNotify);
 
     private:
-        static void* networkMangerEventMonitor(void *arg);
-        static bool apToJsonObject(NMAccessPoint *ap, JsonObject& ssidObj);
+        /* both run on the GlibReactor thread */
+        static void registerEvents(NMEvents *nmEvents);
         void cleanupSignalHandlers();
+        static bool apToScanResult(NMAccessPoint *ap, ScanResultSet& scanResults);
         GnomeNetworkManagerEvents();
         ~GnomeNetworkManagerEvents();
-        std::atomic<bool>isEventThrdActive = {false};
+        std::atomic<bool>isMonitorActive = {false};
         std::atomic<bool>doScanNotify = {false};
         NMEvents nmEvents;
-        GThread *eventThrdID;
     };
 
     }   // Plugin
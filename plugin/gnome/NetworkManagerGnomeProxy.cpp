@@ -20,6 +20,7 @@
 #include "NetworkManagerGnomeWIFI.h"
 #include "NetworkManagerGnomeEvents.h"
 #include "NetworkManagerGnomeUtils.h"
+#include "NetworkManagerGnomeDeviceSnapshot.h"
 #include <fstream>
 #include <sstream>
 using namespace WPEFramework;
@@ -31,16 +32,22 @@ namespace WPEFramework
     namespace Plugin
     {
         /*
-         * Per-call NMClient helpers (same pattern as wifiManager).
+         * Per-call NMClient helpers (same pattern as wifiManager::ReadClient).
          * A fresh NMClient is created for each proxy API call and destroyed
          * immediately after use, so no D-Bus signals accumulate between calls.
+         * Each client gets a GMainContext of its own, so API threads never push
+         * the same context concurrently.
+         * Read-only calls use the DeviceSnapshot kept by the event monitor instead,
+         * and only create a client while that snapshot is not loaded.
          */
-        static NMClient* createProxyClient(GMainContext *ctx)
+        static NMClient* createProxyClient()
         {
             GError *error = NULL;
+            GMainContext *ctx = g_main_context_new();
             g_main_context_push_thread_default(ctx);
             NMClient *client = nm_client_new(NULL, &error);
             g_main_context_pop_thread_default(ctx);
+            g_main_context_unref(ctx); // the client keeps its own reference
             if (!client) {
                 if (error) {
                     NMLOG_ERROR("Failed to create NMClient: %s", error->message);
@@ -230,8 +237,8 @@ namespace WPEFramework
         /* @brief Set the dhcp hostname */
         uint32_t NetworkManagerImplementation::SetHostname(const string& hostname /* @in */)
         {
-            if (m_nmContext == nullptr) {
-                NMLOG_ERROR("NMContext is NULL");
+            if (!m_nmReady) {
+                NMLOG_ERROR("NetworkManager client not initialized");
                 return Core::ERROR_GENERAL;
             }
 
@@ -241,7 +248,7 @@ namespace WPEFramework
                 return Core::ERROR_BAD_REQUEST;
             }
 
-            NMClient *client = createProxyClient(m_nmContext);
+            NMClient *client = createProxyClient();
             if (client == nullptr) {
                 NMLOG_ERROR("Failed to create NMClient for SetHostname");
                 return Core::ERROR_GENERAL;
@@ -296,7 +303,7 @@ namespace WPEFramework
 
         void NetworkManagerImplementation::platform_deinit()
         {
-            if(m_nmContext) { g_main_context_unref(m_nmContext); m_nmContext = nullptr; }
+            m_nmReady = false;
         }
 
         void NetworkManagerImplementation::platform_logging(const NetworkManagerLogger::LogLevel& level)
@@ -311,19 +318,16 @@ namespace WPEFramework
         {
             ::_instance = this;
 
-            // Create an isolated GMainContext for per-call NMClient creation.
-            m_nmContext = g_main_context_new();
-
             // Create a temporary client for one-time init work
-            NMClient *initClient = createProxyClient(m_nmContext);
+            NMClient *initClient = createProxyClient();
             if (initClient == NULL) {
                 NMLOG_FATAL("Error initializing NMClient during platform_init");
-                g_main_context_unref(m_nmContext);
-                m_nmContext = nullptr;
                 return;
             }
+            m_nmReady = true;
 
             nmUtils::getDeviceProperties(); // get interface name form '/etc/device.proprties'
+            m_ipCache.setInterfaces(nmUtils::ethIface(), nmUtils::wlanIface());
             modifyDefaultConnConfig(initClient);
             NMDeviceState ethState = ifaceState(initClient, nmUtils::ethIface());
             if(ethState > NM_DEVICE_STATE_DISCONNECTED && ethState < NM_DEVICE_STATE_DEACTIVATING)
@@ -341,18 +345,49 @@ namespace WPEFramework
             wifi = wifiManager::getInstance();
         }
 
-        uint32_t NetworkManagerImplementation::GetAvailableInterfaces (Exchange::INetworkManager::IInterfaceDetailsIterator*& interfacesItr/* @out */)
+        /* Fills the details of an eth/wlan device and refreshes the cached link flags */
+        static bool getInterfaceDetails(NetworkManagerImplementation* impl, const std::string& ifaceStr, const char* macAddr,
+                                        NMDeviceState deviceState, Exchange::INetworkManager::InterfaceDetails& interface)
         {
-            uint32_t rc = Core::ERROR_GENERAL;
-            std::vector<Exchange::INetworkManager::InterfaceDetails> interfaceList;
             std::string wifiname = nmUtils::wlanIface(), ethname = nmUtils::ethIface();
+            if(ifaceStr != wifiname && ifaceStr != ethname) // only wifi and ethenet taking
+                return false;
 
-            if(m_nmContext == nullptr) {
-                NMLOG_FATAL("NMContext is null");
+            if(macAddr != nullptr) {
+                interface.mac = macAddr;
+            }
+            interface.enabled = (deviceState >= NM_DEVICE_STATE_UNAVAILABLE)? true : false;
+            if(deviceState > NM_DEVICE_STATE_DISCONNECTED && deviceState < NM_DEVICE_STATE_DEACTIVATING)
+                interface.connected = true;
+            else
+                interface.connected = false;
+
+            if(ifaceStr == wifiname) {
+                interface.type = Exchange::INetworkManager::INTERFACE_TYPE_WIFI;
+                interface.name = wifiname;
+                impl->m_wlanConnected.store(interface.connected);
+                impl->m_wlanEnabled.store(interface.enabled);
+            }
+            else {
+                interface.type = Exchange::INetworkManager::INTERFACE_TYPE_ETHERNET;
+                interface.name = ethname;
+                impl->m_ethConnected.store(interface.connected);
+                impl->m_ethEnabled.store(interface.enabled);
+            }
+            return true;
+        }
+
+        static uint32_t getAvailableInterfacesFromClient(NetworkManagerImplementation* impl,
+                                                         std::vector<Exchange::INetworkManager::InterfaceDetails>& interfaceList)
+        {
+            uint32_t rc = Core::ERROR_GENERAL;
+
+            if(!impl->m_nmReady) {
+                NMLOG_FATAL("NetworkManager client not initialized");
                 return Core::ERROR_GENERAL;
             }
 
-            NMClient *client = createProxyClient(m_nmContext);
+            NMClient *client = createProxyClient();
             if (client == nullptr) {
                 NMLOG_FATAL("Failed to create NMClient for GetAvailableInterfaces");
                 return Core::ERROR_GENERAL;
@@ -373,35 +408,13 @@ namespace WPEFramework
                     const char* ifacePtr =  nm_device_get_iface(device);
                     if(ifacePtr == nullptr)
                         continue;
+                    Exchange::INetworkManager::InterfaceDetails interface{};
                     std::string ifaceStr = ifacePtr;
-                    if(ifaceStr == wifiname || ifaceStr == ethname) // only wifi and ethenet taking
+                    if(ifaceStr != nmUtils::wlanIface() && ifaceStr != nmUtils::ethIface())
+                        continue;
+                    const char* macAddr = nm_device_get_hw_address(device);
+                    if(getInterfaceDetails(impl, ifaceStr, macAddr, nm_device_get_state(device), interface))
                     {
-                        NMDeviceState deviceState = NM_DEVICE_STATE_UNKNOWN;
-                        Exchange::INetworkManager::InterfaceDetails interface{};
-                        const char* macAddr = nm_device_get_hw_address(device);
-                        if(macAddr != nullptr) {
-                            interface.mac = macAddr;
-                        }
-                        deviceState = nm_device_get_state(device);
-                        interface.enabled = (deviceState >= NM_DEVICE_STATE_UNAVAILABLE)? true : false;
-                        if(deviceState > NM_DEVICE_STATE_DISCONNECTED && deviceState < NM_DEVICE_STATE_DEACTIVATING)
-                            interface.connected = true;
-                        else
-                            interface.connected = false;
-
-                        if(ifaceStr == wifiname) {
-                            interface.type = INTERFACE_TYPE_WIFI;
-                            interface.name = wifiname;
-                            m_wlanConnected.store(interface.connected);
-                            m_wlanEnabled.store(interface.enabled);
-                        }
-                        else if(ifaceStr == ethname) {
-                            interface.type = INTERFACE_TYPE_ETHERNET;
-                            interface.name = ethname;
-                            m_ethConnected.store(interface.connected);
-                            m_ethEnabled.store(interface.enabled);
-                        }
-
                         interfaceList.push_back(interface);
                         rc = Core::ERROR_NONE;
                     }
@@ -409,6 +422,29 @@ namespace WPEFramework
             }
 
             deleteProxyClient(client);
+            return rc;
+        }
+
+        uint32_t NetworkManagerImplementation::GetAvailableInterfaces (Exchange::INetworkManager::IInterfaceDetailsIterator*& interfacesItr/* @out */)
+        {
+            uint32_t rc = Core::ERROR_GENERAL;
+            std::vector<Exchange::INetworkManager::InterfaceDetails> interfaceList;
+
+            std::shared_ptr<const DeviceSnapshot::View> snapshot = DeviceSnapshot::getInstance()->view();
+            if(snapshot)
+            {
+                for (const auto& device : snapshot->devices)
+                {
+                    Exchange::INetworkManager::InterfaceDetails interface{};
+                    if(getInterfaceDetails(this, device.iface, device.mac.c_str(), static_cast<NMDeviceState>(device.state), interface))
+                    {
+                        interfaceList.push_back(interface);
+                        rc = Core::ERROR_NONE;
+                    }
+                }
+            }
+            else
+                rc = getAvailableInterfacesFromClient(this, interfaceList);
 
             if (rc != Core::ERROR_NONE)
                 return rc;
@@ -494,9 +530,9 @@ namespace WPEFramework
         uint32_t NetworkManagerImplementation::SetInterfaceState(const string& interface/* @in */, const bool enabled /* @in */)
         {
 
-            if(m_nmContext == nullptr)
+            if(!m_nmReady)
             {
-                NMLOG_WARNING("NMContext is null");
+                NMLOG_WARNING("NetworkManager client not initialized");
                 return Core::ERROR_RPC_CALL_FAILED;
             }
 
@@ -532,7 +568,7 @@ namespace WPEFramework
                         {
                             NMLOG_INFO("BOOT_MIGRATION detected, deleting all wired NM connections");
 
-                            NMClient *client = createProxyClient(m_nmContext);
+                            NMClient *client = createProxyClient();
                             if (client != nullptr)
                             {
                                 // Bring down the ethernet interface before wiping its connections
@@ -649,13 +685,27 @@ namespace WPEFramework
                 return Core::ERROR_GENERAL;
             }
 
-            if(m_nmContext == nullptr)
+            std::shared_ptr<const DeviceSnapshot::View> snapshot = DeviceSnapshot::getInstance()->view();
+            if(snapshot)
+            {
+                const DeviceSnapshot::Device* device = snapshot->find(interface);
+                if(device == nullptr)
+                {
+                    NMLOG_ERROR("%s : not found", interface.c_str());
+                    return Core::ERROR_GENERAL;
+                }
+                isEnabled = (static_cast<NMDeviceState>(device->state) > NM_DEVICE_STATE_UNAVAILABLE) ? true : false;
+                NMLOG_INFO("%s : %s", interface.c_str(), isEnabled?"enabled":"disabled");
+                return Core::ERROR_NONE;
+            }
+
+            if(!m_nmReady)
             {
-                NMLOG_WARNING("NMContext is null");
+                NMLOG_WARNING("NetworkManager client not initialized");
                 return Core::ERROR_RPC_CALL_FAILED;
             }
 
-            NMClient *client = createProxyClient(m_nmContext);
+            NMClient *client = createProxyClient();
             if (client == nullptr) {
                 NMLOG_ERROR("Failed to create NMClient for GetInterfaceState");
                 return Core::ERROR_RPC_CALL_FAILED;
@@ -181,21 +181,6 @@ namespace WPEFramework
             return securityStr;
         }
 
-       double nmUtils::wifiFrequencyFromAp(guint32 apFreq)
-       {
-            double freq;
-            if (apFreq >= 2400 && apFreq < 5000)
-                freq = 2.4;
-            else if (apFreq >= 5000 && apFreq < 6000)
-                freq = 5;
-            else if (apFreq >= 6000)
-                freq = 6;
-            else
-                freq = 0;
-
-            return freq;
-       }
-
         bool nmUtils::isValidBSSID(const std::string& bssid)
         {
             // Regular expression to match valid BSSID formats (e.g., "00:11:22:33:44:55")
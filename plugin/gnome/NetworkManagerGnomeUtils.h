@@ -43,7 +43,6 @@ namespace WPEFramework
                static int convertPercentageToSignalStrength(int percentage);
                static bool caseInsensitiveCompare(const std::string& str1, const std::string& str2);
                static uint8_t wifiSecurityModeFromAp(const std::string& ssid, guint32 flags, guint32 wpaFlags, guint32 rsnFlags, bool doPrint = true);
-               static double wifiFrequencyFromAp(guint32 apFreq);
                static std::string getSecurityModeString(guint32 flags, guint32 wpaFlags, guint32 rsnFlags);
                static bool setNetworkManagerlogLevelToTrace();
                static void setMarkerFile(const char* filename, bool unmark = false);
@@ -28,6 +28,8 @@
 #include "INetworkManager.h"
 #include "NetworkManagerGnomeWIFI.h"
 #include "NetworkManagerGnomeUtils.h"
+#include "NetworkManagerGnomeDeviceSnapshot.h"
+#include "NetworkManagerGlibReactor.h"
 #include "NetworkManagerImplementation.h"
 #ifdef ENABLE_MIGRATION_MFRMGR_SUPPORT
 #include "NetworkManagerGnomeMfrMgr.h"
@@ -42,39 +44,56 @@ namespace WPEFramework
         extern NetworkManagerImplementation* _instance;
         static std::atomic<bool> wpsProcessRun = {false};
 
-        wifiManager::wifiManager() : m_client(nullptr), m_loop(nullptr), m_createNewConnection(false), m_objectPath(nullptr), m_wifidevice(nullptr), m_source(nullptr), m_cancellable(nullptr){
+        wifiManager::wifiManager() : m_client(nullptr), m_loop(nullptr), m_createNewConnection(false), m_objectPath(nullptr), m_wifidevice(nullptr), m_cancellable(nullptr){
             NMLOG_INFO("wifiManager");
-            m_nmContext = g_main_context_new();
-            // g_main_context_push_thread_default(m_nmContext);
-            // Do NOT push m_nmContext here. Pushing here permanently locks ownership
-            // to the constructor thread (owner_count stays at 1, never released).
-            // All callers — must push/pop around
-            // each createClientNewConnection()/deleteClientConnection() pair instead.
-            m_loop = g_main_loop_new(m_nmContext, FALSE);
+            // constructed before m_secretAgent, so the reactor outlives this instance
+            GlibReactor::getInstance();
+        }
+
+        wifiManager::~wifiManager()
+        {
+            NMLOG_INFO("~wifiManager");
+            if(m_client != NULL) {
+                GlibReactor::getInstance()->run<void>([this]() { deleteClientConnection(); });
+            }
+        }
+
+        bool wifiManager::runOperation(std::function<bool()> operation)
+        {
+            // without a reactor the operation would come straight back here
+            if(!GlibReactor::getInstance()->start()) {
+                NMLOG_ERROR("no glib reactor for the wifi operation");
+                return false;
+            }
+            // operations queue up here, so the reactor never holds two of them at once
+            std::lock_guard<std::mutex> lock(m_opMutex);
+            return GlibReactor::getInstance()->run<bool>(std::move(operation));
         }
 
         bool wifiManager::createClientNewConnection()
         {
             GError *error = NULL;
 
-            // Serialize concurrent wifi operations from different threads
-            m_opMutex.lock();
-
-            g_main_context_push_thread_default(m_nmContext);
+            if(m_client != nullptr) {
+                NMLOG_ERROR("wifi operation already in progress");
+                return false;
+            }
 
+            // on the reactor thread the client takes the reactor context, nothing to push
             m_client = nm_client_new(NULL, &error);
-            if (!m_client || !m_loop) {
+            if (!m_client) {
                 if (error) {
                     NMLOG_ERROR("Could not connect to NetworkManager: %s.", error->message);
                     g_error_free(error);
                 }
                 g_clear_object(&m_client);
                 m_client = nullptr;
-                g_main_context_pop_thread_default(m_nmContext);
-                m_opMutex.unlock();
                 return false;
             }
 
+            // A loop per operation; a timeout or callback of an earlier operation cannot end this one
+            m_loop = g_main_loop_new(GlibReactor::getInstance()->context(), FALSE);
+
             // Create new cancellable for this client session
             {
                 std::lock_guard<std::mutex> lock(m_cancellableMutex);
@@ -116,11 +135,11 @@ namespace WPEFramework
                 m_objectPath = nullptr;
             }
 
-            // Pop the context pushed in createClientNewConnection()
-            if (m_nmContext)
-                g_main_context_pop_thread_default(m_nmContext);
-            // Release operation lock acquired in createClientNewConnection()
-            m_opMutex.unlock();
+            // Every callback of this operation has run once the busy watcher is gone
+            if(m_loop) {
+                g_main_loop_unref(m_loop);
+                m_loop = nullptr;
+            }
         }
 
         bool wifiManager::quit(NMDevice *wifiNMDevice)
@@ -134,6 +153,20 @@ namespace WPEFramework
             return false;
         }
 
+        wifiManager* wifiManager::operationOf(gpointer user_data)
+        {
+            GMainLoop *loop = static_cast<GMainLoop *>(user_data);
+            wifiManager *manager = getInstance();
+            // the reference held so far keeps a new loop from reusing the address
+            bool current = (loop == manager->m_loop);
+            g_main_loop_unref(loop);
+            if (!current) {
+                NMLOG_WARNING("callback of an operation that already ended, ignored");
+                return nullptr;
+            }
+            return manager;
+        }
+
         static gboolean gmainLoopTimoutCB(gpointer user_data)
         {
             wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
@@ -150,29 +183,60 @@ namespace WPEFramework
                 NMLOG_WARNING("g_main_loop_is running");
                 return false;
             }
-            m_source = g_timeout_source_new(timeOutMs);  // 10000ms interval
-            g_source_set_callback(m_source, (GSourceFunc)gmainLoopTimoutCB, this, NULL);
-            g_source_attach(m_source, g_main_loop_get_context(loop));
+            GSource *source = g_timeout_source_new(timeOutMs);  // 10000ms interval
+            g_source_set_callback(source, (GSourceFunc)gmainLoopTimoutCB, this, NULL);
+            g_source_attach(source, g_main_loop_get_context(loop));
             g_main_loop_run(loop);
-            if(m_source != nullptr) {
-                if(g_source_is_destroyed(m_source)) {
-                    NMLOG_WARNING("Source has been destroyed");
-                }
-                else {
-                    g_source_destroy(m_source);
-                }
-                g_source_unref(m_source);
-                m_source = nullptr;
+            if(g_source_is_destroyed(source)) {
+                NMLOG_WARNING("Source has been destroyed");
             }
+            else {
+                g_source_destroy(source);
+            }
+            g_source_unref(source);
             NMLOG_DEBUG("wait exited ...");
             return true;
         }
 
+        wifiManager::ReadClient::ReadClient()
+        {
+            GError *error = NULL;
+            m_context = g_main_context_new();
+            g_main_context_push_thread_default(m_context);
+            m_client = nm_client_new(NULL, &error);
+            g_main_context_pop_thread_default(m_context);
+            if (!m_client) {
+                if (error) {
+                    NMLOG_ERROR("Could not connect to NetworkManager: %s.", error->message);
+                    g_error_free(error);
+                }
+            }
+        }
+
+        wifiManager::ReadClient::~ReadClient()
+        {
+            if(m_client) {
+                GObject *contextBusyWatcher = nm_client_get_context_busy_watcher(m_client);
+                g_object_add_weak_pointer(contextBusyWatcher,(gpointer *) &contextBusyWatcher);
+                g_clear_object(&m_client);
+                while (contextBusyWatcher)
+                {
+                    g_main_context_iteration(m_context, TRUE);
+                }
+            }
+            g_main_context_unref(m_context);
+        }
+
         NMDevice* wifiManager::getWifiDevice()
+        {
+            return getWifiDevice(m_client);
+        }
+
+        NMDevice* wifiManager::getWifiDevice(NMClient *client)
         {
             NMDevice *wifiDevice = NULL;
 
-            GPtrArray *devices = const_cast<GPtrArray *>(nm_client_get_devices(m_client));
+            GPtrArray *devices = const_cast<GPtrArray *>(nm_client_get_devices(client));
             if (devices == NULL) {
                 NMLOG_ERROR("Failed to get device list.");
                 return wifiDevice;
@@ -294,58 +358,73 @@ namespace WPEFramework
             return false;
         }
 
-        bool wifiManager::getWifiState(Exchange::INetworkManager::WiFiState& state)
+        static Exchange::INetworkManager::WiFiState wifiStateFromDeviceState(NMDeviceState deviceState)
         {
-            if(!createClientNewConnection())
-                return false;
-
-            NMDevice *wifiDevice = getWifiDevice();
-            if(wifiDevice == NULL) {
-                NMLOG_WARNING("wifi state disabled !");
-                state = Exchange::INetworkManager::WiFiState::WIFI_STATE_DISABLED;
-                deleteClientConnection();
-                return true;
-            }
-            NMDeviceState deviceState = nm_device_get_state(wifiDevice);
             // Todo check NMDeviceStateReason for more information
             switch(deviceState)
             {
                 case NM_DEVICE_STATE_ACTIVATED: 
-                    state = Exchange::INetworkManager::WiFiState::WIFI_STATE_CONNECTED;
-                    break;
+                    return Exchange::INetworkManager::WiFiState::WIFI_STATE_CONNECTED;
                 case NM_DEVICE_STATE_PREPARE:
                 case NM_DEVICE_STATE_CONFIG:
-                    state = Exchange::INetworkManager::WiFiState::WIFI_STATE_PAIRING;
-                    break;
+                    return Exchange::INetworkManager::WiFiState::WIFI_STATE_PAIRING;
                 case NM_DEVICE_STATE_NEED_AUTH:
                 case NM_DEVICE_STATE_IP_CONFIG:
                 case NM_DEVICE_STATE_IP_CHECK:
                 case NM_DEVICE_STATE_SECONDARIES:
-                    state = Exchange::INetworkManager::WiFiState::WIFI_STATE_CONNECTING;
-                    break;
+                    return Exchange::INetworkManager::WiFiState::WIFI_STATE_CONNECTING;
                 case NM_DEVICE_STATE_DEACTIVATING:
                 case NM_DEVICE_STATE_DISCONNECTED:
                 case NM_DEVICE_STATE_UNAVAILABLE:
-                    state = Exchange::INetworkManager::WiFiState::WIFI_STATE_DISCONNECTED;
-                    break;
+                    return Exchange::INetworkManager::WiFiState::WIFI_STATE_DISCONNECTED;
                 default:
+                    return Exchange::INetworkManager::WiFiState::WIFI_STATE_DISABLED;
+            }
+        }
+
+        bool wifiManager::getWifiState(Exchange::INetworkManager::WiFiState& state)
+        {
+            // answered from the event thread's device snapshot when it is loaded
+            std::shared_ptr<const DeviceSnapshot::View> snapshot = DeviceSnapshot::getInstance()->view();
+            if(snapshot)
+            {
+                const DeviceSnapshot::Device* device = snapshot->find(nmUtils::wlanIface());
+                if(device == nullptr) {
+                    NMLOG_WARNING("wifi state disabled !");
                     state = Exchange::INetworkManager::WiFiState::WIFI_STATE_DISABLED;
+                    return true;
+                }
+                state = wifiStateFromDeviceState(static_cast<NMDeviceState>(device->state));
+                NMLOG_INFO("wifi state (%d) mapped state (%d) ", (int)device->state, (int)state);
+                return true;
+            }
+
+            ReadClient client;
+            if(client.get() == nullptr)
+                return false;
+
+            NMDevice *wifiDevice = getWifiDevice(client.get());
+            if(wifiDevice == NULL) {
+                NMLOG_WARNING("wifi state disabled !");
+                state = Exchange::INetworkManager::WiFiState::WIFI_STATE_DISABLED;
+                return true;
             }
+            NMDeviceState deviceState = nm_device_get_state(wifiDevice);
+            state = wifiStateFromDeviceState(deviceState);
 
             NMLOG_INFO("wifi state (%d) mapped state (%d) ", (int)deviceState, (int)state);
-            deleteClientConnection();
             return true;
         }
 
         bool wifiManager::wifiConnectedSSIDInfo(Exchange::INetworkManager::WiFiSSIDInfo &ssidinfo)
         {
-            if(!createClientNewConnection())
+            ReadClient client;
+            if(client.get() == nullptr)
                 return false;
 
-            NMDevice* wifiDevice = getWifiDevice();
+            NMDevice* wifiDevice = getWifiDevice(client.get());
             if(wifiDevice == NULL) {
                 NMLOG_FATAL("NMDeviceWifi * NULL !");
-                deleteClientConnection();
                 return false;
             }
 
@@ -355,18 +434,15 @@ namespace WPEFramework
                 NMAccessPoint *activeAP = nm_device_wifi_get_active_access_point(NM_DEVICE_WIFI(wifiDevice));
                 if(activeAP == NULL) {
                     NMLOG_ERROR("NMAccessPoint = NULL !");
-                    deleteClientConnection();
                     return false;
                 }
                 NMLOG_DEBUG("active access point found !");
                 getApInfo(activeAP, ssidinfo, false);
-                deleteClientConnection();
                 return true;
             }
             else
                 NMLOG_WARNING("no active access point!; wifi device state: (%d)", deviceState);
 
-            deleteClientConnection();
             return true;
         }
 
@@ -374,7 +450,9 @@ namespace WPEFramework
         {
             NMDevice *device = NM_DEVICE(object);
             GError *error = NULL;
-            wifiManager *_wifiManager = static_cast<wifiManager*>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
 
             NMLOG_DEBUG("Disconnecting... ");
             _wifiManager->m_isSuccess = true;
@@ -400,6 +478,9 @@ namespace WPEFramework
 
         bool wifiManager::wifiDisconnect()
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return wifiDisconnect(); });
+
             NMDeviceState deviceState = NM_DEVICE_STATE_UNKNOWN;
             if(!createClientNewConnection())
                 return false;
@@ -420,7 +501,7 @@ namespace WPEFramework
                 return true;
             }
 
-            nm_device_disconnect_async(wifiNMDevice, m_cancellable, disconnectCb, this);
+            nm_device_disconnect_async(wifiNMDevice, m_cancellable, disconnectCb, operationRef());
             wait(m_loop);
             deleteClientConnection();
             return m_isSuccess;
@@ -430,7 +511,9 @@ namespace WPEFramework
         {
             NMClient *client = NM_CLIENT(object);
             GError *error = NULL;
-            wifiManager *_wifiManager = static_cast<wifiManager*>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
 
             NMLOG_DEBUG("ethernet connection deactivating...");
             _wifiManager->m_isSuccess = true;
@@ -456,6 +539,9 @@ namespace WPEFramework
 
         bool wifiManager::ethernetDeactivate()
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return ethernetDeactivate(); });
+
             NMDeviceState deviceState = NM_DEVICE_STATE_UNKNOWN;
             if(!createClientNewConnection())
                 return false;
@@ -483,7 +569,7 @@ namespace WPEFramework
                 return true;
             }
 
-            nm_client_deactivate_connection_async(m_client, activeConn, m_cancellable, ethernetDeactivateCb, this);
+            nm_client_deactivate_connection_async(m_client, activeConn, m_cancellable, ethernetDeactivateCb, operationRef());
             wait(m_loop);
             deleteClientConnection();
             return m_isSuccess;
@@ -491,7 +577,9 @@ namespace WPEFramework
 
         static void appliedConnCb(GObject *src, GAsyncResult *res, gpointer user_data)
         {
-            wifiManager *_wifiManager = static_cast<wifiManager *>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             GError *error = NULL;
             guint64 versionId = 0;
             NMConnection *conn = nm_device_get_applied_connection_finish(
@@ -512,7 +600,9 @@ namespace WPEFramework
 
         static void reappliedCb(GObject *src, GAsyncResult *res, gpointer user_data)
         {
-            wifiManager *_wifiManager = static_cast<wifiManager *>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             GError *error = NULL;
             nm_device_reapply_finish(NM_DEVICE(src), res, &error);
             if (error) {
@@ -529,6 +619,9 @@ namespace WPEFramework
 
         bool wifiManager::reacquireDhcpLease(const std::string& iface)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return reacquireDhcpLease(iface); });
+
             /* No direct libnm API to trigger a DHCP renew, hence by toggling ipv4.auto-route-ext-gw on the
              * APPLIED connection (not the stored profile) and calling reapply().
              */
@@ -545,7 +638,7 @@ namespace WPEFramework
             /* Round 1: fetch what NM actually has applied in memory */
             m_isSuccess = false;
             m_appliedConn = nullptr;
-            nm_device_get_applied_connection_async(device, 0, m_cancellable, appliedConnCb, this);
+            nm_device_get_applied_connection_async(device, 0, m_cancellable, appliedConnCb, operationRef());
             wait(m_loop);
 
             if (!m_isSuccess || m_appliedConn == nullptr) {
@@ -573,7 +666,7 @@ namespace WPEFramework
 
             /* Round 2: reapply with version_id for race safety — no disk write */
             m_isSuccess = false;
-            nm_device_reapply_async(device, m_appliedConn, m_versionId, 0, m_cancellable, reappliedCb, this);
+            nm_device_reapply_async(device, m_appliedConn, m_versionId, 0, m_cancellable, reappliedCb, operationRef());
             wait(m_loop);
 
             if (!m_isSuccess) {
@@ -666,7 +759,9 @@ namespace WPEFramework
         static void wifiConnectCb(GObject *client, GAsyncResult *result, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             NMActiveConnection *activeConnection = NULL;
 
             if (_wifiManager->m_createNewConnection) {
@@ -705,7 +800,9 @@ namespace WPEFramework
         static void wifiConnectTempCb(GObject *client, GAsyncResult *result, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             NMRemoteConnection *remoteConnection = NULL;
 
             remoteConnection = nm_client_add_connection2_finish(NM_CLIENT(client), result, NULL, &error);
@@ -742,7 +839,7 @@ namespace WPEFramework
                                                   _wifiManager->m_objectPath,
                                                   _wifiManager->m_cancellable,
                                                   wifiConnectCb,
-                                                  _wifiManager);
+                                                  _wifiManager->operationRef());
                 g_object_unref(remoteConnection);
             } else {
                 NMLOG_ERROR("Failed to add temporary connection - no connection returned");
@@ -754,7 +851,9 @@ namespace WPEFramework
         static void wifiConnectionUpdate(GObject *rmObject, GAsyncResult *res, gpointer user_data)
         {
             NMRemoteConnection *remote_con = NM_REMOTE_CONNECTION(rmObject);
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             GVariant *ret = NULL;
             GError *error = NULL;
 
@@ -782,7 +881,7 @@ namespace WPEFramework
 
             _wifiManager->m_createNewConnection = false; // no need to create new connection
             nm_client_activate_connection_async(
-                _wifiManager->m_client, NM_CONNECTION(remote_con), _wifiManager->m_wifidevice, _wifiManager->m_objectPath, _wifiManager->m_cancellable, wifiConnectCb, _wifiManager);
+                _wifiManager->m_client, NM_CONNECTION(remote_con), _wifiManager->m_wifidevice, _wifiManager->m_objectPath, _wifiManager->m_cancellable, wifiConnectCb, _wifiManager->operationRef());
         }
 
         static NMConnection* createMinimalEthernetConnection(const std::string& iface)
@@ -848,7 +947,9 @@ namespace WPEFramework
         static void addMinimalEthernetConnectionCb(GObject *client, GAsyncResult *result, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = static_cast<wifiManager*>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             NMRemoteConnection *remoteConn = nm_client_add_connection2_finish(NM_CLIENT(client), result, NULL, &error);
             if (error) {
                 if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
@@ -879,6 +980,9 @@ namespace WPEFramework
 
         bool wifiManager::addMinimalEthernetConnection(std::string iface)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return addMinimalEthernetConnection(iface); });
+
             if (!createClientNewConnection())
                 return false;
 
@@ -898,7 +1002,7 @@ namespace WPEFramework
                                       connSettings,
                                       NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK,
                                       NULL, TRUE, m_cancellable,
-                                      addMinimalEthernetConnectionCb, this);
+                                      addMinimalEthernetConnectionCb, operationRef());
             g_variant_unref(connSettings);
             wait(m_loop);
             deleteClientConnection();
@@ -1115,6 +1219,9 @@ namespace WPEFramework
 
         bool wifiManager::connectToKnownSSID(const std::string& ssid)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return connectToKnownSSID(ssid); });
+
             const GPtrArray *allnmConn = NULL;
             const char* specificObjPath = "/";
             NMConnection *knownConnection = NULL;
@@ -1176,7 +1283,7 @@ namespace WPEFramework
                 NMLOG_INFO("activating known wifi '%s' connection", ssid.c_str());
                 m_isSuccess = false;
                 m_createNewConnection = false; // no need to create new connection
-                nm_client_activate_connection_async(m_client, NM_CONNECTION(knownConnection), m_wifidevice, specificObjPath, m_cancellable, wifiConnectCb, this);
+                nm_client_activate_connection_async(m_client, NM_CONNECTION(knownConnection), m_wifidevice, specificObjPath, m_cancellable, wifiConnectCb, operationRef());
                 wait(m_loop);
                 g_object_unref(knownConnection);
                 ret =  m_isSuccess;
@@ -1193,6 +1300,9 @@ namespace WPEFramework
 
         bool wifiManager::activateKnownConnection(std::string iface, std::string knowConnectionID)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return activateKnownConnection(iface, knowConnectionID); });
+
             const GPtrArray *devConnections = NULL;
             NMConnection *knownConnection = NULL;
             NMConnection *firstConnection = NULL;
@@ -1225,7 +1335,7 @@ namespace WPEFramework
                     }
                     m_isSuccess = false;
                     m_createNewConnection = true;
-                    nm_client_add_and_activate_connection_async(m_client, ethConn, nmDevice, NULL, m_cancellable, wifiConnectCb, this);
+                    nm_client_add_and_activate_connection_async(m_client, ethConn, nmDevice, NULL, m_cancellable, wifiConnectCb, operationRef());
                     g_object_unref(ethConn);
                     wait(m_loop);
                     deleteClientConnection();
@@ -1300,7 +1410,7 @@ namespace WPEFramework
             {
                 NMLOG_INFO("activating known wifi '%s' connection", knowConnectionID.c_str());
                 m_createNewConnection = false; // no need to create new connection
-                nm_client_activate_connection_async(m_client, NM_CONNECTION(knownConnection), nmDevice, specificObjPath, m_cancellable, wifiConnectCb, this);
+                nm_client_activate_connection_async(m_client, NM_CONNECTION(knownConnection), nmDevice, specificObjPath, m_cancellable, wifiConnectCb, operationRef());
                 wait(m_loop);
             }
             else
@@ -1319,7 +1429,7 @@ namespace WPEFramework
                     else
                     {
                         m_createNewConnection = true;
-                        nm_client_add_and_activate_connection_async(m_client, ethConn, nmDevice, NULL, m_cancellable, wifiConnectCb, this);
+                        nm_client_add_and_activate_connection_async(m_client, ethConn, nmDevice, NULL, m_cancellable, wifiConnectCb, operationRef());
                         g_object_unref(ethConn);
                         wait(m_loop);
                     }
@@ -1337,6 +1447,9 @@ namespace WPEFramework
 
         bool wifiManager::wifiConnect(const Exchange::INetworkManager::WiFiConnectTo &ssidInfoParam)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return wifiConnect(ssidInfoParam); });
+
             NMAccessPoint *AccessPoint = NULL;
             const GPtrArray* ApList = NULL;
             NMConnection *m_connection = NULL;
@@ -1502,7 +1615,7 @@ namespace WPEFramework
                             NULL,
                             NULL,
                             wifiConnectionUpdate,
-                            this);
+                            operationRef());
                     g_variant_unref(connSettings);
                 }
                 else
@@ -1511,7 +1624,7 @@ namespace WPEFramework
                     // Note: Any changes made by connectionBuilder will be temporary for this session only
                     NMLOG_INFO("activating existing connection without persisting changes '%s'", ssidInfo.ssid.c_str());
                     m_createNewConnection = false;
-                    nm_client_activate_connection_async(m_client, NM_CONNECTION(m_connection), m_wifidevice, m_objectPath, m_cancellable, wifiConnectCb, this);
+                    nm_client_activate_connection_async(m_client, NM_CONNECTION(m_connection), m_wifidevice, m_objectPath, m_cancellable, wifiConnectCb, operationRef());
                 }
                 g_object_unref(m_connection);
                 m_connection = NULL;
@@ -1548,7 +1661,7 @@ namespace WPEFramework
                 if (ssidInfo.persist)
                 {
                     m_createNewConnection = true;
-                    nm_client_add_and_activate_connection_async(m_client, m_connection, m_wifidevice, m_objectPath, m_cancellable, wifiConnectCb, this);
+                    nm_client_add_and_activate_connection_async(m_client, m_connection, m_wifidevice, m_objectPath, m_cancellable, wifiConnectCb, operationRef());
                 }
                 else
                 {
@@ -1564,7 +1677,7 @@ namespace WPEFramework
                                             TRUE,
                                             m_cancellable,
                                             wifiConnectTempCb,
-                                            this);
+                                            operationRef());
                     g_variant_unref(connSettings);
                 }
                 if(m_connection)
@@ -1579,7 +1692,9 @@ namespace WPEFramework
          static void addToKnownSSIDsUpdateCb(GObject *rmObject, GAsyncResult *res, gpointer user_data)
         {
             NMRemoteConnection *remote_con = NM_REMOTE_CONNECTION(rmObject);
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             GVariant *ret = NULL;
             GError *error = NULL;
 
@@ -1608,7 +1723,9 @@ namespace WPEFramework
         static void addToKnownSSIDsCb(GObject *client, GAsyncResult *result, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             if (!nm_client_add_connection2_finish(NM_CLIENT(client), result, NULL, &error)) {
                 NMLOG_ERROR("AddToKnownSSIDs Failed");
                 _wifiManager->m_isSuccess = false;
@@ -1633,6 +1750,9 @@ namespace WPEFramework
 
         bool wifiManager::addToKnownSSIDs(const Exchange::INetworkManager::WiFiConnectTo &ssidinfo)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return addToKnownSSIDs(ssidinfo); });
+
             m_isSuccess = false;
             NMConnection *m_connection = NULL;
 
@@ -1680,7 +1800,7 @@ namespace WPEFramework
                                             NULL,
                                             NULL,
                                             addToKnownSSIDsUpdateCb,
-                                            this);
+                                            operationRef());
                 g_variant_unref(connSettings);
                 g_object_unref(m_connection);
                 m_connection = NULL;
@@ -1703,7 +1823,7 @@ namespace WPEFramework
                                         connSettings,
                                         NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK,
                                         NULL, TRUE, m_cancellable,
-                                        addToKnownSSIDsCb, this);
+                                        addToKnownSSIDsCb, operationRef());
                 g_variant_unref(connSettings);
                 g_object_unref(m_connection);
                 m_connection = NULL;
@@ -1715,6 +1835,9 @@ namespace WPEFramework
 
         bool wifiManager::removeKnownSSID(const string& ssid)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return removeKnownSSID(ssid); });
+
             NMConnection *m_connection = NULL;
             bool ssidSpecified = false;
             bool connectionFound = false;
@@ -1807,14 +1930,14 @@ namespace WPEFramework
         {
             std::string ssidPrint{};
 
-            if(!createClientNewConnection())
+            ReadClient client;
+            if(client.get() == nullptr)
                 return false;
 
-            const GPtrArray *connections = nm_client_get_connections(m_client);
+            const GPtrArray *connections = nm_client_get_connections(client.get());
             if(connections == nullptr)
             {
                 NMLOG_ERROR("nm connections list null ");
-                deleteClientConnection();
                 return false;
             }
             for (guint i = 0; i < connections->len; i++)
@@ -1849,18 +1972,18 @@ namespace WPEFramework
             if (!ssids.empty())
             {
                 NMLOG_INFO("known wifi connections are %s", ssidPrint.c_str());
-                deleteClientConnection();
                 return true;
             }
 
-            deleteClientConnection();
             return false;
         }
 
         static void wifiScanCb(GObject *object, GAsyncResult *result, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = (static_cast<wifiManager*>(user_data));
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             if(nm_device_wifi_request_scan_finish(NM_DEVICE_WIFI(object), result, &error)) {
                  _wifiManager->m_isSuccess = true;
                  NMLOG_DEBUG("wifi scanning request success ..");
@@ -1884,6 +2007,9 @@ namespace WPEFramework
 
         bool wifiManager::wifiScanRequest(const std::vector<std::string>& ssidsToFilter)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return wifiScanRequest(ssidsToFilter); });
+
             if(!createClientNewConnection())
                 return false;
             NMDeviceWifi *wifiDevice = NM_DEVICE_WIFI(getWifiDevice());
@@ -1907,12 +2033,12 @@ namespace WPEFramework
                 }
                 g_variant_builder_add(&nm_variant, "{sv}", "ssids", g_variant_builder_end(&nm_array_variant));
                 options = g_variant_builder_end(&nm_variant);
-                nm_device_wifi_request_scan_options_async(wifiDevice, options, m_cancellable, wifiScanCb, this);
+                nm_device_wifi_request_scan_options_async(wifiDevice, options, m_cancellable, wifiScanCb, operationRef());
                 g_variant_unref(options); // Unreference the GVariant after passing it to the async function
             }
             else {
                 NMLOG_INFO("Starting normal wifi scanning ..");
-                nm_device_wifi_request_scan_async(wifiDevice, m_cancellable, wifiScanCb, this);
+                nm_device_wifi_request_scan_async(wifiDevice, m_cancellable, wifiScanCb, operationRef());
             }
             wait(m_loop);
             deleteClientConnection();
@@ -1921,30 +2047,27 @@ namespace WPEFramework
 
         bool wifiManager::isWifiScannedRecently(int timelimitInSec)
         {
-            if (!createClientNewConnection())
+            ReadClient client;
+            if (client.get() == nullptr)
                 return false;
 
-            NMDeviceWifi *wifiDevice = NM_DEVICE_WIFI(getWifiDevice());
+            NMDeviceWifi *wifiDevice = NM_DEVICE_WIFI(getWifiDevice(client.get()));
             if (wifiDevice == NULL) {
                 NMLOG_ERROR("Invalid Wi-Fi device.");
-                deleteClientConnection();
                 return false;
             }
 
             gint64 last_scan_time = nm_device_wifi_get_last_scan(wifiDevice);
             if (last_scan_time <= 0) {
                 NMLOG_INFO("No scan has been performed yet");
-                deleteClientConnection();
                 return false;
             }
 
             gint64 current_time_in_msec = nm_utils_get_timestamp_msec();
             gint64 time_difference_in_seconds = (current_time_in_msec - last_scan_time) / 1000;
             if (time_difference_in_seconds <= timelimitInSec) {
-                deleteClientConnection();
                 return true;
             }
-            deleteClientConnection();
             return false;
         }
 
@@ -2301,9 +2424,18 @@ namespace WPEFramework
             return m_secretAgent.UnregisterAgent();
         }
 
+        static void deviceStateNotifyCb(NMDevice *device, GParamSpec *pspec, gpointer user_data)
+        {
+            GMainLoop *loop = static_cast<GMainLoop *>(user_data);
+            if (nm_device_get_state(device) <= NM_DEVICE_STATE_DISCONNECTED && g_main_loop_is_running(loop))
+                g_main_loop_quit(loop);
+        }
+
         static void deviceManagedCb(GObject *object, GAsyncResult *result, gpointer user_data)
         {
-            wifiManager *_wifiManager = static_cast<wifiManager *>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             GError *error = nullptr;
 
             if (!nm_client_dbus_set_property_finish(NM_CLIENT(object), result, &error))
@@ -2334,6 +2466,9 @@ namespace WPEFramework
 
         bool wifiManager::setInterfaceState(std::string interface, bool enabled)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return setInterfaceState(interface, enabled); });
+
             m_isSuccess = false;
             NMDevice *device = nullptr;
 
@@ -2396,29 +2531,18 @@ namespace WPEFramework
                     // and DNS configuration associated with the interface. Setting an interface
                     // to unmanaged without disconnecting first may leave residual configuration
                     // that can cause networking issues.
-                    nm_device_disconnect_async(device, nullptr, disconnectCb, this);
+                    nm_device_disconnect_async(device, nullptr, disconnectCb, operationRef());
                     wait(m_loop);
-                    
-                    // Identify the correct context 
-                    GMainContext *device_context = g_main_loop_get_context(m_loop);
-                    int retry = 24; // 12 seconds
-                    NMDeviceState oldDevState = NM_DEVICE_STATE_UNKNOWN;
-                    while (retry-- > 0) {
-                        // If there are multiple messages backed up, process a bounded number
-                        // of pending iterations so this path cannot stall indefinitely if the
-                        // context keeps receiving new work.
-                        while (g_main_context_iteration(device_context, FALSE));
-
-                        // Fetch the updated state
+
+                    deviceState = nm_device_get_state(device);
+                    if (deviceState > NM_DEVICE_STATE_DISCONNECTED) {
+                        // NM finishes the disconnect on its own; run the loop of the operation, so the
+                        // reactor keeps dispatching, until the device reports it or 12 seconds pass
+                        NMLOG_WARNING("Device state: %d, waiting for the disconnect", deviceState);
+                        gulong stateHandler = g_signal_connect(device, "notify::" NM_DEVICE_STATE, G_CALLBACK(deviceStateNotifyCb), m_loop);
+                        wait(m_loop, 12000);
+                        g_signal_handler_disconnect(device, stateHandler);
                         deviceState = nm_device_get_state(device);
-                        if(oldDevState != deviceState) {
-                            oldDevState = deviceState;
-                            NMLOG_WARNING("Device state: %d Retry: %d", deviceState, retry);
-                        }
-                        if (deviceState <= NM_DEVICE_STATE_DISCONNECTED) {
-                            break;
-                        }
-                        g_usleep(500 * 1000);  // give some time to NM to process the request
                     }
                 }
             }
@@ -2433,7 +2557,7 @@ namespace WPEFramework
             GVariant *value = g_variant_new_boolean(enabled);
 
             nm_client_dbus_set_property( m_client, objectPath, NM_DBUS_INTERFACE_DEVICE,"Managed",
-                                                                    value, -1, nullptr, deviceManagedCb, this);
+                                                                    value, -1, nullptr, deviceManagedCb, operationRef());
             wait(m_loop);
             deleteClientConnection();
 
@@ -2452,7 +2576,9 @@ namespace WPEFramework
         static void onActivateComplete(GObject *source_object, GAsyncResult *res, gpointer user_data)
         {
             GError *error = NULL;
-            wifiManager *_wifiManager = static_cast<wifiManager *>(user_data);
+            wifiManager *_wifiManager = wifiManager::operationOf(user_data);
+            if (_wifiManager == nullptr)
+                return;
             NMLOG_DEBUG("activate connection completeing...");
             // Check if the operation was successful
             if (!nm_client_activate_connection_finish(NM_CLIENT(source_object), res, &error)) {
@@ -2489,6 +2615,9 @@ namespace WPEFramework
 
         bool wifiManager::setIpSettings(const string interface, const Exchange::INetworkManager::IPAddress &address)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return setIpSettings(interface, address); });
+
             m_isSuccess = false;
             NMConnection *connection = NULL;
             NMRemoteConnection *remoteConn = NULL;
@@ -2655,7 +2784,7 @@ namespace WPEFramework
                 }
             }
 
-            nm_client_activate_connection_async(m_client, connection, device, specObject, NULL, onActivateComplete, this);
+            nm_client_activate_connection_async(m_client, connection, device, specObject, NULL, onActivateComplete, operationRef());
             wait(m_loop);
             deleteClientConnection();
             return m_isSuccess;
@@ -2663,6 +2792,9 @@ namespace WPEFramework
 
         bool wifiManager::setPrimaryInterface(const string interface)
         {
+            if(!GlibReactor::getInstance()->isCurrent())
+                return runOperation([&]() { return setPrimaryInterface(interface); });
+
             uint32_t rc = Core::ERROR_RPC_CALL_FAILED;
             GError *error = NULL;
             std::string otherInterface;
@@ -2733,7 +2865,7 @@ namespace WPEFramework
                                 return false;
                             }
                         }
-                        nm_client_activate_connection_async(m_client, NM_CONNECTION(connection), device, specObject, NULL, onActivateComplete, this);
+                        nm_client_activate_connection_async(m_client, NM_CONNECTION(connection), device, specObject, NULL, onActivateComplete, operationRef());
                     }
                 }
             }
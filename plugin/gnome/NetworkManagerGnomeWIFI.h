@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <vector>
 
@@ -65,6 +66,14 @@ namespace WPEFramework
             bool connectToKnownSSID(const std::string& ssid);
             bool quit(NMDevice *wifiNMDevice);
             bool wait(GMainLoop *loop, int timeOutMs = 10000); // default maximium set as 10 sec
+            /*
+             * An async call takes operationRef() as user data, a reference to the loop of the
+             * operation making it. Its callback passes that to operationOf(), which drops the
+             * reference and returns nullptr when the operation has ended since, so a late
+             * callback cannot touch or quit the next operation.
+             */
+            gpointer operationRef() { return g_main_loop_ref(m_loop); }
+            static wifiManager* operationOf(gpointer user_data);
             bool startWPS();
             bool stopWPS();
             bool setInterfaceState(std::string interface, bool enabled);
@@ -73,43 +82,51 @@ namespace WPEFramework
             bool addMinimalEthernetConnection(std::string iface);
         private:
             NMDevice *getWifiDevice();
+            static NMDevice *getWifiDevice(NMClient *client);
+
+            /*
+             * NMClient for one read-only call, on a GMainContext of its own. Reads do not
+             * take m_opMutex, so they are not held up while a connect or WPS attempt waits
+             * on NetworkManager.
+             */
+            class ReadClient
+            {
+            public:
+                ReadClient();
+                ~ReadClient();
+                ReadClient(const ReadClient&) = delete;
+                ReadClient& operator=(const ReadClient&) = delete;
+                NMClient *get() const { return m_client; }
+            private:
+                GMainContext *m_context = nullptr;
+                NMClient *m_client = nullptr;
+            };
 
         private:
             wifiManager();
-            ~wifiManager() {
-                NMLOG_INFO("~wifiManager");
-                if(m_client != NULL) {
-                    deleteClientConnection();  // handles pop
-                }
-                if (m_nmContext) {
-                    // Do NOT pop here — deleteClientConnection already popped
-                    g_main_context_unref(m_nmContext);
-                    m_nmContext = NULL;
-                }
-                if(m_loop != NULL) {
-                    g_main_loop_unref(m_loop);
-                    m_loop = NULL;
-                }
-            }
+            ~wifiManager();
 
             void wpsProcess();
             wifiManager(wifiManager const&) = delete;
             void operator=(wifiManager const&) = delete;
 
+            /*
+             * Mutating operations run on the GlibReactor thread, one at a time, each with its
+             * own GMainLoop and GCancellable. runOperation() hands one over from an API thread.
+             */
+            bool runOperation(std::function<bool()> operation);
             bool createClientNewConnection();
             void deleteClientConnection();
 
         public:
             NMClient *m_client;
-            GMainLoop *m_loop;
+            GMainLoop *m_loop;  // loop of the operation in progress
             gboolean m_createNewConnection;
-            GMainContext *m_nmContext = nullptr;
             char* m_objectPath = nullptr;
             NMDevice *m_wifidevice;
-            GSource *m_source;
             GCancellable *m_cancellable;
             std::mutex m_cancellableMutex;
-            std::mutex m_opMutex; // serializes concurrent wifi operations from different threads
+            std::mutex m_opMutex; // serializes mutating wifi operations from different threads, held by the caller
             bool m_isSuccess = false;
             NMConnection *m_appliedConn = nullptr;
             guint64 m_versionId = 0;
@@ -0,0 +1,472 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <glib.h>
+#include <gio/gio.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+
+#include "NetworkManagerGdbusAsync.h"
+#include "NetworkManagerGlibReactor.h"
+#include "NetworkManagerLogger.h"
+
+/* slack on top of the D-Bus timeout before a caller stops waiting for the completion */
+#define GDBUS_COMPLETION_GRACE_MS         1000
+#define GDBUS_WAIT_SLICE_MS               100
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        using ReplyPromise = std::shared_ptr<std::promise<DbusReply>>;
+
+        struct PropertyWait {
+            std::mutex lock;
+            std::condition_variable cond;
+            bool done = false;
+            bool finished = false;      /* the waiter gave up or completed; do not subscribe anymore */
+            guint subscription = 0;
+            GDBusConnection* connection = nullptr;
+            std::string property;
+            std::function<bool(GVariant*)> check;
+        };
+        using PropertyWaitPtr = std::shared_ptr<PropertyWait>;
+
+        DbusReply::~DbusReply()
+        {
+            if (m_value)
+                g_variant_unref(m_value);
+            if (m_error)
+                g_error_free(m_error);
+        }
+
+        DbusReply::DbusReply(DbusReply&& other) noexcept
+            : m_value(other.m_value)
+            , m_error(other.m_error)
+        {
+            other.m_value = nullptr;
+            other.m_error = nullptr;
+        }
+
+        DbusReply& DbusReply::operator=(DbusReply&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_value)
+                    g_variant_unref(m_value);
+                if (m_error)
+                    g_error_free(m_error);
+                m_value = other.m_value;
+                m_error = other.m_error;
+                other.m_value = nullptr;
+                other.m_error = nullptr;
+            }
+            return *this;
+        }
+
+        bool DbusReply::timedOut() const
+        {
+            return m_error != nullptr && g_error_matches(m_error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT);
+        }
+
+        GVariant* DbusReply::takeValue()
+        {
+            GVariant* value = m_value;
+            m_value = nullptr;
+            return value;
+        }
+
+        GError* DbusReply::takeError()
+        {
+            GError* error = m_error;
+            m_error = nullptr;
+            return error;
+        }
+
+        DbusAsyncClient::DbusAsyncClient()
+        {
+            /* constructed first, so the reactor outlives this client */
+            GlibReactor::getInstance();
+        }
+
+        DbusAsyncClient::~DbusAsyncClient()
+        {
+            stop();
+        }
+
+        bool DbusAsyncClient::start()
+        {
+            std::lock_guard<std::mutex> lock(m_startLock);
+            if (m_cancellable != nullptr)
+                return true;
+
+            if (!GlibReactor::getInstance()->start())
+            {
+                NMLOG_ERROR("gdbus async client has no reactor");
+                return false;
+            }
+            m_cancellable = g_cancellable_new();
+            NMLOG_INFO("gdbus async client started");
+            return true;
+        }
+
+        void DbusAsyncClient::stop()
+        {
+            std::lock_guard<std::mutex> lock(m_startLock);
+            if (m_cancellable == nullptr)
+                return;
+
+            /* pending calls complete with G_IO_ERROR_CANCELLED on the reactor */
+            g_cancellable_cancel(m_cancellable);
+            g_object_unref(m_cancellable);
+            m_cancellable = nullptr;
+        }
+
+        void DbusAsyncClient::invoke(std::function<void()> task)
+        {
+            GlibReactor::getInstance()->post(std::move(task));
+        }
+
+        static void onCallDone(GObject* source, GAsyncResult* result, gpointer userData)
+        {
+            ReplyPromise* promise = static_cast<ReplyPromise*>(userData);
+            GError* error = nullptr;
+            GVariant* value = g_dbus_proxy_call_finish(G_DBUS_PROXY(source), result, &error);
+            (*promise)->set_value(DbusReply(value, error));
+            delete promise;
+        }
+
+        std::future<DbusReply> DbusAsyncClient::call(GDBusProxy* proxy, const char* method, GVariant* parameters, int timeoutMs)
+        {
+            ReplyPromise promise = std::make_shared<std::promise<DbusReply>>();
+            std::future<DbusReply> future = promise->get_future();
+
+            if (parameters != nullptr)
+                g_variant_ref_sink(parameters);
+
+            if (proxy == nullptr || method == nullptr || !start())
+            {
+                promise->set_value(DbusReply(nullptr, g_error_new(G_IO_ERROR, G_IO_ERROR_FAILED, "gdbus call %s not issued", method ? method : "")));
+                if (parameters != nullptr)
+                    g_variant_unref(parameters);
+                return future;
+            }
+
+            g_object_ref(proxy);
+            std::string name(method);
+            GCancellable* cancellable = m_cancellable;
+            invoke([proxy, name, parameters, timeoutMs, promise, cancellable]() {
+                g_dbus_proxy_call(proxy, name.c_str(), parameters, G_DBUS_CALL_FLAGS_NONE, timeoutMs,
+                                  cancellable, onCallDone, new ReplyPromise(promise));
+                if (parameters != nullptr)
+                    g_variant_unref(parameters);
+                g_object_unref(proxy);
+            });
+            return future;
+        }
+
+        GVariant* DbusAsyncClient::callSync(GDBusProxy* proxy, const char* method, GVariant* parameters, int timeoutMs, GError** error)
+        {
+            if (GlibReactor::getInstance()->isCurrent())
+            {
+                /* called from a completion on the reactor thread; waiting on a future here would dead lock */
+                return g_dbus_proxy_call_sync(proxy, method, parameters, G_DBUS_CALL_FLAGS_NONE, timeoutMs, nullptr, error);
+            }
+
+            std::future<DbusReply> future = call(proxy, method, parameters, timeoutMs);
+            if (future.wait_for(std::chrono::milliseconds(timeoutMs + GDBUS_COMPLETION_GRACE_MS)) != std::future_status::ready)
+            {
+                NMLOG_ERROR("gdbus call %s did not complete in %d ms", method, timeoutMs);
+                g_set_error(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT, "%s timed out", method);
+                return nullptr;
+            }
+
+            DbusReply reply = future.get();
+            if (!reply.ok())
+            {
+                GError* replyError = reply.takeError();
+                if (error != nullptr && replyError != nullptr)
+                    *error = replyError;
+                else if (replyError != nullptr)
+                    g_error_free(replyError);
+                return nullptr;
+            }
+            return reply.takeValue();
+        }
+
+        static void checkProperty(const PropertyWaitPtr& wait, GVariant* value)
+        {
+            /* done() may refer to the waiter's stack, so it never runs once the waiter returned */
+            std::lock_guard<std::mutex> lock(wait->lock);
+            if (value == nullptr || wait->finished || wait->done || !wait->check(value))
+                return;
+            wait->done = true;
+            wait->cond.notify_all();
+        }
+
+        static void onPropertiesChanged(GDBusConnection* connection, const gchar* sender, const gchar* objectPath,
+                                        const gchar* interfaceName, const gchar* signalName, GVariant* parameters, gpointer userData)
+        {
+            PropertyWaitPtr& wait = *static_cast<PropertyWaitPtr*>(userData);
+            if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sa{sv}as)")))
+                return;
+
+            GVariant* changed = g_variant_get_child_value(parameters, 1);
+            GVariant* value = g_variant_lookup_value(changed, wait->property.c_str(), nullptr);
+            checkProperty(wait, value);
+            if (value)
+                g_variant_unref(value);
+            g_variant_unref(changed);
+        }
+
+        static void onPropertyGetDone(GObject* source, GAsyncResult* result, gpointer userData)
+        {
+            PropertyWaitPtr* wait = static_cast<PropertyWaitPtr*>(userData);
+            GError* error = nullptr;
+            GVariant* reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+            if (reply != nullptr)
+            {
+                GVariant* value = nullptr;
+                g_variant_get(reply, "(v)", &value);
+                checkProperty(*wait, value);
+                if (value)
+                    g_variant_unref(value);
+                g_variant_unref(reply);
+            }
+            else if (error != nullptr)
+            {
+                if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+                    NMLOG_WARNING("property %s read failed: %s", (*wait)->property.c_str(), error->message);
+                g_error_free(error);
+            }
+            delete wait;
+        }
+
+        struct ProxyRequest {
+            std::mutex lock;
+            std::promise<void> done;
+            bool abandoned = false;
+            GDBusProxy* proxy = nullptr;
+            GError* error = nullptr;
+        };
+        using ProxyRequestPtr = std::shared_ptr<ProxyRequest>;
+
+        using SignalHandler = std::function<void(const char*, GVariant*)>;
+
+        static void onProxyReady(GObject* source, GAsyncResult* result, gpointer userData)
+        {
+            ProxyRequestPtr* request = static_cast<ProxyRequestPtr*>(userData);
+            GError* error = nullptr;
+            GDBusProxy* proxy = g_dbus_proxy_new_finish(result, &error);
+            {
+                std::lock_guard<std::mutex> lock((*request)->lock);
+                if ((*request)->abandoned)
+                {
+                    /* the caller gave up waiting; nobody takes ownership */
+                    if (proxy)
+                        g_object_unref(proxy);
+                    if (error)
+                        g_error_free(error);
+                }
+                else
+                {
+                    (*request)->proxy = proxy;
+                    (*request)->error = error;
+                    (*request)->done.set_value();
+                }
+            }
+            delete request;
+        }
+
+        GDBusProxy* DbusAsyncClient::newProxy(GDBusConnection* connection, const char* objectPath, const char* interfaceName,
+                                              int timeoutMs, GError** error)
+        {
+            if (connection == nullptr || objectPath == nullptr || interfaceName == nullptr || !start())
+            {
+                g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "proxy %s not created", interfaceName ? interfaceName : "");
+                return nullptr;
+            }
+
+            if (GlibReactor::getInstance()->isCurrent())
+                return g_dbus_proxy_new_sync(connection, G_DBUS_PROXY_FLAGS_NONE, nullptr, "org.freedesktop.NetworkManager",
+                                             objectPath, interfaceName, nullptr, error);
+
+            ProxyRequestPtr request = std::make_shared<ProxyRequest>();
+            std::future<void> done = request->done.get_future();
+            std::string path(objectPath);
+            std::string iface(interfaceName);
+            GCancellable* cancellable = m_cancellable;
+            g_object_ref(connection);
+            invoke([connection, path, iface, request, cancellable]() {
+                g_dbus_proxy_new(connection, G_DBUS_PROXY_FLAGS_NONE, nullptr, "org.freedesktop.NetworkManager",
+                                 path.c_str(), iface.c_str(), cancellable, onProxyReady, new ProxyRequestPtr(request));
+                g_object_unref(connection);
+            });
+
+            if (done.wait_for(std::chrono::milliseconds(timeoutMs + GDBUS_COMPLETION_GRACE_MS)) != std::future_status::ready)
+            {
+                std::lock_guard<std::mutex> lock(request->lock);
+                if (request->proxy == nullptr && request->error == nullptr)
+                {
+                    request->abandoned = true;
+                    g_set_error(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT, "%s proxy timed out", interfaceName);
+                    return nullptr;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(request->lock);
+            if (request->error != nullptr)
+            {
+                if (error != nullptr)
+                    *error = request->error;
+                else
+                    g_error_free(request->error);
+                request->error = nullptr;
+            }
+            GDBusProxy* proxy = request->proxy;
+            request->proxy = nullptr;
+            return proxy;
+        }
+
+        static void onSignal(GDBusConnection* connection, const gchar* sender, const gchar* objectPath,
+                             const gchar* interfaceName, const gchar* signalName, GVariant* parameters, gpointer userData)
+        {
+            (*static_cast<SignalHandler*>(userData))(objectPath, parameters);
+        }
+
+        guint DbusAsyncClient::subscribeSignal(GDBusConnection* connection, const char* sender, const char* interfaceName,
+                                               const char* member, const char* objectPath,
+                                               std::function<void(const char* objectPath, GVariant* parameters)> handler)
+        {
+            if (connection == nullptr || !start())
+                return 0;
+
+            /* signals are dispatched to the context that was the thread default at subscription time */
+            auto subscribe = [connection, handler](const std::string& sender, const std::string& iface,
+                                                   const std::string& member, const std::string& path) -> guint {
+                return g_dbus_connection_signal_subscribe(connection, sender.empty() ? nullptr : sender.c_str(),
+                                iface.empty() ? nullptr : iface.c_str(), member.empty() ? nullptr : member.c_str(),
+                                path.empty() ? nullptr : path.c_str(), nullptr, G_DBUS_SIGNAL_FLAGS_NONE, onSignal,
+                                new SignalHandler(handler), [](gpointer data) { delete static_cast<SignalHandler*>(data); });
+            };
+
+            std::string senderName(sender ? sender : "");
+            std::string iface(interfaceName ? interfaceName : "");
+            std::string signal(member ? member : "");
+            std::string path(objectPath ? objectPath : "");
+            if (GlibReactor::getInstance()->isCurrent())
+                return subscribe(senderName, iface, signal, path);
+
+            std::shared_ptr<std::promise<guint>> result = std::make_shared<std::promise<guint>>();
+            std::future<guint> subscription = result->get_future();
+            g_object_ref(connection);
+            invoke([connection, subscribe, senderName, iface, signal, path, result]() {
+                result->set_value(subscribe(senderName, iface, signal, path));
+                g_object_unref(connection);
+            });
+
+            if (subscription.wait_for(std::chrono::milliseconds(GDBUS_READ_TIMEOUT_MS)) != std::future_status::ready)
+            {
+                NMLOG_ERROR("subscribing to %s.%s timed out", interfaceName, member);
+                return 0;
+            }
+            return subscription.get();
+        }
+
+        void DbusAsyncClient::unsubscribeSignal(GDBusConnection* connection, guint subscription)
+        {
+            if (connection != nullptr && subscription != 0)
+                g_dbus_connection_signal_unsubscribe(connection, subscription);
+        }
+
+        bool DbusAsyncClient::waitForProperty(GDBusConnection* connection, const char* objectPath, const char* interfaceName,
+                                              const char* property, std::function<bool(GVariant*)> done, int timeoutMs,
+                                              const std::atomic<bool>* keepWaiting)
+        {
+            if (connection == nullptr || objectPath == nullptr || interfaceName == nullptr || property == nullptr || !start())
+                return false;
+
+            if (GlibReactor::getInstance()->isCurrent())
+            {
+                /* the signal it waits for is dispatched by this very thread */
+                NMLOG_ERROR("waiting for %s.%s on the reactor thread", interfaceName, property);
+                return false;
+            }
+
+            PropertyWaitPtr wait = std::make_shared<PropertyWait>();
+            wait->connection = G_DBUS_CONNECTION(g_object_ref(connection));
+            wait->property = property;
+            wait->check = std::move(done);
+
+            std::string path(objectPath);
+            std::string iface(interfaceName);
+            GCancellable* cancellable = m_cancellable;
+            invoke([wait, path, iface, cancellable]() {
+                {
+                    std::lock_guard<std::mutex> lock(wait->lock);
+                    if (wait->finished)
+                        return;
+                    /* subscribe before reading the current value so that no transition is missed */
+                    wait->subscription = g_dbus_connection_signal_subscribe(wait->connection, "org.freedesktop.NetworkManager",
+                                                "org.freedesktop.DBus.Properties", "PropertiesChanged", path.c_str(), iface.c_str(),
+                                                G_DBUS_SIGNAL_FLAGS_NONE, onPropertiesChanged, new PropertyWaitPtr(wait),
+                                                [](gpointer data) { delete static_cast<PropertyWaitPtr*>(data); });
+                }
+                g_dbus_connection_call(wait->connection, "org.freedesktop.NetworkManager", path.c_str(),
+                                       "org.freedesktop.DBus.Properties", "Get", g_variant_new("(ss)", iface.c_str(), wait->property.c_str()),
+                                       G_VARIANT_TYPE("(v)"), G_DBUS_CALL_FLAGS_NONE, GDBUS_READ_TIMEOUT_MS, cancellable,
+                                       onPropertyGetDone, new PropertyWaitPtr(wait));
+            });
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+            bool result = false;
+            {
+                std::unique_lock<std::mutex> lock(wait->lock);
+                while (!wait->done)
+                {
+                    if (keepWaiting != nullptr && !keepWaiting->load())
+                        break;
+                    auto slice = std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(GDBUS_WAIT_SLICE_MS));
+                    if (wait->cond.wait_until(lock, slice, [&wait]() { return wait->done; }))
+                        break;
+                    if (std::chrono::steady_clock::now() >= deadline)
+                        break;
+                }
+                result = wait->done;
+                wait->finished = true;
+            }
+
+            /* the subscription data holds its own reference; late signals only touch that */
+            PropertyWaitPtr keep = wait;
+            invoke([keep]() {
+                if (keep->subscription != 0)
+                    g_dbus_connection_signal_unsubscribe(keep->connection, keep->subscription);
+                keep->subscription = 0;
+                g_object_unref(keep->connection);
+                keep->connection = nullptr;
+            });
+
+            if (!result)
+                NMLOG_DEBUG("%s.%s on %s not reached in %d ms", interfaceName, property, objectPath, timeoutMs);
+            return result;
+        }
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,118 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+#include <gio/gio.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+
+#define GDBUS_CALL_TIMEOUT_MS             10000   // default deadline of a method call
+#define GDBUS_READ_TIMEOUT_MS             5000    // deadline of the Get* API reads
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /* Result of an asynchronous method call; owns the reply or the error */
+        class DbusReply
+        {
+            public:
+                DbusReply() = default;
+                DbusReply(GVariant* value, GError* error) : m_value(value), m_error(error) {}
+                ~DbusReply();
+
+                DbusReply(DbusReply&& other) noexcept;
+                DbusReply& operator=(DbusReply&& other) noexcept;
+                DbusReply(const DbusReply&) = delete;
+                DbusReply& operator=(const DbusReply&) = delete;
+
+                bool ok() const { return m_value != nullptr; }
+                GVariant* value() const { return m_value; }
+                const char* errorMessage() const { return m_error ? m_error->message : "no reply"; }
+                bool timedOut() const;
+                GVariant* takeValue();
+                GError* takeError();
+
+            private:
+                GVariant* m_value = nullptr;
+                GError* m_error = nullptr;
+        };
+
+        /*
+         * Runs D-Bus method calls and signal subscriptions on the GlibReactor thread.
+         * Callers get a future per call, so several requests can be
+         * in flight at once and each one has its own deadline; nothing blocks with an
+         * infinite timeout. Property waits replace fixed sleeps while NetworkManager
+         * changes a device state.
+         */
+        class DbusAsyncClient
+        {
+            public:
+                static DbusAsyncClient* getInstance()
+                {
+                    static DbusAsyncClient instance;
+                    return &instance;
+                }
+
+                DbusAsyncClient(const DbusAsyncClient&) = delete;
+                DbusAsyncClient& operator=(const DbusAsyncClient&) = delete;
+
+                /* parameters is consumed if floating, like g_dbus_proxy_call() */
+                std::future<DbusReply> call(GDBusProxy* proxy, const char* method, GVariant* parameters, int timeoutMs = GDBUS_CALL_TIMEOUT_MS);
+
+                /* Blocking form with a deadline; same ownership rules as g_dbus_proxy_call_sync() */
+                GVariant* callSync(GDBusProxy* proxy, const char* method, GVariant* parameters, int timeoutMs, GError** error);
+
+                /*
+                 * Waits until property of interfaceName on objectPath satisfies done(), checking the
+                 * current value first and then every PropertiesChanged signal. Gives up after timeoutMs,
+                 * or earlier once keepWaiting (when given) turns false.
+                 */
+                bool waitForProperty(GDBusConnection* connection, const char* objectPath, const char* interfaceName,
+                                     const char* property, std::function<bool(GVariant*)> done, int timeoutMs,
+                                     const std::atomic<bool>* keepWaiting = nullptr);
+
+                /*
+                 * Creates a NetworkManager proxy owned by the reactor context, so that its cached
+                 * properties keep following PropertiesChanged after the call returns.
+                 */
+                GDBusProxy* newProxy(GDBusConnection* connection, const char* objectPath, const char* interfaceName,
+                                     int timeoutMs, GError** error);
+
+                /* handler runs on the reactor thread; returns 0 if the subscription failed */
+                guint subscribeSignal(GDBusConnection* connection, const char* sender, const char* interfaceName,
+                                      const char* member, const char* objectPath,
+                                      std::function<void(const char* objectPath, GVariant* parameters)> handler);
+                void unsubscribeSignal(GDBusConnection* connection, guint subscription);
+
+            private:
+                DbusAsyncClient();
+                ~DbusAsyncClient();
+                bool start();
+                void stop();
+                void invoke(std::function<void()> task);
+
+                GCancellable* m_cancellable = nullptr;
+                std::mutex m_startLock;
+        };
+    } // Plugin
+} // WPEFramework
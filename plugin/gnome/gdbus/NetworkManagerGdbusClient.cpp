@@ -21,12 +21,16 @@
 #include <gio/gio.h>
 #include <string>
 #include <list>
+#include <vector>
+#include <chrono>
+#include <functional>
 #include <uuid/uuid.h>
 #include <NetworkManager.h>
 #include <libnm/NetworkManager.h>
 #include "NetworkManagerLogger.h"
 #include "NetworkManagerGdbusClient.h"
 #include "NetworkManagerGdbusUtils.h"
+#include "NetworkManagerGdbusAsync.h"
 #include "../NetworkManagerGnomeUtils.h"
 
 namespace WPEFramework
@@ -34,7 +38,7 @@ namespace WPEFramework
     namespace Plugin
     {
         extern NetworkManagerImplementation* _instance;
-        NetworkManagerClient::NetworkManagerClient() {
+        NetworkManagerClient::NetworkManagerClient() : m_dbus(true) {
             NMLOG_INFO("NetworkManagerClient");
             m_wpsProcessRun = false;
             m_wpsActionTriggered = false;
@@ -44,6 +48,37 @@ namespace WPEFramework
             NMLOG_INFO("~NetworkManagerClient");
         }
 
+        /* Waits until the State property of the device satisfies done(), instead of polling it */
+        static bool waitForDeviceState(DbusMgr& m_dbus, const std::string& devPath, std::function<bool(NMDeviceState)> done,
+                                       int timeoutMs, const std::atomic<bool>* keepWaiting = nullptr)
+        {
+            return DbusAsyncClient::getInstance()->waitForProperty(m_dbus.getConnection(), devPath.c_str(),
+                        "org.freedesktop.NetworkManager.Device", "State", [done](GVariant* value) {
+                            return g_variant_is_of_type(value, G_VARIANT_TYPE_UINT32) &&
+                                   done(static_cast<NMDeviceState>(g_variant_get_uint32(value)));
+                        }, timeoutMs, keepWaiting);
+        }
+
+        /* Waits for the next completed scan on the wifi device */
+        static bool waitForLastScan(DbusMgr& m_dbus, int timeoutMs, const std::atomic<bool>* keepWaiting)
+        {
+            deviceInfo devInfo{};
+            if(!GnomeUtils::getDeviceInfoByIfname(m_dbus, GnomeUtils::getWifiIfname(), devInfo))
+                return false;
+
+            gint64 lastScan = -1;
+            return DbusAsyncClient::getInstance()->waitForProperty(m_dbus.getConnection(), devInfo.path.c_str(),
+                        "org.freedesktop.NetworkManager.Device.Wireless", "LastScan", [&lastScan](GVariant* value) {
+                            if(!g_variant_is_of_type(value, G_VARIANT_TYPE_INT64))
+                                return false;
+                            /* the first value is the current one; any later change is a new scan */
+                            gint64 scan = g_variant_get_int64(value);
+                            bool changed = (lastScan != -1 && scan != lastScan);
+                            lastScan = scan;
+                            return changed;
+                        }, timeoutMs, keepWaiting);
+        }
+
         bool updateRouteMetric(DbusMgr& m_dbus, const std::string& connectionPath, gint64 route_metric, const gchar* interface, const std::string& activeConnectionPath)
         {
             GError *error = nullptr;
@@ -57,13 +92,11 @@ namespace WPEFramework
                 return false;
             }
 
-            GVariant *connectionSettings = g_dbus_proxy_call_sync(
+            GVariant *connectionSettings = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "GetSettings",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (connectionSettings == nullptr) {
@@ -186,13 +219,11 @@ namespace WPEFramework
             g_variant_builder_add(&settingsBuilder, "{sa{sv}}", "ipv4", &ipv4Builder);
             g_variant_builder_add(&settingsBuilder, "{sa{sv}}", "ipv6", &ipv6Builder);
 
-            g_dbus_proxy_call_sync(
+            DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "Update",
                     g_variant_new("(a{sa{sv}})", &settingsBuilder),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_CALL_TIMEOUT_MS,
                     &error);
 
             if (error) {
@@ -227,13 +258,11 @@ namespace WPEFramework
                 return false;
             }
 
-            GVariant *connectionSettings = g_dbus_proxy_call_sync(
+            GVariant *connectionSettings = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "GetSettings",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (connectionSettings == nullptr) {
@@ -404,13 +433,11 @@ namespace WPEFramework
                 }
             }
 
-            g_dbus_proxy_call_sync(
+            DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "Update",
                     g_variant_new("(a{sa{sv}})", &settingsBuilder),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_CALL_TIMEOUT_MS,
                     &error);
 
             if (error) {
@@ -445,13 +472,11 @@ namespace WPEFramework
                 return false;
             }
 
-            GVariant *connectionSettings = g_dbus_proxy_call_sync(
+            GVariant *connectionSettings = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "GetSettings",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (connectionSettings == nullptr) {
@@ -575,13 +600,11 @@ namespace WPEFramework
             g_variant_builder_add(&ipv6Builder, "{sv}", "dhcp-send-hostname", g_variant_new_boolean(TRUE));
             g_variant_builder_add(&settingsBuilder, "{sa{sv}}", "ipv6", &ipv6Builder);
 
-            g_dbus_proxy_call_sync(
+            DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "Update",
                     g_variant_new("(a{sa{sv}})", &settingsBuilder),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_CALL_TIMEOUT_MS,
                     &error);
 
             if (error) {
@@ -743,15 +766,12 @@ namespace WPEFramework
             if(nmProxy == nullptr)
                 return false;
 
-            GVariant* result = g_dbus_proxy_call_sync(
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(
                     nmProxy,
                     "Get",
                     g_variant_new("(ss)", "org.freedesktop.NetworkManager", "PrimaryConnection"),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-                    );
+                    GDBUS_READ_TIMEOUT_MS,
+                    &error);
 
             if (error) {
                 NMLOG_ERROR("Error: Getting primary connection path %s",error->message);
@@ -777,15 +797,12 @@ namespace WPEFramework
 
             std::string defaultDevicePath;
 
-            result = g_dbus_proxy_call_sync(
+            result = DbusAsyncClient::getInstance()->callSync(
                     deviceProxy,
                     "Get",
                     g_variant_new("(ss)", "org.freedesktop.NetworkManager.Connection.Active", "Devices"),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-            );
+                    GDBUS_READ_TIMEOUT_MS,
+                    &error);
 
             if (error) {
                 NMLOG_ERROR("Error: Getting default device path %s", error->message);
@@ -816,15 +833,12 @@ namespace WPEFramework
                 return false;
 
             error = nullptr;
-            result = g_dbus_proxy_call_sync(
+            result = DbusAsyncClient::getInstance()->callSync(
                     defaultDeviceProxy,
                     "Get",
                     g_variant_new("(ss)", "org.freedesktop.NetworkManager.Device", "Interface"),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-                    );
+                    GDBUS_READ_TIMEOUT_MS,
+                    &error);
 
             if (error) {
                 NMLOG_ERROR("Error: Getting primary interface %s", error->message);
@@ -886,15 +900,12 @@ namespace WPEFramework
                     // that can cause networking issues.
                     GDBusProxy* deviceProxy = m_dbus.getNetworkManagerDeviceProxy(devInfo.path.c_str());
                     if(deviceProxy != NULL) {
-                        GVariant* disconnectResult = g_dbus_proxy_call_sync(
+                        GVariant* disconnectResult = DbusAsyncClient::getInstance()->callSync(
                             deviceProxy,
                             "Disconnect",
                             nullptr,
-                            G_DBUS_CALL_FLAGS_NONE,
-                            -1,
-                            nullptr,
-                            &error
-                        );
+                            GDBUS_CALL_TIMEOUT_MS,
+                            &error);
 
                         if (error) {
                             NMLOG_WARNING("Error disconnecting device: %s", error->message);
@@ -906,30 +917,12 @@ namespace WPEFramework
                         g_object_unref(deviceProxy);
                     }
 
-                    // Wait until device is truly disconnected
-                    int retry = 24; // 12 seconds
-                    NMDeviceState oldDevState = NM_DEVICE_STATE_UNKNOWN;
-                    while (retry-- > 0) {
-                        /* Force glib event processing to update state
-                         * This below line will create an uncertain time wait. We are taking a fixed time interval of 12 seconds.
-                         */
-                        // while (g_main_context_iteration(NULL, FALSE));
-
-                        if(!GnomeUtils::getDeviceInfoByIfname(m_dbus, interface.c_str(), devInfo)) {
-                            break;
-                        }
-                        deviceState = devInfo.state;
-                        if(oldDevState != deviceState)
-                        {
-                            oldDevState = deviceState;
-                            NMLOG_WARNING("Device state: %d", deviceState);
-                        }
-
-                        if (deviceState <= NM_DEVICE_STATE_DISCONNECTED)
-                            break;
-
-                        g_usleep(500 * 1000);  // 500ms (much faster response)
-                    }
+                    // Wait until device is truly disconnected, woken by the State change signal
+                    waitForDeviceState(m_dbus, devInfo.path, [&deviceState](NMDeviceState state) {
+                        deviceState = state;
+                        return state <= NM_DEVICE_STATE_DISCONNECTED;
+                    }, GDBUS_DEVICE_DISCONNECT_WAIT_MS);
+                    NMLOG_INFO("Device state: %d", deviceState);
                 }
             }
 
@@ -943,15 +936,12 @@ namespace WPEFramework
             if(propertyProxy == NULL)
                 return false;*/
 
-            GVariant* result = g_dbus_proxy_call_sync(
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(
                     deviceProxy,
                     "Set",
                     g_variant_new("(ssv)", "org.freedesktop.NetworkManager.Device", "Managed", g_variant_new_boolean(enable)),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-                    );
+                    GDBUS_CALL_TIMEOUT_MS,
+                    &error);
 
             bool success = (error == nullptr);
 
@@ -976,8 +966,10 @@ namespace WPEFramework
 
                 // Auto-reconnection logic when interface is enabled
                 if(enable) {
-                    // Wait for 1 sec to change the device state
-                    sleep(1);
+                    // Wait for the device to leave the unmanaged state before activating
+                    waitForDeviceState(m_dbus, devInfo.path, [](NMDeviceState state) {
+                        return state > NM_DEVICE_STATE_UNMANAGED;
+                    }, GDBUS_DEVICE_MANAGED_WAIT_MS);
                     if(interface == GnomeUtils::getWifiIfname() && _instance != nullptr) {
                         NMLOG_INFO("Activating connection '%s' ...", _instance->m_lastConnectedSSID.c_str());
                         activateKnownConnection(GnomeUtils::getWifiIfname(), _instance->m_lastConnectedSSID);
@@ -1005,15 +997,12 @@ namespace WPEFramework
                 return false;
 
             // Call the "Get" method using the proxy
-            GVariant* result = g_dbus_proxy_call_sync(
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(
                     deviceProxy,
                     "Get",
                     g_variant_new("(ss)", "org.freedesktop.NetworkManager.Device", "Managed"),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-                    );
+                    GDBUS_READ_TIMEOUT_MS,
+                    &error);
 
             if (error != nullptr) {
                 NMLOG_ERROR("Error getting network interface state: %s", error->message);
@@ -1487,13 +1476,11 @@ namespace WPEFramework
                 return false;
             }
 
-            GVariant *connectionSettings = g_dbus_proxy_call_sync(
+            GVariant *connectionSettings = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "GetSettings",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (connectionSettings == nullptr) {
@@ -1581,33 +1568,18 @@ namespace WPEFramework
             return true;
         }
 
-        static bool getSSIDFromConnection(DbusMgr &m_dbus, const std::string connPath, std::string& ssid)
+        /* settings is the GetSettings reply of a connection profile */
+        static bool getSSIDFromSettings(GVariant *settings, std::string& ssid)
         {
-            GError *error = NULL;
-            GDBusProxy *ConnProxy = NULL;
-            GVariant *settingsProxy= NULL, *connection= NULL, *gVarConn= NULL;
+            GVariant *connection= NULL, *gVarConn= NULL;
             bool ret = false;
 
-            ConnProxy = m_dbus.getNetworkManagerSettingsConnectionProxy(connPath.c_str());
-            if(ConnProxy == NULL)
-                return false;
-        
-            settingsProxy = g_dbus_proxy_call_sync(ConnProxy, "GetSettings", NULL, G_DBUS_CALL_FLAGS_NONE, -1,  NULL, &error);
-            if (!settingsProxy) {
-                g_dbus_error_strip_remote_error(error);
-                NMLOG_ERROR("Failed to get connection settings: %s", error->message);
-                g_error_free(error);
-                g_object_unref(ConnProxy);
-                return false;
-            }
-
-            g_variant_get(settingsProxy, "(@a{sa{sv}})", &connection);
+            g_variant_get(settings, "(@a{sa{sv}})", &connection);
             gVarConn = g_variant_lookup_value(connection, "connection", NULL);
 
             if(gVarConn == NULL) {
                 NMLOG_ERROR("connection Gvarient Error");
-                g_variant_unref(settingsProxy);
-                g_object_unref(ConnProxy);
+                g_variant_unref(connection);
                 return false;
             }
 
@@ -1673,8 +1645,32 @@ namespace WPEFramework
 
             if (connection)
                 g_variant_unref(connection);
-            if (settingsProxy)
-                g_variant_unref(settingsProxy);
+
+            return ret;
+        }
+
+        static bool getSSIDFromConnection(DbusMgr &m_dbus, const std::string connPath, std::string& ssid)
+        {
+            GError *error = NULL;
+            GDBusProxy *ConnProxy = NULL;
+            GVariant *settingsProxy= NULL;
+            bool ret = false;
+
+            ConnProxy = m_dbus.getNetworkManagerSettingsConnectionProxy(connPath.c_str());
+            if(ConnProxy == NULL)
+                return false;
+
+            settingsProxy = DbusAsyncClient::getInstance()->callSync(ConnProxy, "GetSettings", NULL, GDBUS_READ_TIMEOUT_MS, &error);
+            if (!settingsProxy) {
+                g_dbus_error_strip_remote_error(error);
+                NMLOG_ERROR("Failed to get connection settings: %s", error->message);
+                g_error_free(error);
+                g_object_unref(ConnProxy);
+                return false;
+            }
+
+            ret = getSSIDFromSettings(settingsProxy, ssid);
+            g_variant_unref(settingsProxy);
             g_object_unref(ConnProxy);
 
             return ret;
@@ -1690,7 +1686,7 @@ namespace WPEFramework
             if(ConnProxy == NULL)
                 return false;
 
-            deleteVar = g_dbus_proxy_call_sync(ConnProxy, "Delete", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+            deleteVar = DbusAsyncClient::getInstance()->callSync(ConnProxy, "Delete", NULL, GDBUS_CALL_TIMEOUT_MS, &error);
             if (!deleteVar) {
                 g_dbus_error_strip_remote_error(error);
                 NMLOG_ERROR("Failed to get connection settings: %s", error->message);
@@ -1717,10 +1713,32 @@ namespace WPEFramework
                 return false;
             }
 
+            /* issue every GetSettings first, then collect the replies against one deadline */
+            std::vector<std::future<DbusReply>> replies;
+            replies.reserve(paths.size());
             for (const std::string& path : paths) {
-               // NMLOG_DEBUG("connection path %s", path.c_str());
+                GDBusProxy *ConnProxy = m_dbus.getNetworkManagerSettingsConnectionProxy(path.c_str());
+                if(ConnProxy == NULL)
+                    continue;
+                replies.push_back(DbusAsyncClient::getInstance()->call(ConnProxy, "GetSettings", NULL, GDBUS_READ_TIMEOUT_MS));
+                g_object_unref(ConnProxy);
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(GDBUS_READ_TIMEOUT_MS);
+            for (auto& pending : replies) {
+                if(pending.wait_until(deadline) != std::future_status::ready)
+                {
+                    NMLOG_WARNING("connection settings not received in %d ms", GDBUS_READ_TIMEOUT_MS);
+                    continue;
+                }
+                DbusReply reply = pending.get();
+                if(!reply.ok())
+                {
+                    NMLOG_ERROR("Failed to get connection settings: %s", reply.errorMessage());
+                    continue;
+                }
                 std::string ssid;
-                if(getSSIDFromConnection(m_dbus, path, ssid) && !ssid.empty())
+                if(getSSIDFromSettings(reply.value(), ssid) && !ssid.empty())
                     ssids.push_back(ssid);
             }
 
@@ -1801,7 +1819,7 @@ namespace WPEFramework
             if (wProxy == NULL)
                 return false;
 
-            GVariant* result = g_dbus_proxy_call_sync(wProxy, "GetAllAccessPoints", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(wProxy, "GetAllAccessPoints", NULL, GDBUS_READ_TIMEOUT_MS, &error);
             if (error) {
                 NMLOG_ERROR("Error creating proxy: %s", error->message);
                 g_error_free(error);
@@ -1883,13 +1901,21 @@ namespace WPEFramework
                 /* ssid GVariant = [['S', 'S', 'I', 'D']] */
                 g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
                 g_variant_builder_add(&builder, "{sv}", "ssids", g_variant_builder_end(&ssidArray));
-                g_dbus_proxy_call_sync(wProxy, "RequestScan", g_variant_new("(a{sv})", builder),
-                                             G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+                DbusAsyncClient::getInstance()->callSync(
+                                             wProxy,
+                                             "RequestScan",
+                                             g_variant_new("(a{sv})", builder),
+                                             GDBUS_CALL_TIMEOUT_MS,
+                                             &error);
             }
 
             else {
-                g_dbus_proxy_call_sync(wProxy, "RequestScan", g_variant_new("(a{sv})", NULL),
-                                            G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+                DbusAsyncClient::getInstance()->callSync(
+                                            wProxy,
+                                            "RequestScan",
+                                            g_variant_new("(a{sv})", NULL),
+                                            GDBUS_CALL_TIMEOUT_MS,
+                                            &error);
             }
 
             if (error)
@@ -1983,9 +2009,12 @@ namespace WPEFramework
             if(proxy == NULL)
                 return false;
 
-            result = g_dbus_proxy_call_sync (proxy, "Update",
+            result = DbusAsyncClient::getInstance()->callSync(
+                proxy,
+                "Update",
                 g_variant_new("(a{sa{sv}})", connBuilder),
-                G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+                GDBUS_CALL_TIMEOUT_MS,
+                &error);
 
             if (error) {
                 NMLOG_ERROR("Failed to call Update : %s", error->message);
@@ -2009,9 +2038,12 @@ namespace WPEFramework
             }
             const char* specificObject = "/";
 
-            result = g_dbus_proxy_call_sync (proxy, "ActivateConnection",
+            result = DbusAsyncClient::getInstance()->callSync(
+                proxy,
+                "ActivateConnection",
                 g_variant_new("(ooo)", connPath, devicePath, specificObject),
-                G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+                GDBUS_CALL_TIMEOUT_MS,
+                &error);
 
             if (error) {
                 NMLOG_ERROR("Failed to call ActivateConnection: %s", error->message);
@@ -2073,9 +2105,12 @@ namespace WPEFramework
             }
 
             NMLOG_DEBUG("devicePath %s, specificObject %s", devicePath, specificObject);
-            result = g_dbus_proxy_call_sync (proxy, "AddAndActivateConnection2",
+            result = DbusAsyncClient::getInstance()->callSync(
+                proxy,
+                "AddAndActivateConnection2",
                 g_variant_new("(@a{sa{sv}}oo@a{sv})", connBuilderVariant, devicePath?: "/", specificObject?: "/", optionBuilderVariant),
-                G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+                GDBUS_CALL_TIMEOUT_MS,
+                &error);
 
             if (result == NULL) {
                 if(error != NULL)
@@ -2288,9 +2323,12 @@ namespace WPEFramework
 
                 if(proxy != nullptr)
                 {
-                    result = g_dbus_proxy_call_sync (proxy, "Update",
+                    result = DbusAsyncClient::getInstance()->callSync(
+                                proxy,
+                                "Update",
                                 g_variant_new("(a{sa{sv}})", connBuilder),
-                                G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+                                GDBUS_CALL_TIMEOUT_MS,
+                                &error);
 
                     if (error == nullptr) {
                         NMLOG_DEBUG("same connection updated success : %s", exsistingConn.c_str());
@@ -2311,8 +2349,12 @@ namespace WPEFramework
                 proxy = m_dbus.getNetworkManagerSettingsProxy();
                 if (proxy != nullptr)
                 {
-                    result = g_dbus_proxy_call_sync (proxy, "AddConnection",
-                                g_variant_new ("(a{sa{sv}})", &connBuilder), G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+                    result = DbusAsyncClient::getInstance()->callSync(
+                                proxy,
+                                "AddConnection",
+                                g_variant_new ("(a{sa{sv}})", &connBuilder),
+                                GDBUS_CALL_TIMEOUT_MS,
+                                &error);
 
                     if (error != nullptr) {
                         g_dbus_error_strip_remote_error (error);
@@ -2643,7 +2685,7 @@ namespace WPEFramework
             if(wProxy == NULL)
                 return false;
             else
-            g_dbus_proxy_call_sync(wProxy, "Disconnect", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+            DbusAsyncClient::getInstance()->callSync(wProxy, "Disconnect", NULL, GDBUS_CALL_TIMEOUT_MS, &error);
                 return true;
             if (error) {
                 NMLOG_ERROR("Error calling Disconnect method: %s", error->message);
@@ -2680,13 +2722,11 @@ namespace WPEFramework
             if (deviceProxy != nullptr) {
                 GVariant *autoconnectValue = g_variant_new_boolean(TRUE);
                 GError *setError = nullptr;
-                g_dbus_proxy_call_sync(
+                DbusAsyncClient::getInstance()->callSync(
                     deviceProxy,
                     "Set",
                     g_variant_new("(ssv)", "org.freedesktop.NetworkManager.Device", "Autoconnect", autoconnectValue),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_CALL_TIMEOUT_MS,
                     &setError);
 
                 if (setError) {
@@ -2706,13 +2746,11 @@ namespace WPEFramework
                 return false;
             }
 
-            GVariant *connectionsResult = g_dbus_proxy_call_sync(
+            GVariant *connectionsResult = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "ListConnections",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (error || connectionsResult == nullptr) {
@@ -2854,7 +2892,7 @@ namespace WPEFramework
             if (wProxy == NULL)
                 return false;
 
-            GVariant* result = g_dbus_proxy_call_sync(wProxy, "GetAllAccessPoints", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(wProxy, "GetAllAccessPoints", NULL, GDBUS_READ_TIMEOUT_MS, &error);
             if (error) {
                 NMLOG_ERROR("Error creating proxy: %s", error->message);
                 g_error_free(error);
@@ -2963,11 +3001,19 @@ namespace WPEFramework
                 return;
             }
 
+            auto scanDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(GDBUS_WPS_RETRY_COUNT * GDBUS_WPS_RETRY_WAIT_IN_MS);
             for(int retry = 0; retry < GDBUS_WPS_RETRY_COUNT; retry++)
             {
                 if(m_wpsProcessRun.load() == false) // stop wps process if requested
                     break;
-                sleep(GDBUS_WPS_RETRY_WAIT_IN_MS);
+                /* wake up on the event the retry is waiting for; the retry interval stays the upper bound */
+                if(m_wpsActionTriggered)
+                    waitForDeviceState(m_dbus, devProperty.path, [](NMDeviceState state) {
+                        return state <= NM_DEVICE_STATE_DISCONNECTED || state > NM_DEVICE_STATE_NEED_AUTH;
+                    }, GDBUS_WPS_RETRY_WAIT_IN_MS * 1000, &m_wpsProcessRun);
+                else if(waitForLastScan(m_dbus, GDBUS_WPS_RETRY_WAIT_IN_MS * 1000, &m_wpsProcessRun) &&
+                        std::chrono::steady_clock::now() < scanDeadline)
+                    retry--; // an early scan result does not use up a retry of the WPS walk time
                 if(m_wpsProcessRun.load() == false)
                     break;
 
@@ -3042,7 +3088,9 @@ namespace WPEFramework
                 {
                     NMLOG_INFO("Disconnecting current connection for WPS process");
                     wifiDisconnect();
-                    sleep(3); // Wait for disconnect to complete
+                    waitForDeviceState(m_dbus, devProperty.path, [](NMDeviceState state) {
+                        return state <= NM_DEVICE_STATE_DISCONNECTED;
+                    }, GDBUS_WPS_DISCONNECT_WAIT_MS, &m_wpsProcessRun);
                 }
 
                 ssidinfo.security = Exchange::INetworkManager::WIFISecurityMode::WIFI_SECURITY_WPA_PSK;
@@ -3118,13 +3166,11 @@ namespace WPEFramework
             }
 
             // Get all connections
-            GVariant *connectionsResult = g_dbus_proxy_call_sync(
+            GVariant *connectionsResult = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "ListConnections",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (error || connectionsResult == nullptr) {
@@ -3148,13 +3194,11 @@ namespace WPEFramework
                     continue;
                 }
 
-                GVariant *settingsResult = g_dbus_proxy_call_sync(
+                GVariant *settingsResult = DbusAsyncClient::getInstance()->callSync(
                         connectionProxy,
                         "GetSettings",
                         nullptr,
-                        G_DBUS_CALL_FLAGS_NONE,
-                        -1,
-                        nullptr,
+                        GDBUS_READ_TIMEOUT_MS,
                         &error);
 
                 if (error || settingsResult == nullptr) {
@@ -3252,13 +3296,11 @@ namespace WPEFramework
             }
 
             // Get all connections
-            GVariant *connectionsResult = g_dbus_proxy_call_sync(
+            GVariant *connectionsResult = DbusAsyncClient::getInstance()->callSync(
                     settingsProxy,
                     "ListConnections",
                     nullptr,
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (error || connectionsResult == nullptr) {
@@ -3282,13 +3324,11 @@ namespace WPEFramework
                     continue;
                 }
 
-                GVariant *settingsResult = g_dbus_proxy_call_sync(
+                GVariant *settingsResult = DbusAsyncClient::getInstance()->callSync(
                         connectionProxy,
                         "GetSettings",
                         nullptr,
-                        G_DBUS_CALL_FLAGS_NONE,
-                        -1,
-                        nullptr,
+                        GDBUS_READ_TIMEOUT_MS,
                         &error);
 
                 if (error || settingsResult == nullptr) {
@@ -32,6 +32,9 @@
 
 #define GDBUS_WPS_RETRY_WAIT_IN_MS        10 // 10 sec
 #define GDBUS_WPS_RETRY_COUNT             10
+#define GDBUS_WPS_DISCONNECT_WAIT_MS      3000
+#define GDBUS_DEVICE_DISCONNECT_WAIT_MS   12000
+#define GDBUS_DEVICE_MANAGED_WAIT_MS      3000
 
 namespace WPEFramework
 {
@@ -23,9 +23,14 @@
 #include <thread>
 #include <string>
 #include <map>
+#include <vector>
+#include <cmath>
 
 #include "NetworkManagerGdbusEvent.h"
 #include "NetworkManagerGdbusUtils.h"
+#include "NetworkManagerGdbusAsync.h"
+#include "NetworkManagerGdbusObjectModel.h"
+#include "NetworkManagerGlibReactor.h"
 #include "NetworkManagerImplementation.h"
 #include "NetworkManagerLogger.h"
 #include "INetworkManager.h"
@@ -528,18 +533,12 @@ namespace WPEFramework
             g_variant_unref(ip6Config);
     }
 
-    void* NetworkManagerEvents::networkMangerEventMonitor(void *arg)
+    void NetworkManagerEvents::registerEvents(NMEvents *nmEvents)
     {
-        if(arg == NULL)
-        {
-            NMLOG_FATAL("function argument error: nm event monitor failed");
-            return nullptr;
-        }
-
-        NMEvents *nmEvents = static_cast<NMEvents *>(arg);
+        /* proxies made here deliver their signals to the reactor context */
         nmEvents->networkManagerProxy = _NetworkManagerEvents->eventDbus.getNetworkManagerProxy();
         if (nmEvents->networkManagerProxy == NULL) {
-            return nullptr;
+            return;
         }
 
         g_signal_connect(nmEvents->networkManagerProxy, "g-signal", G_CALLBACK(deviceAddRemoveCb), NULL);
@@ -565,54 +564,41 @@ namespace WPEFramework
             g_signal_connect(nmEvents->settingsProxy, "g-signal", G_CALLBACK(onConnectionSignalReceivedCB), NULL);
 
         NMLOG_INFO("registered all networkmnager dbus events");
-        g_main_loop_run(nmEvents->loop);
-
-        if(nmEvents->wirelessDeviceProxy)
-            g_object_unref(nmEvents->wirelessDeviceProxy);
-        if(nmEvents->wirelessProxy)
-            g_object_unref(nmEvents->wirelessProxy);
-        if(nmEvents->wiredDeviceProxy)
-            g_object_unref(nmEvents->wiredDeviceProxy);
-        if(nmEvents->networkManagerProxy)
-            g_object_unref(nmEvents->networkManagerProxy);
-        if(nmEvents->settingsProxy)
-            g_object_unref(nmEvents->settingsProxy);
-        if(nmEvents->ethIPv4Proxy)
-            g_object_unref(nmEvents->ethIPv4Proxy);
-        if(nmEvents->ethIPv6Proxy)
-            g_object_unref(nmEvents->ethIPv6Proxy);
-        if(nmEvents->wlanIPv4Proxy)
-            g_object_unref(nmEvents->wlanIPv4Proxy);
-        if(nmEvents->wlanIPv6Proxy)
-            g_object_unref(nmEvents->wlanIPv6Proxy);
-
-         NMLOG_WARNING("unregistered all event monitor");
-        return nullptr;
+    }
+
+    void NetworkManagerEvents::unregisterEvents(NMEvents *nmEvents)
+    {
+        GDBusProxy **proxies[] = {
+            &nmEvents->wirelessDeviceProxy, &nmEvents->wirelessProxy, &nmEvents->wiredDeviceProxy,
+            &nmEvents->networkManagerProxy, &nmEvents->settingsProxy,
+            &nmEvents->ethIPv4Proxy, &nmEvents->ethIPv6Proxy, &nmEvents->wlanIPv4Proxy, &nmEvents->wlanIPv6Proxy
+        };
+        for (GDBusProxy **proxy : proxies)
+            g_clear_object(proxy);
+
+        NMLOG_WARNING("unregistered all event monitor");
     }
 
     bool NetworkManagerEvents::startNetworkMangerEventMonitor()
     {
         NMLOG_DEBUG("starting gnome event monitor...");
 
-        if(!isEventThrdActive) {
-            isEventThrdActive = true;
-            eventThrdID = g_thread_new("nm_event_thrd", NetworkManagerEvents::networkMangerEventMonitor, &nmEvents);
+        if(!isMonitorActive) {
+            isMonitorActive = true;
+            GlibReactor::getInstance()->post([this]() { registerEvents(&nmEvents); });
         }
         return true;
     }
 
     void NetworkManagerEvents::stopNetworkMangerEventMonitor()
     {
+        if (!isMonitorActive)
+            return;
 
-        if (nmEvents.loop != NULL) {
-            g_main_loop_quit(nmEvents.loop);
-        }
-        if (eventThrdID) {
-            g_thread_join(eventThrdID);
-            eventThrdID = NULL;
-            NMLOG_WARNING("gnome event monitor stoped");
-        }
-        isEventThrdActive = false;
+        /* queued behind the registration, so a quick stop cannot overtake it */
+        GlibReactor::getInstance()->run<void>([this]() { unregisterEvents(&nmEvents); });
+        isMonitorActive = false;
+        NMLOG_WARNING("gnome event monitor stoped");
     }
 
     NetworkManagerEvents::~NetworkManagerEvents()
@@ -630,11 +616,8 @@ namespace WPEFramework
     NetworkManagerEvents::NetworkManagerEvents()
     {
         NMLOG_DEBUG("NetworkManagerEvents");
-        nmEvents.loop = g_main_loop_new(NULL, FALSE);
-        if(nmEvents.loop == NULL) {
-            NMLOG_FATAL("GMain loop failed Fatal Error: Event will not work");
-            return;
-        }
+        /* constructed first, so the reactor outlives the monitor */
+        GlibReactor::getInstance();
         strncpy(wlanIfname, GnomeUtils::getWifiIfname(), sizeof(wlanIfname));
         strncpy(ethIfname, GnomeUtils::getEthIfname(), sizeof(ethIfname));
         _NetworkManagerEvents = this;
@@ -763,11 +746,35 @@ namespace WPEFramework
         }
 
         _NetworkManagerEvents->doScanNotify = false;
+
+        /* one GetManagedObjects call resolves every access point of the scan */
+        ManagedObjectModel* model = ManagedObjectModel::getInstance();
+        std::vector<std::string> apPaths;
+        if(model->refresh(_NetworkManagerEvents->eventDbus.getConnection()) && model->getAccessPoints(wifiDevicePath, apPaths))
+        {
+            ScanResultSet scanResults;
+            scanResults.reserve(apPaths.size());
+            for (const std::string& apPath : apPaths) {
+                Exchange::INetworkManager::WiFiSSIDInfo wifiInfo;
+                bool valid = false;
+                if(model->lookupAccessPoint(apPath, wifiInfo, valid) && valid)
+                {
+                    scanResults.add(wifiInfo.ssid, wifiInfo.bssid, static_cast<uint32_t>(std::lround(wifiInfo.frequency * 1000)),
+                                    wifiInfo.strength, static_cast<uint8_t>(wifiInfo.security));
+                }
+            }
+
+            if(!scanResults.empty() && _instance != nullptr)
+                _instance->ReportAvailableSSIDs(scanResults);
+            return;
+        }
+
+        NMLOG_WARNING("managed object snapshot unavailable, reading access points one by one");
         wProxy = _NetworkManagerEvents->eventDbus.getNetworkManagerWirelessProxy(wifiDevicePath);
         if(wProxy == NULL)
             return;
 
-        GVariant* result = g_dbus_proxy_call_sync(wProxy, "GetAllAccessPoints", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+        GVariant* result = g_dbus_proxy_call_sync(wProxy, "GetAllAccessPoints", NULL, G_DBUS_CALL_FLAGS_NONE, GDBUS_READ_TIMEOUT_MS, NULL, &error);
         if (error) {
             NMLOG_ERROR("Error creating proxy: %s", error->message);
             g_error_free(error);
@@ -777,8 +784,7 @@ namespace WPEFramework
 
         GVariantIter* iter = NULL;
         const gchar* apPath = NULL;
-        JsonArray ssidList = JsonArray();
-        bool oneSSIDFound = false;
+        ScanResultSet scanResults;
 
         g_variant_get(result, "(ao)", &iter);
         if(iter == NULL)
@@ -793,22 +799,13 @@ namespace WPEFramework
             // NMLOG_DEBUG("Access Point Path: %s", apPath);
             if(apPath != NULL && GnomeUtils::getApDetails(_NetworkManagerEvents->eventDbus, apPath, wifiInfo))
             {
-                JsonObject ssidObj;
-                if(GnomeUtils::convertSsidInfoToJsonObject(wifiInfo, ssidObj))
-                {
-                    ssidList.Add(ssidObj);
-                    oneSSIDFound = true;
-                }
+                scanResults.add(wifiInfo.ssid, wifiInfo.bssid, static_cast<uint32_t>(std::lround(wifiInfo.frequency * 1000)),
+                                wifiInfo.strength, static_cast<uint8_t>(wifiInfo.security));
             }
         }
 
-        if(oneSSIDFound) {
-            std::string ssids{};
-            ssidList.ToString(ssids);
-            if(_instance != nullptr)
-                _instance->ReportAvailableSSIDs(ssidList);
-            NMLOG_DEBUG("scanned ssids: %s", ssids.c_str());
-        }
+        if(!scanResults.empty() && _instance != nullptr)
+            _instance->ReportAvailableSSIDs(scanResults);
 
         g_variant_iter_free(iter);
         g_variant_unref(result);
@@ -46,8 +46,6 @@ namespace WPEFramework
     
         std::string wifiDevicePath;
         std::string ethDevicePath;
-
-        GMainLoop *loop;
     } NMEvents;
 
     class NetworkManagerEvents
@@ -67,12 +65,13 @@ namespace WPEFramework
         void setwifiScanOptions(bool doNotify);
 
     private:
-        static void* networkMangerEventMonitor(void *arg);
+        /* both run on the GlibReactor thread */
+        static void registerEvents(NMEvents *nmEvents);
+        static void unregisterEvents(NMEvents *nmEvents);
         NetworkManagerEvents();
         ~NetworkManagerEvents();
-        std::atomic<bool>isEventThrdActive = {false};
+        std::atomic<bool>isMonitorActive = {false};
         std::atomic<bool>doScanNotify = {true};
-        GThread *eventThrdID;
     public:
         NMEvents nmEvents{};
         DbusMgr eventDbus;
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "NetworkManagerGdbusMgr.h"
+#include "NetworkManagerGdbusAsync.h"
 #include "NetworkManagerLogger.h"
 
 namespace WPEFramework
@@ -29,7 +30,7 @@ namespace WPEFramework
     namespace Plugin
     {
 
-        DbusMgr::DbusMgr() : connection(NULL)
+        DbusMgr::DbusMgr(bool cacheProxies) : connection(NULL), m_cacheProxies(cacheProxies)
         {
             GError* error = NULL;
             NMLOG_INFO("DbusMgr");
@@ -43,6 +44,10 @@ namespace WPEFramework
 
         DbusMgr::~DbusMgr() {
             NMLOG_INFO("~DbusMgr");
+            for (guint watch : m_watches)
+                DbusAsyncClient::getInstance()->unsubscribeSignal(connection, watch);
+            m_watches.clear();
+            flushProxyCache();
             if (connection) {
                 g_object_unref(connection);
                 connection = NULL;
@@ -133,6 +138,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerDeviceProxy(const char* devicePath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(devicePath, "org.freedesktop.NetworkManager.Device");
+
             GError* error = NULL;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                 getConnection(), flags, NULL, "org.freedesktop.NetworkManager",
@@ -175,6 +183,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerAccessPointProxy(const char* apPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(apPath, "org.freedesktop.NetworkManager.AccessPoint");
+
             GError* error = NULL;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                 getConnection(), flags, NULL, "org.freedesktop.NetworkManager",
@@ -196,6 +207,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerWirelessProxy(const char* wirelessDevPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(wirelessDevPath, "org.freedesktop.NetworkManager.Device.Wireless");
+
             GError* error = NULL;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                 getConnection(), flags, NULL, "org.freedesktop.NetworkManager",
@@ -217,6 +231,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerIpv4Proxy(const char* ipConfigPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(ipConfigPath, "org.freedesktop.NetworkManager.IP4Config");
+
             GError* error = NULL;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                 getConnection(), flags, NULL, "org.freedesktop.NetworkManager",
@@ -238,6 +255,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerIpv6Proxy(const char* ipConfigPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(ipConfigPath, "org.freedesktop.NetworkManager.IP6Config");
+
             GError* error = NULL;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                 getConnection(), flags, NULL, "org.freedesktop.NetworkManager",
@@ -259,6 +279,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerDhcpv4Proxy(const char* dhcpConfigPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(dhcpConfigPath, "org.freedesktop.NetworkManager.DHCP4Config");
+
             GError* error = nullptr;
             GDBusProxy *proxy = g_dbus_proxy_new_sync(
                     getConnection(),
@@ -281,6 +304,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerDhcpv6Proxy(const char* dhcpConfigPath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(dhcpConfigPath, "org.freedesktop.NetworkManager.DHCP6Config");
+
             GError* error = nullptr;
             GDBusProxy *proxy = g_dbus_proxy_new_sync(
                     getConnection(),
@@ -303,6 +329,9 @@ namespace WPEFramework
 
         GDBusProxy* DbusMgr::getNetworkManagerPropertyProxy(const char* devicePath)
         {
+            if (m_cacheProxies)
+                return getCachedProxy(devicePath, "org.freedesktop.DBus.Properties");
+
             GError* error = nullptr;
             GDBusProxy* proxy = g_dbus_proxy_new_sync(
                     getConnection(),
@@ -324,6 +353,144 @@ namespace WPEFramework
             return proxy;
         }
 
+        GDBusProxy* DbusMgr::getCachedProxy(const char* objectPath, const char* interfaceName)
+        {
+            if (objectPath == NULL || !g_variant_is_object_path(objectPath)) {
+                NMLOG_ERROR("invalid object path for %s proxy", interfaceName);
+                return NULL;
+            }
+
+            std::call_once(m_watchOnce, [this]() { watchObjectRemoval(); });
+            {
+                std::lock_guard<std::mutex> lock(m_proxyCacheLock);
+                auto object = m_proxyCache.find(objectPath);
+                if (object != m_proxyCache.end()) {
+                    auto cached = object->second.find(interfaceName);
+                    if (cached != object->second.end())
+                        return G_DBUS_PROXY(g_object_ref(cached->second));
+                }
+            }
+
+            /* created on the async client context so the cached properties stay current */
+            GError* error = NULL;
+            GDBusProxy* proxy = DbusAsyncClient::getInstance()->newProxy(getConnection(), objectPath, interfaceName, GDBUS_READ_TIMEOUT_MS, &error);
+            if (proxy == NULL) {
+                if (error != NULL) {
+                    g_dbus_error_strip_remote_error(error);
+                    NMLOG_FATAL("Error creating proxy: %s", error->message);
+                    g_clear_error(&error);
+                }
+                return NULL;
+            }
+
+            /* without the removal watches a cached proxy could outlive its object */
+            if (m_watches.empty())
+                return proxy;
+
+            std::lock_guard<std::mutex> lock(m_proxyCacheLock);
+            if (m_proxyCacheSize >= GDBUS_PROXY_CACHE_MAX)
+                flushProxyCache();
+
+            GDBusProxy*& cached = m_proxyCache[objectPath][interfaceName];
+            if (cached != NULL) {
+                /* another thread created it meanwhile */
+                g_object_unref(proxy);
+            } else {
+                cached = proxy;
+                m_proxyCacheSize++;
+            }
+            return G_DBUS_PROXY(g_object_ref(cached));
+        }
+
+        void DbusMgr::watchObjectRemoval()
+        {
+            DbusAsyncClient* client = DbusAsyncClient::getInstance();
+            GDBusConnection* conn = getConnection();
+            guint watch = 0;
+
+            watch = client->subscribeSignal(conn, "org.freedesktop.NetworkManager", "org.freedesktop.NetworkManager",
+                        "DeviceRemoved", "/org/freedesktop/NetworkManager", [this](const char*, GVariant* parameters) {
+                            if (g_variant_is_of_type(parameters, G_VARIANT_TYPE("(o)"))) {
+                                const gchar* path = NULL;
+                                g_variant_get(parameters, "(&o)", &path);
+                                dropCachedProxies(path);
+                            }
+                        });
+            if (watch != 0)
+                m_watches.push_back(watch);
+
+            watch = client->subscribeSignal(conn, "org.freedesktop.NetworkManager", "org.freedesktop.NetworkManager.Device.Wireless",
+                        "AccessPointRemoved", NULL, [this](const char*, GVariant* parameters) {
+                            if (g_variant_is_of_type(parameters, G_VARIANT_TYPE("(o)"))) {
+                                const gchar* path = NULL;
+                                g_variant_get(parameters, "(&o)", &path);
+                                dropCachedProxies(path);
+                            }
+                        });
+            if (watch != 0)
+                m_watches.push_back(watch);
+
+            /* IP and DHCP config objects are replaced without a dedicated signal */
+            watch = client->subscribeSignal(conn, "org.freedesktop.NetworkManager", "org.freedesktop.DBus.ObjectManager",
+                        "InterfacesRemoved", "/org/freedesktop", [this](const char*, GVariant* parameters) {
+                            if (g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oas)"))) {
+                                const gchar* path = NULL;
+                                g_variant_get(parameters, "(&o@as)", &path, NULL);
+                                dropCachedProxies(path);
+                            }
+                        });
+            if (watch != 0)
+                m_watches.push_back(watch);
+
+            /* a restarted NetworkManager invalidates every object */
+            watch = client->subscribeSignal(conn, "org.freedesktop.DBus", "org.freedesktop.DBus",
+                        "NameOwnerChanged", "/org/freedesktop/DBus", [this](const char*, GVariant* parameters) {
+                            const gchar* name = NULL;
+                            if (g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)"))) {
+                                g_variant_get(parameters, "(&s&s&s)", &name, NULL, NULL);
+                                if (g_strcmp0(name, "org.freedesktop.NetworkManager") == 0) {
+                                    NMLOG_INFO("NetworkManager owner changed, dropping cached proxies");
+                                    std::lock_guard<std::mutex> lock(m_proxyCacheLock);
+                                    flushProxyCache();
+                                }
+                            }
+                        });
+            if (watch != 0)
+                m_watches.push_back(watch);
+
+            if (m_watches.size() != 4) {
+                NMLOG_WARNING("object removal watches incomplete, proxies are not cached");
+                for (guint id : m_watches)
+                    client->unsubscribeSignal(conn, id);
+                m_watches.clear();
+            }
+        }
+
+        void DbusMgr::dropCachedProxies(const std::string& objectPath)
+        {
+            std::lock_guard<std::mutex> lock(m_proxyCacheLock);
+            auto object = m_proxyCache.find(objectPath);
+            if (object == m_proxyCache.end())
+                return;
+
+            for (auto& cached : object->second)
+                g_object_unref(cached.second);
+            m_proxyCacheSize -= object->second.size();
+            m_proxyCache.erase(object);
+            NMLOG_DEBUG("dropped cached proxies of %s", objectPath.c_str());
+        }
+
+        /* caller holds m_proxyCacheLock, or is the destructor */
+        void DbusMgr::flushProxyCache()
+        {
+            for (auto& object : m_proxyCache) {
+                for (auto& cached : object.second)
+                    g_object_unref(cached.second);
+            }
+            m_proxyCache.clear();
+            m_proxyCacheSize = 0;
+        }
+
     } // Plugin
 } // WPEFramework
 
@@ -22,17 +22,27 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <mutex>
+#include <unordered_map>
 
 /* include NetworkManager.h for the defines, but we don't link against libnm. */
 #include <libnm/nm-dbus-interface.h>
 
+#define GDBUS_PROXY_CACHE_MAX             256     // proxies kept before the cache is flushed
+
 namespace WPEFramework
 {
     namespace Plugin
     {
         class DbusMgr {
             public:
-                DbusMgr();
+                /*
+                 * With cacheProxies the per object proxies (device, wireless, IP and DHCP config,
+                 * access point) are created once per object path and reused until NetworkManager
+                 * removes the object. Callers still unref what they get. Not for users that
+                 * connect GObject signals to the proxies, those need a proxy of their own.
+                 */
+                DbusMgr(bool cacheProxies = false);
                 ~DbusMgr();
 
                 GDBusProxy* getNetworkManagerProxy();
@@ -50,9 +60,20 @@ namespace WPEFramework
                 GDBusProxy* getNetworkManagerDhcpv6Proxy(const char* dhcpConfigPath);
 
             private:
+                GDBusProxy* getCachedProxy(const char* objectPath, const char* interfaceName);
+                void watchObjectRemoval();
+                void dropCachedProxies(const std::string& objectPath);
+                void flushProxyCache();
+
                 GDBusConnection* connection;
                 GDBusProxyFlags flags;
                 GDBusProxy *nmProxy = NULL;
+                bool m_cacheProxies;
+                std::mutex m_proxyCacheLock;
+                std::unordered_map<std::string, std::unordered_map<std::string, GDBusProxy*>> m_proxyCache;
+                size_t m_proxyCacheSize = 0;
+                std::once_flag m_watchOnce;
+                std::list<guint> m_watches;
             };
 
     }
@@ -0,0 +1,371 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <glib.h>
+#include <gio/gio.h>
+
+#include "NetworkManagerGdbusObjectModel.h"
+#include "NetworkManagerGdbusAsync.h"
+#include "NetworkManagerGdbusUtils.h"
+#include "NetworkManagerLogger.h"
+
+#define NM_OBJECT_MANAGER_PATH            "/org/freedesktop"
+#define NM_ACCESS_POINT_INTERFACE         "org.freedesktop.NetworkManager.AccessPoint"
+#define NM_WIRELESS_INTERFACE             "org.freedesktop.NetworkManager.Device.Wireless"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        static const char* s_trackedInterfaces[] = {
+            NM_ACCESS_POINT_INTERFACE,
+            "org.freedesktop.NetworkManager.Device",
+            NM_WIRELESS_INTERFACE,
+            "org.freedesktop.NetworkManager.IP4Config",
+            "org.freedesktop.NetworkManager.IP6Config"
+        };
+
+        ManagedObjectModel::~ManagedObjectModel()
+        {
+            for (guint watch : m_watches)
+                DbusAsyncClient::getInstance()->unsubscribeSignal(m_connection, watch);
+            m_watches.clear();
+            clear();
+            if (m_connection)
+                g_object_unref(m_connection);
+        }
+
+        bool ManagedObjectModel::isTracked(const char* interfaceName)
+        {
+            for (const char* tracked : s_trackedInterfaces)
+            {
+                if (g_strcmp0(tracked, interfaceName) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        void ManagedObjectModel::releaseProperties(PropertyMap& properties)
+        {
+            for (auto& property : properties)
+                g_variant_unref(property.second);
+            properties.clear();
+        }
+
+        void ManagedObjectModel::clear()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (auto& object : m_objects)
+            {
+                for (auto& iface : object.second)
+                    releaseProperties(iface.second);
+            }
+            m_objects.clear();
+            m_loaded = false;
+        }
+
+        bool ManagedObjectModel::isLive()
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            return m_loaded && !m_watches.empty();
+        }
+
+        void ManagedObjectModel::addInterfaces(const char* objectPath, GVariant* interfaces)
+        {
+            GVariantIter ifaceIter;
+            const gchar* interfaceName = NULL;
+            GVariant* properties = NULL;
+
+            g_variant_iter_init(&ifaceIter, interfaces);
+            while (g_variant_iter_next(&ifaceIter, "{&s@a{sv}}", &interfaceName, &properties))
+            {
+                if (isTracked(interfaceName))
+                {
+                    PropertyMap& propertyMap = m_objects[objectPath][interfaceName];
+                    GVariantIter propIter;
+                    const gchar* name = NULL;
+                    GVariant* value = NULL;
+                    g_variant_iter_init(&propIter, properties);
+                    while (g_variant_iter_next(&propIter, "{&sv}", &name, &value))
+                    {
+                        GVariant*& slot = propertyMap[name];
+                        if (slot)
+                            g_variant_unref(slot);
+                        slot = value;
+                    }
+                }
+                g_variant_unref(properties);
+            }
+        }
+
+        bool ManagedObjectModel::subscribe(GDBusConnection* connection)
+        {
+            DbusAsyncClient* client = DbusAsyncClient::getInstance();
+            std::list<guint> watches;
+            guint watch = 0;
+
+            watch = client->subscribeSignal(connection, "org.freedesktop.NetworkManager", "org.freedesktop.DBus.Properties",
+                        "PropertiesChanged", NULL, [this](const char* objectPath, GVariant* parameters) {
+                            onPropertiesChanged(objectPath, parameters);
+                        });
+            if (watch != 0)
+                watches.push_back(watch);
+
+            watch = client->subscribeSignal(connection, "org.freedesktop.NetworkManager", "org.freedesktop.DBus.ObjectManager",
+                        "InterfacesAdded", NM_OBJECT_MANAGER_PATH, [this](const char*, GVariant* parameters) {
+                            onInterfacesAdded(parameters);
+                        });
+            if (watch != 0)
+                watches.push_back(watch);
+
+            watch = client->subscribeSignal(connection, "org.freedesktop.NetworkManager", "org.freedesktop.DBus.ObjectManager",
+                        "InterfacesRemoved", NM_OBJECT_MANAGER_PATH, [this](const char*, GVariant* parameters) {
+                            onInterfacesRemoved(parameters);
+                        });
+            if (watch != 0)
+                watches.push_back(watch);
+
+            /* objects of a restarted NetworkManager are not in the snapshot until the next refresh */
+            watch = client->subscribeSignal(connection, "org.freedesktop.DBus", "org.freedesktop.DBus",
+                        "NameOwnerChanged", "/org/freedesktop/DBus", [this](const char*, GVariant* parameters) {
+                            const gchar* name = NULL;
+                            if (g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)"))) {
+                                g_variant_get(parameters, "(&s&s&s)", &name, NULL, NULL);
+                                if (g_strcmp0(name, "org.freedesktop.NetworkManager") == 0)
+                                    clear();
+                            }
+                        });
+            if (watch != 0)
+                watches.push_back(watch);
+
+            if (watches.size() != 4)
+            {
+                NMLOG_WARNING("managed object watches incomplete, snapshot is refreshed per scan only");
+                for (guint id : watches)
+                    client->unsubscribeSignal(connection, id);
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_connection = G_DBUS_CONNECTION(g_object_ref(connection));
+            m_watches = std::move(watches);
+            return true;
+        }
+
+        bool ManagedObjectModel::refresh(GDBusConnection* connection)
+        {
+            if (connection == NULL)
+                return false;
+
+            {
+                /* subscribe before loading, so no change falls between the snapshot and the first signal */
+                std::lock_guard<std::mutex> subscribeLock(m_subscribeLock);
+                bool subscribed = false;
+                {
+                    std::lock_guard<std::mutex> lock(m_lock);
+                    subscribed = !m_watches.empty();
+                }
+                if (!subscribed)
+                    subscribe(connection);
+            }
+
+            GError* error = NULL;
+            GVariant* reply = g_dbus_connection_call_sync(connection, "org.freedesktop.NetworkManager", NM_OBJECT_MANAGER_PATH,
+                                    "org.freedesktop.DBus.ObjectManager", "GetManagedObjects", NULL,
+                                    G_VARIANT_TYPE("(a{oa{sa{sv}}})"), G_DBUS_CALL_FLAGS_NONE, GDBUS_READ_TIMEOUT_MS, NULL, &error);
+            if (reply == NULL)
+            {
+                if (error != NULL)
+                {
+                    g_dbus_error_strip_remote_error(error);
+                    NMLOG_ERROR("GetManagedObjects failed: %s", error->message);
+                    g_error_free(error);
+                }
+                return false;
+            }
+
+            GVariant* objects = g_variant_get_child_value(reply, 0);
+            GVariantIter iter;
+            const gchar* objectPath = NULL;
+            GVariant* interfaces = NULL;
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            for (auto& object : m_objects)
+            {
+                for (auto& iface : object.second)
+                    releaseProperties(iface.second);
+            }
+            m_objects.clear();
+
+            g_variant_iter_init(&iter, objects);
+            while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &objectPath, &interfaces))
+            {
+                addInterfaces(objectPath, interfaces);
+                g_variant_unref(interfaces);
+            }
+            m_loaded = true;
+
+            g_variant_unref(objects);
+            g_variant_unref(reply);
+            NMLOG_DEBUG("managed object snapshot holds %zu objects", m_objects.size());
+            return true;
+        }
+
+        void ManagedObjectModel::onPropertiesChanged(const char* objectPath, GVariant* parameters)
+        {
+            if (objectPath == NULL || !g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sa{sv}as)")))
+                return;
+
+            const gchar* interfaceName = NULL;
+            GVariant* changed = NULL;
+            g_variant_get(parameters, "(&s@a{sv}@as)", &interfaceName, &changed, NULL);
+            if (!isTracked(interfaceName))
+            {
+                g_variant_unref(changed);
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto object = m_objects.find(objectPath);
+            if (m_loaded && object != m_objects.end())
+            {
+                /* objects missing from the snapshot arrive with InterfacesAdded */
+                auto iface = object->second.find(interfaceName);
+                if (iface != object->second.end())
+                {
+                    GVariantIter iter;
+                    const gchar* name = NULL;
+                    GVariant* value = NULL;
+                    g_variant_iter_init(&iter, changed);
+                    while (g_variant_iter_next(&iter, "{&sv}", &name, &value))
+                    {
+                        GVariant*& slot = iface->second[name];
+                        if (slot)
+                            g_variant_unref(slot);
+                        slot = value;
+                    }
+                }
+            }
+            g_variant_unref(changed);
+        }
+
+        void ManagedObjectModel::onInterfacesAdded(GVariant* parameters)
+        {
+            if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oa{sa{sv}})")))
+                return;
+
+            const gchar* objectPath = NULL;
+            GVariant* interfaces = NULL;
+            g_variant_get(parameters, "(&o@a{sa{sv}})", &objectPath, &interfaces);
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (m_loaded)
+                    addInterfaces(objectPath, interfaces);
+            }
+            g_variant_unref(interfaces);
+        }
+
+        void ManagedObjectModel::onInterfacesRemoved(GVariant* parameters)
+        {
+            if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oas)")))
+                return;
+
+            const gchar* objectPath = NULL;
+            GVariantIter* ifaceIter = NULL;
+            const gchar* interfaceName = NULL;
+            g_variant_get(parameters, "(&oas)", &objectPath, &ifaceIter);
+
+            std::lock_guard<std::mutex> lock(m_lock);
+            auto object = m_objects.find(objectPath);
+            if (object != m_objects.end())
+            {
+                while (g_variant_iter_next(ifaceIter, "&s", &interfaceName))
+                {
+                    auto iface = object->second.find(interfaceName);
+                    if (iface != object->second.end())
+                    {
+                        releaseProperties(iface->second);
+                        object->second.erase(iface);
+                    }
+                }
+                if (object->second.empty())
+                    m_objects.erase(object);
+            }
+            g_variant_iter_free(ifaceIter);
+        }
+
+        GVariant* ManagedObjectModel::getProperty(const std::string& objectPath, const char* interfaceName, const char* property)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_loaded)
+                return NULL;
+
+            auto object = m_objects.find(objectPath);
+            if (object == m_objects.end())
+                return NULL;
+            auto iface = object->second.find(interfaceName);
+            if (iface == object->second.end())
+                return NULL;
+            auto value = iface->second.find(property);
+            if (value == iface->second.end())
+                return NULL;
+            return g_variant_ref(value->second);
+        }
+
+        bool ManagedObjectModel::getAccessPoints(const std::string& wirelessPath, std::vector<std::string>& apPaths)
+        {
+            GVariant* accessPoints = getProperty(wirelessPath, NM_WIRELESS_INTERFACE, "AccessPoints");
+            if (accessPoints == NULL)
+                return false;
+
+            if (g_variant_is_of_type(accessPoints, G_VARIANT_TYPE_OBJECT_PATH_ARRAY))
+            {
+                GVariantIter iter;
+                const gchar* apPath = NULL;
+                g_variant_iter_init(&iter, accessPoints);
+                apPaths.reserve(g_variant_n_children(accessPoints));
+                while (g_variant_iter_next(&iter, "&o", &apPath))
+                    apPaths.emplace_back(apPath);
+            }
+            g_variant_unref(accessPoints);
+            return true;
+        }
+
+        bool ManagedObjectModel::lookupAccessPoint(const std::string& apPath, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo, bool& valid)
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            if (!m_loaded)
+                return false;
+
+            auto object = m_objects.find(apPath);
+            if (object == m_objects.end())
+                return false;
+            auto ap = object->second.find(NM_ACCESS_POINT_INTERFACE);
+            if (ap == object->second.end())
+                return false;
+
+            const PropertyMap& properties = ap->second;
+            valid = GnomeUtils::getApDetailsFromProperties([&properties](const char* name) -> GVariant* {
+                auto value = properties.find(name);
+                return value == properties.end() ? NULL : g_variant_ref(value->second);
+            }, wifiInfo);
+            return true;
+        }
+    } // Plugin
+} // WPEFramework
@@ -0,0 +1,95 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+#include <gio/gio.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "INetworkManager.h"
+
+namespace WPEFramework
+{
+    namespace Plugin
+    {
+        /*
+         * Snapshot of the NetworkManager objects the gdbus backend reads most: access
+         * points, devices and IP configs. refresh() loads all of them with one
+         * GetManagedObjects call; after that PropertiesChanged, InterfacesAdded and
+         * InterfacesRemoved keep the snapshot current, so resolving a scan list costs
+         * one D-Bus round trip instead of one proxy per access point.
+         */
+        class ManagedObjectModel
+        {
+            public:
+                static ManagedObjectModel* getInstance()
+                {
+                    static ManagedObjectModel instance;
+                    return &instance;
+                }
+
+                ManagedObjectModel(const ManagedObjectModel&) = delete;
+                ManagedObjectModel& operator=(const ManagedObjectModel&) = delete;
+
+                /* Replaces the snapshot; the first call also subscribes to the update signals */
+                bool refresh(GDBusConnection* connection);
+                /* true once a refresh succeeded and the update signals are subscribed */
+                bool isLive();
+                void clear();
+
+                /* new reference to the property value, NULL if the object or property is unknown */
+                GVariant* getProperty(const std::string& objectPath, const char* interfaceName, const char* property);
+
+                /* the AccessPoints property of a wireless device */
+                bool getAccessPoints(const std::string& wirelessPath, std::vector<std::string>& apPaths);
+
+                /*
+                 * Returns false when the snapshot cannot answer (not loaded, or the AP is unknown).
+                 * Otherwise fills wifiInfo and sets valid as GnomeUtils::getApDetails would.
+                 */
+                bool lookupAccessPoint(const std::string& apPath, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo, bool& valid);
+
+            private:
+                using PropertyMap = std::unordered_map<std::string, GVariant*>;
+                using InterfaceMap = std::unordered_map<std::string, PropertyMap>;
+
+                ManagedObjectModel() = default;
+                ~ManagedObjectModel();
+
+                bool subscribe(GDBusConnection* connection);
+                void onPropertiesChanged(const char* objectPath, GVariant* parameters);
+                void onInterfacesAdded(GVariant* parameters);
+                void onInterfacesRemoved(GVariant* parameters);
+                /* caller holds m_lock */
+                void addInterfaces(const char* objectPath, GVariant* interfaces);
+                static bool isTracked(const char* interfaceName);
+                static void releaseProperties(PropertyMap& properties);
+
+                std::mutex m_lock;
+                std::mutex m_subscribeLock;     /* serializes subscribe(); taken before m_lock */
+                std::unordered_map<std::string, InterfaceMap> m_objects;
+                bool m_loaded = false;
+                GDBusConnection* m_connection = nullptr;
+                std::list<guint> m_watches;
+        };
+    } // Plugin
+} // WPEFramework
@@ -27,6 +27,8 @@
 #include "NetworkManagerLogger.h"
 #include "NetworkManagerGdbusUtils.h"
 #include "NetworkManagerGdbusMgr.h"
+#include "NetworkManagerGdbusAsync.h"
+#include "NetworkManagerGdbusObjectModel.h"
 #include "NetworkManagerImplementation.h"
 #include <arpa/inet.h>
 #include <netinet/in.h> // for struct in_addr
@@ -136,17 +138,6 @@ namespace WPEFramework
             return true;
         }
 
-        bool GnomeUtils::convertSsidInfoToJsonObject(Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo, JsonObject& ssidObj)
-        {
-            std::string freq{};
-
-            ssidObj["ssid"] = wifiInfo.ssid;
-            ssidObj["security"] = static_cast<int>(wifiInfo.security);
-            ssidObj["strength"] = wifiInfo.strength;
-            ssidObj["frequency"] = wifiInfo.frequency;
-            return true;
-        }
-
         // TODO change this function 
         const char* GnomeUtils::getWifiIfname() { return ifnameWlan; }
         const char* GnomeUtils::getEthIfname() { return ifnameEth; }
@@ -275,7 +266,7 @@ namespace WPEFramework
             if(nmProxy == NULL)
                 return false;
 
-            devicesVar = g_dbus_proxy_call_sync(nmProxy, "GetDevices", NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, &error);
+            devicesVar = DbusAsyncClient::getInstance()->callSync(nmProxy, "GetDevices", NULL, GDBUS_READ_TIMEOUT_MS, &error);
             if (error) {
                 NMLOG_ERROR("Error calling GetDevices method: %s", error->message);
                 g_error_free(error);
@@ -317,13 +308,11 @@ namespace WPEFramework
             if(nmProxy == NULL)
                 return false;
 
-            GVariant *result = g_dbus_proxy_call_sync(
+            GVariant *result = DbusAsyncClient::getInstance()->callSync(
                     nmProxy,
                     "GetDeviceByIpIface",
                     g_variant_new("(s)", ifaceName),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
+                    GDBUS_READ_TIMEOUT_MS,
                     &error);
 
             if (result == nullptr) {
@@ -345,7 +334,23 @@ namespace WPEFramework
             return true;
         }
 
-        bool GnomeUtils::getApDetails(DbusMgr& m_dbus, const char* apPath, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo)
+        static bool getPropertyU(const std::function<GVariant*(const char*)>& property, const char* name, guint32 *value)
+        {
+            GVariant* result = property(name);
+            if (result == NULL) {
+                NMLOG_ERROR("Failed to get '%s' properties", name);
+                return false;
+            }
+
+            if (g_variant_is_of_type (result, G_VARIANT_TYPE_UINT32))
+                *value = g_variant_get_uint32(result);
+            else
+                NMLOG_WARNING("Unexpected type returned property: %s", g_variant_get_type_string(result));
+            g_variant_unref(result);
+            return true;
+        }
+
+        bool GnomeUtils::getApDetailsFromProperties(const std::function<GVariant*(const char*)>& property, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo)
         {
             guint32 flags= 0, wpaFlags= 0, rsnFlags= 0, freq= 0, bitrate= 0;
             uint8_t strength = 0;
@@ -354,16 +359,10 @@ namespace WPEFramework
             bool ret = false;
             GVariant* ssidVariant = NULL;
 
-            GDBusProxy* proxy = m_dbus.getNetworkManagerAccessPointProxy(apPath);
-            if (proxy == NULL) {
-                return false;
-            }
-
             gsize ssid_length = 0;
-            ssidVariant = g_dbus_proxy_get_cached_property(proxy,"Ssid");
+            ssidVariant = property("Ssid");
             if (!ssidVariant) {
                 NMLOG_ERROR("Failed to get AP properties.");
-                g_object_unref(proxy);
                 return false;
             }
 
@@ -373,10 +372,10 @@ namespace WPEFramework
                 GVariant* result = NULL;
                 gchar *_bssid = NULL;
                 wifiInfo.ssid.assign(reinterpret_cast<const char*>(ssid_data), ssid_length);
-                result = g_dbus_proxy_get_cached_property(proxy,"HwAddress");
+                result = property("HwAddress");
                 if (!result) {
                     NMLOG_ERROR("Failed to get AP properties.");
-                    g_object_unref(proxy);
+                    g_variant_unref(ssidVariant);
                     return false;
                 }
                 g_variant_get(result, "s", &_bssid);
@@ -386,22 +385,22 @@ namespace WPEFramework
                 }
                 g_variant_unref(result);
                 result = NULL;
-                result = g_dbus_proxy_get_cached_property(proxy,"Strength");
+                result = property("Strength");
                 if (!result) {
                     NMLOG_ERROR("Failed to get AP properties.");
-                    g_object_unref(proxy);
+                    g_variant_unref(ssidVariant);
                     return false;
                 }
                 g_variant_get(result, "y", &strength);
                 wifiInfo.strength = GnomeUtils::convertPercentageToSignalStrength((int)strength);
                 g_variant_unref(result);
 
-                GnomeUtils::getCachedPropertyU(proxy, "Flags", &flags);
-                GnomeUtils::getCachedPropertyU(proxy, "WpaFlags", &wpaFlags);
-                GnomeUtils::getCachedPropertyU(proxy, "RsnFlags", &rsnFlags);
-                GnomeUtils::getCachedPropertyU(proxy, "Mode", (guint32*)&mode);
-                GnomeUtils::getCachedPropertyU(proxy, "Frequency", &freq);
-                GnomeUtils::getCachedPropertyU(proxy, "MaxBitrate", &bitrate);
+                getPropertyU(property, "Flags", &flags);
+                getPropertyU(property, "WpaFlags", &wpaFlags);
+                getPropertyU(property, "RsnFlags", &rsnFlags);
+                getPropertyU(property, "Mode", (guint32*)&mode);
+                getPropertyU(property, "Frequency", &freq);
+                getPropertyU(property, "MaxBitrate", &bitrate);
 
                 wifiInfo.frequency = ((double)freq/1000);
                 wifiInfo.rate = bitrate;
@@ -411,13 +410,6 @@ namespace WPEFramework
                 else
                     wifiInfo.noise = 0;
 
-                // NMLOG_DEBUG("SSID: %s", wifiInfo.m_ssid.c_str());
-                // NMLOG_DEBUG("bssid %s", wifiInfo.m_bssid.c_str());
-                // NMLOG_DEBUG("strength : %s dbm (%d%%)", wifiInfo.m_signalStrength.c_str(), strength);
-                // NMLOG_DEBUG("frequency : %f MHz", wifiInfo.m_frequency);
-                // NMLOG_DEBUG("bitrate : %s kbit/s", wifiInfo.m_rate.c_str());
-                // NMLOG_DEBUG("securityMode : %d", wifiInfo.m_securityMode);
- 
                 // TODO add noice
                 ret = true;
             }
@@ -428,8 +420,27 @@ namespace WPEFramework
 
             if(ssidVariant)
                 g_variant_unref(ssidVariant);
-            if(proxy)
-                g_object_unref(proxy);
+
+            return ret;
+        }
+
+        bool GnomeUtils::getApDetails(DbusMgr& m_dbus, const char* apPath, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo)
+        {
+            /* the managed object snapshot answers without a D-Bus round trip while it is live */
+            ManagedObjectModel* model = ManagedObjectModel::getInstance();
+            bool valid = false;
+            if (apPath != NULL && model->isLive() && model->lookupAccessPoint(apPath, wifiInfo, valid))
+                return valid;
+
+            GDBusProxy* proxy = m_dbus.getNetworkManagerAccessPointProxy(apPath);
+            if (proxy == NULL) {
+                return false;
+            }
+
+            bool ret = getApDetailsFromProperties([proxy](const char* name) {
+                return g_dbus_proxy_get_cached_property(proxy, name);
+            }, wifiInfo);
+            g_object_unref(proxy);
 
             return ret;
         }
@@ -505,12 +516,11 @@ namespace WPEFramework
             if(sProxy == NULL)
                 return false;
 
-            listProxy = g_dbus_proxy_call_sync(sProxy,
+            listProxy = DbusAsyncClient::getInstance()->callSync(
+                                        sProxy,
                                         "ListConnections",
                                         NULL,
-                                        G_DBUS_CALL_FLAGS_NONE,
-                                        -1,
-                                        NULL,
+                                        GDBUS_READ_TIMEOUT_MS,
                                         &error);
             if(listProxy == NULL)
             {
@@ -554,15 +564,12 @@ namespace WPEFramework
             if(nmProxy == NULL)
                 return false;
 
-            GVariant* result = g_dbus_proxy_call_sync(
+            GVariant* result = DbusAsyncClient::getInstance()->callSync(
                     nmProxy,
                     "ActivateConnection",
                     g_variant_new("(ooo)", connectionProfile.c_str(), devicePath.c_str(), "/"),
-                    G_DBUS_CALL_FLAGS_NONE,
-                    -1,
-                    nullptr,
-                    &error
-                    );
+                    GDBUS_CALL_TIMEOUT_MS,
+                    &error);
 
             if (error) {
                 NMLOG_ERROR("ActivateConnection Error: %s", error->message);
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <functional>
 
 /* include NetworkManager.h for the defines, but we don't link against libnm. */
 // #include <NetworkManager.h>
@@ -69,6 +70,8 @@ namespace WPEFramework
             public:
                 static bool getDeviceByIpIface(DbusMgr& m_dbus, const gchar *iface_name, std::string& path);
                 static bool getApDetails(DbusMgr& m_dbus, const char* apPath, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo);
+                /* property(name) returns a new reference to the AccessPoint property, or NULL */
+                static bool getApDetailsFromProperties(const std::function<GVariant*(const char*)>& property, Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo);
                 static bool getConnectionPaths(DbusMgr& m_dbus, std::list<std::string>& pathsList);
                 static bool getWifiConnectionPaths(DbusMgr& m_dbus, const char* devicePath, std::list<std::string>& paths);
                 static bool getDevicePropertiesByPath(DbusMgr& m_dbus, const char* devPath, deviceInfo& properties);
@@ -85,7 +88,6 @@ namespace WPEFramework
                 static std::string ip6ToString(const uint8_t *ipv6);
                 static void addGvariantToBuilder(GVariant *variant, GVariantBuilder *builder, gboolean excludeRouteMetric);
 
-                static bool convertSsidInfoToJsonObject(Exchange::INetworkManager::WiFiSSIDInfo& wifiInfo, JsonObject& ssidObj);
                 static int convertPercentageToSignalStrength(int percentage);
                 static uint8_t wifiSecurityModeFromApFlags(const std::string& ssid, guint32 flags, guint32 wpaFlags, guint32 rsnFlags);
                 static const char* getWifiIfname();
@@ -21,6 +21,8 @@
 #include "NetworkManagerRDKProxy.h"
 #include "libIBus.h"
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
 
 using namespace WPEFramework;
 using namespace WPEFramework::Plugin;
@@ -248,7 +250,7 @@ namespace WPEFramework
                         NMLOG_INFO ("IARM_BUS_WIFI_MGR_EVENT_onAvailableSSIDs");
                         std::string serialized(e->data.wifiSSIDList.ssid_list);
                         JsonObject eventDocument;
-                        JsonArray ssidsUpdated;
+                        ScanResultSet scanResults;
                         uint32_t security;
                         WPEC::OptionalType<WPEJ::Error> error;
                         if (!WPEJ::IElement::FromString(serialized, eventDocument, error)) {
@@ -261,19 +263,21 @@ namespace WPEFramework
                         }
 
                         JsonArray ssids = eventDocument["getAvailableSSIDs"].Array();
+                        scanResults.reserve(ssids.Length());
 
                         for (int i = 0; i < ssids.Length(); i++)
                         {
                             JsonObject object = ssids[i].Object();
                             security = object["security"].Number();
-                            JsonObject newObject;
-                            newObject["ssid"] = object["ssid"];
-                            newObject["security"] = mapToNewSecurityMode(security);
-                            newObject["strength"] = object["signalStrength"];
-                            newObject["frequency"] = object["frequency"];
-                            ssidsUpdated.Add(newObject);
+                            /* wifimgr reports strength and frequency (GHz) either as numbers or as strings */
+                            int strength = static_cast<int>(std::strtol(object["signalStrength"].String().c_str(), nullptr, 10));
+                            double frequency = std::strtod(object["frequency"].String().c_str(), nullptr);
+                            if (frequency < 100)
+                                frequency *= 1000;
+                            scanResults.add(object["ssid"].String(), object["bssid"].String(), static_cast<uint32_t>(std::lround(frequency)),
+                                            strength, mapToNewSecurityMode(security));
                         }
-                        ::_instance->ReportAvailableSSIDs(ssidsUpdated);
+                        ::_instance->ReportAvailableSSIDs(scanResults);
                         break;
                     }
                     case IARM_BUS_WIFI_MGR_EVENT_onWIFIStateChanged:
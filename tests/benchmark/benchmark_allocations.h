@@ -0,0 +1,84 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Counts the heap allocations of a benchmark by replacing the global operator new and
+ * delete. Every replaced allocation function has its matching delete, the sized and
+ * aligned ones included, and all of them go through the same malloc/free pair, so no
+ * pointer is released by a function that did not allocate it. The array and nothrow
+ * forms are left to the library, which forwards them here.
+ * Include from exactly one source file of each benchmark executable.
+ */
+
+static std::atomic<size_t> allocations{0};
+
+static void* countedAllocate(size_t size, size_t alignment)
+{
+    allocations++;
+    void* p = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+        p = std::malloc(size ? size : 1);
+    else if (posix_memalign(&p, alignment, size ? size : 1) != 0)
+        p = nullptr;
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+static void countedRelease(void* p) noexcept
+{
+    std::free(p);
+}
+
+void* operator new(size_t size)
+{
+    return countedAllocate(size, 0);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept
+{
+    countedRelease(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    countedRelease(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    countedRelease(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    countedRelease(p);
+}
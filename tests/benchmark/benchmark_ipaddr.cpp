@@ -0,0 +1,207 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "NetworkManagerIpCache.h"
+#include "benchmark_allocations.h"
+
+/*
+ * Micro-benchmark of an IPv6 address refresh under SLAAC churn: every round libnm reports
+ * a link-local, a unique local, the EUI-64 SLAAC address and three privacy addresses, one
+ * of which is replaced each round. The text path classifies and diffs strings the way
+ * refreshIpFamilyCache used to, parsing every address once per classifier and the MAC
+ * once per address; the binary path parses each address once into an IpAddr and the MAC
+ * once per refresh, then builds and diffs an IpFamilySnapshot.
+ * Usage: ipaddr_benchmark [iterations]
+ */
+
+using namespace WPEFramework::Plugin;
+
+namespace {
+    /* the string classifiers as they were before IpAddr */
+    bool textLinkLocal(const std::string& addr)
+    {
+        struct in6_addr sa6{};
+        return inet_pton(AF_INET6, addr.c_str(), &sa6) == 1 && sa6.s6_addr[0] == 0xfe && (sa6.s6_addr[1] & 0xc0) == 0x80;
+    }
+
+    bool textULA(const std::string& addr)
+    {
+        struct in6_addr sa6{};
+        return inet_pton(AF_INET6, addr.c_str(), &sa6) == 1 && (sa6.s6_addr[0] & 0xfe) == 0xfc;
+    }
+
+    bool textMacBased(const std::string& addr, const std::string& macText)
+    {
+        struct in6_addr sa6{};
+        unsigned int b[6];
+        if (inet_pton(AF_INET6, addr.c_str(), &sa6) != 1 ||
+            sscanf(macText.c_str(), "%02x:%02x:%02x:%02x:%02x:%02x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) != 6)
+            return false;
+        const uint8_t eui64[8] = { static_cast<uint8_t>(b[0] ^ 0x02), static_cast<uint8_t>(b[1]), static_cast<uint8_t>(b[2]), 0xff, 0xfe,
+                                   static_cast<uint8_t>(b[3]), static_cast<uint8_t>(b[4]), static_cast<uint8_t>(b[5]) };
+        return memcmp(&sa6.s6_addr[8], eui64, 8) == 0;
+    }
+
+    struct Changes {
+        size_t acquired{0};
+        size_t lost{0};
+        size_t reportedBytes{0};
+    };
+
+    void textRefresh(const std::vector<std::string>& round, const std::string& macText,
+                     std::map<std::string, GlobalAddressType>& previous, Changes& changes)
+    {
+        std::map<std::string, GlobalAddressType> globals;
+        std::set<std::string> linkLocal;
+        std::set<std::string> uniqueLocal;
+        for (const std::string& text : round)
+        {
+            if (textLinkLocal(text))
+                linkLocal.insert(text);
+            else if (textULA(text))
+                uniqueLocal.insert(text);
+            else
+                globals.emplace(text, textMacBased(text, macText) ? ADDR_GLOBAL_MAC_BASED : ADDR_GLOBAL);
+        }
+        for (const auto& entry : globals)
+        {
+            if (previous.find(entry.first) == previous.end())
+            {
+                changes.acquired++;
+                changes.reportedBytes += entry.first.size();
+            }
+        }
+        for (const auto& entry : previous)
+        {
+            if (globals.find(entry.first) == globals.end())
+            {
+                changes.lost++;
+                changes.reportedBytes += entry.first.size();
+            }
+        }
+        previous.swap(globals);
+    }
+
+    void binaryRefresh(const std::vector<std::string>& round, const char* macText,
+                       IpFamilySnapshot& previous, IpFamilySnapshot& next, Changes& changes)
+    {
+        char text[INET6_ADDRSTRLEN];
+        MacAddr mac;
+        MacAddr::parse(macText, mac);
+        next.globalAddresses.clear();
+        next.linkLocalAddresses.clear();
+        next.uniqueLocalAddresses.clear();
+        IpAddr address;
+        for (const std::string& entry : round)
+        {
+            if (IpAddr::parse(entry.c_str(), AF_INET6, address))
+                next.addAddress(address, 64, mac);
+        }
+        next.seal();
+        for (const auto& entry : next.globalAddresses)
+        {
+            if (!previous.hasGlobal(entry.address))
+            {
+                changes.acquired++;
+                changes.reportedBytes += strlen(entry.address.format(text, sizeof(text)));
+            }
+        }
+        for (const auto& entry : previous.globalAddresses)
+        {
+            if (!next.hasGlobal(entry.address))
+            {
+                changes.lost++;
+                changes.reportedBytes += strlen(entry.address.format(text, sizeof(text)));
+            }
+        }
+        std::swap(previous, next);
+    }
+
+    /* a privacy address: 64 random bits after the prefix */
+    std::string privacyAddress(uint64_t& seed)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        char text[INET6_ADDRSTRLEN];
+        std::snprintf(text, sizeof(text), "2001:db8:1:2:%x:%x:%x:%x",
+                      unsigned(seed >> 48) & 0xffff, unsigned(seed >> 32) & 0xffff, unsigned(seed >> 16) & 0xffff, unsigned(seed) & 0xffff);
+        return text;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+    const std::string macText = "aa:bb:cc:dd:ee:ff";
+    const size_t roundCount = 64;
+
+    std::vector<std::vector<std::string>> rounds(roundCount);
+    std::vector<std::string> privacy;
+    uint64_t seed = 42;
+    for (int index = 0; index < 3; ++index)
+        privacy.push_back(privacyAddress(seed));
+    for (size_t index = 0; index < roundCount; ++index)
+    {
+        privacy[index % privacy.size()] = privacyAddress(seed);
+        rounds[index] = { "fe80::a8bb:ccff:fedd:eeff", "fd12:3456:789a:1:a8bb:ccff:fedd:eeff",
+                          "2001:db8:1:2:a8bb:ccff:fedd:eeff" };
+        rounds[index].insert(rounds[index].end(), privacy.begin(), privacy.end());
+    }
+
+    Changes text;
+    std::map<std::string, GlobalAddressType> textPrevious;
+    size_t before = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+        textRefresh(rounds[i % roundCount], macText, textPrevious, text);
+    auto textElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    size_t textHeap = allocations.load() - before;
+
+    /* the two snapshots trade places every refresh, so their vectors stop growing after the first rounds */
+    Changes binary;
+    IpFamilySnapshot binaryPrevious;
+    IpFamilySnapshot binaryNext;
+    before = allocations.load();
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+        binaryRefresh(rounds[i % roundCount], macText.c_str(), binaryPrevious, binaryNext, binary);
+    auto binaryElapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    size_t binaryHeap = allocations.load() - before;
+
+    std::printf("iterations        %ld\n", iterations);
+    std::printf("text refresh      %.1f ns/op, %.2f allocations/op\n",
+                iterations ? double(textElapsed.count()) / iterations : 0.0, iterations ? double(textHeap) / iterations : 0.0);
+    std::printf("binary refresh    %.1f ns/op, %.2f allocations/op\n",
+                iterations ? double(binaryElapsed.count()) / iterations : 0.0, iterations ? double(binaryHeap) / iterations : 0.0);
+    std::printf("events            %zu acquired, %zu lost\n", binary.acquired, binary.lost);
+
+    /* both paths must see the same churn */
+    bool same = text.acquired == binary.acquired && text.lost == binary.lost && text.reportedBytes == binary.reportedBytes;
+    if (!same)
+        std::printf("mismatch: text %zu/%zu, binary %zu/%zu\n", text.acquired, text.lost, binary.acquired, binary.lost);
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
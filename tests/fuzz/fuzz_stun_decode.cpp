@@ -0,0 +1,57 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "NetworkManagerStunClient.h"
+
+/*
+ * libFuzzer harness for stun::decoder::decode_message. Every decoded attribute is
+ * walked and address attributes are decoded, so that out of bounds views show up
+ * under AddressSanitizer.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    if (size > stun::max_message_size)
+        return 0;
+
+    stun::packet buff;
+    std::memcpy(buff.data(), data, size);
+
+    stun::message msg;
+    if (!stun::decoder::decode_message(buff, size, msg))
+        return 0;
+
+    unsigned sum = 0;
+    for (stun::attribute const& attr : msg)
+    {
+        for (uint16_t i = 0; i < attr.length; ++i)
+            sum += attr.value[i];
+
+        sockaddr_storage addr = {};
+        if (attr.type == stun::attribute_type::xor_mapped_address)
+            stun::attributes::address::decode(attr, &msg.header().transaction_id, addr);
+        else if (attr.type == stun::attribute_type::mapped_address)
+            stun::attributes::address::decode(attr, nullptr, addr);
+    }
+
+    stun::packet out;
+    msg.encode(out);
+    return sum == 0xffffffff ? 1 : 0;
+}
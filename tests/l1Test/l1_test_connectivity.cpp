@@ -20,6 +20,13 @@
 #include "NetworkManagerConnectivity.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 using namespace std;
 using namespace WPEFramework;
@@ -33,6 +40,10 @@ namespace WPEFramework
         {
             return;
         }
+        void NetworkManagerImplementation::ReportInternetStatusChangeByFamily(const InternetStatus prevState, const InternetStatus currState, const string interface, const Exchange::INetworkManager::IPVersion ipversion)
+        {
+            return;
+        }
     }
 }
 
@@ -65,3 +76,192 @@ TEST_F(ConnectivityMonitorTest, SetEndpoints_DuplicateEndpoints) {
     cm.setConnectivityMonitorEndpoints(endpoints);
     EXPECT_EQ((int)cm.getConnectivityMonitorEndpoints().size(), 2);
 }
+
+/* Minimal keep-alive HTTP server on loopback; answers every request with the same status line */
+class LoopbackHttpServer {
+public:
+    explicit LoopbackHttpServer(const std::string& response) : m_response(response)
+    {
+        m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(m_listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(m_listenFd, reinterpret_cast<struct sockaddr*>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+        listen(m_listenFd, 8);
+        m_thread = std::thread(&LoopbackHttpServer::serve, this);
+    }
+
+    ~LoopbackHttpServer()
+    {
+        m_running = false;
+        m_thread.join();
+        close(m_listenFd);
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(m_port) + "/generate_204"; }
+    int connections() const { return m_connections.load(); }
+    int requests() const { return m_requests.load(); }
+
+private:
+    void serve()
+    {
+        std::vector<struct pollfd> fds = {{m_listenFd, POLLIN, 0}};
+        while (m_running)
+        {
+            if (poll(fds.data(), fds.size(), 50) <= 0)
+                continue;
+            for (size_t i = fds.size(); i-- > 0; )
+            {
+                if (!(fds[i].revents & (POLLIN | POLLHUP)))
+                    continue;
+                if (i == 0) {
+                    fds.push_back({accept(m_listenFd, nullptr, nullptr), POLLIN, 0});
+                    m_connections++;
+                    continue;
+                }
+                char buf[2048];
+                ssize_t n = read(fds[i].fd, buf, sizeof(buf));
+                if (n <= 0) {
+                    close(fds[i].fd);
+                    fds.erase(fds.begin() + i);
+                    continue;
+                }
+                if (std::string(buf, n).find("\r\n\r\n") != std::string::npos) {
+                    m_requests++;
+                    ssize_t sent = write(fds[i].fd, m_response.data(), m_response.size());
+                    (void)sent;
+                }
+            }
+        }
+        for (size_t i = 1; i < fds.size(); i++)
+            close(fds[i].fd);
+    }
+
+    std::string m_response;
+    int m_listenFd = -1;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_running{true};
+    std::atomic<int> m_connections{0};
+    std::atomic<int> m_requests{0};
+    std::thread m_thread;
+};
+
+TEST(ConnectivityProberTest, ReusesConnectionAcrossProbes) {
+    LoopbackHttpServer server("HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n");
+    ConnectivityProber prober;
+    std::vector<std::string> endpoints = {server.url()};
+
+    for (int i = 0; i < 3; i++) {
+        TestConnectivity testInternet(prober, endpoints, 2000, NMCONNECTIVITY_CURL_HEAD_REQUEST, 0);
+        EXPECT_EQ(testInternet.getInternetState(), Exchange::INetworkManager::InternetStatus::INTERNET_FULLY_CONNECTED);
+        EXPECT_GE(prober.lastLatencyMs(), 0);
+    }
+    EXPECT_EQ(server.requests(), 3);
+    EXPECT_EQ(server.connections(), 1);
+}
+
+TEST(ConnectivityProberTest, CaptivePortalRedirect) {
+    LoopbackHttpServer server("HTTP/1.1 302 Found\r\nLocation: http://portal.example/login\r\nContent-Length: 0\r\n\r\n");
+    ConnectivityProber prober;
+
+    TestConnectivity testInternet(prober, {server.url()}, 2000, NMCONNECTIVITY_CURL_HEAD_REQUEST, 0);
+    EXPECT_EQ(testInternet.getInternetState(), Exchange::INetworkManager::InternetStatus::INTERNET_CAPTIVE_PORTAL);
+    EXPECT_EQ(testInternet.getCaptivePortal(), "http://portal.example/login");
+}
+
+TEST(ConnectivityProberTest, UnreachableEndpoint) {
+    ConnectivityProber prober;
+    /* nothing listens on the discard port of loopback */
+    TestConnectivity testInternet(prober, {"http://127.0.0.1:9/generate_204"}, 2000, NMCONNECTIVITY_CURL_HEAD_REQUEST, 0);
+    EXPECT_EQ(testInternet.getInternetState(), Exchange::INetworkManager::InternetStatus::INTERNET_NOT_AVAILABLE);
+    EXPECT_EQ(testInternet.getCurlError(), CURLE_COULDNT_CONNECT);
+    EXPECT_EQ(prober.lastLatencyMs(), -1);
+}
+
+TEST(ConnectivityProberTest, ProbesBothFamiliesInOneRound) {
+    LoopbackHttpServer server("HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n");
+    ConnectivityProber prober;
+    std::vector<ConnectivityProber::ProbeResult> results;
+
+    /* the endpoint is an IPv4 literal, so the IPv6 requests cannot connect */
+    prober.probe({server.url()}, 2000, NMCONNECTIVITY_CURL_HEAD_REQUEST, std::vector<uint8_t>{Exchange::INetworkManager::IP_ADDRESS_V4, Exchange::INetworkManager::IP_ADDRESS_V6}, "", results);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].responses, std::vector<int>{204});
+    EXPECT_EQ(results[1].responses, std::vector<int>{-1});
+    EXPECT_NE(results[1].curlErrorCode, 0);
+    EXPECT_EQ(TestConnectivity::checkInternetStateFromResponseCode(results[0].responses), Exchange::INetworkManager::InternetStatus::INTERNET_FULLY_CONNECTED);
+    EXPECT_EQ(TestConnectivity::checkInternetStateFromResponseCode(results[1].responses), Exchange::INetworkManager::InternetStatus::INTERNET_NOT_AVAILABLE);
+    EXPECT_EQ(server.requests(), 1);
+}
+
+TEST(ConnectivityStateTableTest, UpdateReturnsPreviousState) {
+    using Status = Exchange::INetworkManager::InternetStatus;
+    ConnectivityStateTable states;
+    EXPECT_EQ(states.update("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, Status::INTERNET_FULLY_CONNECTED, ""), Status::INTERNET_UNKNOWN);
+    EXPECT_EQ(states.update("eth0", Exchange::INetworkManager::IP_ADDRESS_V6, Status::INTERNET_NOT_AVAILABLE, ""), Status::INTERNET_UNKNOWN);
+    EXPECT_EQ(states.update("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, Status::INTERNET_CAPTIVE_PORTAL, "http://portal.example/login"), Status::INTERNET_FULLY_CONNECTED);
+    EXPECT_EQ(states.captivePortalURI("eth0"), "http://portal.example/login");
+    EXPECT_EQ(states.captivePortalURI("wlan0"), "");
+
+    Status state = Status::INTERNET_UNKNOWN;
+    EXPECT_TRUE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V6, std::chrono::seconds(60), state));
+    EXPECT_EQ(state, Status::INTERNET_NOT_AVAILABLE);
+    EXPECT_FALSE(states.lookup("wlan0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state));
+}
+
+TEST(ConnectivityStateTableTest, MonitoredInterfaceExpiresLater) {
+    using Status = Exchange::INetworkManager::InternetStatus;
+    ConnectivityStateTable states;
+    ConnectivityStateTable::Clock::time_point then = ConnectivityStateTable::Clock::now();
+    states.update("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, Status::INTERNET_FULLY_CONNECTED, "", then);
+    states.update("wlan0", Exchange::INetworkManager::IP_ADDRESS_V4, Status::INTERNET_LIMITED, "", then);
+    states.setMonitored("eth0", std::chrono::seconds(NMCONNECTIVITY_MONITORED_STATE_MAX_AGE));
+
+    Status state = Status::INTERNET_UNKNOWN;
+    ConnectivityStateTable::Clock::time_point later = then + std::chrono::minutes(5);
+    EXPECT_TRUE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state, later));
+    EXPECT_EQ(state, Status::INTERNET_FULLY_CONNECTED);
+    EXPECT_FALSE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state, then + std::chrono::minutes(30)));
+    EXPECT_FALSE(states.lookup("wlan0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state, later));
+    EXPECT_TRUE(states.lookup("wlan0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state, then + std::chrono::seconds(30)));
+    EXPECT_EQ(state, Status::INTERNET_LIMITED);
+
+    /* invalidated entries miss, but keep their state for the next change */
+    states.invalidate("eth0");
+    EXPECT_FALSE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state, then));
+    EXPECT_EQ(states.update("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, Status::INTERNET_NOT_AVAILABLE, ""), Status::INTERNET_FULLY_CONNECTED);
+    EXPECT_TRUE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state));
+
+    states.clear();
+    EXPECT_FALSE(states.lookup("eth0", Exchange::INetworkManager::IP_ADDRESS_V4, std::chrono::seconds(60), state));
+}
+
+TEST(ConnectivityStateTableTest, RanksStates) {
+    using Status = Exchange::INetworkManager::InternetStatus;
+    EXPECT_TRUE(ConnectivityStateTable::better(Status::INTERNET_FULLY_CONNECTED, Status::INTERNET_CAPTIVE_PORTAL));
+    EXPECT_TRUE(ConnectivityStateTable::better(Status::INTERNET_CAPTIVE_PORTAL, Status::INTERNET_LIMITED));
+    EXPECT_TRUE(ConnectivityStateTable::better(Status::INTERNET_LIMITED, Status::INTERNET_NOT_AVAILABLE));
+    EXPECT_TRUE(ConnectivityStateTable::better(Status::INTERNET_NOT_AVAILABLE, Status::INTERNET_UNKNOWN));
+    EXPECT_FALSE(ConnectivityStateTable::better(Status::INTERNET_NOT_AVAILABLE, Status::INTERNET_NOT_AVAILABLE));
+}
+
+TEST_F(ConnectivityMonitorTest, AnswersFromTheStateTable) {
+    LoopbackHttpServer server("HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n");
+    cm.setConnectivityMonitorEndpoints({server.url()});
+
+    std::string interface = "lo";
+    Exchange::INetworkManager::IPVersion ipversion = Exchange::INetworkManager::IP_ADDRESS_V4;
+    Exchange::INetworkManager::InternetStatus state = cm.getInternetState(interface, ipversion);
+    int requests = server.requests();
+    /* the request is only sent when the host has an IPv4 default route */
+    if (requests == 0) {
+        EXPECT_EQ(state, Exchange::INetworkManager::InternetStatus::INTERNET_NOT_AVAILABLE);
+    }
+
+    /* answered from memory this time */
+    EXPECT_EQ(cm.getInternetState(interface, ipversion), state);
+    EXPECT_EQ(server.requests(), requests);
+}
@@ -0,0 +1,103 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gnome/NetworkManagerGnomeDeviceSnapshot.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+TEST(DeviceSnapshotTest, NoViewUntilLoaded) {
+    DeviceSnapshot snapshot;
+    EXPECT_EQ(snapshot.view(), nullptr);
+
+    /* updates before the first load are dropped */
+    snapshot.update("eth0", "00:11:22:33:44:55", 100);
+    EXPECT_EQ(snapshot.view(), nullptr);
+
+    snapshot.reset({});
+    ASSERT_NE(snapshot.view(), nullptr);
+    EXPECT_TRUE(snapshot.view()->devices.empty());
+    EXPECT_EQ(snapshot.view()->find("eth0"), nullptr);
+}
+
+TEST(DeviceSnapshotTest, UpdateAndRemove) {
+    DeviceSnapshot snapshot;
+    snapshot.reset({{"wlan0", "66:77:88:99:AA:BB", 30}, {"eth0", "00:11:22:33:44:55", 100}});
+    auto first = snapshot.view();
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(first->devices.size(), 2u);
+    EXPECT_EQ(first->devices[0].iface, "wlan0");
+
+    snapshot.update("wlan0", "66:77:88:99:AA:BB", 100);
+    auto second = snapshot.view();
+    EXPECT_GT(second->version, first->version);
+    EXPECT_EQ(second->find("wlan0")->state, 100u);
+    /* a view taken earlier is not modified */
+    EXPECT_EQ(first->find("wlan0")->state, 30u);
+
+    /* nothing changed, no new version */
+    snapshot.update("wlan0", "66:77:88:99:AA:BB", 100);
+    EXPECT_EQ(snapshot.view()->version, second->version);
+
+    snapshot.remove("eth0");
+    EXPECT_EQ(snapshot.view()->find("eth0"), nullptr);
+    EXPECT_EQ(snapshot.view()->devices.size(), 1u);
+
+    snapshot.update("eth0", "00:11:22:33:44:56", 20);
+    ASSERT_NE(snapshot.view()->find("eth0"), nullptr);
+    EXPECT_EQ(snapshot.view()->find("eth0")->mac, "00:11:22:33:44:56");
+
+    snapshot.invalidate();
+    EXPECT_EQ(snapshot.view(), nullptr);
+    EXPECT_EQ(second->devices.size(), 2u);
+}
+
+TEST(DeviceSnapshotTest, ReadersDuringUpdates) {
+    DeviceSnapshot snapshot;
+    snapshot.reset({{"eth0", "mac-20", 20}});
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                auto view = snapshot.view();
+                const DeviceSnapshot::Device* device = view->find("eth0");
+                /* state and mac are always written together */
+                if (device == nullptr || device->mac != "mac-" + std::to_string(device->state))
+                    torn++;
+            }
+        });
+    }
+
+    for (uint32_t state = 21; state < 2000; state++)
+        snapshot.update("eth0", "mac-" + std::to_string(state), state);
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(snapshot.view()->find("eth0")->state, 1999u);
+}
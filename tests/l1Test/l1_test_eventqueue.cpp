@@ -0,0 +1,113 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <string>
+#include "NetworkManagerEventQueue.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+using TestQueue = EventDispatchQueue<string>;
+
+enum { STATE_EVENT = 0, SCAN_EVENT, SIGNAL_EVENT };
+
+class EventDispatchQueueTest : public ::testing::Test {
+protected:
+    TestQueue queue{8};
+
+    string popPayload()
+    {
+        int kind = -1;
+        string payload;
+        EXPECT_TRUE(queue.pop(kind, payload));
+        return payload;
+    }
+};
+
+TEST_F(EventDispatchQueueTest, FifoWithinLane) {
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "eth0 up");
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "eth0 down");
+    EXPECT_EQ(popPayload(), "eth0 up");
+    EXPECT_EQ(popPayload(), "eth0 down");
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(EventDispatchQueueTest, HighPriorityFirst) {
+    queue.push(SCAN_EVENT, "wifi", TestQueue::PRIORITY_BULK, "scan 1");
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "wlan0 up");
+    EXPECT_EQ(popPayload(), "wlan0 up");
+    EXPECT_EQ(popPayload(), "scan 1");
+}
+
+TEST_F(EventDispatchQueueTest, LastWriterWins) {
+    EXPECT_FALSE(queue.push(SCAN_EVENT, "wifi", TestQueue::PRIORITY_BULK, "scan 1"));
+    EXPECT_FALSE(queue.push(SIGNAL_EVENT, "wifi", TestQueue::PRIORITY_BULK, "weak"));
+    EXPECT_TRUE(queue.push(SCAN_EVENT, "wifi", TestQueue::PRIORITY_BULK, "scan 2"));
+    EXPECT_TRUE(queue.push(SIGNAL_EVENT, "wifi", TestQueue::PRIORITY_BULK, "good"));
+
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(popPayload(), "scan 2");
+    EXPECT_EQ(popPayload(), "good");
+
+    auto stats = queue.stats();
+    EXPECT_EQ(stats.enqueued, 4u);
+    EXPECT_EQ(stats.coalesced, 2u);
+    EXPECT_EQ(stats.dropped, 0u);
+
+    /* once delivered the key is free again */
+    EXPECT_FALSE(queue.push(SCAN_EVENT, "wifi", TestQueue::PRIORITY_BULK, "scan 3"));
+}
+
+TEST_F(EventDispatchQueueTest, MergeCanCancel) {
+    auto cancel = [](string&, string&&) { return false; };
+    queue.push(STATE_EVENT, "internet", TestQueue::PRIORITY_HIGH, "A->B");
+    EXPECT_TRUE(queue.push(STATE_EVENT, "internet", TestQueue::PRIORITY_HIGH, "B->A", cancel));
+    EXPECT_TRUE(queue.empty());
+    /* one coalesce per merged push, even when the pair cancels */
+    EXPECT_EQ(queue.stats().coalesced, 1u);
+}
+
+TEST_F(EventDispatchQueueTest, KeysAreScopedPerInterface) {
+    queue.push(STATE_EVENT, "internetstatus:eth0", TestQueue::PRIORITY_HIGH, "eth0 A->B");
+    EXPECT_FALSE(queue.push(STATE_EVENT, "internetstatus:wlan0", TestQueue::PRIORITY_HIGH, "wlan0 A->B"));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(popPayload(), "eth0 A->B");
+    EXPECT_EQ(popPayload(), "wlan0 A->B");
+}
+
+TEST_F(EventDispatchQueueTest, LimitDropsBulkFirst) {
+    queue.setLimit(3);
+    queue.push(SCAN_EVENT, "wifi", TestQueue::PRIORITY_BULK, "scan");
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "s1");
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "s2");
+    queue.push(STATE_EVENT, "", TestQueue::PRIORITY_HIGH, "s3");
+
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.stats().dropped, 1u);
+
+    /* a bulk payload never displaces a state change */
+    queue.push(SIGNAL_EVENT, "wifi", TestQueue::PRIORITY_BULK, "good");
+    EXPECT_EQ(queue.stats().dropped, 2u);
+    EXPECT_EQ(popPayload(), "s1");
+    EXPECT_EQ(popPayload(), "s2");
+    EXPECT_EQ(popPayload(), "s3");
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.stats().highWaterMark, 3u);
+}
@@ -0,0 +1,227 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <unistd.h>
+#include "NetworkManagerIcmp.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+TEST(IcmpEchoTest, ChecksumVerifiesToZero) {
+    uint8_t packet[9] = { 0x08, 0x00, 0x00, 0x00, 0x12, 0x34, 0x00, 0x01, 0xAB };
+    uint16_t sum = IcmpEchoEngine::checksum(packet, sizeof(packet));
+    memcpy(&packet[2], &sum, sizeof(sum));
+    EXPECT_EQ(IcmpEchoEngine::checksum(packet, sizeof(packet)), 0);
+}
+
+TEST(IcmpEchoTest, SummarizeSkipsLostReplies) {
+    IcmpEchoResult result;
+    result.transmitted = 4;
+    result.received = 3;
+    result.rtt = { 10.0, -1.0, 20.0, 15.0 };
+    result.summarize();
+
+    EXPECT_DOUBLE_EQ(result.tripMin, 10.0);
+    EXPECT_DOUBLE_EQ(result.tripMax, 20.0);
+    EXPECT_DOUBLE_EQ(result.tripAvg, 15.0);
+    EXPECT_DOUBLE_EQ(result.jitter, 7.5);
+    EXPECT_NEAR(result.tripStdDev, 4.082, 0.001);
+    EXPECT_DOUBLE_EQ(result.packetLoss(), 25.0);
+}
+
+TEST(IcmpEchoTest, BadAddress) {
+    vector<IcmpEchoResult> results;
+    EXPECT_TRUE(IcmpEchoEngine::run({ {"", AF_INET, 1, 100, 10}, {"127.0.0.1", AF_INET6, 1, 100, 10} }, results));
+    ASSERT_EQ(results.size(), 2u);
+    for (const IcmpEchoResult& result : results)
+    {
+        EXPECT_FALSE(result.resolved);
+        EXPECT_EQ(result.error, "Bad Address");
+        EXPECT_EQ(result.transmitted, 0u);
+    }
+}
+
+TEST(IcmpEchoTest, PingsTargetsConcurrently) {
+    if (!IcmpEchoEngine::available(AF_INET))
+        GTEST_SKIP() << "no ICMP socket permitted";
+
+    vector<IcmpEchoTarget> targets = {
+        {"127.0.0.1", AF_INET, 3, 1000, 100},
+        {"localhost", AF_INET, 3, 1000, 100},
+        {"127.0.0.2", AF_INET, 3, 1000, 100},
+    };
+    vector<IcmpEchoResult> results;
+
+    auto start = chrono::steady_clock::now();
+    ASSERT_TRUE(IcmpEchoEngine::run(targets, results));
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    ASSERT_EQ(results.size(), targets.size());
+    for (const IcmpEchoResult& result : results)
+    {
+        EXPECT_TRUE(result.error.empty()) << result.endpoint;
+        EXPECT_EQ(result.transmitted, 3u);
+        EXPECT_EQ(result.received, 3u);
+        EXPECT_EQ(result.rtt.size(), 3u);
+        EXPECT_GE(result.tripMin, 0.0);
+        EXPECT_LE(result.tripMin, result.tripMax);
+        EXPECT_DOUBLE_EQ(result.packetLoss(), 0.0);
+    }
+    EXPECT_EQ(results[1].address, "127.0.0.1");
+    /* three targets at 100 ms spacing take one schedule, not three */
+    EXPECT_LT(elapsed, chrono::milliseconds(600));
+}
+
+TEST(IcmpEchoTest, PingsIPv6Loopback) {
+    if (!IcmpEchoEngine::available(AF_INET6))
+        GTEST_SKIP() << "no ICMPv6 socket permitted";
+
+    vector<IcmpEchoResult> results;
+    ASSERT_TRUE(IcmpEchoEngine::run({ {"::1", AF_INET6, 2, 1000, 50} }, results));
+    ASSERT_EQ(results.size(), 1u);
+    if (results[0].received == 0)
+        GTEST_SKIP() << "IPv6 loopback is not configured";
+    EXPECT_EQ(results[0].address, "::1");
+    EXPECT_EQ(results[0].received, 2u);
+    EXPECT_EQ(results[0].duplicates, 0u);
+}
+
+TEST(TraceRouteTest, FormatsTracerouteLines) {
+    TraceResult result;
+    result.endpoint = "example";
+    result.address = "192.0.2.10";
+    result.hops.resize(2);
+    result.hops[0].ttl = 1;
+    result.hops[0].address = "10.0.0.1";
+    result.hops[0].rtt = { 0.448, -1.0 };
+    result.hops[1].ttl = 2;
+    result.hops[1].rtt = { -1.0, -1.0 };
+
+    vector<string> lines;
+    result.toLines(6, lines);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "traceroute to example (192.0.2.10), 6 hops max, 52 byte packets");
+    EXPECT_EQ(lines[1], "1  10.0.0.1  0.448 ms  *");
+    EXPECT_EQ(lines[2], "2   *  *");
+}
+
+TEST(TraceRouteTest, BadAddress) {
+    TraceResult result;
+    EXPECT_TRUE(TraceRouteEngine::run({"127.0.0.1", AF_INET6, 1, 6, 500}, result));
+    EXPECT_FALSE(result.resolved);
+    EXPECT_EQ(result.error, "Bad Address");
+    EXPECT_TRUE(result.hops.empty());
+}
+
+TEST(TraceRouteTest, ReachesLoopbackAtFirstHop) {
+    TraceResult result;
+    auto start = chrono::steady_clock::now();
+    ASSERT_TRUE(TraceRouteEngine::run({"127.0.0.1", AF_INET, 3, 6, 2000}, result));
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(result.reached);
+    ASSERT_EQ(result.hops.size(), 1u);
+    EXPECT_EQ(result.hops[0].address, "127.0.0.1");
+    EXPECT_TRUE(result.hops[0].reached);
+    ASSERT_EQ(result.hops[0].rtt.size(), 3u);
+    for (double rtt : result.hops[0].rtt)
+        EXPECT_GE(rtt, 0.0);
+    /* every probe answered, so the trace does not sit out the wait */
+    EXPECT_LT(elapsed, chrono::milliseconds(500));
+}
+
+/*
+ * host --- router --- destination, built from two network namespaces and two veth
+ * pairs. The test thread moves into a private namespace for the host side, so
+ * nothing outside the test sees the addresses or routes.
+ */
+TEST(TraceRouteTest, TracesThroughRouterNamespace) {
+    if (geteuid() != 0 || system("ip -V > /dev/null 2>&1") != 0)
+        GTEST_SKIP() << "needs root and iproute2";
+
+    const string router = "nmtr-r-" + to_string(getpid());
+    const string destination = "nmtr-d-" + to_string(getpid());
+    bool ready = false;
+    bool ran = false;
+    TraceResult result;
+    chrono::steady_clock::duration elapsed{};
+
+    thread host([&]() {
+        if (unshare(CLONE_NEWNET) != 0)
+            return;
+
+        const string commands[] = {
+            "ip link set lo up",
+            "ip netns add " + router,
+            "ip netns add " + destination,
+            "ip link add h0 type veth peer name r0 netns " + router,
+            "ip addr add 10.77.1.1/24 dev h0",
+            "ip link set h0 up",
+            "ip route add default via 10.77.1.2",
+            "ip -n " + router + " addr add 10.77.1.2/24 dev r0",
+            "ip -n " + router + " link set r0 up",
+            "ip -n " + router + " link add r1 type veth peer name d0 netns " + destination,
+            "ip -n " + router + " addr add 10.77.2.1/24 dev r1",
+            "ip -n " + router + " link set r1 up",
+            "ip netns exec " + router + " sysctl -qw net.ipv4.ip_forward=1",
+            "ip -n " + destination + " link set lo up",
+            "ip -n " + destination + " addr add 10.77.2.2/24 dev d0",
+            "ip -n " + destination + " link set d0 up",
+            "ip -n " + destination + " route add default via 10.77.2.1",
+        };
+        ready = true;
+        for (const string& command : commands)
+            ready = ready && system((command + " > /dev/null 2>&1").c_str()) == 0;
+
+        if (ready)
+        {
+            /* let the links come up before the probes go out */
+            this_thread::sleep_for(chrono::milliseconds(200));
+            auto start = chrono::steady_clock::now();
+            ran = TraceRouteEngine::run({"10.77.2.2", AF_INET, 2, 6, 3000}, result);
+            elapsed = chrono::steady_clock::now() - start;
+        }
+    });
+    host.join();
+    system(("ip netns del " + router + " > /dev/null 2>&1").c_str());
+    system(("ip netns del " + destination + " > /dev/null 2>&1").c_str());
+
+    if (!ready)
+        GTEST_SKIP() << "cannot build the namespace topology";
+
+    ASSERT_TRUE(ran);
+    EXPECT_TRUE(result.reached);
+    ASSERT_EQ(result.hops.size(), 2u);
+    EXPECT_EQ(result.hops[0].address, "10.77.1.2");
+    EXPECT_FALSE(result.hops[0].reached);
+    EXPECT_EQ(result.hops[1].address, "10.77.2.2");
+    EXPECT_TRUE(result.hops[1].reached);
+    for (const TraceHop& hop : result.hops)
+        for (double rtt : hop.rtt)
+            EXPECT_GE(rtt, 0.0) << "hop " << hop.ttl;
+    EXPECT_LT(elapsed, chrono::milliseconds(1000));
+}
@@ -0,0 +1,152 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <arpa/inet.h>
+#include <string>
+#include "NetworkManagerIpAddr.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+/* the classifiers are usable at compile time */
+static_assert(IpAddr::v4(169, 254, 10, 1).isIPv4LinkLocal(), "169.254/16 is link-local");
+static_assert(!IpAddr::v4(169, 255, 0, 1).isIPv4LinkLocal(), "169.255/16 is not link-local");
+static_assert(IpAddr::v6(0xfebf, 0, 0, 0, 0, 0, 0, 1).isIPv6LinkLocal(), "febf:: is in fe80::/10");
+static_assert(!IpAddr::v6(0xfec0, 0, 0, 0, 0, 0, 0, 1).isIPv6LinkLocal(), "fec0:: is not in fe80::/10");
+static_assert(IpAddr::v6(0xfd12, 0x3456, 0, 0, 0, 0, 0, 1).isIPv6ULA(), "fd00::/8 is unique local");
+static_assert(!IpAddr::v6(0xfe00, 0, 0, 0, 0, 0, 0, 1).isIPv6ULA(), "fe00:: is not unique local");
+static_assert(!IpAddr::v4(252, 0, 0, 1).isIPv6ULA(), "an IPv4 address is never unique local");
+static_assert(IpAddr::v4(10, 0, 0, 9) < IpAddr::v4(10, 0, 0, 10), "numeric order");
+static_assert(IpAddr::v4(255, 255, 255, 255) < IpAddr::v6(0, 0, 0, 0, 0, 0, 0, 1), "IPv4 before IPv6");
+
+namespace {
+    IpAddr address(const char* text)
+    {
+        IpAddr parsed;
+        EXPECT_TRUE(IpAddr::parseAny(text, parsed)) << text;
+        return parsed;
+    }
+}
+
+TEST(IpAddrTest, ParsesAndFormatsCanonically) {
+    IpAddr parsed;
+    ASSERT_TRUE(IpAddr::parse("192.168.1.10", AF_INET, parsed));
+    EXPECT_EQ(parsed.family(), AF_INET);
+    EXPECT_EQ(parsed, IpAddr::v4(192, 168, 1, 10));
+    EXPECT_EQ(parsed.toString(), "192.168.1.10");
+
+    ASSERT_TRUE(IpAddr::parse("2001:DB8:0:0:0::01", AF_INET6, parsed));
+    EXPECT_EQ(parsed, IpAddr::v6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1));
+    EXPECT_EQ(parsed.toString(), "2001:db8::1");
+    EXPECT_EQ(address("2001:db8:0:1:0:0:0:1").toString(), "2001:db8:0:1::1");
+
+    char text[INET6_ADDRSTRLEN];
+    EXPECT_STREQ(IpAddr::v6(0xfe80, 0, 0, 0, 0x1, 0, 0, 0).format(text, sizeof(text)), "fe80::1:0:0:0");
+
+    EXPECT_FALSE(IpAddr::parse("2001:db8::1", AF_INET, parsed));
+    EXPECT_TRUE(parsed.empty());
+    EXPECT_EQ(parsed.toString(), "");
+    EXPECT_FALSE(IpAddr::parse("", AF_INET6, parsed));
+    EXPECT_FALSE(IpAddr::parse(nullptr, AF_INET6, parsed));
+    EXPECT_FALSE(IpAddr::parseAny("not_an_ip", parsed));
+
+    /* a DNS server of the other family still parses */
+    ASSERT_TRUE(IpAddr::parseAny("2001:4860:4860::8888", parsed));
+    EXPECT_TRUE(parsed.isIPv6());
+    ASSERT_TRUE(IpAddr::parseAny("8.8.8.8", parsed));
+    EXPECT_FALSE(parsed.isIPv6());
+}
+
+TEST(IpAddrTest, FormatsAsInetNtop) {
+    /* zero runs of every length and position, and the mapped and compatible forms */
+    const char* samples[] = { "::", "::1", "::2", "1::", "::ffff:10.1.2.3", "::10.1.2.3", "::ffff:0:10.1.2.3",
+                              "1:0:1:0:0:1:0:1", "1:0:0:1:0:0:1:1", "0:0:1::", "1:2:3:4:5:6:7:8", "fe80::1:0:0:0",
+                              "0.0.0.0", "255.255.255.255", "10.0.100.9" };
+    for (const char* sample : samples)
+    {
+        IpAddr parsed;
+        ASSERT_TRUE(IpAddr::parseAny(sample, parsed)) << sample;
+        char expected[INET6_ADDRSTRLEN];
+        ASSERT_NE(inet_ntop(parsed.family(), parsed.bytes(), expected, sizeof(expected)), nullptr);
+        EXPECT_EQ(parsed.toString(), expected) << sample;
+    }
+
+    uint32_t seed = 1;
+    for (int round = 0; round < 20000; ++round)
+    {
+        uint8_t bytes[16];
+        for (auto& byte : bytes)
+        {
+            seed = seed * 1103515245u + 12345u;
+            /* mostly zero groups, so that runs of every shape come up */
+            byte = ((seed >> 16) & 3) ? 0 : static_cast<uint8_t>(seed >> 24);
+        }
+        IpAddr address = IpAddr::fromBytes(AF_INET6, bytes);
+        char expected[INET6_ADDRSTRLEN];
+        ASSERT_NE(inet_ntop(AF_INET6, bytes, expected, sizeof(expected)), nullptr);
+        ASSERT_EQ(address.toString(), expected);
+    }
+
+    /* a buffer too small gets an empty string rather than a truncated address */
+    char small[8];
+    EXPECT_STREQ(IpAddr::v6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1).format(small, sizeof(small)), "");
+}
+
+TEST(IpAddrTest, ClassifiesByPrefix) {
+    EXPECT_TRUE(address("169.254.255.255").isLinkLocal());
+    EXPECT_FALSE(address("169.253.255.255").isLinkLocal());
+    EXPECT_TRUE(address("fe80::abcd:1234:5678:9abc").isLinkLocal());
+    EXPECT_FALSE(address("fec0::1").isLinkLocal());
+    EXPECT_TRUE(address("fc00::1").isIPv6ULA());
+    EXPECT_TRUE(address("fdff:ffff:ffff:ffff:ffff:ffff:ffff:ffff").isIPv6ULA());
+    EXPECT_FALSE(address("fb00::1").isIPv6ULA());
+    EXPECT_FALSE(address("2001:db8::1").isLinkLocal());
+
+    EXPECT_TRUE(address("10.1.2.3").inPrefix(address("10.0.0.0"), 8));
+    EXPECT_TRUE(address("10.1.2.3").inPrefix(address("10.1.2.0"), 23));
+    EXPECT_FALSE(address("10.1.4.3").inPrefix(address("10.1.2.0"), 23));
+    EXPECT_TRUE(address("10.1.4.3").inPrefix(address("192.0.2.1"), 0));
+    EXPECT_TRUE(address("2001:db8::1").inPrefix(address("2001:db8::1"), 128));
+    EXPECT_FALSE(address("2001:db8::1").inPrefix(address("2001:db8::1"), 129));
+    EXPECT_FALSE(address("10.1.2.3").inPrefix(address("::"), 0));
+}
+
+TEST(IpAddrTest, MatchesEui64OfMac) {
+    MacAddr mac;
+    ASSERT_TRUE(MacAddr::parse("AA:BB:CC:DD:EE:FF", mac));
+    EXPECT_EQ(mac.toString(), "aa:bb:cc:dd:ee:ff");
+    MacAddr plain;
+    ASSERT_TRUE(MacAddr::parse("aabbccddeeff", plain));
+    EXPECT_EQ(mac, plain);
+
+    EXPECT_TRUE(address("2001:db8::a8bb:ccff:fedd:eeff").isEui64Of(mac));
+    EXPECT_FALSE(address("2001:db8::4f2a:8c91:e3d7:b560").isEui64Of(mac));
+    EXPECT_EQ(IpAddr::eui64(address("2001:db8:1:2::"), mac).toString(), "2001:db8:1:2:a8bb:ccff:fedd:eeff");
+
+    /* no MAC, no match */
+    MacAddr none;
+    EXPECT_FALSE(address("2001:db8::a8bb:ccff:fedd:eeff").isEui64Of(none));
+
+    EXPECT_FALSE(MacAddr::parse("not_a_mac", plain));
+    EXPECT_FALSE(plain.valid);
+    EXPECT_FALSE(MacAddr::parse("AA:BB:CC:DD:EE", plain));
+    EXPECT_FALSE(MacAddr::parse("AA-BB-CC-DD-EE-FF", plain));
+    EXPECT_FALSE(MacAddr::parse(nullptr, plain));
+}
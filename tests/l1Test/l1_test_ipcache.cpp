@@ -0,0 +1,215 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetworkManagerIpCache.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+namespace {
+    CachedAddress address(const string& text, int family, uint8_t prefix = 0, GlobalAddressType type = ADDR_GLOBAL)
+    {
+        IpAddr parsed;
+        EXPECT_TRUE(IpAddr::parse(text, family, parsed)) << text;
+        return CachedAddress(parsed, prefix, type);
+    }
+}
+
+TEST(CachedAddressTest, OrdersByAddressOnly) {
+    /* binary order, not text order */
+    EXPECT_TRUE(address("10.0.0.9", AF_INET) < address("10.0.0.10", AF_INET));
+    EXPECT_TRUE(address("10.0.0.9", AF_INET) < address("::1", AF_INET6));
+
+    /* the prefix and type take part in equality but not in the order */
+    CachedAddress slaac = address("2001:db8::1", AF_INET6, 64, ADDR_GLOBAL_MAC_BASED);
+    CachedAddress other = address("2001:db8::1", AF_INET6, 128);
+    EXPECT_FALSE(slaac < other || other < slaac);
+    EXPECT_NE(slaac, other);
+    EXPECT_EQ(slaac.toString(), "2001:db8::1");
+}
+
+TEST(IpFamilySnapshotTest, SealPrefersNonMacGlobal) {
+    IpFamilySnapshot snapshot;
+    snapshot.globalAddresses.push_back(address("2001:db8::211:22ff:fe33:4455", AF_INET6, 64, ADDR_GLOBAL_MAC_BASED));
+    snapshot.seal();
+    ASSERT_EQ(snapshot.preferredGlobal, 0);
+
+    snapshot.globalAddresses.push_back(address("2001:db8::9", AF_INET6, 64));
+    snapshot.globalAddresses.push_back(address("2001:db8::1", AF_INET6, 64, ADDR_GLOBAL_MAC_BASED));
+    snapshot.seal();
+    ASSERT_EQ(snapshot.preferredGlobal, 1);
+    EXPECT_EQ(snapshot.globalAddresses[snapshot.preferredGlobal].toString(), "2001:db8::9");
+    EXPECT_TRUE(snapshot.hasGlobal(address("2001:db8::1", AF_INET6).address));
+    EXPECT_FALSE(snapshot.hasGlobal(address("2001:db8::2", AF_INET6).address));
+
+    snapshot.globalAddresses.clear();
+    snapshot.seal();
+    EXPECT_EQ(snapshot.preferredGlobal, -1);
+}
+
+TEST(IpFamilySnapshotTest, FilesAddressesByScope) {
+    MacAddr mac;
+    ASSERT_TRUE(MacAddr::parse("aa:bb:cc:dd:ee:ff", mac));
+    IpFamilySnapshot snapshot;
+    snapshot.addAddress(address("fe80::1", AF_INET6).address, 64, mac);
+    snapshot.addAddress(address("fd00::1", AF_INET6).address, 64, mac);
+    snapshot.addAddress(address("2001:db8::a8bb:ccff:fedd:eeff", AF_INET6).address, 64, mac);
+    snapshot.addAddress(address("169.254.3.4", AF_INET).address, 16, mac);
+    snapshot.addAddress(address("192.168.1.2", AF_INET).address, 24, mac);
+    snapshot.seal();
+
+    ASSERT_EQ(snapshot.linkLocalAddresses.size(), 2u);
+    EXPECT_EQ(snapshot.linkLocalAddresses[0].toString(), "169.254.3.4");
+    ASSERT_EQ(snapshot.uniqueLocalAddresses.size(), 1u);
+    ASSERT_EQ(snapshot.globalAddresses.size(), 2u);
+    EXPECT_EQ(snapshot.globalAddresses[0].type, ADDR_GLOBAL);
+    EXPECT_EQ(snapshot.globalAddresses[1].type, ADDR_GLOBAL_MAC_BASED);
+    EXPECT_EQ(snapshot.preferredGlobal, 0);
+}
+
+TEST(IpFamilySnapshotTest, DiffGlobalSplitsAcquiredAndLost) {
+    /* a privacy address rotation: one temporary address replaced, the stable one kept */
+    IpFamilySnapshot previous;
+    previous.globalAddresses.push_back(address("2001:db8::1", AF_INET6, 64));
+    previous.globalAddresses.push_back(address("2001:db8::7", AF_INET6, 64));
+    previous.seal();
+    IpFamilySnapshot current;
+    current.globalAddresses.push_back(address("2001:db8::1", AF_INET6, 128));
+    current.globalAddresses.push_back(address("2001:db8::3", AF_INET6, 64));
+    current.globalAddresses.push_back(address("2001:db8::9", AF_INET6, 64));
+    current.seal();
+
+    vector<IpAddr> acquired, lost;
+    current.diffGlobal(previous, acquired, lost);
+    ASSERT_EQ(acquired.size(), 2u);
+    EXPECT_EQ(acquired[0].toString(), "2001:db8::3");
+    EXPECT_EQ(acquired[1].toString(), "2001:db8::9");
+    ASSERT_EQ(lost.size(), 1u);
+    EXPECT_EQ(lost[0].toString(), "2001:db8::7");
+
+    acquired.clear();
+    lost.clear();
+    current.diffGlobal(current, acquired, lost);
+    EXPECT_TRUE(acquired.empty());
+    EXPECT_TRUE(lost.empty());
+    IpFamilySnapshot().diffGlobal(current, acquired, lost);
+    EXPECT_EQ(lost.size(), 3u);
+}
+
+TEST(IpCacheStoreTest, MapsInterfacesToSlots) {
+    IpCacheStore store;
+    IpCacheStore::Slot slot;
+    ASSERT_TRUE(store.slotFor("eth0", true, slot));
+    EXPECT_EQ(slot, IpCacheStore::SLOT_ETH_IPV6);
+    EXPECT_FALSE(store.slotFor("eth1", false, slot));
+
+    store.setInterfaces("eth1", "wlp2s0");
+    ASSERT_TRUE(store.slotFor("wlp2s0", false, slot));
+    EXPECT_EQ(slot, IpCacheStore::SLOT_WLAN_IPV4);
+    EXPECT_EQ(store.interfaceOf(IpCacheStore::SLOT_ETH_IPV6), "eth1");
+    EXPECT_TRUE(IpCacheStore::isIPv6(IpCacheStore::SLOT_WLAN_IPV6));
+    EXPECT_FALSE(store.slotFor("eth0", false, slot));
+}
+
+TEST(IpCacheStoreTest, VersionMovesOnlyOnChange) {
+    IpCacheStore store;
+    EXPECT_EQ(store.load(IpCacheStore::SLOT_ETH_IPV4)->version, 0u);
+    EXPECT_FALSE(store.load(IpCacheStore::SLOT_ETH_IPV4)->valid);
+
+    IpFamilySnapshot snapshot;
+    snapshot.valid = true;
+    snapshot.globalAddresses.push_back(address("192.168.1.2", AF_INET, 24));
+    IpAddr::parse("192.168.1.1", AF_INET, snapshot.gateway);
+
+    shared_ptr<const IpFamilySnapshot> current;
+    shared_ptr<const IpFamilySnapshot> previous = store.publish(IpCacheStore::SLOT_ETH_IPV4, snapshot, &current);
+    EXPECT_FALSE(previous->valid);
+    EXPECT_EQ(current->version, 1u);
+    EXPECT_EQ(current, store.load(IpCacheStore::SLOT_ETH_IPV4));
+    EXPECT_EQ(current->gateway.toString(), "192.168.1.1");
+
+    /* the same content again publishes nothing */
+    previous = store.publish(IpCacheStore::SLOT_ETH_IPV4, snapshot, &current);
+    EXPECT_EQ(previous, current);
+    EXPECT_EQ(current->version, 1u);
+
+    /* a declined update leaves the slot alone */
+    store.update(IpCacheStore::SLOT_ETH_IPV4, [](IpFamilySnapshot& next) {
+        next.valid = false;
+        return false;
+    });
+    EXPECT_TRUE(store.load(IpCacheStore::SLOT_ETH_IPV4)->valid);
+
+    /* readers holding the old snapshot keep it whole */
+    shared_ptr<const IpFamilySnapshot> held = store.load(IpCacheStore::SLOT_ETH_IPV4);
+    store.update(IpCacheStore::SLOT_ETH_IPV4, [](IpFamilySnapshot& next) {
+        next.globalAddresses.clear();
+        return true;
+    });
+    EXPECT_EQ(store.load(IpCacheStore::SLOT_ETH_IPV4)->version, 2u);
+    EXPECT_EQ(held->globalAddresses.size(), 1u);
+    EXPECT_TRUE(store.load(IpCacheStore::SLOT_ETH_IPV4)->globalAddresses.empty());
+    EXPECT_EQ(store.load(IpCacheStore::SLOT_WLAN_IPV4)->version, 0u);
+}
+
+TEST(IpCacheStoreTest, ReadersNeverSeeAPartialSnapshot) {
+    IpCacheStore store;
+    atomic<bool> done{false};
+    atomic<uint64_t> torn{0};
+
+    /* every published snapshot has as many addresses as its autoconfig flag says: odd or even */
+    vector<thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&]() {
+            while (!done.load())
+            {
+                shared_ptr<const IpFamilySnapshot> snapshot = store.load(IpCacheStore::SLOT_WLAN_IPV6);
+                if (snapshot->autoconfig != (snapshot->globalAddresses.size() % 2 == 1))
+                    torn++;
+            }
+        });
+    }
+
+    for (uint16_t round = 1; round <= 2000; ++round)
+    {
+        store.update(IpCacheStore::SLOT_WLAN_IPV6, [round](IpFamilySnapshot& next) {
+            next.globalAddresses.clear();
+            for (uint16_t index = 0; index < round % 7; ++index)
+            {
+                next.globalAddresses.push_back(address("2001:db8::" + to_string(index + 1), AF_INET6));
+            }
+            next.autoconfig = (next.globalAddresses.size() % 2 == 1);
+            next.valid = true;
+            return true;
+        });
+    }
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_EQ(store.load(IpCacheStore::SLOT_WLAN_IPV6)->version, 2000u);
+}
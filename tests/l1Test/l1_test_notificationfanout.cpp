@@ -0,0 +1,157 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "NetworkManagerNotificationFanout.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+struct FakeSubscriber {
+    std::atomic<int> refs{0};
+    std::mutex lock;
+    std::condition_variable cond;
+    std::vector<int> received;
+    std::atomic<bool> blocked{false};
+
+    void onEvent(int value)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [this]() { return !blocked.load(); });
+        received.push_back(value);
+        cond.notify_all();
+    }
+
+    bool waitFor(size_t count)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        return cond.wait_for(guard, std::chrono::seconds(2), [this, count]() { return received.size() >= count; });
+    }
+
+    void unblock()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        blocked = false;
+        cond.notify_all();
+    }
+};
+
+using TestFanout = NotificationFanout<FakeSubscriber>;
+
+class NotificationFanoutTest : public ::testing::Test {
+protected:
+    NotificationFanoutTest()
+    {
+        hooks.addRef = [](FakeSubscriber* subscriber) { subscriber->refs++; };
+        hooks.release = [](FakeSubscriber* subscriber) { subscriber->refs--; };
+        hooks.slowSubscriber = [this](FakeSubscriber* subscriber) { slow.push_back(subscriber); };
+    }
+
+    void publish(TestFanout& fanout, int value)
+    {
+        fanout.publish(std::make_shared<const TestFanout::Delivery>([value](FakeSubscriber* subscriber) {
+            subscriber->onEvent(value);
+        }));
+    }
+
+    TestFanout::Hooks hooks;
+    std::vector<FakeSubscriber*> slow;
+};
+
+TEST_F(NotificationFanoutTest, DeliversInOrderPerSubscriber) {
+    FakeSubscriber first, second;
+    TestFanout fanout(hooks, 2, 16);
+    fanout.start();
+    fanout.addSubscriber(&first);
+    fanout.addSubscriber(&second);
+    EXPECT_EQ(first.refs, 1);
+
+    for (int i = 0; i < 10; i++)
+        publish(fanout, i);
+
+    ASSERT_TRUE(first.waitFor(10));
+    ASSERT_TRUE(second.waitFor(10));
+    EXPECT_EQ(first.received, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(second.received, first.received);
+
+    /* counters are updated once the callback has returned */
+    uint64_t delivered = 0;
+    for (int retry = 0; retry < 100 && delivered != 20; retry++)
+    {
+        auto stats = fanout.stats();
+        ASSERT_EQ(stats.size(), 2u);
+        delivered = stats[0].delivered + stats[1].delivered;
+        if (delivered != 20)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(delivered, 20u);
+
+    fanout.stop();
+    EXPECT_EQ(first.refs, 0);
+    EXPECT_EQ(second.refs, 0);
+}
+
+TEST_F(NotificationFanoutTest, SlowSubscriberDoesNotBlockOthers) {
+    FakeSubscriber slowOne, fastOne;
+    TestFanout fanout(hooks, 2, 4);
+    fanout.start();
+    slowOne.blocked = true;
+    fanout.addSubscriber(&slowOne);
+    fanout.addSubscriber(&fastOne);
+
+    /* the blocked lane overflows and is dropped while the other one keeps up */
+    for (int i = 0; i < 10; i++)
+    {
+        publish(fanout, i);
+        ASSERT_TRUE(fastOne.waitFor(i + 1));
+    }
+    ASSERT_EQ(slow.size(), 1u);
+    EXPECT_EQ(slow[0], &slowOne);
+    EXPECT_EQ(fanout.stats().size(), 1u);
+
+    slowOne.unblock();
+    fanout.stop();
+    EXPECT_EQ(slowOne.refs, 0);
+    EXPECT_EQ(fastOne.refs, 0);
+}
+
+TEST_F(NotificationFanoutTest, RemoveSubscriber) {
+    FakeSubscriber subscriber;
+    TestFanout fanout(hooks);
+    fanout.start();
+    fanout.addSubscriber(&subscriber);
+    fanout.addSubscriber(&subscriber);
+    EXPECT_EQ(subscriber.refs, 1);
+
+    publish(fanout, 1);
+    ASSERT_TRUE(subscriber.waitFor(1));
+    fanout.removeSubscriber(&subscriber);
+    EXPECT_TRUE(fanout.stats().empty());
+
+    publish(fanout, 2);
+    fanout.stop();
+    EXPECT_EQ(subscriber.refs, 0);
+    EXPECT_EQ(subscriber.received.size(), 1u);
+}
@@ -0,0 +1,277 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "NetworkManagerOperationScheduler.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+/* Holds the operations that wait on it until open() */
+class Gate {
+public:
+    void wait()
+    {
+        unique_lock<mutex> lock(m_lock);
+        m_cond.wait(lock, [this]() { return m_open; });
+    }
+    void open()
+    {
+        lock_guard<mutex> lock(m_lock);
+        m_open = true;
+        m_cond.notify_all();
+    }
+private:
+    mutex m_lock;
+    condition_variable m_cond;
+    bool m_open = false;
+};
+
+class OperationSchedulerTest : public ::testing::Test {
+protected:
+    OperationSchedulerTest()
+        : scheduler([this](const OperationScheduler::Completion& completion) {
+            lock_guard<mutex> lock(completionLock);
+            completions.push_back(completion);
+            completionCond.notify_all();
+        }, 2, 4)
+    {
+        scheduler.start();
+    }
+
+    ~OperationSchedulerTest() override
+    {
+        gate.open();
+        scheduler.stop();
+    }
+
+    OperationScheduler::Request request(const string& kind, const string& key, const string& lane, const string& group,
+                                        uint32_t result = 0, uint32_t timeoutMs = 5000)
+    {
+        OperationScheduler::Request req;
+        req.kind = kind;
+        req.key = key;
+        req.lane = lane;
+        req.group = group;
+        req.timeoutMs = timeoutMs;
+        req.run = [this, key, result]() {
+            {
+                lock_guard<mutex> lock(completionLock);
+                started.push_back(key);
+            }
+            return result;
+        };
+        return req;
+    }
+
+    /* an operation that holds its lane until the gate opens */
+    OperationScheduler::Request blocker(const string& lane, uint32_t timeoutMs = 5000)
+    {
+        OperationScheduler::Request req = request("Blocker", "blocker-" + lane, lane, "");
+        req.timeoutMs = timeoutMs;
+        req.run = [this]() { blockerRunning = true; gate.wait(); return 7u; };
+        return req;
+    }
+
+    void waitBlockerRunning()
+    {
+        for (int i = 0; i < 500 && !blockerRunning; i++)
+            this_thread::sleep_for(chrono::milliseconds(2));
+        ASSERT_TRUE(blockerRunning);
+    }
+
+    bool waitCompletions(size_t count)
+    {
+        unique_lock<mutex> lock(completionLock);
+        return completionCond.wait_for(lock, chrono::seconds(5), [this, count]() { return completions.size() >= count; });
+    }
+
+    const OperationScheduler::Completion* completionOf(uint32_t id)
+    {
+        lock_guard<mutex> lock(completionLock);
+        for (const auto& completion : completions)
+            if (completion.id == id)
+                return &completion;
+        return nullptr;
+    }
+
+    Gate gate;
+    atomic<bool> blockerRunning{false};
+    mutex completionLock;
+    condition_variable completionCond;
+    vector<OperationScheduler::Completion> completions;
+    vector<string> started;
+    OperationScheduler scheduler;
+};
+
+TEST_F(OperationSchedulerTest, ReportsCompletion) {
+    uint32_t id = 0;
+    EXPECT_EQ(scheduler.submit(request("WiFiConnect", "wifi/home", "wifi", "association", 3), id), OperationScheduler::ADMIT_QUEUED);
+    EXPECT_NE(id, 0u);
+    ASSERT_TRUE(waitCompletions(1));
+    ASSERT_NE(completionOf(id), nullptr);
+    EXPECT_EQ(completionOf(id)->kind, "WiFiConnect");
+    EXPECT_EQ(completionOf(id)->outcome, OperationScheduler::OUTCOME_COMPLETED);
+    EXPECT_EQ(completionOf(id)->result, 3u);
+    EXPECT_EQ(scheduler.inFlight(), 0u);
+}
+
+TEST_F(OperationSchedulerTest, DuplicateJoinsPendingOperation) {
+    uint32_t blockerId = 0, first = 0, second = 0;
+    scheduler.submit(blocker("wifi"), blockerId);
+    waitBlockerRunning();
+
+    EXPECT_EQ(scheduler.submit(request("WiFiConnect", "wifi/home", "wifi", "association"), first), OperationScheduler::ADMIT_QUEUED);
+    EXPECT_EQ(scheduler.submit(request("WiFiConnect", "wifi/home", "wifi", "association"), second), OperationScheduler::ADMIT_DUPLICATE);
+    EXPECT_EQ(first, second);
+
+    gate.open();
+    ASSERT_TRUE(waitCompletions(2));
+    lock_guard<mutex> lock(completionLock);
+    EXPECT_EQ(started, vector<string>{"wifi/home"});
+}
+
+TEST_F(OperationSchedulerTest, SupersedesQueuedOperationsOfGroup) {
+    uint32_t blockerId = 0, first = 0, second = 0, other = 0;
+    scheduler.submit(blocker("wifi"), blockerId);
+    waitBlockerRunning();
+
+    scheduler.submit(request("WiFiConnect", "wifi/home", "wifi", "association"), first);
+    scheduler.submit(request("SetIPSettings", "ip/wlan0", "wifi", "ip:wlan0"), other);
+    ASSERT_EQ(scheduler.submit(request("ConnectToKnownSSID", "known/office", "wifi", "association"), second), OperationScheduler::ADMIT_QUEUED);
+
+    ASSERT_TRUE(waitCompletions(1));
+    ASSERT_NE(completionOf(first), nullptr);
+    EXPECT_EQ(completionOf(first)->outcome, OperationScheduler::OUTCOME_SUPERSEDED);
+
+    gate.open();
+    ASSERT_TRUE(waitCompletions(4));
+    EXPECT_EQ(completionOf(second)->outcome, OperationScheduler::OUTCOME_COMPLETED);
+    lock_guard<mutex> lock(completionLock);
+    EXPECT_EQ(started, (vector<string>{"ip/wlan0", "known/office"}));
+}
+
+TEST_F(OperationSchedulerTest, BoundsOperationsInFlight) {
+    uint32_t id = 0;
+    scheduler.submit(blocker("wifi"), id);
+    waitBlockerRunning();
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(scheduler.submit(request("SetInterfaceState", "state/" + to_string(i), "wifi", ""), id), OperationScheduler::ADMIT_QUEUED);
+    EXPECT_EQ(scheduler.inFlight(), 4u);
+    EXPECT_EQ(scheduler.submit(request("SetInterfaceState", "state/full", "wifi", ""), id), OperationScheduler::ADMIT_FULL);
+
+    /* superseding frees the slot it needs */
+    EXPECT_EQ(scheduler.submit(request("WiFiConnect", "wifi/a", "wifi", "association"), id), OperationScheduler::ADMIT_FULL);
+    gate.open();
+    ASSERT_TRUE(waitCompletions(4));
+}
+
+TEST_F(OperationSchedulerTest, LanesRunIndependently) {
+    uint32_t blockerId = 0, id = 0;
+    scheduler.submit(blocker("wifi"), blockerId);
+    waitBlockerRunning();
+    scheduler.submit(request("SetIPSettings", "ip/eth0", "eth0", "ip:eth0", 0), id);
+    ASSERT_TRUE(waitCompletions(1));
+    EXPECT_EQ(completionOf(id)->outcome, OperationScheduler::OUTCOME_COMPLETED);
+    EXPECT_EQ(completionOf(blockerId), nullptr);
+}
+
+TEST_F(OperationSchedulerTest, DeadlineReportsTimeout) {
+    uint32_t blockerId = 0, queued = 0;
+    scheduler.submit(blocker("wifi", 50), blockerId);
+    waitBlockerRunning();
+    scheduler.submit(request("WiFiConnect", "wifi/home", "wifi", "association", 0, 50), queued);
+
+    ASSERT_TRUE(waitCompletions(2));
+    EXPECT_EQ(completionOf(blockerId)->outcome, OperationScheduler::OUTCOME_TIMEDOUT);
+    EXPECT_EQ(completionOf(queued)->outcome, OperationScheduler::OUTCOME_TIMEDOUT);
+    EXPECT_GE(completionOf(blockerId)->latencyMs, 50u);
+
+    /* the timed out call still holds its slot until it returns; its result is dropped */
+    EXPECT_EQ(scheduler.inFlight(), 1u);
+    gate.open();
+    for (int i = 0; i < 500 && scheduler.inFlight() > 0; i++)
+        this_thread::sleep_for(chrono::milliseconds(2));
+    EXPECT_EQ(scheduler.inFlight(), 0u);
+    lock_guard<mutex> lock(completionLock);
+    EXPECT_EQ(completions.size(), 2u);
+    EXPECT_TRUE(started.empty());
+}
+
+TEST_F(OperationSchedulerTest, CancelQueuedOperation) {
+    uint32_t blockerId = 0, id = 0;
+    scheduler.submit(blocker("wifi"), blockerId);
+    waitBlockerRunning();
+    scheduler.submit(request("StartWPS", "wps/pbc", "wifi", "association"), id);
+
+    EXPECT_TRUE(scheduler.cancel(id));
+    EXPECT_FALSE(scheduler.cancel(id));
+    EXPECT_FALSE(scheduler.cancel(12345));
+    ASSERT_NE(completionOf(id), nullptr);
+    EXPECT_EQ(completionOf(id)->outcome, OperationScheduler::OUTCOME_CANCELLED);
+
+    gate.open();
+    ASSERT_TRUE(waitCompletions(2));
+    lock_guard<mutex> lock(completionLock);
+    EXPECT_TRUE(started.empty());
+}
+
+TEST_F(OperationSchedulerTest, StopCancelsQueuedOperations) {
+    uint32_t blockerId = 0, id = 0;
+    scheduler.submit(blocker("wifi"), blockerId);
+    waitBlockerRunning();
+    scheduler.submit(request("WiFiConnect", "connect/home", "wifi", "association"), id);
+
+    thread stopper([this]() { scheduler.stop(); });
+    ASSERT_TRUE(waitCompletions(1));
+    ASSERT_NE(completionOf(id), nullptr);
+    EXPECT_EQ(completionOf(id)->outcome, OperationScheduler::OUTCOME_CANCELLED);
+
+    gate.open();
+    stopper.join();
+    ASSERT_NE(completionOf(blockerId), nullptr);
+    EXPECT_EQ(completionOf(blockerId)->outcome, OperationScheduler::OUTCOME_COMPLETED);
+    lock_guard<mutex> lock(completionLock);
+    EXPECT_EQ(completions.size(), 2u);
+    EXPECT_TRUE(started.empty());
+}
+
+TEST_F(OperationSchedulerTest, LatencyHistogram) {
+    uint32_t id = 0;
+    scheduler.submit(request("SetInterfaceState", "state/eth0", "eth0", ""), id);
+    ASSERT_TRUE(waitCompletions(1));
+
+    auto stats = scheduler.stats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].kind, "SetInterfaceState");
+    EXPECT_EQ(stats[0].outcomes[OperationScheduler::OUTCOME_COMPLETED], 1u);
+    EXPECT_EQ(stats[0].buckets[0], 1u);
+
+    string json;
+    scheduler.statsToJson(json);
+    EXPECT_EQ(json.find("{\"SetInterfaceState\":{\"completed\":1,\"timedout\":0,\"cancelled\":0,\"superseded\":0,\"max\":"), 0u);
+    EXPECT_NE(json.find("\"histogram\":[{\"le\":\"100\",\"count\":1},{\"le\":\"250\",\"count\":0}"), string::npos);
+    EXPECT_NE(json.find("{\"le\":\"+Inf\",\"count\":0}]}}"), string::npos);
+}
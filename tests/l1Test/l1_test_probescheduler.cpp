@@ -0,0 +1,218 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "NetworkManagerProbeScheduler.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace WPEFramework::Plugin;
+
+TEST(ProbeSchedulerTest, BacksOffUpToTheCap) {
+    ProbeScheduler scheduler(1);
+    scheduler.setPolicy(ProbeScheduler::PHASE_DEGRADED, {milliseconds(30000), milliseconds(300000), 2.0, 0.0});
+
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_DEGRADED), milliseconds(30000));
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_DEGRADED), milliseconds(60000));
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_DEGRADED), milliseconds(120000));
+    for (int i = 0; i < 10; i++)
+        scheduler.next(ProbeScheduler::PHASE_DEGRADED);
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_DEGRADED), milliseconds(300000));
+
+    /* the other phases keep their own count */
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_INITIAL), milliseconds(5000));
+
+    scheduler.resetBackoff();
+    EXPECT_EQ(scheduler.next(ProbeScheduler::PHASE_DEGRADED), milliseconds(30000));
+}
+
+TEST(ProbeSchedulerTest, JitterStaysInBounds) {
+    ProbeScheduler scheduler(7);
+    scheduler.setPolicy(ProbeScheduler::PHASE_DEGRADED, {milliseconds(10000), milliseconds(10000), 2.0, 0.2});
+
+    bool varies = false;
+    milliseconds first = scheduler.next(ProbeScheduler::PHASE_DEGRADED);
+    for (int i = 0; i < 200; i++)
+    {
+        milliseconds delay = scheduler.next(ProbeScheduler::PHASE_DEGRADED);
+        EXPECT_GE(delay, milliseconds(8000));
+        EXPECT_LE(delay, milliseconds(12000));
+        varies |= (delay != first);
+    }
+    EXPECT_TRUE(varies);
+}
+
+TEST(ProbeSchedulerTest, SanitizesPolicy) {
+    ProbeScheduler scheduler;
+    scheduler.setPolicy(ProbeScheduler::PHASE_LINK_DOWN, {milliseconds(5000), milliseconds(1000), 0.5, 3.0});
+    BackoffPolicy policy = scheduler.policy(ProbeScheduler::PHASE_LINK_DOWN);
+    EXPECT_EQ(policy.maximum, milliseconds(5000));
+    EXPECT_DOUBLE_EQ(policy.multiplier, 1.0);
+    EXPECT_LT(policy.jitter, 1.0);
+}
+
+TEST(ProbeSchedulerTest, WakeEndsTheWait) {
+    ProbeScheduler scheduler;
+    EXPECT_FALSE(scheduler.wait(milliseconds(10)));
+
+    std::thread waker([&scheduler] {
+        std::this_thread::sleep_for(milliseconds(50));
+        scheduler.wake(ProbeScheduler::WAKE_ADDRESS);
+    });
+    steady_clock::time_point start = steady_clock::now();
+    EXPECT_TRUE(scheduler.wait(seconds(30)));
+    EXPECT_LT(steady_clock::now() - start, seconds(10));
+    waker.join();
+
+    /* a wake is consumed by one wait */
+    EXPECT_FALSE(scheduler.wait(milliseconds(10)));
+
+    scheduler.stop();
+    EXPECT_TRUE(scheduler.stopped());
+    EXPECT_TRUE(scheduler.wait(seconds(30)));
+    EXPECT_TRUE(scheduler.wait(seconds(30)));
+    scheduler.restart();
+    EXPECT_FALSE(scheduler.stopped());
+    EXPECT_FALSE(scheduler.wait(milliseconds(10)));
+}
+
+TEST(ProbeSchedulerTest, CountsProbesInTheLastHour) {
+    ProbeScheduler scheduler;
+    ProbeScheduler::Clock::time_point now = ProbeScheduler::Clock::now();
+
+    scheduler.recordProbe(now);
+    scheduler.recordProbe(now + minutes(30));
+    scheduler.recordProbe(now + minutes(50));
+    EXPECT_EQ(scheduler.probesLastHour(now + minutes(55)), 3u);
+    EXPECT_EQ(scheduler.probesLastHour(now + minutes(61)), 2u);
+    EXPECT_EQ(scheduler.probesLastHour(now + minutes(111)), 0u);
+}
+
+TEST(ProbeSchedulerTest, StatsToJson) {
+    ProbeScheduler scheduler(1);
+    scheduler.setPolicy(ProbeScheduler::PHASE_DEGRADED, {milliseconds(30000), milliseconds(300000), 2.0, 0.0});
+    scheduler.recordProbe();
+    scheduler.recordProbe();
+    scheduler.recordSkippedProbe();
+    scheduler.wake(ProbeScheduler::WAKE_INTERFACE);
+    scheduler.wake(ProbeScheduler::WAKE_ROUTE);
+    scheduler.wake(ProbeScheduler::WAKE_ROUTE);
+    scheduler.next(ProbeScheduler::PHASE_DEGRADED);
+    scheduler.next(ProbeScheduler::PHASE_DEGRADED);
+
+    string json;
+    scheduler.statsToJson(json);
+    EXPECT_EQ(json, "{\"probesLastHour\":2,\"probes\":2,\"skipped\":1,"
+                    "\"wakeups\":{\"interface\":1,\"address\":0,\"route\":2,\"request\":0},"
+                    "\"phase\":\"degraded\",\"nextDelayMs\":60000}");
+    EXPECT_STREQ(ProbeScheduler::phaseName(ProbeScheduler::PHASE_LINK_DOWN), "linkdown");
+}
+
+class LinkPrecheckTest : public ::testing::Test {
+protected:
+    LinkPrecheckTest()
+    {
+        procNet = "/tmp/nm_precheck_" + to_string(getpid());
+        mkdir(procNet.c_str(), 0700);
+    }
+
+    ~LinkPrecheckTest() override
+    {
+        unlink((procNet + "/route").c_str());
+        unlink((procNet + "/ipv6_route").c_str());
+        unlink((procNet + "/arp").c_str());
+        rmdir(procNet.c_str());
+    }
+
+    void write(const string& name, const string& content)
+    {
+        ofstream file(procNet + "/" + name, ios::trunc);
+        file << content;
+    }
+
+    string procNet;
+};
+
+static const char* s_routeHeader = "Iface\tDestination\tGateway \tFlags\tRefCnt\tUse\tMetric\tMask\t\tMTU\tWindow\tIRTT\n";
+static const char* s_arpHeader = "IP address       HW type     Flags       HW address            Mask     Device\n";
+static const char* s_ipv6Reject = "00000000000000000000000000000000 00 00000000000000000000000000000000 00 00000000000000000000000000000000 ffffffff 00000001 00000000 00200200       lo\n";
+
+TEST_F(LinkPrecheckTest, DefaultRouteWithResolvedGateway) {
+    write("route", string(s_routeHeader) +
+                   "eth0\t00000000\t0101A8C0\t0003\t0\t0\t100\t00000000\t0\t0\t0\n"
+                   "eth0\t0001A8C0\t00000000\t0001\t0\t0\t100\t00FFFFFF\t0\t0\t0\n");
+    write("ipv6_route", s_ipv6Reject);
+    write("arp", string(s_arpHeader) + "192.168.1.1      0x1         0x2         00:11:22:33:44:55     *        eth0\n");
+
+    LinkPrecheck precheck(procNet);
+    LinkPrecheck::Result result = precheck.check("eth0");
+    EXPECT_TRUE(result.ipv4Route);
+    EXPECT_EQ(result.ipv4Gateway, "192.168.1.1");
+    EXPECT_FALSE(result.ipv4GatewayFailed);
+    EXPECT_FALSE(result.ipv6Route);
+    EXPECT_TRUE(result.usable());
+
+    result = precheck.check("wlan0");
+    EXPECT_FALSE(result.ipv4Route);
+    EXPECT_FALSE(result.usable());
+    EXPECT_TRUE(precheck.check("").usable());
+}
+
+TEST_F(LinkPrecheckTest, IncompleteArpEntryFailsTheGateway) {
+    write("route", string(s_routeHeader) + "wlan0\t00000000\t0101A8C0\t0003\t0\t0\t600\t00000000\t0\t0\t0\n");
+    write("arp", string(s_arpHeader) + "192.168.1.1      0x1         0x0         00:00:00:00:00:00     *        wlan0\n");
+
+    LinkPrecheck::Result result = LinkPrecheck(procNet).check("wlan0");
+    EXPECT_TRUE(result.ipv4Route);
+    EXPECT_TRUE(result.ipv4GatewayFailed);
+    EXPECT_FALSE(result.usable());
+}
+
+TEST_F(LinkPrecheckTest, GatewayNotInArpTableIsNotAFailure) {
+    write("route", string(s_routeHeader) + "wlan0\t00000000\t0101A8C0\t0003\t0\t0\t600\t00000000\t0\t0\t0\n");
+    write("arp", s_arpHeader);
+
+    LinkPrecheck::Result result = LinkPrecheck(procNet).check("wlan0");
+    EXPECT_FALSE(result.ipv4GatewayFailed);
+    EXPECT_TRUE(result.usable());
+}
+
+TEST_F(LinkPrecheckTest, Ipv6DefaultRoute) {
+    write("route", s_routeHeader);
+    write("ipv6_route", string(s_ipv6Reject) +
+                        "00000000000000000000000000000000 00 00000000000000000000000000000000 00 fe800000000000000000000000000001 00000400 00000001 00000000 00450003     eth0\n");
+
+    LinkPrecheck precheck(procNet);
+    EXPECT_TRUE(precheck.check("eth0").ipv6Route);
+    EXPECT_TRUE(precheck.check("eth0").usable());
+    EXPECT_FALSE(precheck.check("lo").ipv6Route);
+}
+
+TEST_F(LinkPrecheckTest, MissingFiles) {
+    LinkPrecheck::Result result = LinkPrecheck(procNet + "/absent").check("eth0");
+    EXPECT_FALSE(result.ipv4Route);
+    EXPECT_FALSE(result.ipv6Route);
+    EXPECT_FALSE(result.usable());
+}
@@ -20,6 +20,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <UpnpDiscoveryManager.h>
+#include "NetworkManagerRtnetlink.h"
 #include <thread>
 
 using ::testing::_;
@@ -36,24 +37,12 @@ protected:
 };
 
 std::string getInterfaceWithDefaultRoute() {
-    std::string command = "ip -4 route show | grep default | awk '{print $5}'";
-    std::array<char, 128> buffer;
-    std::string result;
-
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(command.c_str(), "r"), pclose);
-    if (!pipe) {
-        throw std::runtime_error("popen() failed!");
-    }
-
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
-    }
-
-    // Remove trailing newline character
-    if (!result.empty() && result.back() == '\n') {
-        result.pop_back();
-    }
-    return result;
+    /* the interface of the IPv4 default route, straight from the kernel */
+    WPEFramework::Plugin::RtnetlinkMonitor monitor;
+    WPEFramework::Plugin::RtnetlinkRoute route;
+    if (!monitor.start(nullptr) || !monitor.getDefaultRoute(AF_INET, route))
+        return std::string();
+    return monitor.getDefaultInterface();
 }
 
 TEST_F(UpnpDiscoveryManagerTest, FindGatewayDeviceTest)
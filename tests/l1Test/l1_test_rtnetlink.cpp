@@ -0,0 +1,285 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <arpa/inet.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_addr.h>
+#include <linux/if.h>
+#include <sched.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "NetworkManagerRtnetlink.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+namespace {
+    /* Builds a datagram of rtnetlink messages the way the kernel lays them out */
+    class MessageBuilder {
+    public:
+        template <typename Body>
+        void begin(uint16_t type, const Body& body, uint16_t flags = 0)
+        {
+            m_start = m_buffer.size();
+            struct nlmsghdr header{};
+            header.nlmsg_type = type;
+            header.nlmsg_flags = flags;
+            append(&header, sizeof(header));
+            append(&body, sizeof(body));
+        }
+
+        void attribute(uint16_t type, const void* data, size_t length)
+        {
+            struct rtattr attribute{};
+            attribute.rta_type = type;
+            attribute.rta_len = RTA_LENGTH(length);
+            append(&attribute, sizeof(attribute));
+            append(data, length);
+        }
+
+        void attribute(uint16_t type, uint32_t value) { attribute(type, &value, sizeof(value)); }
+
+        void address(uint16_t type, int family, const char* text)
+        {
+            uint8_t data[16];
+            inet_pton(family, text, data);
+            attribute(type, data, family == AF_INET6 ? 16 : 4);
+        }
+
+        void end()
+        {
+            reinterpret_cast<struct nlmsghdr*>(&m_buffer[m_start])->nlmsg_len = m_buffer.size() - m_start;
+        }
+
+        const uint8_t* data() const { return m_buffer.data(); }
+        size_t size() const { return m_buffer.size(); }
+
+    private:
+        void append(const void* data, size_t length)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            m_buffer.insert(m_buffer.end(), bytes, bytes + length);
+            m_buffer.resize(NLMSG_ALIGN(m_buffer.size()), 0);
+        }
+
+        vector<uint8_t> m_buffer;
+        size_t m_start{0};
+    };
+
+    void addLink(MessageBuilder& builder, uint16_t type, int index, const char* name, unsigned flags)
+    {
+        struct ifinfomsg info{};
+        info.ifi_index = index;
+        info.ifi_flags = flags;
+        builder.begin(type, info);
+        builder.attribute(IFLA_IFNAME, name, strlen(name) + 1);
+        const uint8_t mac[6] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+        builder.attribute(IFLA_ADDRESS, mac, sizeof(mac));
+        builder.end();
+    }
+
+    void addAddress(MessageBuilder& builder, uint16_t type, int index, int family, const char* text, uint8_t prefix, uint32_t flags = 0)
+    {
+        struct ifaddrmsg info{};
+        info.ifa_family = family;
+        info.ifa_prefixlen = prefix;
+        info.ifa_index = index;
+        builder.begin(type, info);
+        builder.address(IFA_ADDRESS, family, text);
+        builder.attribute(IFA_FLAGS, flags);
+        builder.end();
+    }
+
+    void addDefaultRoute(MessageBuilder& builder, uint16_t type, int index, int family, const char* gateway, uint32_t metric, uint32_t table = RT_TABLE_MAIN)
+    {
+        struct rtmsg info{};
+        info.rtm_family = family;
+        info.rtm_table = RT_TABLE_UNSPEC;
+        info.rtm_type = RTN_UNICAST;
+        builder.begin(type, info);
+        builder.attribute(RTA_TABLE, table);
+        builder.attribute(RTA_OIF, static_cast<uint32_t>(index));
+        builder.attribute(RTA_PRIORITY, metric);
+        builder.address(RTA_GATEWAY, family, gateway);
+        builder.end();
+    }
+}
+
+TEST(RtnetlinkMonitorTest, DecodesABatch) {
+    RtnetlinkMonitor monitor;
+    MessageBuilder builder;
+    addLink(builder, RTM_NEWLINK, 7, "eth9", IFF_UP | IFF_LOWER_UP);
+    addAddress(builder, RTM_NEWADDR, 7, AF_INET, "10.1.2.3", 24);
+    addAddress(builder, RTM_NEWADDR, 7, AF_INET6, "2001:db8::1", 64);
+    addAddress(builder, RTM_NEWADDR, 7, AF_INET6, "2001:db8::2", 64, IFA_F_TENTATIVE);
+    addDefaultRoute(builder, RTM_NEWROUTE, 7, AF_INET, "10.1.2.1", 200);
+    addDefaultRoute(builder, RTM_NEWROUTE, 7, AF_INET, "10.1.2.254", 100);
+    addDefaultRoute(builder, RTM_NEWROUTE, 7, AF_INET, "10.1.2.9", 1, 100);
+
+    RtnetlinkChanges changes;
+    monitor.decode(builder.data(), builder.size(), changes);
+    EXPECT_EQ(monitor.messages(), 7u);
+    EXPECT_EQ(changes.links, set<string>({"eth9"}));
+    EXPECT_EQ(changes.addresses, (set<pair<string, int>>{{"eth9", AF_INET}, {"eth9", AF_INET6}}));
+    EXPECT_EQ(changes.routes, set<int>({AF_INET}));
+
+    RtnetlinkLink link;
+    ASSERT_TRUE(monitor.getLink("eth9", link));
+    EXPECT_EQ(link.index, 7);
+    EXPECT_EQ(link.mac.toString(), "02:11:22:33:44:55");
+    EXPECT_TRUE(link.up);
+    EXPECT_TRUE(link.lowerUp);
+
+    vector<RtnetlinkAddress> addresses = monitor.getAddresses("eth9", AF_INET6);
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses[0].address.toString(), "2001:db8::1");
+    EXPECT_EQ(addresses[0].prefix, 64);
+
+    /* the lowest metric wins; the route of table 100 is not a main table default */
+    RtnetlinkRoute route;
+    ASSERT_TRUE(monitor.getDefaultRoute(AF_INET, route));
+    EXPECT_EQ(route.gateway.toString(), "10.1.2.254");
+    EXPECT_EQ(route.metric, 100u);
+    EXPECT_FALSE(monitor.getDefaultRoute(AF_INET6, route));
+    EXPECT_EQ(monitor.getDefaultInterface(), "eth9");
+
+    /* nothing new is not a change */
+    changes = RtnetlinkChanges();
+    monitor.decode(builder.data(), builder.size(), changes);
+    EXPECT_TRUE(changes.empty());
+
+    /* the link takes its addresses and routes with it */
+    MessageBuilder removal;
+    addLink(removal, RTM_DELLINK, 7, "eth9", 0);
+    monitor.decode(removal.data(), removal.size(), changes);
+    EXPECT_EQ(changes.addresses.size(), 2u);
+    EXPECT_EQ(changes.routes, set<int>({AF_INET}));
+    EXPECT_FALSE(monitor.getLink("eth9", link));
+    EXPECT_TRUE(monitor.getAddresses("eth9", AF_INET).empty());
+    EXPECT_EQ(monitor.getDefaultInterface(), "");
+}
+
+TEST(RtnetlinkMonitorTest, LinkDownDropsIPv4Routes) {
+    RtnetlinkMonitor monitor;
+    MessageBuilder builder;
+    addLink(builder, RTM_NEWLINK, 3, "wlan9", IFF_UP);
+    addDefaultRoute(builder, RTM_NEWROUTE, 3, AF_INET, "192.168.1.1", 600);
+    addDefaultRoute(builder, RTM_NEWROUTE, 3, AF_INET6, "fe80::1", 600);
+    RtnetlinkChanges changes;
+    monitor.decode(builder.data(), builder.size(), changes);
+
+    MessageBuilder down;
+    addLink(down, RTM_NEWLINK, 3, "wlan9", 0);
+    changes = RtnetlinkChanges();
+    monitor.decode(down.data(), down.size(), changes);
+    EXPECT_EQ(changes.routes, set<int>({AF_INET}));
+    RtnetlinkRoute route;
+    EXPECT_FALSE(monitor.getDefaultRoute(AF_INET, route));
+    ASSERT_TRUE(monitor.getDefaultRoute(AF_INET6, route, "wlan9"));
+    EXPECT_EQ(route.gateway.toString(), "fe80::1");
+}
+
+/*
+ * The monitor runs in a private network namespace with a veth pair, so the test
+ * sees real kernel events without touching the host's interfaces.
+ */
+TEST(RtnetlinkMonitorTest, FollowsTheKernelInANamespace) {
+    if (geteuid() != 0 || system("ip -V > /dev/null 2>&1") != 0)
+        GTEST_SKIP() << "needs root and iproute2";
+
+    bool ready = false;
+    bool started = false;
+    bool sawAddress = false;
+    bool sawRoute = false;
+    bool routeFlushed = false;
+    string defaultInterface;
+    RtnetlinkRoute route;
+    vector<RtnetlinkAddress> addresses;
+
+    thread host([&]() {
+        if (unshare(CLONE_NEWNET) != 0)
+            return;
+        ready = system("ip link add nm0 type veth peer name nm1 > /dev/null 2>&1") == 0 &&
+                system("ip link set nm1 up > /dev/null 2>&1") == 0 &&
+                system("ip link set nm0 up > /dev/null 2>&1") == 0;
+        if (!ready)
+            return;
+
+        mutex lock;
+        condition_variable changed;
+        RtnetlinkChanges seen;
+        RtnetlinkMonitor monitor;
+        started = monitor.start([&](const RtnetlinkChanges& changes) {
+            lock_guard<mutex> guard(lock);
+            seen.addresses.insert(changes.addresses.begin(), changes.addresses.end());
+            seen.routes.insert(changes.routes.begin(), changes.routes.end());
+            changed.notify_all();
+        });
+        if (!started)
+            return;
+
+        auto waitFor = [&](function<bool()> done) {
+            unique_lock<mutex> guard(lock);
+            return changed.wait_for(guard, chrono::seconds(2), done);
+        };
+
+        ready = system("ip addr add 10.88.0.2/24 dev nm0 > /dev/null 2>&1") == 0;
+        sawAddress = waitFor([&]() { return seen.addresses.count({"nm0", AF_INET}) > 0; });
+
+        ready = ready && system("ip route add default via 10.88.0.1 dev nm0 metric 50 > /dev/null 2>&1") == 0;
+        sawRoute = waitFor([&]() { return seen.routes.count(AF_INET) > 0; });
+        addresses = monitor.getAddresses("nm0", AF_INET);
+        monitor.getDefaultRoute(AF_INET, route);
+        defaultInterface = monitor.getDefaultInterface();
+
+        /* the kernel drops the route with the address without saying so; the monitor dumps again */
+        {
+            lock_guard<mutex> guard(lock);
+            seen = RtnetlinkChanges();
+        }
+        ready = ready && system("ip addr del 10.88.0.2/24 dev nm0 > /dev/null 2>&1") == 0;
+        RtnetlinkRoute gone;
+        routeFlushed = waitFor([&]() { return seen.routes.count(AF_INET) > 0; }) && !monitor.getDefaultRoute(AF_INET, gone);
+        monitor.stop();
+    });
+    host.join();
+
+    if (!ready && !started)
+        GTEST_SKIP() << "cannot create a veth pair in a private namespace";
+
+    ASSERT_TRUE(started);
+    EXPECT_TRUE(sawAddress);
+    EXPECT_TRUE(sawRoute);
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses[0].address.toString(), "10.88.0.2");
+    EXPECT_EQ(addresses[0].prefix, 24);
+    EXPECT_EQ(route.gateway.toString(), "10.88.0.1");
+    EXPECT_EQ(route.metric, 50u);
+    EXPECT_EQ(defaultInterface, "nm0");
+    EXPECT_TRUE(routeFlushed);
+}
@@ -0,0 +1,164 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+#include "NetworkManagerScanResults.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+class ScanResultSetTest : public ::testing::Test {
+protected:
+    ScanResultSetTest()
+    {
+        scanResults.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -45, 2);
+        scanResults.add("HomeWiFi", "AA:BB:CC:DD:EE:02", 5180, -60, 2);
+        scanResults.add("Office", "AA:BB:CC:DD:EE:03", 5955, -70, 3);
+        scanResults.add("Cafe", "AA:BB:CC:DD:EE:04", 2462, -80, 0);
+    }
+
+    ScanResultSet scanResults;
+};
+
+TEST(ScanResultSetBandTest, BandFromFrequency) {
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(2412), ScanResultSet::BAND_2_4GHZ);
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(5745), ScanResultSet::BAND_5GHZ);
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(6115), ScanResultSet::BAND_6GHZ);
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(5955), ScanResultSet::BAND_6GHZ);
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(5885), ScanResultSet::BAND_5GHZ);
+    EXPECT_EQ(ScanResultSet::bandFromFrequency(0), ScanResultSet::BAND_UNKNOWN);
+
+    ScanResultSet::Band band = ScanResultSet::BAND_UNKNOWN;
+    EXPECT_TRUE(ScanResultSet::parseBand("2.4", band));
+    EXPECT_EQ(band, ScanResultSet::BAND_2_4GHZ);
+    EXPECT_TRUE(ScanResultSet::parseBand("5.0", band));
+    EXPECT_EQ(band, ScanResultSet::BAND_5GHZ);
+    EXPECT_FALSE(ScanResultSet::parseBand("", band));
+    EXPECT_FALSE(ScanResultSet::parseBand("5GHz", band));
+}
+
+TEST_F(ScanResultSetTest, NoFilterKeepsAll) {
+    EXPECT_EQ(scanResults.filter({}, {}), 4u);
+    EXPECT_EQ(scanResults.filter({}, {"ALL"}), 4u);
+}
+
+TEST_F(ScanResultSetTest, FilterBySsidAndBand) {
+    EXPECT_EQ(scanResults.filter({"HomeWiFi", "Cafe"}, {"2.4"}), 2u);
+    EXPECT_EQ(scanResults.bssid(0), "AA:BB:CC:DD:EE:01");
+    EXPECT_EQ(scanResults.ssid(1), "Cafe");
+    EXPECT_EQ(scanResults.strength(1), -80);
+    EXPECT_EQ(scanResults.frequency(1), 2462u);
+}
+
+TEST_F(ScanResultSetTest, FilterByBandOnly) {
+    EXPECT_EQ(scanResults.filter({}, {"5", "6"}), 2u);
+    EXPECT_EQ(scanResults.ssid(0), "HomeWiFi");
+    EXPECT_EQ(scanResults.ssid(1), "Office");
+}
+
+TEST_F(ScanResultSetTest, InvalidBandMatchesNothing) {
+    EXPECT_EQ(scanResults.filter({}, {"junk"}), 0u);
+    EXPECT_TRUE(scanResults.empty());
+}
+
+TEST_F(ScanResultSetTest, ToJson) {
+    scanResults.filter({"Office"}, {});
+    string json;
+    scanResults.toJson(json);
+    EXPECT_EQ(json, "[{\"ssid\":\"Office\",\"bssid\":\"AA:BB:CC:DD:EE:03\",\"security\":3,\"strength\":-70,\"frequency\":6}]");
+}
+
+TEST(ScanResultSetJsonTest, EscapesSsid) {
+    ScanResultSet scanResults;
+    string json;
+    scanResults.toJson(json);
+    EXPECT_EQ(json, "[]");
+
+    scanResults.add(string("a\"b\\c\x01", 6), "", 2412, -50, 0);
+    scanResults.add("second", "AA:BB:CC:DD:EE:05", 5200, -55, 1);
+    json.clear();
+    scanResults.toJson(json);
+    EXPECT_EQ(json, "[{\"ssid\":\"a\\\"b\\\\c\\u0001\",\"bssid\":\"\",\"security\":0,\"strength\":-50,\"frequency\":2.4},"
+                    "{\"ssid\":\"second\",\"bssid\":\"AA:BB:CC:DD:EE:05\",\"security\":1,\"strength\":-55,\"frequency\":5}]");
+}
+
+TEST(ScanResultIndexTest, FirstScanIsAllAdded) {
+    ScanResultSet scan;
+    ScanResultIndex index;
+    string json;
+    EXPECT_FALSE(index.update(scan, json));
+    EXPECT_TRUE(json.empty());
+
+    scan.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -45, 2);
+    ASSERT_TRUE(index.update(scan, json));
+    EXPECT_EQ(json, "{\"sequence\":1,\"added\":[{\"ssid\":\"HomeWiFi\",\"bssid\":\"AA:BB:CC:DD:EE:01\",\"security\":2,\"strength\":-45,\"frequency\":2.4}],"
+                    "\"changed\":[],\"removed\":[]}");
+    EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(ScanResultIndexTest, ReportsChangesPastHysteresis) {
+    ScanResultIndex index(5);
+    string json;
+    ScanResultSet first;
+    first.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -45, 2);
+    first.add("Office", "AA:BB:CC:DD:EE:02", 5180, -60, 3);
+    ASSERT_TRUE(index.update(first, json));
+
+    /* small fluctuations are not reported, and do not move the reference value */
+    ScanResultSet second;
+    second.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -48, 2);
+    second.add("Office", "AA:BB:CC:DD:EE:02", 5180, -57, 3);
+    json.clear();
+    EXPECT_FALSE(index.update(second, json));
+    EXPECT_TRUE(json.empty());
+
+    ScanResultSet third;
+    third.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -50, 2);
+    third.add("Office", "AA:BB:CC:DD:EE:02", 5180, -57, 4);
+    third.add("Office", "AA:BB:CC:DD:EE:02", 5180, -57, 4);
+    ASSERT_TRUE(index.update(third, json));
+    EXPECT_EQ(json, "{\"sequence\":2,\"added\":[],\"changed\":["
+                    "{\"ssid\":\"HomeWiFi\",\"bssid\":\"AA:BB:CC:DD:EE:01\",\"security\":2,\"strength\":-50,\"frequency\":2.4},"
+                    "{\"ssid\":\"Office\",\"bssid\":\"AA:BB:CC:DD:EE:02\",\"security\":4,\"strength\":-57,\"frequency\":5}],"
+                    "\"removed\":[]}");
+}
+
+TEST(ScanResultIndexTest, ReportsRemoved) {
+    ScanResultIndex index;
+    string json;
+    ScanResultSet first;
+    first.add("HomeWiFi", "AA:BB:CC:DD:EE:01", 2437, -45, 2);
+    first.add("NoBssid", "", 5180, -60, 0);
+    ASSERT_TRUE(index.update(first, json));
+
+    ScanResultSet second;
+    second.add("NoBssid", "", 5200, -61, 0);
+    second.add("Cafe", "AA:BB:CC:DD:EE:03", 2462, -80, 0);
+    json.clear();
+    ASSERT_TRUE(index.update(second, json));
+    EXPECT_EQ(json, "{\"sequence\":2,\"added\":[{\"ssid\":\"Cafe\",\"bssid\":\"AA:BB:CC:DD:EE:03\",\"security\":0,\"strength\":-80,\"frequency\":2.4}],"
+                    "\"changed\":[],\"removed\":[{\"ssid\":\"HomeWiFi\",\"bssid\":\"AA:BB:CC:DD:EE:01\"}]}");
+    EXPECT_EQ(index.size(), 2u);
+
+    index.reset();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.sequence(), 0u);
+}
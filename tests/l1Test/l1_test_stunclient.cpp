@@ -18,7 +18,11 @@
 **/
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <arpa/inet.h>
 #include "NetworkManagerStunClient.h"
+#include "StunMockServer.h"
 
 using namespace std;
 using namespace stun;
@@ -53,3 +57,285 @@ TEST_F(ClientTest, BindWithInvalidInterface) {
     EXPECT_FALSE(success);
     EXPECT_FALSE(result.is_valid());
 }
+
+class StunCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_server.start());
+    }
+
+    StunMockServer m_server;
+    stun::client m_client;
+};
+
+TEST_F(StunCacheTest, CachesPerInterfaceAndFamily) {
+    if (!m_server.hasIPv6())
+        GTEST_SKIP() << "no IPv6 loopback";
+
+    stun::bind_result v4, v6;
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 60, v4));
+    EXPECT_EQ(v4.public_ip, "127.0.0.1");
+    ASSERT_TRUE(m_client.bind("::1", m_server.port(), "lo", stun::protocol::af_inet6, 5, 60, v6));
+    EXPECT_EQ(v6.public_ip, "::1");
+    EXPECT_EQ(m_server.requestCount(), 2);
+
+    /* alternating families no longer evicts the other entry */
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 60, v4));
+    ASSERT_TRUE(m_client.bind("::1", m_server.port(), "lo", stun::protocol::af_inet6, 5, 60, v6));
+    EXPECT_EQ(v4.public_ip, "127.0.0.1");
+    EXPECT_EQ(v6.public_ip, "::1");
+    EXPECT_EQ(m_server.requestCount(), 2);
+
+    /* the interface is part of the key */
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "", stun::protocol::af_inet, 5, 60, v4));
+    EXPECT_EQ(m_server.requestCount(), 3);
+
+    m_client.clear_cache();
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 60, v4));
+    EXPECT_EQ(m_server.requestCount(), 4);
+}
+
+TEST_F(StunCacheTest, NoCacheWhenDisabled) {
+    stun::bind_result result;
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_EQ(result.public_ip, "127.0.0.1");
+    EXPECT_EQ(m_server.requestCount(), 2);
+}
+
+TEST_F(StunCacheTest, DualStackFillsEachFamily) {
+    stun::bind_result v4, v6;
+    ASSERT_TRUE(m_client.bind_dual_stack("localhost", m_server.port(), "lo", 5, 60, v4, v6));
+    EXPECT_EQ(v4.public_ip, "127.0.0.1");
+    /* localhost may not resolve to ::1; a failed family is simply left empty */
+    if (v6.is_valid()) {
+        EXPECT_EQ(v6.public_ip, "::1");
+    }
+
+    int requests = m_server.requestCount();
+    ASSERT_TRUE(m_client.bind("localhost", m_server.port(), "lo", stun::protocol::af_inet, 5, 60, v4));
+    EXPECT_EQ(m_server.requestCount(), requests);
+}
+
+class StunProtocolTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        /* short schedule so that lost requests cost milliseconds: 50, 100, 200 then 100 ms */
+        stun::retransmission schedule;
+        schedule.rto = std::chrono::milliseconds(50);
+        schedule.max_requests = 3;
+        schedule.last_wait_factor = 2;
+        m_client.set_retransmission(schedule);
+    }
+
+    static long long elapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    StunMockServer m_server;
+    stun::client m_client;
+};
+
+TEST_F(StunProtocolTest, XorMappedAddress) {
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_EQ(result.public_ip, "127.0.0.1");
+
+    if (m_server.hasIPv6()) {
+        ASSERT_TRUE(m_client.bind("::1", m_server.port(), "lo", stun::protocol::af_inet6, 5, 0, result));
+        EXPECT_EQ(result.public_ip, "::1");
+    }
+}
+
+TEST_F(StunProtocolTest, Rfc3489MappedAddress) {
+    m_server.setRfc5389(false);
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_EQ(result.public_ip, "127.0.0.1");
+}
+
+TEST_F(StunProtocolTest, RetransmitsLostRequests) {
+    m_server.dropRequests(2);
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_EQ(result.public_ip, "127.0.0.1");
+    EXPECT_EQ(m_server.requestCount(), 3);
+    EXPECT_LT(elapsedMs(start), 1000);
+}
+
+TEST_F(StunProtocolTest, GivesUpAfterSchedule) {
+    m_server.setSilent(true);
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_FALSE(result.is_valid());
+    EXPECT_EQ(m_server.requestCount(), 3);
+    /* 50 + 100 + 2 * 50 ms, far below the 5 s bind timeout */
+    EXPECT_LT(elapsedMs(start), 2000);
+}
+
+TEST_F(StunProtocolTest, IgnoresForeignTransaction) {
+    m_server.setWrongTransaction(true);
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    EXPECT_FALSE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_FALSE(result.is_valid());
+}
+
+TEST_F(StunProtocolTest, RacesServers) {
+    StunMockServer silent;
+    silent.setSilent(true);
+    ASSERT_TRUE(silent.start());
+    m_server.dropRequests(1);
+    ASSERT_TRUE(m_server.start());
+
+    stun::bind_result result;
+    std::vector<stun::server> servers = {
+        stun::server("127.0.0.1", silent.port()),
+        stun::server("no.such.host.invalid", 3478),
+        stun::server("127.0.0.1", m_server.port())
+    };
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(m_client.bind(servers, "lo", stun::protocol::af_inet, 5, 0, result));
+    EXPECT_EQ(result.public_ip, "127.0.0.1");
+    /* the silent server costs nothing: the second request to the good one answers */
+    EXPECT_EQ(silent.requestCount(), 2);
+    EXPECT_EQ(m_server.requestCount(), 2);
+    EXPECT_LT(elapsedMs(start), 1000);
+}
+
+TEST_F(StunProtocolTest, BindTimeoutBoundsSchedule) {
+    stun::retransmission schedule;
+    m_client.set_retransmission(schedule);
+    m_server.setSilent(true);
+    ASSERT_TRUE(m_server.start());
+    stun::bind_result result;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(m_client.bind("127.0.0.1", m_server.port(), "lo", stun::protocol::af_inet, 1, 0, result));
+    auto elapsed = elapsedMs(start);
+    EXPECT_GE(elapsed, 900);
+    EXPECT_LT(elapsed, 2000);
+    /* 500 ms then 1000 ms: the second request is sent before the deadline */
+    EXPECT_EQ(m_server.requestCount(), 2);
+}
+
+TEST(StunCodecTest, EncodesBindingRequest) {
+    stun::message request;
+    stun::message_factory::create_binding_request(request);
+    EXPECT_TRUE(request.is_rfc5389());
+
+    stun::packet bytes;
+    ASSERT_EQ(request.encode(bytes), stun::header_size);
+    EXPECT_EQ(bytes[0], 0x00);
+    EXPECT_EQ(bytes[1], 0x01);
+    EXPECT_EQ(bytes[2], 0x00);
+    EXPECT_EQ(bytes[3], 0x00);
+    EXPECT_EQ(bytes[4], 0x21);
+    EXPECT_EQ(bytes[5], 0x12);
+    EXPECT_EQ(bytes[6], 0xA4);
+    EXPECT_EQ(bytes[7], 0x42);
+}
+
+TEST(StunCodecTest, DecodesIntoViews) {
+    /* binding response: SOFTWARE "mock!" padded to 8, then XOR-MAPPED-ADDRESS of 192.0.2.1:32853 */
+    stun::packet bytes = {
+        0x01, 0x01, 0x00, 0x18, 0x21, 0x12, 0xA4, 0x42,
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+        0x80, 0x22, 0x00, 0x05, 'm', 'o', 'c', 'k', '!', 0x00, 0x00, 0x00,
+        0x00, 0x20, 0x00, 0x08, 0x00, 0x01, 0xA1, 0x47, 0xE1, 0x12, 0xA6, 0x43
+    };
+    stun::message response;
+    ASSERT_TRUE(stun::decoder::decode_message(bytes, 44, response));
+    EXPECT_TRUE(response.is_rfc5389());
+    ASSERT_EQ(response.attribute_count(), 2u);
+
+    stun::attribute const * software = response.find_attribute(stun::attribute_type::software);
+    ASSERT_NE(software, nullptr);
+    EXPECT_EQ(software->length, 5);
+    EXPECT_EQ(software->value, bytes.data() + 24);
+
+    stun::attribute const * mapped = response.find_attribute(stun::attribute_type::xor_mapped_address);
+    ASSERT_NE(mapped, nullptr);
+    sockaddr_storage addr = {};
+    ASSERT_TRUE(stun::attributes::address::decode(*mapped, &response.header().transaction_id, addr));
+    EXPECT_EQ(stun::sockaddr_to_string(addr), "192.0.2.1");
+    EXPECT_EQ(ntohs(reinterpret_cast<sockaddr_in*>(&addr)->sin_port), 32853);
+
+    /* re-encoding keeps the padding */
+    stun::packet out;
+    ASSERT_EQ(response.encode(out), 44u);
+    EXPECT_TRUE(std::equal(bytes.begin(), bytes.begin() + 44, out.begin()));
+}
+
+TEST(StunCodecTest, RejectsMalformedMessages) {
+    stun::packet bytes = {};
+    stun::message msg;
+    EXPECT_FALSE(stun::decoder::decode_message(bytes, 4, msg));
+    EXPECT_FALSE(stun::decoder::decode_message(bytes, bytes.size() + 1, msg));
+
+    /* header claims 8 bytes of attributes that are not there */
+    bytes[0] = 0x01; bytes[1] = 0x01; bytes[3] = 0x08;
+    EXPECT_FALSE(stun::decoder::decode_message(bytes, 20, msg));
+
+    /* attribute longer than the message */
+    bytes[3] = 0x04;
+    bytes[20] = 0x00; bytes[21] = 0x01; bytes[22] = 0x00; bytes[23] = 0x08;
+    EXPECT_FALSE(stun::decoder::decode_message(bytes, 24, msg));
+
+    /* truncated attribute header */
+    bytes[3] = 0x02;
+    EXPECT_FALSE(stun::decoder::decode_message(bytes, 22, msg));
+
+    /* too short to be an address */
+    stun::attribute shortAddress = { stun::attribute_type::mapped_address, 4, bytes.data() };
+    sockaddr_storage addr = {};
+    EXPECT_FALSE(stun::attributes::address::decode(shortAddress, nullptr, addr));
+}
+
+TEST(StunCodecTest, BoundsAttributeCount) {
+    stun::message msg;
+    const uint8_t value[4] = {};
+    for (size_t i = 0; i < stun::max_attributes; ++i)
+        ASSERT_TRUE(msg.add_attribute(stun::attribute_type::software, value, sizeof(value)));
+    EXPECT_FALSE(msg.add_attribute(stun::attribute_type::software, value, sizeof(value)));
+
+    /* 16 attributes of 8 bytes plus the header fit; a 548 byte limit holds for larger ones */
+    stun::packet out;
+    EXPECT_EQ(msg.encode(out), stun::header_size + stun::max_attributes * 8);
+
+    stun::message large;
+    static uint8_t big[400] = {};
+    ASSERT_TRUE(large.add_attribute(stun::attribute_type::software, big, sizeof(big)));
+    ASSERT_TRUE(large.add_attribute(stun::attribute_type::software, big, sizeof(big)));
+    EXPECT_EQ(large.encode(out), 0u);
+}
+
+TEST(StunServerTest, ParsesServerList) {
+    stun::server srv("", 0);
+    ASSERT_TRUE(stun::parse_server("stun.l.google.com", 19302, srv));
+    EXPECT_EQ(srv.hostname, "stun.l.google.com");
+    EXPECT_EQ(srv.port, 19302);
+    ASSERT_TRUE(stun::parse_server("stun1.example.com:3478", 19302, srv));
+    EXPECT_EQ(srv.hostname, "stun1.example.com");
+    EXPECT_EQ(srv.port, 3478);
+    ASSERT_TRUE(stun::parse_server("[2001:db8::1]:3479", 19302, srv));
+    EXPECT_EQ(srv.hostname, "2001:db8::1");
+    EXPECT_EQ(srv.port, 3479);
+    ASSERT_TRUE(stun::parse_server("2001:db8::1", 19302, srv));
+    EXPECT_EQ(srv.hostname, "2001:db8::1");
+    EXPECT_EQ(srv.port, 19302);
+
+    EXPECT_FALSE(stun::parse_server("", 19302, srv));
+    EXPECT_FALSE(stun::parse_server("host:0", 19302, srv));
+    EXPECT_FALSE(stun::parse_server("host:70000", 19302, srv));
+    EXPECT_FALSE(stun::parse_server("host:12ab", 19302, srv));
+    EXPECT_FALSE(stun::parse_server("[2001:db8::1", 19302, srv));
+}
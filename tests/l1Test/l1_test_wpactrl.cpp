@@ -0,0 +1,285 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "NetworkManagerWpaCtrl.h"
+
+using namespace std;
+using namespace WPEFramework::Plugin;
+
+/* Minimal stand-in for the wpa_supplicant control interface */
+class FakeWpaSupplicant {
+public:
+    explicit FakeWpaSupplicant(const string& path) : m_path(path) {}
+    ~FakeWpaSupplicant() { stop(); }
+
+    void setReply(const string& cmd, const string& reply) { m_replies[cmd] = reply; }
+    void setSilent(bool silent) { m_silent = silent; }
+    int requestCount() const { return m_requests.load(); }
+
+    /* Pushes an unsolicited message to the last attached client */
+    bool sendEvent(const string& event)
+    {
+        std::lock_guard<std::mutex> lock(m_attachLock);
+        if (!m_attached)
+            return false;
+        return sendto(m_fd, event.c_str(), event.size(), 0, reinterpret_cast<struct sockaddr*>(&m_monitor), m_monitorLen) > 0;
+    }
+
+    bool start()
+    {
+        struct sockaddr_un addr = {};
+        m_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+        if (m_fd < 0)
+            return false;
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(m_path.c_str());
+        if (bind(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)
+            return false;
+        m_stop = false;
+        m_thread = std::thread(&FakeWpaSupplicant::serve, this);
+        return true;
+    }
+
+    void stop()
+    {
+        m_stop = true;
+        if (m_thread.joinable())
+            m_thread.join();
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+            m_fd = -1;
+            unlink(m_path.c_str());
+        }
+    }
+
+private:
+    void serve()
+    {
+        char buf[256];
+        while (!m_stop)
+        {
+            struct pollfd pfd = { m_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 50) <= 0)
+                continue;
+
+            struct sockaddr_un from = {};
+            socklen_t fromLen = sizeof(from);
+            ssize_t len = recvfrom(m_fd, buf, sizeof(buf) - 1, 0, reinterpret_cast<struct sockaddr*>(&from), &fromLen);
+            if (len <= 0)
+                continue;
+            buf[len] = '\0';
+            m_requests++;
+            if (m_silent)
+                continue;
+
+            if (strcmp(buf, "ATTACH") == 0)
+            {
+                std::lock_guard<std::mutex> lock(m_attachLock);
+                m_monitor = from;
+                m_monitorLen = fromLen;
+                m_attached = true;
+            }
+
+            /* An unsolicited event ahead of the reply must be skipped by the client */
+            const char* event = "<3>CTRL-EVENT-SCAN-STARTED ";
+            sendto(m_fd, event, strlen(event), 0, reinterpret_cast<struct sockaddr*>(&from), fromLen);
+
+            auto it = m_replies.find(buf);
+            string reply = (it != m_replies.end()) ? it->second : "UNKNOWN COMMAND\n";
+            sendto(m_fd, reply.c_str(), reply.size(), 0, reinterpret_cast<struct sockaddr*>(&from), fromLen);
+        }
+    }
+
+    string m_path;
+    int m_fd = -1;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{true};
+    std::atomic<bool> m_silent{false};
+    std::atomic<int> m_requests{0};
+    std::map<string, string> m_replies;
+    std::mutex m_attachLock;
+    struct sockaddr_un m_monitor = {};
+    socklen_t m_monitorLen = 0;
+    bool m_attached = false;
+};
+
+static const char* STATUS_CONNECTED =
+    "bssid=aa:bb:cc:dd:ee:ff\n"
+    "freq=2462\n"
+    "ssid=dummySSID\n"
+    "id=0\n"
+    "mode=station\n"
+    "wpa_state=COMPLETED\n";
+
+static const char* SIGNAL_POLL_REPLY =
+    "RSSI=-52\n"
+    "LINKSPEED=300\n"
+    "NOISE=-92\n"
+    "FREQUENCY=5180\n"
+    "AVG_RSSI=-50\n";
+
+class WpaCtrlClientTest : public ::testing::Test {
+protected:
+    WpaCtrlClientTest()
+        : m_path("/tmp/nm_l1_wpa_" + std::to_string(getpid()))
+        , m_server(m_path)
+        , m_client(m_path)
+    {
+    }
+
+    string m_path;
+    FakeWpaSupplicant m_server;
+    WpaCtrlClient m_client;
+};
+
+TEST(WpaCtrlParserTest, FindValueMatchesWholeKey) {
+    const char* value = nullptr;
+    size_t len = 0;
+    EXPECT_TRUE(WpaCtrlClient::findValue(STATUS_CONNECTED, strlen(STATUS_CONNECTED), "ssid", value, len));
+    EXPECT_EQ(string(value, len), "dummySSID");
+    EXPECT_TRUE(WpaCtrlClient::findValue(STATUS_CONNECTED, strlen(STATUS_CONNECTED), "bssid", value, len));
+    EXPECT_EQ(string(value, len), "aa:bb:cc:dd:ee:ff");
+    EXPECT_FALSE(WpaCtrlClient::findValue(STATUS_CONNECTED, strlen(STATUS_CONNECTED), "sid", value, len));
+}
+
+TEST(WpaCtrlParserTest, ParseInt) {
+    int result = 0;
+    EXPECT_TRUE(WpaCtrlClient::parseInt("-52", 3, result));
+    EXPECT_EQ(result, -52);
+    EXPECT_TRUE(WpaCtrlClient::parseInt("300", 3, result));
+    EXPECT_EQ(result, 300);
+    EXPECT_FALSE(WpaCtrlClient::parseInt("", 0, result));
+    EXPECT_FALSE(WpaCtrlClient::parseInt("-", 1, result));
+    EXPECT_FALSE(WpaCtrlClient::parseInt("12a", 3, result));
+}
+
+TEST(WpaCtrlParserTest, ParseSignalPollEmptyRssi) {
+    const char* reply = "RSSI=\nNOISE=-114\nAVG_RSSI=-90\n";
+    WpaSignalInfo info;
+    info.clear();
+    WpaCtrlClient::parseSignalPoll(reply, strlen(reply), info);
+    EXPECT_FALSE(info.hasRssi);
+    EXPECT_TRUE(info.hasAvgRssi);
+    EXPECT_EQ(info.avgRssi, -90);
+    EXPECT_TRUE(info.hasNoise);
+    EXPECT_EQ(info.noise, -114);
+    EXPECT_FALSE(info.hasFrequency);
+}
+
+TEST_F(WpaCtrlClientTest, OpenFailsWithoutSupplicant) {
+    EXPECT_FALSE(m_client.open());
+    WpaSignalInfo info;
+    EXPECT_FALSE(m_client.getSignalInfo(info));
+}
+
+TEST_F(WpaCtrlClientTest, GetSignalInfoConnected) {
+    m_server.setReply("STATUS", STATUS_CONNECTED);
+    m_server.setReply("SIGNAL_POLL", SIGNAL_POLL_REPLY);
+    ASSERT_TRUE(m_server.start());
+
+    WpaSignalInfo info;
+    ASSERT_TRUE(m_client.getSignalInfo(info));
+    EXPECT_STREQ(info.ssid, "dummySSID");
+    EXPECT_STREQ(info.bssid, "aa:bb:cc:dd:ee:ff");
+    EXPECT_EQ(info.rssi, -52);
+    EXPECT_EQ(info.avgRssi, -50);
+    EXPECT_EQ(info.noise, -92);
+    EXPECT_EQ(info.frequency, 5180);
+    EXPECT_EQ(info.linkSpeed, 300);
+
+    /* The socket stays open between requests */
+    EXPECT_TRUE(m_client.isOpen());
+    ASSERT_TRUE(m_client.getSignalInfo(info));
+    EXPECT_EQ(m_server.requestCount(), 4);
+}
+
+TEST_F(WpaCtrlClientTest, GetSignalInfoDisconnected) {
+    m_server.setReply("STATUS", "wpa_state=DISCONNECTED\naddress=d4:52:ee:d9:0a:39\n");
+    ASSERT_TRUE(m_server.start());
+
+    WpaSignalInfo info;
+    ASSERT_TRUE(m_client.getSignalInfo(info));
+    EXPECT_STREQ(info.bssid, "");
+    EXPECT_FALSE(info.hasRssi);
+    /* SIGNAL_POLL is not issued when not associated */
+    EXPECT_EQ(m_server.requestCount(), 1);
+}
+
+TEST_F(WpaCtrlClientTest, RequestTimesOut) {
+    m_server.setSilent(true);
+    ASSERT_TRUE(m_server.start());
+
+    char reply[64];
+    EXPECT_EQ(m_client.request("PING", reply, sizeof(reply), 100), -1);
+}
+
+TEST_F(WpaCtrlClientTest, ReconnectsAfterSupplicantRestart) {
+    m_server.setReply("PING", "PONG\n");
+    ASSERT_TRUE(m_server.start());
+
+    char reply[64];
+    ASSERT_GT(m_client.request("PING", reply, sizeof(reply)), 0);
+    EXPECT_STREQ(reply, "PONG\n");
+
+    m_server.stop();
+    ASSERT_TRUE(m_server.start());
+    ASSERT_GT(m_client.request("PING", reply, sizeof(reply)), 0);
+    EXPECT_STREQ(reply, "PONG\n");
+}
+
+TEST_F(WpaCtrlClientTest, AttachAndReceiveSignalChange) {
+    m_server.setReply("ATTACH", "OK\n");
+    m_server.setReply("SIGNAL_MONITOR THRESHOLD=-67 HYSTERESIS=2", "OK\n");
+    ASSERT_TRUE(m_server.start());
+
+    char event[256];
+    ASSERT_TRUE(m_client.attach());
+    EXPECT_TRUE(m_client.setSignalMonitor(-67, 2));
+    EXPECT_EQ(m_client.receiveEvent(event, sizeof(event)), 0);
+
+    ASSERT_TRUE(m_server.sendEvent("<3>CTRL-EVENT-SIGNAL-CHANGE above=0 signal=-70 noise=-92 txrate=6000"));
+    struct pollfd pfd = { m_client.fd(), POLLIN, 0 };
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+    ASSERT_GT(m_client.receiveEvent(event, sizeof(event)), 0);
+    EXPECT_TRUE(WpaCtrlClient::isEvent(event, WPA_EVENT_SIGNAL_CHANGE));
+    EXPECT_FALSE(WpaCtrlClient::isEvent(event, WPA_EVENT_DISCONNECTED));
+    EXPECT_STREQ(event, "CTRL-EVENT-SIGNAL-CHANGE above=0 signal=-70 noise=-92 txrate=6000");
+}
+
+TEST_F(WpaCtrlClientTest, SignalMonitorUnsupported) {
+    m_server.setReply("ATTACH", "OK\n");
+    m_server.setReply("SIGNAL_MONITOR THRESHOLD=-67 HYSTERESIS=2", "FAIL\n");
+    ASSERT_TRUE(m_server.start());
+
+    ASSERT_TRUE(m_client.attach());
+    EXPECT_FALSE(m_client.setSignalMonitor(-67, 2));
+}
@@ -35,6 +35,7 @@
 #include "NetworkManagerImplementation.h"
 #include "NetworkManagerLogger.h"
 #include "NetworkManager.h"
+#include "NetworkManagerGnomeDeviceSnapshot.h"
 #include <libnm/NetworkManager.h>
 
 using namespace WPEFramework;
@@ -511,6 +512,36 @@ TEST_F(NetworkManagerTest, GetAvailableInterfaces_disabled)
     g_ptr_array_free(fakeDevices, TRUE);
 }
 
+TEST_F(NetworkManagerTest, GetInterfaces_FromDeviceSnapshot)
+{
+    /* with the event thread's snapshot loaded, read-only calls create no NMClient */
+    Plugin::DeviceSnapshot::getInstance()->reset({{"wlan0", "66:77:88:99:AA:BB", NM_DEVICE_STATE_ACTIVATED},
+                                          {"eth0", "00:11:22:33:44:55", NM_DEVICE_STATE_UNMANAGED}});
+    EXPECT_CALL(*p_libnmWrapsImplMock, nm_client_new(::testing::_, ::testing::_))
+        .Times(0);
+    EXPECT_CALL(*p_libnmWrapsImplMock, nm_client_get_devices(::testing::_))
+        .Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("GetInterfaceState"), _T("{\"interface\":\"wlan0\"}"), response));
+    EXPECT_EQ(response, _T("{\"enabled\":true,\"success\":true}"));
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("GetInterfaceState"), _T("{\"interface\":\"eth0\"}"), response));
+    EXPECT_EQ(response, _T("{\"enabled\":false,\"success\":true}"));
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("GetAvailableInterfaces"), _T(""), response));
+    std::string expectedResponse =
+        _T("{\"interfaces\":[")
+        _T("{\"type\":\"WIFI\",\"name\":\"wlan0\",\"mac\":\"66:77:88:99:AA:BB\",\"enabled\":true,\"connected\":true},")
+        _T("{\"type\":\"ETHERNET\",\"name\":\"eth0\",\"mac\":\"00:11:22:33:44:55\",\"enabled\":false,\"connected\":false}")
+        _T("],\"success\":true}");
+    EXPECT_EQ(response, expectedResponse);
+
+    Plugin::DeviceSnapshot::getInstance()->remove("eth0");
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("GetInterfaceState"), _T("{\"interface\":\"eth0\"}"), response));
+    EXPECT_EQ(response, _T("{\"success\":false}"));
+
+    Plugin::DeviceSnapshot::getInstance()->invalidate();
+}
+
 TEST_F(NetworkManagerTest, GetIPSettings_unknown_iface)
 {
     EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("GetIPSettings"), _T("{\"interface\":\"eth1\"}"), response));
@@ -838,7 +869,7 @@ TEST_F(NetworkManagerTest, GetIPSettings_cache_cleared)
 
 /* ────────────────────────────────────────────────────────────────────────────
  * Utility function tests — isIPv4LinkLocal, isIPv6LinkLocal, isIPv6ULA,
- * isIPv6MacBased (which exercises parseMac internally).
+ * isIPv6MacBased (which exercises MacAddr::parse internally).
  * ──────────────────────────────────────────────────────────────────────────── */
 
 TEST_F(NetworkManagerTest, isIPv4LinkLocal_true_for_169_254)
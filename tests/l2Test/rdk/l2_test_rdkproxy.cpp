@@ -1450,6 +1450,9 @@ TEST_F(NetworkManagerTest, GetWiFiSignalQualityConnectedLowBad)
 
 TEST_F(NetworkManagerTest, Trace_Success_ipv4)
 {
+    /* no UDP socket with an error queue: the traceroute binary runs and its output is passed on */
+    EXPECT_CALL(*p_wrapsImplMock, setsockopt(::testing::_, IPPROTO_IP, IP_RECVERR, ::testing::_, ::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(ENOPROTOOPT, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         EXPECT_THAT(string(command), ::testing::MatchesRegex("traceroute -w 3 -m 6 -q 1 8.8.8.8 52 2>&1"));
@@ -1481,6 +1484,9 @@ TEST_F(NetworkManagerTest, Trace_Success_ipv4)
 
 TEST_F(NetworkManagerTest, Trace_Failed_ipv6)
 {
+    /* no UDP socket with an error queue: the traceroute binary runs and its output is passed on */
+    EXPECT_CALL(*p_wrapsImplMock, setsockopt(::testing::_, IPPROTO_IPV6, IPV6_RECVERR, ::testing::_, ::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(ENOPROTOOPT, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         EXPECT_THAT(string(command), ::testing::MatchesRegex("traceroute6 -w 3 -m 6 -q 1 8.8.8.8 64 2>&1"));
@@ -1502,6 +1508,9 @@ TEST_F(NetworkManagerTest, Trace_Failed_ipv6)
 
 TEST_F(NetworkManagerTest, Trace_Success_ipv6)
 {
+    /* no UDP socket with an error queue: the traceroute binary runs and its output is passed on */
+    EXPECT_CALL(*p_wrapsImplMock, setsockopt(::testing::_, IPPROTO_IPV6, IPV6_RECVERR, ::testing::_, ::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(ENOPROTOOPT, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         EXPECT_THAT(string(command), ::testing::MatchesRegex("traceroute6 -w 3 -m 6 -q 1 2001:4860:4860::8888 64 2>&1"));
@@ -1525,6 +1534,9 @@ TEST_F(NetworkManagerTest, Trace_Success_ipv6)
 
 TEST_F(NetworkManagerTest, Ping_Success_ipv4)
 {
+    /* no ICMP socket can be served: the ping binary runs and its output is parsed */
+    EXPECT_CALL(*p_wrapsImplMock, epoll_create1(::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(EMFILE, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         std::string cmdStr = command;
@@ -1555,6 +1567,9 @@ TEST_F(NetworkManagerTest, Ping_Success_ipv4)
 
 TEST_F(NetworkManagerTest, Ping_Failed_ipv4)
 {
+    /* no ICMP socket can be served: the ping binary runs and its output is parsed */
+    EXPECT_CALL(*p_wrapsImplMock, epoll_create1(::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(EMFILE, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         std::string cmdStr = command;
@@ -1581,6 +1596,9 @@ TEST_F(NetworkManagerTest, Ping_Failed_ipv4)
 
 TEST_F(NetworkManagerTest, Ping_success_ipv6)
 {
+    /* no ICMP socket can be served: the ping binary runs and its output is parsed */
+    EXPECT_CALL(*p_wrapsImplMock, epoll_create1(::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(EMFILE, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         std::string cmdStr = command;
@@ -1612,6 +1630,9 @@ TEST_F(NetworkManagerTest, Ping_success_ipv6)
 
 TEST_F(NetworkManagerTest, Ping_Failed_ipv6)
 {
+    /* no ICMP socket can be served: the ping binary runs and its output is parsed */
+    EXPECT_CALL(*p_wrapsImplMock, epoll_create1(::testing::_))
+        .WillOnce(::testing::SetErrnoAndReturn(EMFILE, -1));
     EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_))
         .WillOnce([](const char* command, const char* type) -> FILE* {
         std::string cmdStr = command;
@@ -1626,3 +1647,122 @@ TEST_F(NetworkManagerTest, Ping_Failed_ipv6)
 
     EXPECT_EQ(response, _T("{\"endpoint\":\"2404:6800:4007:80b::200e\"}"));
 }
+
+TEST_F(NetworkManagerTest, Trace_Loopback_ipv4)
+{
+    /* the probes are sent in process; the traceroute binary is only a fallback */
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Trace"), 
+        _T("{\"endpoint\":\"127.0.0.1\",\"ipversion\":\"IPv4\",\"packets\":1}"), response));
+
+    // We expect the response to contain success, results and the hop list
+    EXPECT_TRUE(response.find("\"success\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("\"results\":") != std::string::npos);
+    EXPECT_TRUE(response.find("\"endpoint\":\"127.0.0.1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("6 hops max, 52 byte packets") != std::string::npos);
+    EXPECT_TRUE(response.find("\"reached\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("\"hops\":[{") != std::string::npos);
+    EXPECT_TRUE(response.find("\"address\":\"127.0.0.1\"") != std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Trace_BadAddress_ipv6)
+{
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Trace"), 
+        _T("{\"endpoint\":\"8.8.8.8\",\"ipversion\":\"IPv6\",\"packets\":1}"), response));
+
+    /* as with the traceroute binary, the call succeeds and results carries the reason */
+    EXPECT_TRUE(response.find("\"success\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("traceroute6: bad address '8.8.8.8'") != std::string::npos);
+    EXPECT_TRUE(response.find("\"endpoint\":\"8.8.8.8\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"hops\"") == std::string::npos);
+    EXPECT_TRUE(response.find("\"error\"") == std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Trace_Loopback_ipv6)
+{
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Trace"), 
+        _T("{\"endpoint\":\"::1\",\"ipversion\":\"IPv6\",\"packets\":1}"), response));
+
+    if (response.find("\"reached\":false") != std::string::npos)
+        GTEST_SKIP() << "IPv6 loopback is not configured";
+    EXPECT_TRUE(response.find("\"success\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("6 hops max, 64 byte packets") != std::string::npos);
+    EXPECT_TRUE(response.find("\"endpoint\":\"::1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"address\":\"::1\"") != std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Ping_Loopback_ipv4)
+{
+    if (!Plugin::IcmpEchoEngine::available(AF_INET))
+        GTEST_SKIP() << "no ICMP socket permitted";
+
+    /* the echo requests are sent in process; the ping binary is only a fallback */
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Ping"), 
+        _T("{\"endpoint\":\"127.0.0.1\",\"ipversion\":\"IPv4\",\"count\":3,\"timeout\":2}"), response));
+
+    EXPECT_TRUE(response.find("\"endpoint\":\"127.0.0.1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("\"packetsTransmitted\":3") != std::string::npos);
+    EXPECT_TRUE(response.find("\"packetsReceived\":3") != std::string::npos);
+    EXPECT_TRUE(response.find("\"packetLoss\":\" 0\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"tripMin\":\" ") != std::string::npos);
+    EXPECT_TRUE(response.find("\"tripAvg\"") != std::string::npos);
+    EXPECT_THAT(string(response), ::testing::ContainsRegex("\"tripStdDev\":\"[0-9.]+ ms\""));
+    EXPECT_TRUE(response.find("\"tripJitter\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"rtt\":[") != std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Ping_WrongFamily_ipv4)
+{
+    if (!Plugin::IcmpEchoEngine::available(AF_INET))
+        GTEST_SKIP() << "no ICMP socket permitted";
+
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Ping"), 
+        _T("{\"endpoint\":\"::1\",\"ipversion\":\"IPv4\",\"count\":3,\"timeout\":2}"), response));
+
+    EXPECT_TRUE(response.find("\"endpoint\":\"::1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"success\":false") != std::string::npos);
+    EXPECT_TRUE(response.find("\"error\":\"Bad Address\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"packetsTransmitted\":0") != std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Ping_Loopback_ipv6)
+{
+    if (!Plugin::IcmpEchoEngine::available(AF_INET6))
+        GTEST_SKIP() << "no ICMPv6 socket permitted";
+
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Ping"), 
+        _T("{\"endpoint\":\"::1\",\"ipversion\":\"IPv6\",\"count\":2,\"timeout\":2}"), response));
+
+    if (response.find("\"packetsReceived\":0") != std::string::npos)
+        GTEST_SKIP() << "IPv6 loopback is not configured";
+    EXPECT_TRUE(response.find("\"endpoint\":\"::1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"success\":true") != std::string::npos);
+    EXPECT_TRUE(response.find("\"packetsReceived\":2") != std::string::npos);
+}
+
+TEST_F(NetworkManagerTest, Ping_WrongFamily_ipv6)
+{
+    if (!Plugin::IcmpEchoEngine::available(AF_INET6))
+        GTEST_SKIP() << "no ICMPv6 socket permitted";
+
+    EXPECT_CALL(*p_wrapsImplMock, popen(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(Core::ERROR_NONE, handler.Invoke(connection, _T("Ping"), 
+        _T("{\"endpoint\":\"127.0.0.1\",\"ipversion\":\"IPv6\",\"count\":2,\"timeout\":2}"), response));
+
+    EXPECT_TRUE(response.find("\"endpoint\":\"127.0.0.1\"") != std::string::npos);
+    EXPECT_TRUE(response.find("\"success\":false") != std::string::npos);
+    EXPECT_TRUE(response.find("\"error\":\"Bad Address\"") != std::string::npos);
+}
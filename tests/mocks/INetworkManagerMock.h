@@ -54,6 +54,15 @@ public:
     MOCK_METHOD(uint32_t, SetHostname, (const string& hostname), (override));
     MOCK_METHOD(uint32_t, GetLogLevel, (Logging& level), (override));
     MOCK_METHOD(uint32_t, Configure, (const string configLine), (override));
+    MOCK_METHOD(uint32_t, WiFiConnectAsync, (const WiFiConnectTo& ssid, const uint32_t timeout, uint32_t& operationId), (override));
+    MOCK_METHOD(uint32_t, ConnectToKnownSSIDAsync, (const string& ssid, const uint32_t timeout, uint32_t& operationId), (override));
+    MOCK_METHOD(uint32_t, SetInterfaceStateAsync, (const string& interface, const bool enabled, const uint32_t timeout, uint32_t& operationId), (override));
+    MOCK_METHOD(uint32_t, SetIPSettingsAsync, (const string& interface, const IPAddress& address, const uint32_t timeout, uint32_t& operationId), (override));
+    MOCK_METHOD(uint32_t, StartWPSAsync, (const WiFiWPS& method, const string& pin, const uint32_t timeout, uint32_t& operationId), (override));
+    MOCK_METHOD(uint32_t, CancelOperation, (const uint32_t operationId), (override));
+    MOCK_METHOD(uint32_t, GetOperationStatistics, (string& statistics), (override));
+    MOCK_METHOD(uint32_t, GetDualStackPublicIP, (string& interface, string& ipv4address, string& ipv6address), (override));
+    MOCK_METHOD(uint32_t, GetConnectivityMonitorStatistics, (string& statistics), (override));
     MOCK_METHOD(uint32_t, Register, (WPEFramework::Exchange::INetworkManager::INotification* notification), (override));
     MOCK_METHOD(uint32_t, Unregister, (WPEFramework::Exchange::INetworkManager::INotification* notification), (override));
     MOCK_METHOD(uint32_t, AddRef, (), (const, override));
@@ -0,0 +1,187 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#pragma once
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/*
+ * Local UDP STUN responder on 127.0.0.1 and, when available, ::1 (same port). It answers
+ * binding requests with the sender address, as XOR-MAPPED-ADDRESS (RFC 5389) or
+ * MAPPED-ADDRESS (RFC 3489), and can drop requests to model a lossy path.
+ */
+class StunMockServer {
+public:
+    ~StunMockServer() { stop(); }
+
+    void setRfc5389(bool enable) { m_rfc5389 = enable; }
+    void setSilent(bool silent) { m_silent = silent; }
+    /* the first count requests get no answer */
+    void dropRequests(int count) { m_drop = count; }
+    /* answer with a transaction id the client never sent */
+    void setWrongTransaction(bool wrong) { m_wrongTransaction = wrong; }
+
+    bool start()
+    {
+        m_fd4 = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in v4 = {};
+        v4.sin_family = AF_INET;
+        v4.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(v4);
+        if (m_fd4 < 0 || ::bind(m_fd4, reinterpret_cast<sockaddr*>(&v4), sizeof(v4)) < 0
+            || getsockname(m_fd4, reinterpret_cast<sockaddr*>(&v4), &len) < 0)
+            return false;
+        m_port = ntohs(v4.sin_port);
+
+        m_fd6 = socket(AF_INET6, SOCK_DGRAM, 0);
+        sockaddr_in6 v6 = {};
+        v6.sin6_family = AF_INET6;
+        v6.sin6_addr = in6addr_loopback;
+        v6.sin6_port = htons(m_port);
+        int only = 1;
+        if (m_fd6 >= 0)
+            setsockopt(m_fd6, IPPROTO_IPV6, IPV6_V6ONLY, &only, sizeof(only));
+        if (m_fd6 >= 0 && ::bind(m_fd6, reinterpret_cast<sockaddr*>(&v6), sizeof(v6)) < 0)
+        {
+            close(m_fd6);
+            m_fd6 = -1;
+        }
+
+        m_running = true;
+        m_thread = std::thread(&StunMockServer::serve, this);
+        return true;
+    }
+
+    void stop()
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+        if (m_fd4 >= 0)
+            close(m_fd4);
+        if (m_fd6 >= 0)
+            close(m_fd6);
+        m_fd4 = m_fd6 = -1;
+    }
+
+    uint16_t port() const { return m_port; }
+    bool hasIPv6() const { return m_fd6 >= 0; }
+    int requestCount() const { return m_requests.load(); }
+
+private:
+    void serve()
+    {
+        while (m_running)
+        {
+            struct pollfd pfd[2] = { { m_fd4, POLLIN, 0 }, { m_fd6, POLLIN, 0 } };
+            if (poll(pfd, m_fd6 >= 0 ? 2 : 1, 20) <= 0)
+                continue;
+            for (auto& p : pfd)
+            {
+                if (p.fd >= 0 && (p.revents & POLLIN))
+                    answer(p.fd);
+            }
+        }
+    }
+
+    void answer(int fd)
+    {
+        uint8_t request[548];
+        sockaddr_storage from = {};
+        socklen_t fromLen = sizeof(from);
+        ssize_t n = recvfrom(fd, request, sizeof(request), 0, reinterpret_cast<sockaddr*>(&from), &fromLen);
+        if (n < 20 || request[0] != 0x00 || request[1] != 0x01)
+            return;
+        int count = ++m_requests;
+        if (m_silent || count <= m_drop)
+            return;
+
+        /* the transaction id is bytes 4..19, including the magic cookie of RFC 5389 */
+        std::vector<uint8_t> id(request + 4, request + 20);
+        if (m_wrongTransaction)
+            id.back() ^= 0xff;
+
+        uint16_t port = 0;
+        std::vector<uint8_t> address;
+        uint8_t family = 0;
+        if (from.ss_family == AF_INET)
+        {
+            auto* v4 = reinterpret_cast<sockaddr_in*>(&from);
+            family = 0x01;
+            port = ntohs(v4->sin_port);
+            const uint8_t* a = reinterpret_cast<const uint8_t*>(&v4->sin_addr);
+            address.assign(a, a + 4);
+        }
+        else
+        {
+            auto* v6 = reinterpret_cast<sockaddr_in6*>(&from);
+            family = 0x02;
+            port = ntohs(v6->sin6_port);
+            address.assign(v6->sin6_addr.s6_addr, v6->sin6_addr.s6_addr + 16);
+        }
+
+        uint16_t type = 0x0001;
+        if (m_rfc5389)
+        {
+            type = 0x0020;
+            port ^= 0x2112;
+            for (size_t i = 0; i < address.size(); ++i)
+                address[i] ^= id[i];
+        }
+
+        std::vector<uint8_t> reply = { 0x01, 0x01, 0x00, 0x00 };
+        reply.insert(reply.end(), id.begin(), id.end());
+        if (m_rfc5389)
+        {
+            /* an unknown comprehension-optional attribute with padding, which the client must skip */
+            const uint8_t software[] = { 0x80, 0x22, 0x00, 0x05, 'm', 'o', 'c', 'k', '!', 0x00, 0x00, 0x00 };
+            reply.insert(reply.end(), software, software + sizeof(software));
+        }
+        reply.push_back(type >> 8);
+        reply.push_back(type & 0xff);
+        reply.push_back(0x00);
+        reply.push_back(static_cast<uint8_t>(4 + address.size()));
+        reply.push_back(0x00);
+        reply.push_back(family);
+        reply.push_back(port >> 8);
+        reply.push_back(port & 0xff);
+        reply.insert(reply.end(), address.begin(), address.end());
+        reply[2] = static_cast<uint8_t>((reply.size() - 20) >> 8);
+        reply[3] = static_cast<uint8_t>((reply.size() - 20) & 0xff);
+        sendto(fd, reply.data(), reply.size(), 0, reinterpret_cast<sockaddr*>(&from), fromLen);
+    }
+
+    int m_fd4 = -1;
+    int m_fd6 = -1;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_rfc5389{true};
+    std::atomic<bool> m_silent{false};
+    std::atomic<bool> m_wrongTransaction{false};
+    std::atomic<int> m_drop{0};
+    std::atomic<int> m_requests{0};
+    std::thread m_thread;
+};
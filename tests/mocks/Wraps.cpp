@@ -76,6 +76,18 @@ extern "C" time_t __wrap_time(time_t *arg)
     return Wraps::getInstance().time(arg);
 }
 
+extern "C" int __wrap_epoll_create1(int flags)
+{
+    return Wraps::getInstance().epoll_create1(flags);
+}
+
+extern "C" int __real_setsockopt(int fd, int level, int name, const void* value, socklen_t length);
+
+extern "C" int __wrap_setsockopt(int fd, int level, int name, const void* value, socklen_t length)
+{
+    return Wraps::getInstance().setsockopt(fd, level, name, value, length);
+}
+
 WrapsImpl* Wraps::impl = nullptr;
 
 Wraps::Wraps() {}
@@ -160,3 +172,17 @@ time_t Wraps::time(time_t* arg)
     return impl->time(arg);
 }
 
+int Wraps::epoll_create1(int flags)
+{
+    EXPECT_NE(impl, nullptr);
+    return impl->epoll_create1(flags);
+}
+
+int Wraps::setsockopt(int fd, int level, int name, const void* value, socklen_t length)
+{
+    /* Netlink and STUN sockets are configured from fixtures that install no impl */
+    if (impl == nullptr)
+        return __real_setsockopt(fd, level, name, value, length);
+    return impl->setsockopt(fd, level, name, value, length);
+}
+
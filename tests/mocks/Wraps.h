@@ -2,6 +2,7 @@
 
 #include <stdio.h>
 #include <mntent.h>
+#include <sys/socket.h>
 #include "secure_wrappermock.h"
 
 class WrapsImpl {
@@ -19,6 +20,8 @@ public:
     virtual int v_secure_system(const char *command, va_list args) =0;
     virtual ssize_t readlink(const char *pathname, char *buf, size_t bufsiz) = 0;
     virtual time_t time(time_t* arg) = 0;
+    virtual int epoll_create1(int flags) = 0;
+    virtual int setsockopt(int fd, int level, int name, const void* value, socklen_t length) = 0;
 };
 
 class Wraps {
@@ -52,4 +55,8 @@ public:
     ssize_t readlink(const char *pathname, char *buf, size_t bufsiz);
 
     static time_t time(time_t* arg);
+
+    static int epoll_create1(int flags);
+
+    static int setsockopt(int fd, int level, int name, const void* value, socklen_t length);
 };
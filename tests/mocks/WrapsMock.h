@@ -6,6 +6,8 @@
 #include "Wraps.h"
 
 extern "C" FILE* __real_setmntent(const char* command, const char* type);
+extern "C" int __real_epoll_create1(int flags);
+extern "C" int __real_setsockopt(int fd, int level, int name, const void* value, socklen_t length);
 
 class WrapsImplMock : public WrapsImpl {
 public:
@@ -19,6 +21,17 @@ public:
             [&](const char* command, const char* type) -> FILE* {
                 return __real_setmntent(command, type);
             }));
+        /* The ICMP engines use real sockets and epoll unless a test makes them fail */
+        ON_CALL(*this, epoll_create1(::testing::_))
+        .WillByDefault(::testing::Invoke(
+            [&](int flags) -> int {
+                return __real_epoll_create1(flags);
+            }));
+        ON_CALL(*this, setsockopt(::testing::_, ::testing::_, ::testing::_, ::testing::_, ::testing::_))
+        .WillByDefault(::testing::Invoke(
+            [&](int fd, int level, int name, const void* value, socklen_t length) -> int {
+                return __real_setsockopt(fd, level, name, value, length);
+            }));
     }
     virtual ~WrapsImplMock() = default;
 
@@ -33,4 +46,6 @@ public:
     MOCK_METHOD(int, v_secure_system,(const char *command, va_list args), (override));
     MOCK_METHOD(ssize_t, readlink, (const char *pathname, char *buf, size_t bufsiz), (override));
     MOCK_METHOD(time_t, time, (time_t* arg), (override));
+    MOCK_METHOD(int, epoll_create1, (int flags), (override));
+    MOCK_METHOD(int, setsockopt, (int fd, int level, int name, const void* value, socklen_t length), (override));
 };
\ No newline at end of file
@@ -55,9 +55,9 @@ namespace WPEFramework
         {
             NMLOG_INFO("calling 'ReportInternetStatusChange' cb");
         }
-        void NetworkManagerImplementation::ReportAvailableSSIDs(const JsonArray &arrayofWiFiScanResults)
+        void NetworkManagerImplementation::ReportAvailableSSIDs(ScanResultSet &scanResults)
         {
-            NMLOG_INFO("calling 'ReportAvailableSSIDs' cb");
+            NMLOG_INFO("calling 'ReportAvailableSSIDs' cb with %d SSIDs", static_cast<int>(scanResults.size()));
         }
         void NetworkManagerImplementation::ReportWiFiStateChange(const Exchange::INetworkManager::WiFiState state)
         {